@@ -84,8 +84,82 @@ static void avx512argsort(benchmark::State &state, Args &&...args)
     }
 }
 
+template <typename T, class... Args>
+static void avx512argsort_parallel(benchmark::State &state, Args &&...args)
+{
+    auto args_tuple = std::make_tuple(std::move(args)...);
+    if (!__builtin_cpu_supports("avx512bw")) {
+        state.SkipWithMessage("Requires AVX512 BW ISA");
+    }
+    // Perform setup here
+    size_t ARRSIZE = std::get<0>(args_tuple);
+    std::vector<T> arr;
+    std::vector<int64_t> inx;
+
+    std::string arrtype = std::get<1>(args_tuple);
+    if (arrtype == "random") { arr = get_uniform_rand_array<T>(ARRSIZE); }
+    else if (arrtype == "sorted") {
+        arr = get_uniform_rand_array<T>(ARRSIZE);
+        std::sort(arr.begin(), arr.end());
+    }
+    else if (arrtype == "constant") {
+        T temp = get_uniform_rand_array<T>(1)[0];
+        for (size_t ii = 0; ii < ARRSIZE; ++ii) {
+            arr.push_back(temp);
+        }
+    }
+    else if (arrtype == "reverse") {
+        arr = get_uniform_rand_array<T>(ARRSIZE);
+        std::sort(arr.begin(), arr.end());
+        std::reverse(arr.begin(), arr.end());
+    }
+
+    /* call avx512 argsort on the default thread pool */
+    for (auto _ : state) {
+        inx = avx512_argsort_parallel<T>(arr.data(), ARRSIZE);
+    }
+}
+
+template <typename T, class... Args>
+static void avx2argsort(benchmark::State &state, Args &&...args)
+{
+    auto args_tuple = std::make_tuple(std::move(args)...);
+    if (!__builtin_cpu_supports("avx2")) {
+        state.SkipWithMessage("Requires AVX2 ISA");
+    }
+    // Perform setup here
+    size_t ARRSIZE = std::get<0>(args_tuple);
+    std::vector<T> arr;
+    std::vector<int64_t> inx;
+
+    std::string arrtype = std::get<1>(args_tuple);
+    if (arrtype == "random") { arr = get_uniform_rand_array<T>(ARRSIZE); }
+    else if (arrtype == "sorted") {
+        arr = get_uniform_rand_array<T>(ARRSIZE);
+        std::sort(arr.begin(), arr.end());
+    }
+    else if (arrtype == "constant") {
+        T temp = get_uniform_rand_array<T>(1)[0];
+        for (size_t ii = 0; ii < ARRSIZE; ++ii) {
+            arr.push_back(temp);
+        }
+    }
+    else if (arrtype == "reverse") {
+        arr = get_uniform_rand_array<T>(ARRSIZE);
+        std::sort(arr.begin(), arr.end());
+        std::reverse(arr.begin(), arr.end());
+    }
+
+    /* call avx2 argsort */
+    for (auto _ : state) {
+        inx = avx2_argsort<T>(arr.data(), ARRSIZE);
+    }
+}
+
 #define BENCH_BOTH(type) \
     BENCH(avx512argsort, type) \
+    BENCH(avx512argsort_parallel, type) \
+    BENCH(avx2argsort, type) \
     BENCH(stdargsort, type)
 
 BENCH_BOTH(int64_t)
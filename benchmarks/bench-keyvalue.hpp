@@ -0,0 +1,91 @@
+#include "bench-qsort-common.h"
+
+/*
+ * Keys of type T with their uint64_t index as the value, like the key/rowid
+ * arrays avx512_qsort_kv_parallel is meant for
+ */
+template <typename T>
+static std::vector<T> get_keyvalue_keys(size_t ARRSIZE, std::string arrtype)
+{
+    std::vector<T> keys;
+    if (arrtype == "random") { keys = get_uniform_rand_array<T>(ARRSIZE); }
+    else if (arrtype == "sorted") {
+        keys = get_uniform_rand_array<T>(ARRSIZE);
+        std::sort(keys.begin(), keys.end());
+    }
+    else if (arrtype == "constant") {
+        T temp = get_uniform_rand_array<T>(1)[0];
+        for (size_t ii = 0; ii < ARRSIZE; ++ii) {
+            keys.push_back(temp);
+        }
+    }
+    else if (arrtype == "reverse") {
+        keys = get_uniform_rand_array<T>(ARRSIZE);
+        std::sort(keys.begin(), keys.end());
+        std::reverse(keys.begin(), keys.end());
+    }
+    return keys;
+}
+
+template <typename T, class... Args>
+static void avx512qsort_kv(benchmark::State &state, Args &&...args)
+{
+    auto args_tuple = std::make_tuple(std::move(args)...);
+    if (!__builtin_cpu_supports("avx512bw")) {
+        state.SkipWithMessage("Requires AVX512 BW ISA");
+    }
+    // Perform setup here
+    size_t ARRSIZE = std::get<0>(args_tuple);
+    std::vector<T> keys
+            = get_keyvalue_keys<T>(ARRSIZE, std::get<1>(args_tuple));
+    std::vector<T> keys_bkp = keys;
+    std::vector<uint64_t> values(ARRSIZE);
+    std::iota(values.begin(), values.end(), 0);
+    std::vector<uint64_t> values_bkp = values;
+
+    /* call avx512 key-value sort */
+    for (auto _ : state) {
+        avx512_qsort_kv<T, uint64_t>(keys.data(), values.data(), ARRSIZE);
+        state.PauseTiming();
+        keys = keys_bkp;
+        values = values_bkp;
+        state.ResumeTiming();
+    }
+}
+
+template <typename T, class... Args>
+static void avx512qsort_kv_parallel(benchmark::State &state, Args &&...args)
+{
+    auto args_tuple = std::make_tuple(std::move(args)...);
+    if (!__builtin_cpu_supports("avx512bw")) {
+        state.SkipWithMessage("Requires AVX512 BW ISA");
+    }
+    // Perform setup here
+    size_t ARRSIZE = std::get<0>(args_tuple);
+    std::vector<T> keys
+            = get_keyvalue_keys<T>(ARRSIZE, std::get<1>(args_tuple));
+    std::vector<T> keys_bkp = keys;
+    std::vector<uint64_t> values(ARRSIZE);
+    std::iota(values.begin(), values.end(), 0);
+    std::vector<uint64_t> values_bkp = values;
+
+    /* call avx512 key-value sort on the default thread pool */
+    for (auto _ : state) {
+        avx512_qsort_kv_parallel<T, uint64_t>(
+                keys.data(), values.data(), ARRSIZE);
+        state.PauseTiming();
+        keys = keys_bkp;
+        values = values_bkp;
+        state.ResumeTiming();
+    }
+}
+
+#define BENCH_BOTH_KV(type) \
+    BENCH(avx512qsort_kv, type) \
+    BENCH(avx512qsort_kv_parallel, type)
+
+BENCH_BOTH_KV(uint64_t)
+BENCH_BOTH_KV(int64_t)
+BENCH_BOTH_KV(double)
+BENCH_BOTH_KV(uint32_t)
+BENCH_BOTH_KV(float)
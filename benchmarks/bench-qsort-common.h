@@ -2,9 +2,20 @@
 #define AVX512_BENCH_COMMON
 
 #include "avx512-16bit-qsort.hpp"
+#include "avx512-32bit-keyvaluesort.hpp"
 #include "avx512-32bit-qsort.hpp"
 #include "avx512-64bit-argsort.hpp"
+#include "avx512-64bit-keyvaluesort.hpp"
 #include "avx512-64bit-qsort.hpp"
+#include "avx512-8bit-qsort.hpp"
+#include "avx512-parallel-argsort.hpp"
+#include "avx512-parallel-keyvaluesort.hpp"
+#include "avx512-parallel-qsort.hpp"
+#include "avx2-16bit-qsort.hpp"
+#include "avx2-32bit-qsort.hpp"
+#include "avx2-64bit-argsort.hpp"
+#include "avx2-64bit-qsort.hpp"
+#include "scalar-qsort.hpp"
 
 #include "rand_array.h"
 #include <benchmark/benchmark.h>
@@ -0,0 +1,92 @@
+/*
+ * Built with -march=skylake-avx512: the 16-bit quicksort emulates the
+ * compressstore of AVX512-VBMI2 here, so these are the numbers that set
+ * histogram_sort_threshold on the CPUs without it. avx512qsort_nohistogram in
+ * bench-qsort.hpp measures the same thing with VBMI2.
+ */
+#include "bench-qsort-common.h"
+
+template <typename T, class... Args>
+static void avx512qsort_skx(benchmark::State &state, Args &&...args)
+{
+    auto args_tuple = std::make_tuple(std::move(args)...);
+    if (!__builtin_cpu_supports("avx512bw")) {
+        state.SkipWithMessage("Requires AVX512 BW ISA");
+    }
+    // Perform setup here
+    size_t ARRSIZE = std::get<0>(args_tuple);
+    std::vector<T> arr = get_uniform_rand_array<T>(ARRSIZE);
+    std::vector<T> arr_bkp = arr;
+
+    /* counting sort above histogram_sort_threshold, quicksort below */
+    for (auto _ : state) {
+        xss_avx512_qsort<T, false>(arr.data(), ARRSIZE);
+        state.PauseTiming();
+        arr = arr_bkp;
+        state.ResumeTiming();
+    }
+}
+
+template <typename T, class... Args>
+static void avx512qsort_nohistogram_skx(benchmark::State &state, Args &&...args)
+{
+    auto args_tuple = std::make_tuple(std::move(args)...);
+    if (!__builtin_cpu_supports("avx512bw")) {
+        state.SkipWithMessage("Requires AVX512 BW ISA");
+    }
+    // Perform setup here
+    size_t ARRSIZE = std::get<0>(args_tuple);
+    std::vector<T> arr = get_uniform_rand_array<T>(ARRSIZE);
+    std::vector<T> arr_bkp = arr;
+
+    /* call the partitioning quicksort, whatever the array size */
+    for (auto _ : state) {
+        qsort_<zmm_partition_vector<T>, T>(
+                arr.data(), 0, ARRSIZE - 1, 2 * (int64_t)log2(ARRSIZE));
+        state.PauseTiming();
+        arr = arr_bkp;
+        state.ResumeTiming();
+    }
+}
+
+template <typename T, class... Args>
+static void avx512_histogram_sort_skx(benchmark::State &state, Args &&...args)
+{
+    auto args_tuple = std::make_tuple(std::move(args)...);
+    if (!__builtin_cpu_supports("avx512bw")) {
+        state.SkipWithMessage("Requires AVX512 BW ISA");
+    }
+    // Perform setup here
+    size_t ARRSIZE = std::get<0>(args_tuple);
+    std::vector<T> arr = get_uniform_rand_array<T>(ARRSIZE);
+    std::vector<T> arr_bkp = arr;
+
+    /* call the counting sort, whatever the array size */
+    for (auto _ : state) {
+        avx512_histogram_sort_16bit<T>(arr.data(), ARRSIZE);
+        state.PauseTiming();
+        arr = arr_bkp;
+        state.ResumeTiming();
+    }
+}
+
+/* Both sides of histogram_sort_threshold, 1 << 16 without AVX512_VBMI2 */
+#define BENCH_HISTOGRAM_SKX(func, type) \
+    MY_BENCHMARK_CAPTURE(func, type, random_16k, 16384, std::string("random")); \
+    MY_BENCHMARK_CAPTURE(func, type, random_32k, 32768, std::string("random")); \
+    MY_BENCHMARK_CAPTURE(func, type, random_64k, 65536, std::string("random")); \
+    MY_BENCHMARK_CAPTURE( \
+            func, type, random_128k, 131072, std::string("random")); \
+    MY_BENCHMARK_CAPTURE( \
+            func, type, random_256k, 262144, std::string("random")); \
+    MY_BENCHMARK_CAPTURE( \
+            func, type, random_1m, 1000000, std::string("random")); \
+    MY_BENCHMARK_CAPTURE( \
+            func, type, random_10m, 10000000, std::string("random"));
+
+BENCH_HISTOGRAM_SKX(avx512qsort_skx, uint16_t)
+BENCH_HISTOGRAM_SKX(avx512qsort_skx, int16_t)
+BENCH_HISTOGRAM_SKX(avx512qsort_nohistogram_skx, uint16_t)
+BENCH_HISTOGRAM_SKX(avx512qsort_nohistogram_skx, int16_t)
+BENCH_HISTOGRAM_SKX(avx512_histogram_sort_skx, uint16_t)
+BENCH_HISTOGRAM_SKX(avx512_histogram_sort_skx, int16_t)
@@ -2,3 +2,4 @@
 #include "bench-argsort.hpp"
 #include "bench-partial-qsort.hpp"
 #include "bench-qselect.hpp"
+#include "bench-keyvalue.hpp"
@@ -80,8 +80,242 @@ static void avx512qsort(benchmark::State &state, Args &&...args)
     }
 }
 
+template <typename T, class... Args>
+static void avx512qsort_regcompress(benchmark::State &state, Args &&...args)
+{
+    auto args_tuple = std::make_tuple(std::move(args)...);
+    if (!__builtin_cpu_supports("avx512bw")) {
+        state.SkipWithMessage("Requires AVX512 BW ISA");
+    }
+    if ((sizeof(T) == 2) && (!__builtin_cpu_supports("avx512vbmi2"))) {
+        state.SkipWithMessage("Requires AVX512 VBMI2");
+    }
+    // Perform setup here
+    size_t ARRSIZE = std::get<0>(args_tuple);
+    std::vector<T> arr;
+    std::vector<T> arr_bkp;
+
+    std::string arrtype = std::get<1>(args_tuple);
+    if (arrtype == "random") { arr = get_uniform_rand_array<T>(ARRSIZE); }
+    else if (arrtype == "sorted") {
+        arr = get_uniform_rand_array<T>(ARRSIZE);
+        std::sort(arr.begin(), arr.end());
+    }
+    else if (arrtype == "constant") {
+        T temp = get_uniform_rand_array<T>(1)[0];
+        for (size_t ii = 0; ii < ARRSIZE; ++ii) {
+            arr.push_back(temp);
+        }
+    }
+    else if (arrtype == "reverse") {
+        arr = get_uniform_rand_array<T>(ARRSIZE);
+        std::sort(arr.begin(), arr.end());
+        std::reverse(arr.begin(), arr.end());
+    }
+    arr_bkp = arr;
+
+    /* call avx512 quicksort, partitioning with compress-to-register */
+    for (auto _ : state) {
+        xss_qsort<zmm_vector_regcompress<zmm_vector<T>>, T>(arr.data(),
+                                                            ARRSIZE);
+        state.PauseTiming();
+        arr = arr_bkp;
+        state.ResumeTiming();
+    }
+}
+
+template <typename T, class... Args>
+static void avx512qsort_parallel(benchmark::State &state, Args &&...args)
+{
+    auto args_tuple = std::make_tuple(std::move(args)...);
+    if (!__builtin_cpu_supports("avx512bw")) {
+        state.SkipWithMessage("Requires AVX512 BW ISA");
+    }
+    if ((sizeof(T) == 2) && (!__builtin_cpu_supports("avx512vbmi2"))) {
+        state.SkipWithMessage("Requires AVX512 VBMI2");
+    }
+    // Perform setup here
+    size_t ARRSIZE = std::get<0>(args_tuple);
+    std::vector<T> arr;
+    std::vector<T> arr_bkp;
+
+    std::string arrtype = std::get<1>(args_tuple);
+    if (arrtype == "random") { arr = get_uniform_rand_array<T>(ARRSIZE); }
+    else if (arrtype == "sorted") {
+        arr = get_uniform_rand_array<T>(ARRSIZE);
+        std::sort(arr.begin(), arr.end());
+    }
+    else if (arrtype == "constant") {
+        T temp = get_uniform_rand_array<T>(1)[0];
+        for (size_t ii = 0; ii < ARRSIZE; ++ii) {
+            arr.push_back(temp);
+        }
+    }
+    else if (arrtype == "reverse") {
+        arr = get_uniform_rand_array<T>(ARRSIZE);
+        std::sort(arr.begin(), arr.end());
+        std::reverse(arr.begin(), arr.end());
+    }
+    arr_bkp = arr;
+
+    /* call avx512 quicksort on the default thread pool */
+    for (auto _ : state) {
+        avx512_qsort_parallel<T>(arr.data(), ARRSIZE);
+        state.PauseTiming();
+        arr = arr_bkp;
+        state.ResumeTiming();
+    }
+}
+
+template <typename T, class... Args>
+static void avx2qsort(benchmark::State &state, Args &&...args)
+{
+    auto args_tuple = std::make_tuple(std::move(args)...);
+    if (!__builtin_cpu_supports("avx2")) {
+        state.SkipWithMessage("Requires AVX2 ISA");
+    }
+    // Perform setup here
+    size_t ARRSIZE = std::get<0>(args_tuple);
+    std::vector<T> arr;
+    std::vector<T> arr_bkp;
+
+    std::string arrtype = std::get<1>(args_tuple);
+    if (arrtype == "random") { arr = get_uniform_rand_array<T>(ARRSIZE); }
+    else if (arrtype == "sorted") {
+        arr = get_uniform_rand_array<T>(ARRSIZE);
+        std::sort(arr.begin(), arr.end());
+    }
+    else if (arrtype == "constant") {
+        T temp = get_uniform_rand_array<T>(1)[0];
+        for (size_t ii = 0; ii < ARRSIZE; ++ii) {
+            arr.push_back(temp);
+        }
+    }
+    else if (arrtype == "reverse") {
+        arr = get_uniform_rand_array<T>(ARRSIZE);
+        std::sort(arr.begin(), arr.end());
+        std::reverse(arr.begin(), arr.end());
+    }
+    arr_bkp = arr;
+
+    /* call avx2 quicksort */
+    for (auto _ : state) {
+        avx2_qsort<T>(arr.data(), ARRSIZE);
+        state.PauseTiming();
+        arr = arr_bkp;
+        state.ResumeTiming();
+    }
+}
+
+template <typename T, class... Args>
+static void scalarqsort(benchmark::State &state, Args &&...args)
+{
+    auto args_tuple = std::make_tuple(std::move(args)...);
+    // Perform setup here
+    size_t ARRSIZE = std::get<0>(args_tuple);
+    std::vector<T> arr;
+    std::vector<T> arr_bkp;
+
+    std::string arrtype = std::get<1>(args_tuple);
+    if (arrtype == "random") { arr = get_uniform_rand_array<T>(ARRSIZE); }
+    else if (arrtype == "sorted") {
+        arr = get_uniform_rand_array<T>(ARRSIZE);
+        std::sort(arr.begin(), arr.end());
+    }
+    else if (arrtype == "constant") {
+        T temp = get_uniform_rand_array<T>(1)[0];
+        for (size_t ii = 0; ii < ARRSIZE; ++ii) {
+            arr.push_back(temp);
+        }
+    }
+    else if (arrtype == "reverse") {
+        arr = get_uniform_rand_array<T>(ARRSIZE);
+        std::sort(arr.begin(), arr.end());
+        std::reverse(arr.begin(), arr.end());
+    }
+    arr_bkp = arr;
+
+    /* call the portable branchless quicksort */
+    for (auto _ : state) {
+        scalar_qsort<T>(arr.data(), ARRSIZE);
+        state.PauseTiming();
+        arr = arr_bkp;
+        state.ResumeTiming();
+    }
+}
+
+template <typename T, class... Args>
+static void avx512vlqsort(benchmark::State &state, Args &&...args)
+{
+    auto args_tuple = std::make_tuple(std::move(args)...);
+    if (!__builtin_cpu_supports("avx512vl")) {
+        state.SkipWithMessage("Requires AVX512 VL ISA");
+    }
+    // Perform setup here
+    size_t ARRSIZE = std::get<0>(args_tuple);
+    std::vector<T> arr;
+    std::vector<T> arr_bkp;
+
+    std::string arrtype = std::get<1>(args_tuple);
+    if (arrtype == "random") { arr = get_uniform_rand_array<T>(ARRSIZE); }
+    else if (arrtype == "sorted") {
+        arr = get_uniform_rand_array<T>(ARRSIZE);
+        std::sort(arr.begin(), arr.end());
+    }
+    else if (arrtype == "constant") {
+        T temp = get_uniform_rand_array<T>(1)[0];
+        for (size_t ii = 0; ii < ARRSIZE; ++ii) {
+            arr.push_back(temp);
+        }
+    }
+    else if (arrtype == "reverse") {
+        arr = get_uniform_rand_array<T>(ARRSIZE);
+        std::sort(arr.begin(), arr.end());
+        std::reverse(arr.begin(), arr.end());
+    }
+    arr_bkp = arr;
+
+    /* call avx512 quicksort on 256-bit registers */
+    for (auto _ : state) {
+        avx512vl_qsort<T>(arr.data(), ARRSIZE);
+        state.PauseTiming();
+        arr = arr_bkp;
+        state.ResumeTiming();
+    }
+}
+
+/*
+ * avx512_qsort without the counting sort of avx512-16bit-common.h, to compare
+ * the two paths of 16-bit types around histogram_sort_threshold.
+ */
+template <typename T, class... Args>
+static void avx512qsort_nohistogram(benchmark::State &state, Args &&...args)
+{
+    auto args_tuple = std::make_tuple(std::move(args)...);
+    if (!__builtin_cpu_supports("avx512bw")) {
+        state.SkipWithMessage("Requires AVX512 BW ISA");
+    }
+    if ((sizeof(T) == 2) && (!__builtin_cpu_supports("avx512vbmi2"))) {
+        state.SkipWithMessage("Requires AVX512 VBMI2");
+    }
+    // Perform setup here
+    size_t ARRSIZE = std::get<0>(args_tuple);
+    std::vector<T> arr = get_uniform_rand_array<T>(ARRSIZE);
+    std::vector<T> arr_bkp = arr;
+
+    /* call the partitioning quicksort, whatever the array size */
+    for (auto _ : state) {
+        qsort_<zmm_partition_vector<T>, T>(
+                arr.data(), 0, ARRSIZE - 1, 2 * (int64_t)log2(ARRSIZE));
+        state.PauseTiming();
+        arr = arr_bkp;
+        state.ResumeTiming();
+    }
+}
+
 #define BENCH_BOTH_QSORT(type) \
     BENCH(avx512qsort, type) \
+    BENCH(avx512qsort_regcompress, type) \
     BENCH(stdsort, type)
 
 BENCH_BOTH_QSORT(uint64_t)
@@ -92,3 +326,64 @@ BENCH_BOTH_QSORT(uint16_t)
 BENCH_BOTH_QSORT(int16_t)
 BENCH_BOTH_QSORT(float)
 BENCH_BOTH_QSORT(double)
+
+/*
+ * Same sizes as avx512qsort/random_*: 100k stays below histogram_sort_threshold
+ * and 1m/10m counting sort with avx512qsort.
+ */
+#define BENCH_NOHISTOGRAM(type) \
+    MY_BENCHMARK_CAPTURE(avx512qsort_nohistogram, \
+                         type, \
+                         random_100k, \
+                         100000, \
+                         std::string("random")); \
+    MY_BENCHMARK_CAPTURE(avx512qsort_nohistogram, \
+                         type, \
+                         random_1m, \
+                         1000000, \
+                         std::string("random")); \
+    MY_BENCHMARK_CAPTURE(avx512qsort_nohistogram, \
+                         type, \
+                         random_10m, \
+                         10000000, \
+                         std::string("random"));
+
+BENCH_NOHISTOGRAM(uint16_t)
+BENCH_NOHISTOGRAM(int16_t)
+
+BENCH(avx512qsort, uint8_t)
+BENCH(avx512qsort, int8_t)
+BENCH(stdsort, uint8_t)
+BENCH(stdsort, int8_t)
+
+BENCH(avx512qsort_parallel, uint64_t)
+BENCH(avx512qsort_parallel, int64_t)
+BENCH(avx512qsort_parallel, uint32_t)
+BENCH(avx512qsort_parallel, int32_t)
+BENCH(avx512qsort_parallel, float)
+BENCH(avx512qsort_parallel, double)
+
+BENCH(avx2qsort, uint64_t)
+BENCH(avx2qsort, int64_t)
+BENCH(avx2qsort, uint32_t)
+BENCH(avx2qsort, int32_t)
+BENCH(avx2qsort, uint16_t)
+BENCH(avx2qsort, int16_t)
+BENCH(avx2qsort, float)
+BENCH(avx2qsort, double)
+
+BENCH(scalarqsort, uint64_t)
+BENCH(scalarqsort, int64_t)
+BENCH(scalarqsort, uint32_t)
+BENCH(scalarqsort, int32_t)
+BENCH(scalarqsort, uint16_t)
+BENCH(scalarqsort, int16_t)
+BENCH(scalarqsort, float)
+BENCH(scalarqsort, double)
+
+BENCH(avx512vlqsort, uint64_t)
+BENCH(avx512vlqsort, int64_t)
+BENCH(avx512vlqsort, uint32_t)
+BENCH(avx512vlqsort, int32_t)
+BENCH(avx512vlqsort, float)
+BENCH(avx512vlqsort, double)
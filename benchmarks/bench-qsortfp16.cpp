@@ -1,3 +1,4 @@
+#include "avx512fp16-16bit-argsort.hpp"
 #include "avx512fp16-16bit-qsort.hpp"
 
 #include "rand_array.h"
@@ -199,3 +200,56 @@ BENCHMARK(avx512_partial_qsort<_Float16>)
         ->Arg(1000)
         ->Arg(5000);
 BENCHMARK(stdpartialsort<_Float16>)->Arg(10)->Arg(100)->Arg(1000)->Arg(5000);
+
+template <typename T>
+static void avx512_argsort(benchmark::State &state)
+{
+    if (__builtin_cpu_supports("avx512fp16")) {
+        // Perform setup here
+        size_t ARRSIZE = state.range(0);
+        std::vector<T> arr;
+
+        for (size_t jj = 0; jj < ARRSIZE; ++jj) {
+            _Float16 temp = (float)rand() / (float)(RAND_MAX);
+            arr.push_back(temp);
+        }
+
+        /* call avx512 argsort */
+        for (auto _ : state) {
+            std::vector<int64_t> inx = avx512_argsort<T>(arr.data(), ARRSIZE);
+        }
+    }
+    else {
+        state.SkipWithMessage("Requires AVX512-FP16 ISA");
+    }
+}
+
+template <typename T>
+static void stdargsort(benchmark::State &state)
+{
+    if (__builtin_cpu_supports("avx512fp16")) {
+        // Perform setup here
+        size_t ARRSIZE = state.range(0);
+        std::vector<T> arr;
+
+        for (size_t jj = 0; jj < ARRSIZE; ++jj) {
+            _Float16 temp = (float)rand() / (float)(RAND_MAX);
+            arr.push_back(temp);
+        }
+
+        /* call std::sort on the indices */
+        for (auto _ : state) {
+            std::vector<int64_t> inx(ARRSIZE);
+            std::iota(inx.begin(), inx.end(), 0);
+            std::sort(inx.begin(), inx.end(), [&arr](int64_t a, int64_t b) {
+                return arr[a] < arr[b];
+            });
+        }
+    }
+    else {
+        state.SkipWithMessage("Requires AVX512-FP16 ISA");
+    }
+}
+
+BENCHMARK(avx512_argsort<_Float16>)->Arg(10000)->Arg(1000000);
+BENCHMARK(stdargsort<_Float16>)->Arg(10000)->Arg(1000000);
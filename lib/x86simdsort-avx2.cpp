@@ -0,0 +1,49 @@
+// AVX2 specific routines:
+#include "avx2-16bit-qsort.hpp"
+#include "avx2-32bit-qsort.hpp"
+#include "avx2-64bit-argsort.hpp"
+#include "avx2-64bit-qsort.hpp"
+#include "x86simdsort-internal.h"
+
+#define DEFINE_SORT_METHODS(type) \
+    template <> \
+    void qsort(type *arr, int64_t arrsize) \
+    { \
+        xss_qsort<avx2_vector<type>, type>(arr, arrsize); \
+    } \
+    template <> \
+    void qselect(type *arr, int64_t k, int64_t arrsize, bool hasnan) \
+    { \
+        xss_qselect<avx2_vector<type>, type>(arr, k, arrsize, hasnan); \
+    } \
+    template <> \
+    void partial_qsort(type *arr, int64_t k, int64_t arrsize, bool hasnan) \
+    { \
+        xss_partial_qsort<avx2_vector<type>, type>(arr, k, arrsize, hasnan); \
+    }
+
+#define DEFINE_ALL_METHODS(type) \
+    DEFINE_SORT_METHODS(type) \
+    template <> \
+    void argsort(type *arr, int64_t *arg, int64_t arrsize) \
+    { \
+        avx2_argsort(arr, arg, arrsize); \
+    } \
+    template <> \
+    void argselect(type *arr, int64_t *arg, int64_t k, int64_t arrsize) \
+    { \
+        avx2_argselect(arr, arg, k, arrsize); \
+    }
+
+namespace xss {
+namespace avx2 {
+    DEFINE_SORT_METHODS(uint16_t)
+    DEFINE_SORT_METHODS(int16_t)
+    DEFINE_ALL_METHODS(uint32_t)
+    DEFINE_ALL_METHODS(int32_t)
+    DEFINE_ALL_METHODS(float)
+    DEFINE_ALL_METHODS(uint64_t)
+    DEFINE_ALL_METHODS(int64_t)
+    DEFINE_ALL_METHODS(double)
+} // namespace avx2
+} // namespace xss
@@ -0,0 +1,39 @@
+// ICL specific routines:
+#include "avx512-16bit-qsort.hpp"
+#include "avx512-32bit-qsort.hpp"
+#include "avx512-64bit-qsort.hpp"
+#include "x86simdsort-internal.h"
+
+#define DEFINE_ALL_METHODS(type, vtype) \
+    template <> \
+    void qsort(type *arr, int64_t arrsize) \
+    { \
+        xss_qsort<vtype, type>(arr, arrsize); \
+    } \
+    template <> \
+    void qselect(type *arr, int64_t k, int64_t arrsize, bool hasnan) \
+    { \
+        xss_qselect<vtype, type>(arr, k, arrsize, hasnan); \
+    } \
+    template <> \
+    void partial_qsort(type *arr, int64_t k, int64_t arrsize, bool hasnan) \
+    { \
+        xss_partial_qsort<vtype, type>(arr, k, arrsize, hasnan); \
+    }
+
+namespace xss {
+namespace avx512 {
+    DEFINE_ALL_METHODS(uint16_t, zmm_vector<uint16_t>)
+    DEFINE_ALL_METHODS(int16_t, zmm_vector<int16_t>)
+} // namespace avx512
+namespace avx512_zen4 {
+    DEFINE_ALL_METHODS(uint16_t, zmm_vector_regcompress<zmm_vector<uint16_t>>)
+    DEFINE_ALL_METHODS(int16_t, zmm_vector_regcompress<zmm_vector<int16_t>>)
+    DEFINE_ALL_METHODS(uint32_t, zmm_vector_regcompress<zmm_vector<uint32_t>>)
+    DEFINE_ALL_METHODS(int32_t, zmm_vector_regcompress<zmm_vector<int32_t>>)
+    DEFINE_ALL_METHODS(float, zmm_vector_regcompress<zmm_vector<float>>)
+    DEFINE_ALL_METHODS(uint64_t, zmm_vector_regcompress<zmm_vector<uint64_t>>)
+    DEFINE_ALL_METHODS(int64_t, zmm_vector_regcompress<zmm_vector<int64_t>>)
+    DEFINE_ALL_METHODS(double, zmm_vector_regcompress<zmm_vector<double>>)
+} // namespace avx512_zen4
+} // namespace xss
@@ -0,0 +1,63 @@
+#ifndef XSS_INTERNAL_METHODS
+#define XSS_INTERNAL_METHODS
+
+#include "x86simdsort.h"
+#include <stdint.h>
+
+#define XSS_DECLARE_INTERNAL_METHODS \
+    /* quicksort */ \
+    template <typename T> \
+    XSS_HIDE_SYMBOL void qsort(T *arr, int64_t arrsize); \
+    /* quickselect */ \
+    template <typename T> \
+    XSS_HIDE_SYMBOL void qselect( \
+            T *arr, int64_t k, int64_t arrsize, bool hasnan = false); \
+    /* partial sort */ \
+    template <typename T> \
+    XSS_HIDE_SYMBOL void partial_qsort( \
+            T *arr, int64_t k, int64_t arrsize, bool hasnan = false); \
+    /* argsort */ \
+    template <typename T> \
+    XSS_HIDE_SYMBOL void argsort(T *arr, int64_t *arg, int64_t arrsize); \
+    /* argselect */ \
+    template <typename T> \
+    XSS_HIDE_SYMBOL void argselect( \
+            T *arr, int64_t *arg, int64_t k, int64_t arrsize);
+
+/*
+ * Per ISA entry points. Each one is specialized for the supported types in
+ * exactly one of the x86simdsort-<isa>.cpp files, which are compiled with the
+ * matching -march flag. Only x86simdsort.cpp calls these, after checking the
+ * CPU supports the ISA.
+ */
+namespace xss {
+namespace avx512 {
+    XSS_DECLARE_INTERNAL_METHODS
+} // namespace avx512
+/*
+ * 16-bit routines for AVX-512 CPUs without VBMI2 (Skylake-X, Cascade Lake),
+ * compiled for Skylake-AVX512
+ */
+namespace avx512_bw {
+    XSS_DECLARE_INTERNAL_METHODS
+} // namespace avx512_bw
+/*
+ * 32-bit and 64-bit routines for CPUs that throttle for 512-bit instructions
+ * (Skylake-SP, Cascade Lake, Cooper Lake): small and medium arrays are
+ * sorted on ymm registers. Compiled for Skylake-AVX512.
+ */
+namespace avx512_ymm {
+    XSS_DECLARE_INTERNAL_METHODS
+} // namespace avx512_ymm
+/*
+ * AMD Zen4: partitions with compress-to-register instead of compressstore,
+ * compiled for Icelake
+ */
+namespace avx512_zen4 {
+    XSS_DECLARE_INTERNAL_METHODS
+} // namespace avx512_zen4
+namespace avx2 {
+    XSS_DECLARE_INTERNAL_METHODS
+} // namespace avx2
+} // namespace xss
+#endif
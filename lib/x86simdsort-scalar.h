@@ -0,0 +1,42 @@
+#ifndef XSS_SCALAR_METHODS
+#define XSS_SCALAR_METHODS
+
+#include "scalar-qsort.hpp"
+#include <stdint.h>
+
+/*
+ * Fallback for CPUs without AVX2, built with the baseline flags of the
+ * dispatcher. Same semantics as the vectorized routines: NAN's are sorted to
+ * the end of the array.
+ */
+namespace xss {
+namespace scalar {
+    template <typename T>
+    void qsort(T *arr, int64_t arrsize)
+    {
+        scalar_qsort(arr, arrsize);
+    }
+    template <typename T>
+    void qselect(T *arr, int64_t k, int64_t arrsize, bool hasnan)
+    {
+        scalar_qselect(arr, k, arrsize, hasnan);
+    }
+    template <typename T>
+    void partial_qsort(T *arr, int64_t k, int64_t arrsize, bool hasnan)
+    {
+        scalar_partial_qsort(arr, k, arrsize, hasnan);
+    }
+    template <typename T>
+    void argsort(T *arr, int64_t *arg, int64_t arrsize)
+    {
+        scalar_argsort(arr, arg, arrsize);
+    }
+    template <typename T>
+    void argselect(T *arr, int64_t *arg, int64_t k, int64_t arrsize)
+    {
+        scalar_argselect(arr, arg, k, arrsize);
+    }
+
+} // namespace scalar
+} // namespace xss
+#endif
@@ -0,0 +1,148 @@
+// SKX specific routines:
+#include "avx512-16bit-argsort.hpp"
+#include "avx512-16bit-qsort.hpp"
+#include "avx512-32bit-qsort.hpp"
+#include "avx512-64bit-argsort.hpp"
+#include "avx512-64bit-qsort.hpp"
+#include "avx512-8bit-qsort.hpp"
+#include "x86simdsort-internal.h"
+
+#define DEFINE_SORT_METHODS(type) \
+    template <> \
+    void qsort(type *arr, int64_t arrsize) \
+    { \
+        xss_qsort<zmm_vector<type>, type>(arr, arrsize); \
+    } \
+    template <> \
+    void qselect(type *arr, int64_t k, int64_t arrsize, bool hasnan) \
+    { \
+        xss_qselect<zmm_vector<type>, type>(arr, k, arrsize, hasnan); \
+    } \
+    template <> \
+    void partial_qsort(type *arr, int64_t k, int64_t arrsize, bool hasnan) \
+    { \
+        xss_partial_qsort<zmm_vector<type>, type>(arr, k, arrsize, hasnan); \
+    }
+
+#define DEFINE_ARGSORT_METHODS(type) \
+    template <> \
+    void argsort(type *arr, int64_t *arg, int64_t arrsize) \
+    { \
+        avx512_argsort(arr, arg, arrsize); \
+    } \
+    template <> \
+    void argselect(type *arr, int64_t *arg, int64_t k, int64_t arrsize) \
+    { \
+        avx512_argselect(arr, arg, k, arrsize); \
+    }
+
+#define DEFINE_ALL_METHODS(type) \
+    DEFINE_SORT_METHODS(type) \
+    DEFINE_ARGSORT_METHODS(type)
+
+/* 8-bit types use the counting sort in avx512-8bit-qsort.hpp */
+#define DEFINE_COUNTSORT_METHODS(type) \
+    template <> \
+    void qsort(type *arr, int64_t arrsize) \
+    { \
+        avx512_qsort(arr, arrsize); \
+    } \
+    template <> \
+    void qselect(type *arr, int64_t k, int64_t arrsize, bool hasnan) \
+    { \
+        avx512_qselect(arr, k, arrsize, hasnan); \
+    } \
+    template <> \
+    void partial_qsort(type *arr, int64_t k, int64_t arrsize, bool hasnan) \
+    { \
+        avx512_partial_qsort(arr, k, arrsize, hasnan); \
+    }
+
+/*
+ * Skylake-SP, Cascade Lake and Cooper Lake lower the core frequency for a
+ * while after 512-bit instructions. Arrays of up to ymm_threshold elements
+ * take less time to sort than the core spends at the lower frequency
+ * afterwards, so on those CPUs they are sorted on ymm registers (see
+ * avx512vl_qsort) and only larger ones on zmm registers.
+ */
+#define DEFINE_YMM_METHODS(type) \
+    template <> \
+    void qsort(type *arr, int64_t arrsize) \
+    { \
+        if (arrsize <= ymm_threshold) { \
+            xss_qsort<ymm_vector<type>, type>(arr, arrsize); \
+        } \
+        else { \
+            xss_qsort<zmm_vector<type>, type>(arr, arrsize); \
+        } \
+    } \
+    template <> \
+    void qselect(type *arr, int64_t k, int64_t arrsize, bool hasnan) \
+    { \
+        if (arrsize <= ymm_threshold) { \
+            xss_qselect<ymm_vector<type>, type>(arr, k, arrsize, hasnan); \
+        } \
+        else { \
+            xss_qselect<zmm_vector<type>, type>(arr, k, arrsize, hasnan); \
+        } \
+    } \
+    template <> \
+    void partial_qsort(type *arr, int64_t k, int64_t arrsize, bool hasnan) \
+    { \
+        if (arrsize <= ymm_threshold) { \
+            xss_partial_qsort<ymm_vector<type>, type>( \
+                    arr, k, arrsize, hasnan); \
+        } \
+        else { \
+            xss_partial_qsort<zmm_vector<type>, type>( \
+                    arr, k, arrsize, hasnan); \
+        } \
+    } \
+    template <> \
+    void argsort(type *arr, int64_t *arg, int64_t arrsize) \
+    { \
+        if (arrsize <= ymm_threshold) { \
+            avx512vl_argsort(arr, arg, arrsize); \
+        } \
+        else { \
+            avx512_argsort(arr, arg, arrsize); \
+        } \
+    } \
+    template <> \
+    void argselect(type *arr, int64_t *arg, int64_t k, int64_t arrsize) \
+    { \
+        if (arrsize <= ymm_threshold) { \
+            avx512vl_argselect(arr, arg, k, arrsize); \
+        } \
+        else { \
+            avx512_argselect(arr, arg, k, arrsize); \
+        } \
+    }
+
+namespace xss {
+namespace avx512 {
+    DEFINE_COUNTSORT_METHODS(uint8_t)
+    DEFINE_COUNTSORT_METHODS(int8_t)
+    DEFINE_ARGSORT_METHODS(uint16_t)
+    DEFINE_ARGSORT_METHODS(int16_t)
+    DEFINE_ALL_METHODS(uint32_t)
+    DEFINE_ALL_METHODS(int32_t)
+    DEFINE_ALL_METHODS(float)
+    DEFINE_ALL_METHODS(uint64_t)
+    DEFINE_ALL_METHODS(int64_t)
+    DEFINE_ALL_METHODS(double)
+} // namespace avx512
+namespace avx512_bw {
+    DEFINE_SORT_METHODS(uint16_t)
+    DEFINE_SORT_METHODS(int16_t)
+} // namespace avx512_bw
+namespace avx512_ymm {
+    constexpr int64_t ymm_threshold = 65536;
+    DEFINE_YMM_METHODS(uint32_t)
+    DEFINE_YMM_METHODS(int32_t)
+    DEFINE_YMM_METHODS(float)
+    DEFINE_YMM_METHODS(uint64_t)
+    DEFINE_YMM_METHODS(int64_t)
+    DEFINE_YMM_METHODS(double)
+} // namespace avx512_ymm
+} // namespace xss
@@ -0,0 +1,261 @@
+#include "x86simdsort.h"
+#include "x86simdsort-internal.h"
+#include "x86simdsort-scalar.h"
+#include <initializer_list>
+#include <numeric>
+#include <string_view>
+
+static int check_cpu_feature_support(std::string_view cpufeature)
+{
+#ifdef XSS_HAVE_FP16
+    if (cpufeature == "avx512_spr")
+        return __builtin_cpu_supports("avx512fp16")
+                && __builtin_cpu_supports("avx512vbmi2");
+#endif
+    if (cpufeature == "avx512_zen4")
+        return __builtin_cpu_is("amd") && __builtin_cpu_supports("avx512f")
+                && __builtin_cpu_supports("avx512bw")
+                && __builtin_cpu_supports("avx512vbmi2");
+    if (cpufeature == "avx512_icl")
+        return __builtin_cpu_supports("avx512f")
+                && __builtin_cpu_supports("avx512bw")
+                && __builtin_cpu_supports("avx512vbmi2");
+    if (cpufeature == "avx512_bw")
+        return __builtin_cpu_supports("avx512f")
+                && __builtin_cpu_supports("avx512bw");
+    if (cpufeature == "avx512_ymm")
+        return check_cpu_feature_support("avx512_skx")
+                && (__builtin_cpu_is("skylake-avx512")
+                    || __builtin_cpu_is("cascadelake")
+                    || __builtin_cpu_is("cooperlake"));
+    if (cpufeature == "avx512_skx")
+        return __builtin_cpu_supports("avx512f")
+                && __builtin_cpu_supports("avx512dq")
+                && __builtin_cpu_supports("avx512vl")
+                && __builtin_cpu_supports("avx512bw");
+    if (cpufeature == "avx2")
+        return __builtin_cpu_supports("avx2");
+    return 0;
+}
+
+/* First ISA in the list (best first) that the running CPU supports */
+static std::string_view
+find_preferred_cpu(std::initializer_list<std::string_view> cpulist)
+{
+    for (auto cpu : cpulist) {
+        if (check_cpu_feature_support(cpu)) return cpu;
+    }
+    return "scalar";
+}
+
+constexpr bool
+dispatch_requested(std::string_view cpurequested,
+                   std::initializer_list<std::string_view> cpulist)
+{
+    for (auto cpu : cpulist) {
+        if (cpu.find(cpurequested) != std::string_view::npos) return true;
+    }
+    return false;
+}
+
+#define CAT_(a, b) a##b
+#define CAT(a, b) CAT_(a, b)
+
+#define DECLARE_INTERNAL_qsort(TYPE) \
+    static void (*internal_qsort##TYPE)(TYPE *, int64_t) = NULL; \
+    template <> \
+    void qsort(TYPE *arr, int64_t arrsize) \
+    { \
+        (*internal_qsort##TYPE)(arr, arrsize); \
+    }
+
+#define DECLARE_INTERNAL_qselect(TYPE) \
+    static void (*internal_qselect##TYPE)(TYPE *, int64_t, int64_t, bool) \
+            = NULL; \
+    template <> \
+    void qselect(TYPE *arr, int64_t k, int64_t arrsize, bool hasnan) \
+    { \
+        (*internal_qselect##TYPE)(arr, k, arrsize, hasnan); \
+    }
+
+#define DECLARE_INTERNAL_partial_qsort(TYPE) \
+    static void (*internal_partial_qsort##TYPE)( \
+            TYPE *, int64_t, int64_t, bool) \
+            = NULL; \
+    template <> \
+    void partial_qsort(TYPE *arr, int64_t k, int64_t arrsize, bool hasnan) \
+    { \
+        (*internal_partial_qsort##TYPE)(arr, k, arrsize, hasnan); \
+    }
+
+#define DECLARE_INTERNAL_argsort(TYPE) \
+    static void (*internal_argsort##TYPE)(TYPE *, int64_t *, int64_t) \
+            = NULL; \
+    template <> \
+    std::vector<int64_t> argsort(TYPE *arr, int64_t arrsize) \
+    { \
+        std::vector<int64_t> indices(arrsize); \
+        std::iota(indices.begin(), indices.end(), 0); \
+        (*internal_argsort##TYPE)(arr, indices.data(), arrsize); \
+        return indices; \
+    }
+
+#define DECLARE_INTERNAL_argselect(TYPE) \
+    static void (*internal_argselect##TYPE)( \
+            TYPE *, int64_t *, int64_t, int64_t) \
+            = NULL; \
+    template <> \
+    std::vector<int64_t> argselect(TYPE *arr, int64_t k, int64_t arrsize) \
+    { \
+        std::vector<int64_t> indices(arrsize); \
+        std::iota(indices.begin(), indices.end(), 0); \
+        (*internal_argselect##TYPE)(arr, indices.data(), k, arrsize); \
+        return indices; \
+    }
+
+/*
+ * DISPATCH(func, TYPE, ISA...) defines x86simdsort::func<TYPE> and a
+ * constructor that points it at the best ISA specific version, in the order
+ * the ISA's are listed. Falls back to xss::scalar::func<TYPE>.
+ */
+#define DISPATCH(func, TYPE, ...) \
+    DECLARE_INTERNAL_##func(TYPE) static __attribute__((constructor)) void \
+            CAT(CAT(resolve_, func), TYPE)(void) \
+    { \
+        CAT(CAT(internal_, func), TYPE) = &xss::scalar::func<TYPE>; \
+        __builtin_cpu_init(); \
+        std::string_view preferred_cpu = find_preferred_cpu({__VA_ARGS__}); \
+        if constexpr (dispatch_requested("avx512_zen4", {__VA_ARGS__})) { \
+            if (preferred_cpu == "avx512_zen4") { \
+                CAT(CAT(internal_, func), TYPE) \
+                        = &xss::avx512_zen4::func<TYPE>; \
+                return; \
+            } \
+        } \
+        if constexpr (dispatch_requested("avx512_ymm", {__VA_ARGS__})) { \
+            if (preferred_cpu == "avx512_ymm") { \
+                CAT(CAT(internal_, func), TYPE) \
+                        = &xss::avx512_ymm::func<TYPE>; \
+                return; \
+            } \
+        } \
+        if constexpr (dispatch_requested("avx512_bw", {__VA_ARGS__})) { \
+            if (preferred_cpu == "avx512_bw") { \
+                CAT(CAT(internal_, func), TYPE) = &xss::avx512_bw::func<TYPE>; \
+                return; \
+            } \
+        } \
+        if constexpr (dispatch_requested("avx512", {__VA_ARGS__})) { \
+            if (preferred_cpu.find("avx512") != std::string_view::npos) { \
+                CAT(CAT(internal_, func), TYPE) = &xss::avx512::func<TYPE>; \
+                return; \
+            } \
+        } \
+        if constexpr (dispatch_requested("avx2", {__VA_ARGS__})) { \
+            if (preferred_cpu.find("avx2") != std::string_view::npos) { \
+                CAT(CAT(internal_, func), TYPE) = &xss::avx2::func<TYPE>; \
+                return; \
+            } \
+        } \
+    }
+
+namespace x86simdsort {
+#ifdef XSS_HAVE_FP16
+DISPATCH(qsort, _Float16, "avx512_spr")
+DISPATCH(qselect, _Float16, "avx512_spr")
+DISPATCH(partial_qsort, _Float16, "avx512_spr")
+DISPATCH(argsort, _Float16, "avx512_spr")
+DISPATCH(argselect, _Float16, "avx512_spr")
+#endif
+
+DISPATCH(qsort, uint8_t, "avx512_skx")
+DISPATCH(qsort, int8_t, "avx512_skx")
+DISPATCH(qsort, uint16_t, "avx512_zen4", "avx512_icl", "avx512_bw", "avx2")
+DISPATCH(qsort, int16_t, "avx512_zen4", "avx512_icl", "avx512_bw", "avx2")
+DISPATCH(qsort, float, "avx512_zen4", "avx512_ymm", "avx512_skx", "avx2")
+DISPATCH(qsort, double, "avx512_zen4", "avx512_ymm", "avx512_skx", "avx2")
+DISPATCH(qsort, int32_t, "avx512_zen4", "avx512_ymm", "avx512_skx", "avx2")
+DISPATCH(qsort, uint32_t, "avx512_zen4", "avx512_ymm", "avx512_skx", "avx2")
+DISPATCH(qsort, int64_t, "avx512_zen4", "avx512_ymm", "avx512_skx", "avx2")
+DISPATCH(qsort, uint64_t, "avx512_zen4", "avx512_ymm", "avx512_skx", "avx2")
+
+DISPATCH(qselect, uint8_t, "avx512_skx")
+DISPATCH(qselect, int8_t, "avx512_skx")
+DISPATCH(qselect, uint16_t, "avx512_zen4", "avx512_icl", "avx512_bw", "avx2")
+DISPATCH(qselect, int16_t, "avx512_zen4", "avx512_icl", "avx512_bw", "avx2")
+DISPATCH(qselect, float, "avx512_zen4", "avx512_ymm", "avx512_skx", "avx2")
+DISPATCH(qselect, double, "avx512_zen4", "avx512_ymm", "avx512_skx", "avx2")
+DISPATCH(qselect, int32_t, "avx512_zen4", "avx512_ymm", "avx512_skx", "avx2")
+DISPATCH(qselect, uint32_t, "avx512_zen4", "avx512_ymm", "avx512_skx", "avx2")
+DISPATCH(qselect, int64_t, "avx512_zen4", "avx512_ymm", "avx512_skx", "avx2")
+DISPATCH(qselect, uint64_t, "avx512_zen4", "avx512_ymm", "avx512_skx", "avx2")
+
+DISPATCH(partial_qsort, uint8_t, "avx512_skx")
+DISPATCH(partial_qsort, int8_t, "avx512_skx")
+DISPATCH(partial_qsort,
+         uint16_t,
+         "avx512_zen4",
+         "avx512_icl",
+         "avx512_bw",
+         "avx2")
+DISPATCH(partial_qsort,
+         int16_t,
+         "avx512_zen4",
+         "avx512_icl",
+         "avx512_bw",
+         "avx2")
+DISPATCH(partial_qsort,
+         float,
+         "avx512_zen4",
+         "avx512_ymm",
+         "avx512_skx",
+         "avx2")
+DISPATCH(partial_qsort,
+         double,
+         "avx512_zen4",
+         "avx512_ymm",
+         "avx512_skx",
+         "avx2")
+DISPATCH(partial_qsort,
+         int32_t,
+         "avx512_zen4",
+         "avx512_ymm",
+         "avx512_skx",
+         "avx2")
+DISPATCH(partial_qsort,
+         uint32_t,
+         "avx512_zen4",
+         "avx512_ymm",
+         "avx512_skx",
+         "avx2")
+DISPATCH(partial_qsort,
+         int64_t,
+         "avx512_zen4",
+         "avx512_ymm",
+         "avx512_skx",
+         "avx2")
+DISPATCH(partial_qsort,
+         uint64_t,
+         "avx512_zen4",
+         "avx512_ymm",
+         "avx512_skx",
+         "avx2")
+
+DISPATCH(argsort, uint16_t, "avx512_skx")
+DISPATCH(argsort, int16_t, "avx512_skx")
+DISPATCH(argsort, int32_t, "avx512_ymm", "avx512_skx", "avx2")
+DISPATCH(argsort, uint32_t, "avx512_ymm", "avx512_skx", "avx2")
+DISPATCH(argsort, int64_t, "avx512_ymm", "avx512_skx", "avx2")
+DISPATCH(argsort, uint64_t, "avx512_ymm", "avx512_skx", "avx2")
+DISPATCH(argsort, float, "avx512_ymm", "avx512_skx", "avx2")
+DISPATCH(argsort, double, "avx512_ymm", "avx512_skx", "avx2")
+
+DISPATCH(argselect, uint16_t, "avx512_skx")
+DISPATCH(argselect, int16_t, "avx512_skx")
+DISPATCH(argselect, int32_t, "avx512_ymm", "avx512_skx", "avx2")
+DISPATCH(argselect, uint32_t, "avx512_ymm", "avx512_skx", "avx2")
+DISPATCH(argselect, int64_t, "avx512_ymm", "avx512_skx", "avx2")
+DISPATCH(argselect, uint64_t, "avx512_ymm", "avx512_skx", "avx2")
+DISPATCH(argselect, float, "avx512_ymm", "avx512_skx", "avx2")
+DISPATCH(argselect, double, "avx512_ymm", "avx512_skx", "avx2")
+} // namespace x86simdsort
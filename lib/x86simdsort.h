@@ -0,0 +1,50 @@
+#ifndef X86_SIMD_SORT
+#define X86_SIMD_SORT
+
+#include <stdint.h>
+#include <vector>
+
+#define XSS_EXPORT_SYMBOL __attribute__((visibility("default")))
+#define XSS_HIDE_SYMBOL __attribute__((visibility("hidden")))
+
+/*
+ * Compiled version of the sorting routines in src/. Every routine is built
+ * once per ISA (AVX2, Skylake-AVX512, Icelake, Sapphire Rapids) and the best
+ * one for the running CPU is picked once, when the library is loaded. Callers
+ * can be compiled for baseline x86-64. On CPUs that lower their frequency for
+ * 512-bit instructions (Skylake-SP, Cascade Lake, Cooper Lake), 32-bit and
+ * 64-bit arrays of up to 65536 elements are sorted on 256-bit registers.
+ *
+ * Supported types are the same as the header only API: 8-bit, 16-bit types
+ * (and _Float16, if the compiler supports it), 32-bit and 64-bit types for
+ * qsort/qselect/partial_qsort and 16-bit (including _Float16), 32-bit and
+ * 64-bit types for argsort/argselect. NAN's are sorted to the end of the
+ * array.
+ */
+namespace x86simdsort {
+
+// quicksort
+template <typename T>
+XSS_EXPORT_SYMBOL void qsort(T *arr, int64_t arrsize);
+
+// quickselect
+template <typename T>
+XSS_EXPORT_SYMBOL void
+qselect(T *arr, int64_t k, int64_t arrsize, bool hasnan = false);
+
+// partial sort
+template <typename T>
+XSS_EXPORT_SYMBOL void
+partial_qsort(T *arr, int64_t k, int64_t arrsize, bool hasnan = false);
+
+// argsort
+template <typename T>
+XSS_EXPORT_SYMBOL std::vector<int64_t> argsort(T *arr, int64_t arrsize);
+
+// argselect
+template <typename T>
+XSS_EXPORT_SYMBOL std::vector<int64_t>
+argselect(T *arr, int64_t k, int64_t arrsize);
+
+} // namespace x86simdsort
+#endif
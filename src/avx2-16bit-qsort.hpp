@@ -0,0 +1,422 @@
+/*******************************************************************
+ * Copyright (C) 2022 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * Authors: Raghuveer Devulapalli <raghuveer.devulapalli@intel.com>
+ * ****************************************************************/
+
+#ifndef AVX2_QSORT_16BIT
+#define AVX2_QSORT_16BIT
+
+#include "avx2-emu-funcs.hpp"
+#include "xss-network-qsort.hpp"
+#include "xss-network-ymm.hpp"
+
+/*
+ * 16 x 16-bit lanes in a YMM register. The opmask_t is a 16-bit bitmask, the
+ * blend masks passed to the ymm networks have one bit per 16-bit lane.
+ */
+template <>
+struct avx2_vector<int16_t> {
+    using type_t = int16_t;
+    using reg_t = __m256i;
+    using opmask_t = int32_t;
+    static const uint8_t numlanes = 16;
+    static constexpr int network_sort_threshold = 256;
+    static constexpr int partition_unroll_factor = 4;
+
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_MAX_INT16;
+    }
+    static type_t type_min()
+    {
+        return X86_SIMD_SORT_MIN_INT16;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm256_set1_epi16(type_max());
+    }
+
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return x ^ 0xFFFF;
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        reg_t lt = _mm256_cmpgt_epi16(y, x);
+        return convert_avx2_mask_to_int_16bit(lt) ^ 0xFFFF;
+    }
+    static opmask_t get_partial_loadmask(int size)
+    {
+        return (0x01 << size) - 0x01;
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return _mm256_loadu_si256((reg_t const *)mem);
+    }
+    static reg_t maskz_loadu(opmask_t mask, void const *mem)
+    {
+        return mask_loadu(_mm256_setzero_si256(), mask, mem);
+    }
+    static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
+    {
+        return avx2_emu_mask_loadu16<avx2_vector<type_t>>(x, mask, mem);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        return _mm256_blendv_epi8(x, y, convert_int_to_avx2_mask_16bit(mask));
+    }
+    static void mask_storeu(void *mem, opmask_t mask, reg_t x)
+    {
+        avx2_emu_mask_storeu16<avx2_vector<type_t>>(mem, mask, x);
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx2_double_compressstore16<avx2_vector<type_t>>(
+                left_addr, right_addr, k, reg);
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm256_min_epi16(x, y);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm256_max_epi16(x, y);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        return avx2_emu_reduce_max16<avx2_vector<type_t>>(v);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        return avx2_emu_reduce_min16<avx2_vector<type_t>>(v);
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm256_set1_epi16(v);
+    }
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t ymm)
+    {
+        ymm = _mm256_shufflehi_epi16(ymm, mask);
+        return _mm256_shufflelo_epi16(ymm, mask);
+    }
+    template <uint16_t mask>
+    static reg_t blend(reg_t x, reg_t y)
+    {
+        return avx2_emu_blend16<mask>(x, y);
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        _mm256_storeu_si256((reg_t *)mem, x);
+    }
+    static reg_t reverse(reg_t ymm)
+    {
+        return ymm_16bit_reverse8(ymm_16bit_swap8(ymm));
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_ymm_16bit<avx2_vector<type_t>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_ymm_16bit<avx2_vector<type_t>>(x);
+    }
+};
+template <>
+struct avx2_vector<uint16_t> {
+    using type_t = uint16_t;
+    using reg_t = __m256i;
+    using opmask_t = int32_t;
+    static const uint8_t numlanes = 16;
+    static constexpr int network_sort_threshold = 256;
+    static constexpr int partition_unroll_factor = 4;
+
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_MAX_UINT16;
+    }
+    static type_t type_min()
+    {
+        return 0;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm256_set1_epi16(type_max());
+    }
+
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return x ^ 0xFFFF;
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        reg_t ge_vec = _mm256_cmpeq_epi16(_mm256_max_epu16(x, y), x);
+        return convert_avx2_mask_to_int_16bit(ge_vec);
+    }
+    static opmask_t get_partial_loadmask(int size)
+    {
+        return (0x01 << size) - 0x01;
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return _mm256_loadu_si256((reg_t const *)mem);
+    }
+    static reg_t maskz_loadu(opmask_t mask, void const *mem)
+    {
+        return mask_loadu(_mm256_setzero_si256(), mask, mem);
+    }
+    static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
+    {
+        return avx2_emu_mask_loadu16<avx2_vector<type_t>>(x, mask, mem);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        return _mm256_blendv_epi8(x, y, convert_int_to_avx2_mask_16bit(mask));
+    }
+    static void mask_storeu(void *mem, opmask_t mask, reg_t x)
+    {
+        avx2_emu_mask_storeu16<avx2_vector<type_t>>(mem, mask, x);
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx2_double_compressstore16<avx2_vector<type_t>>(
+                left_addr, right_addr, k, reg);
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm256_min_epu16(x, y);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm256_max_epu16(x, y);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        return avx2_emu_reduce_max16<avx2_vector<type_t>>(v);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        return avx2_emu_reduce_min16<avx2_vector<type_t>>(v);
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm256_set1_epi16(v);
+    }
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t ymm)
+    {
+        ymm = _mm256_shufflehi_epi16(ymm, mask);
+        return _mm256_shufflelo_epi16(ymm, mask);
+    }
+    template <uint16_t mask>
+    static reg_t blend(reg_t x, reg_t y)
+    {
+        return avx2_emu_blend16<mask>(x, y);
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        _mm256_storeu_si256((reg_t *)mem, x);
+    }
+    static reg_t reverse(reg_t ymm)
+    {
+        return ymm_16bit_reverse8(ymm_16bit_swap8(ymm));
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_ymm_16bit<avx2_vector<type_t>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_ymm_16bit<avx2_vector<type_t>>(x);
+    }
+};
+/*
+ * Half-precision floats without F16C conversions in the hot loop: flipping
+ * the magnitude bits of negative values maps the fp16 ordering onto the
+ * signed 16-bit ordering (-0 sorts before +0), so compares and min/max are
+ * an integer compare and a blend.
+ */
+template <>
+struct avx2_vector<float16> {
+    using type_t = uint16_t;
+    using reg_t = __m256i;
+    using opmask_t = int32_t;
+    static const uint8_t numlanes = 16;
+    static constexpr int network_sort_threshold = 256;
+    static constexpr int partition_unroll_factor = 4;
+
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_INFINITYH;
+    }
+    static type_t type_min()
+    {
+        return X86_SIMD_SORT_NEGINFINITYH;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm256_set1_epi16(type_max());
+    }
+    static reg_t to_signed_order(reg_t x)
+    {
+        reg_t neg = _mm256_srai_epi16(x, 15);
+        return _mm256_xor_si256(
+                x, _mm256_and_si256(neg, _mm256_set1_epi16(0x7FFF)));
+    }
+    static reg_t lt_vec(reg_t x, reg_t y)
+    {
+        return _mm256_cmpgt_epi16(to_signed_order(y), to_signed_order(x));
+    }
+
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return x ^ 0xFFFF;
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        return convert_avx2_mask_to_int_16bit(lt_vec(x, y)) ^ 0xFFFF;
+    }
+    static opmask_t get_partial_loadmask(int size)
+    {
+        return (0x01 << size) - 0x01;
+    }
+    /* Only the NaN check (QNaN | SNaN) of vfpclassph is emulated */
+    template <int type>
+    static opmask_t fpclass(reg_t x)
+    {
+        static_assert(type == (0x01 | 0x80), "should not reach here");
+        reg_t abs = _mm256_and_si256(x, _mm256_set1_epi16(0x7FFF));
+        reg_t nan = _mm256_cmpgt_epi16(abs, zmm_max());
+        return convert_avx2_mask_to_int_16bit(nan);
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return _mm256_loadu_si256((reg_t const *)mem);
+    }
+    static reg_t maskz_loadu(opmask_t mask, void const *mem)
+    {
+        return mask_loadu(_mm256_setzero_si256(), mask, mem);
+    }
+    static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
+    {
+        return avx2_emu_mask_loadu16<avx2_vector<float16>>(x, mask, mem);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        return _mm256_blendv_epi8(x, y, convert_int_to_avx2_mask_16bit(mask));
+    }
+    static void mask_storeu(void *mem, opmask_t mask, reg_t x)
+    {
+        avx2_emu_mask_storeu16<avx2_vector<float16>>(mem, mask, x);
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx2_double_compressstore16<avx2_vector<float16>>(
+                left_addr, right_addr, k, reg);
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm256_blendv_epi8(y, x, lt_vec(x, y));
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm256_blendv_epi8(x, y, lt_vec(x, y));
+    }
+    static type_t reducemax(reg_t v)
+    {
+        return avx2_emu_reduce_max16<avx2_vector<float16>>(v);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        return avx2_emu_reduce_min16<avx2_vector<float16>>(v);
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm256_set1_epi16(v);
+    }
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t ymm)
+    {
+        ymm = _mm256_shufflehi_epi16(ymm, mask);
+        return _mm256_shufflelo_epi16(ymm, mask);
+    }
+    template <uint16_t mask>
+    static reg_t blend(reg_t x, reg_t y)
+    {
+        return avx2_emu_blend16<mask>(x, y);
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        _mm256_storeu_si256((reg_t *)mem, x);
+    }
+    static reg_t reverse(reg_t ymm)
+    {
+        return ymm_16bit_reverse8(ymm_16bit_swap8(ymm));
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_ymm_16bit<avx2_vector<float16>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_ymm_16bit<avx2_vector<float16>>(x);
+    }
+};
+
+template <>
+bool comparison_func<avx2_vector<float16>>(const uint16_t &a,
+                                           const uint16_t &b)
+{
+    /* the same ordering as avx2_vector<float16>::ge */
+    int16_t a_ordered = (int16_t)(a ^ ((a & 0x8000) ? 0x7FFF : 0));
+    int16_t b_ordered = (int16_t)(b ^ ((b & 0x8000) ? 0x7FFF : 0));
+    return a_ordered < b_ordered;
+}
+
+inline void avx2_qsort_fp16(uint16_t *arr, int64_t arrsize)
+{
+    if (arrsize > 1) {
+        int64_t nan_count
+                = replace_nan_with_inf<avx2_vector<float16>, uint16_t>(
+                        arr, arrsize);
+        qsort_<avx2_vector<float16>, uint16_t>(
+                arr, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+        replace_inf_with_nan(arr, arrsize, nan_count);
+    }
+}
+
+inline void avx2_qselect_fp16(uint16_t *arr,
+                              int64_t k,
+                              int64_t arrsize,
+                              bool hasnan = false)
+{
+    int64_t indx_last_elem = arrsize - 1;
+    if (UNLIKELY(hasnan)) {
+        indx_last_elem = move_nans_to_end_of_array(arr, arrsize);
+    }
+    if (indx_last_elem >= k) {
+        qselect_<avx2_vector<float16>, uint16_t>(
+                arr, k, 0, indx_last_elem, 2 * (int64_t)log2(indx_last_elem));
+    }
+}
+
+inline void avx2_partial_qsort_fp16(uint16_t *arr,
+                                    int64_t k,
+                                    int64_t arrsize,
+                                    bool hasnan = false)
+{
+    avx2_qselect_fp16(arr, k - 1, arrsize, hasnan);
+    avx2_qsort_fp16(arr, k - 1);
+}
+
+#endif // AVX2_QSORT_16BIT
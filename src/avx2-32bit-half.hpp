@@ -0,0 +1,360 @@
+/*******************************************************************
+ * Copyright (C) 2022 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * Authors: Raghuveer Devulapalli <raghuveer.devulapalli@intel.com>
+ * ****************************************************************/
+
+#ifndef AVX2_HALF_32BIT
+#define AVX2_HALF_32BIT
+
+#include "avx2-emu-funcs.hpp"
+#include "xss-network-ymm.hpp"
+
+/*
+ * 32-bit keys in a 128-bit register. argsort on AVX2 gathers the keys through
+ * a ymm register of four 64-bit indices, which yields four 32-bit values. The
+ * shuffle, permutexvar and blend masks follow the 4 x 64-bit convention of
+ * avx2_vector<int64_t>, so the same 4-lane networks work for both.
+ */
+template <>
+struct avx2_half_vector<int32_t> {
+    using type_t = int32_t;
+    using reg_t = __m128i;
+    using opmask_t = int32_t;
+    static const uint8_t numlanes = 4;
+
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_MAX_INT32;
+    }
+    static type_t type_min()
+    {
+        return X86_SIMD_SORT_MIN_INT32;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm_set1_epi32(type_max());
+    }
+
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return x ^ 0xF;
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        reg_t lt = _mm_cmpgt_epi32(y, x);
+        return _mm_movemask_ps(_mm_castsi128_ps(lt)) ^ 0xF;
+    }
+    static opmask_t eq(reg_t x, reg_t y)
+    {
+        return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(x, y)));
+    }
+    template <int scale>
+    static reg_t
+    mask_i64gather(reg_t src, opmask_t mask, __m256i index, void const *base)
+    {
+        return _mm256_mask_i64gather_epi32(src,
+                                           (int const *)base,
+                                           index,
+                                           convert_int_to_avx2_mask_half(mask),
+                                           scale);
+    }
+    template <int scale>
+    static reg_t i64gather(__m256i index, void const *base)
+    {
+        return _mm256_i64gather_epi32((int const *)base, index, scale);
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return _mm_loadu_si128((reg_t const *)mem);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        return _mm_blendv_epi8(x, y, convert_int_to_avx2_mask_half(mask));
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm_min_epi32(x, y);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm_max_epi32(x, y);
+    }
+    template <int32_t idx>
+    static reg_t permutexvar(reg_t xmm)
+    {
+        return _mm_shuffle_epi32(xmm, idx);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        return avx2_emu_reduce_max32_half<avx2_half_vector<type_t>>(v);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        return avx2_emu_reduce_min32_half<avx2_half_vector<type_t>>(v);
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm_set1_epi32(v);
+    }
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t xmm)
+    {
+        if constexpr (mask == 0b01010101) {
+            return _mm_shuffle_epi32(xmm, SHUFFLE_MASK(2, 3, 0, 1));
+        }
+        else {
+            return _mm_shuffle_epi32(xmm, mask);
+        }
+    }
+    template <uint8_t mask>
+    static reg_t blend(reg_t x, reg_t y)
+    {
+        return _mm_blend_epi32(x, y, mask);
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        _mm_storeu_si128((reg_t *)mem, x);
+    }
+    static reg_t reverse(reg_t xmm)
+    {
+        return permutexvar<SHUFFLE_MASK(0, 1, 2, 3)>(xmm);
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_ymm_64bit<avx2_half_vector<type_t>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_ymm_64bit<avx2_half_vector<type_t>>(x);
+    }
+};
+template <>
+struct avx2_half_vector<uint32_t> {
+    using type_t = uint32_t;
+    using reg_t = __m128i;
+    using opmask_t = int32_t;
+    static const uint8_t numlanes = 4;
+
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_MAX_UINT32;
+    }
+    static type_t type_min()
+    {
+        return 0;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm_set1_epi32(type_max());
+    }
+
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return x ^ 0xF;
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        reg_t ge_mask = _mm_cmpeq_epi32(_mm_max_epu32(x, y), x);
+        return _mm_movemask_ps(_mm_castsi128_ps(ge_mask));
+    }
+    static opmask_t eq(reg_t x, reg_t y)
+    {
+        return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(x, y)));
+    }
+    template <int scale>
+    static reg_t
+    mask_i64gather(reg_t src, opmask_t mask, __m256i index, void const *base)
+    {
+        return _mm256_mask_i64gather_epi32(src,
+                                           (int const *)base,
+                                           index,
+                                           convert_int_to_avx2_mask_half(mask),
+                                           scale);
+    }
+    template <int scale>
+    static reg_t i64gather(__m256i index, void const *base)
+    {
+        return _mm256_i64gather_epi32((int const *)base, index, scale);
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return _mm_loadu_si128((reg_t const *)mem);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        return _mm_blendv_epi8(x, y, convert_int_to_avx2_mask_half(mask));
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm_min_epu32(x, y);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm_max_epu32(x, y);
+    }
+    template <int32_t idx>
+    static reg_t permutexvar(reg_t xmm)
+    {
+        return _mm_shuffle_epi32(xmm, idx);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        return avx2_emu_reduce_max32_half<avx2_half_vector<type_t>>(v);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        return avx2_emu_reduce_min32_half<avx2_half_vector<type_t>>(v);
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm_set1_epi32(v);
+    }
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t xmm)
+    {
+        if constexpr (mask == 0b01010101) {
+            return _mm_shuffle_epi32(xmm, SHUFFLE_MASK(2, 3, 0, 1));
+        }
+        else {
+            return _mm_shuffle_epi32(xmm, mask);
+        }
+    }
+    template <uint8_t mask>
+    static reg_t blend(reg_t x, reg_t y)
+    {
+        return _mm_blend_epi32(x, y, mask);
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        _mm_storeu_si128((reg_t *)mem, x);
+    }
+    static reg_t reverse(reg_t xmm)
+    {
+        return permutexvar<SHUFFLE_MASK(0, 1, 2, 3)>(xmm);
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_ymm_64bit<avx2_half_vector<type_t>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_ymm_64bit<avx2_half_vector<type_t>>(x);
+    }
+};
+template <>
+struct avx2_half_vector<float> {
+    using type_t = float;
+    using reg_t = __m128;
+    using opmask_t = int32_t;
+    static const uint8_t numlanes = 4;
+
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_INFINITYF;
+    }
+    static type_t type_min()
+    {
+        return -X86_SIMD_SORT_INFINITYF;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm_set1_ps(type_max());
+    }
+
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return x ^ 0xF;
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        return _mm_movemask_ps(_mm_cmp_ps(x, y, _CMP_GE_OQ));
+    }
+    static opmask_t eq(reg_t x, reg_t y)
+    {
+        return _mm_movemask_ps(_mm_cmp_ps(x, y, _CMP_EQ_OQ));
+    }
+    template <int scale>
+    static reg_t
+    mask_i64gather(reg_t src, opmask_t mask, __m256i index, void const *base)
+    {
+        return _mm256_mask_i64gather_ps(
+                src,
+                (float const *)base,
+                index,
+                _mm_castsi128_ps(convert_int_to_avx2_mask_half(mask)),
+                scale);
+    }
+    template <int scale>
+    static reg_t i64gather(__m256i index, void const *base)
+    {
+        return _mm256_i64gather_ps((float const *)base, index, scale);
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return _mm_loadu_ps((float const *)mem);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        __m128i vmask = convert_int_to_avx2_mask_half(mask);
+        return _mm_blendv_ps(x, y, _mm_castsi128_ps(vmask));
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm_min_ps(x, y);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm_max_ps(x, y);
+    }
+    template <int32_t idx>
+    static reg_t permutexvar(reg_t xmm)
+    {
+        return _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(xmm), idx));
+    }
+    static type_t reducemax(reg_t v)
+    {
+        return avx2_emu_reduce_max32_half<avx2_half_vector<type_t>>(v);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        return avx2_emu_reduce_min32_half<avx2_half_vector<type_t>>(v);
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm_set1_ps(v);
+    }
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t xmm)
+    {
+        if constexpr (mask == 0b01010101) {
+            return permutexvar<SHUFFLE_MASK(2, 3, 0, 1)>(xmm);
+        }
+        else {
+            return permutexvar<mask>(xmm);
+        }
+    }
+    template <uint8_t mask>
+    static reg_t blend(reg_t x, reg_t y)
+    {
+        return _mm_blend_ps(x, y, mask);
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        _mm_storeu_ps((float *)mem, x);
+    }
+    static reg_t reverse(reg_t xmm)
+    {
+        return permutexvar<SHUFFLE_MASK(0, 1, 2, 3)>(xmm);
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_ymm_64bit<avx2_half_vector<type_t>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_ymm_64bit<avx2_half_vector<type_t>>(x);
+    }
+};
+
+#endif // AVX2_HALF_32BIT
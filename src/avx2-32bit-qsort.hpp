@@ -0,0 +1,379 @@
+/*******************************************************************
+ * Copyright (C) 2022 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * Authors: Raghuveer Devulapalli <raghuveer.devulapalli@intel.com>
+ * ****************************************************************/
+
+#ifndef AVX2_QSORT_32BIT
+#define AVX2_QSORT_32BIT
+
+#include "avx2-emu-funcs.hpp"
+#include "xss-network-qsort.hpp"
+#include "xss-network-ymm.hpp"
+
+template <>
+struct avx2_vector<int32_t> {
+    using type_t = int32_t;
+    using reg_t = __m256i;
+    using opmask_t = int32_t;
+    static const uint8_t numlanes = 8;
+    static constexpr int network_sort_threshold = 256;
+    static constexpr int partition_unroll_factor = 4;
+
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_MAX_INT32;
+    }
+    static type_t type_min()
+    {
+        return X86_SIMD_SORT_MIN_INT32;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm256_set1_epi32(type_max());
+    }
+
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return x ^ 0xFF;
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        reg_t lt = _mm256_cmpgt_epi32(y, x);
+        return _mm256_movemask_ps(_mm256_castsi256_ps(lt)) ^ 0xFF;
+    }
+    static opmask_t get_partial_loadmask(int size)
+    {
+        return (0x01 << size) - 0x01;
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return _mm256_loadu_si256((reg_t const *)mem);
+    }
+    static reg_t maskz_loadu(opmask_t mask, void const *mem)
+    {
+        return _mm256_maskload_epi32((int const *)mem,
+                                     convert_int_to_avx2_mask_32bit(mask));
+    }
+    static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
+    {
+        __m256i vmask = convert_int_to_avx2_mask_32bit(mask);
+        reg_t dst = _mm256_maskload_epi32((int const *)mem, vmask);
+        return _mm256_blendv_epi8(x, dst, vmask);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        return _mm256_blendv_epi8(x, y, convert_int_to_avx2_mask_32bit(mask));
+    }
+    static void mask_storeu(void *mem, opmask_t mask, reg_t x)
+    {
+        return _mm256_maskstore_epi32(
+                (int *)mem, convert_int_to_avx2_mask_32bit(mask), x);
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx2_double_compressstore32<avx2_vector<type_t>>(
+                left_addr, right_addr, k, reg);
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm256_min_epi32(x, y);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm256_max_epi32(x, y);
+    }
+    static reg_t permutexvar(__m256i idx, reg_t ymm)
+    {
+        return _mm256_permutevar8x32_epi32(ymm, idx);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        return avx2_emu_reduce_max32<avx2_vector<type_t>>(v);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        return avx2_emu_reduce_min32<avx2_vector<type_t>>(v);
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm256_set1_epi32(v);
+    }
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t ymm)
+    {
+        return _mm256_shuffle_epi32(ymm, mask);
+    }
+    template <uint8_t mask>
+    static reg_t blend(reg_t x, reg_t y)
+    {
+        return _mm256_blend_epi32(x, y, mask);
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        _mm256_storeu_si256((reg_t *)mem, x);
+    }
+    static reg_t reverse(reg_t ymm)
+    {
+        const __m256i rev_index = _mm256_set_epi32(NETWORK_32BIT_AVX2_1);
+        return permutexvar(rev_index, ymm);
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_ymm_32bit<avx2_vector<type_t>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_ymm_32bit<avx2_vector<type_t>>(x);
+    }
+};
+template <>
+struct avx2_vector<uint32_t> {
+    using type_t = uint32_t;
+    using reg_t = __m256i;
+    using opmask_t = int32_t;
+    static const uint8_t numlanes = 8;
+    static constexpr int network_sort_threshold = 256;
+    static constexpr int partition_unroll_factor = 4;
+
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_MAX_UINT32;
+    }
+    static type_t type_min()
+    {
+        return 0;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm256_set1_epi32(type_max());
+    }
+
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return x ^ 0xFF;
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        reg_t ge_vec = _mm256_cmpeq_epi32(_mm256_max_epu32(x, y), x);
+        return _mm256_movemask_ps(_mm256_castsi256_ps(ge_vec));
+    }
+    static opmask_t get_partial_loadmask(int size)
+    {
+        return (0x01 << size) - 0x01;
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return _mm256_loadu_si256((reg_t const *)mem);
+    }
+    static reg_t maskz_loadu(opmask_t mask, void const *mem)
+    {
+        return _mm256_maskload_epi32((int const *)mem,
+                                     convert_int_to_avx2_mask_32bit(mask));
+    }
+    static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
+    {
+        __m256i vmask = convert_int_to_avx2_mask_32bit(mask);
+        reg_t dst = _mm256_maskload_epi32((int const *)mem, vmask);
+        return _mm256_blendv_epi8(x, dst, vmask);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        return _mm256_blendv_epi8(x, y, convert_int_to_avx2_mask_32bit(mask));
+    }
+    static void mask_storeu(void *mem, opmask_t mask, reg_t x)
+    {
+        return _mm256_maskstore_epi32(
+                (int *)mem, convert_int_to_avx2_mask_32bit(mask), x);
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx2_double_compressstore32<avx2_vector<type_t>>(
+                left_addr, right_addr, k, reg);
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm256_min_epu32(x, y);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm256_max_epu32(x, y);
+    }
+    static reg_t permutexvar(__m256i idx, reg_t ymm)
+    {
+        return _mm256_permutevar8x32_epi32(ymm, idx);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        return avx2_emu_reduce_max32<avx2_vector<type_t>>(v);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        return avx2_emu_reduce_min32<avx2_vector<type_t>>(v);
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm256_set1_epi32(v);
+    }
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t ymm)
+    {
+        return _mm256_shuffle_epi32(ymm, mask);
+    }
+    template <uint8_t mask>
+    static reg_t blend(reg_t x, reg_t y)
+    {
+        return _mm256_blend_epi32(x, y, mask);
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        _mm256_storeu_si256((reg_t *)mem, x);
+    }
+    static reg_t reverse(reg_t ymm)
+    {
+        const __m256i rev_index = _mm256_set_epi32(NETWORK_32BIT_AVX2_1);
+        return permutexvar(rev_index, ymm);
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_ymm_32bit<avx2_vector<type_t>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_ymm_32bit<avx2_vector<type_t>>(x);
+    }
+};
+template <>
+struct avx2_vector<float> {
+    using type_t = float;
+    using reg_t = __m256;
+    using opmask_t = int32_t;
+    static const uint8_t numlanes = 8;
+    static constexpr int network_sort_threshold = 256;
+    static constexpr int partition_unroll_factor = 4;
+
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_INFINITYF;
+    }
+    static type_t type_min()
+    {
+        return -X86_SIMD_SORT_INFINITYF;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm256_set1_ps(type_max());
+    }
+
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return x ^ 0xFF;
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        return _mm256_movemask_ps(_mm256_cmp_ps(x, y, _CMP_GE_OQ));
+    }
+    static opmask_t get_partial_loadmask(int size)
+    {
+        return (0x01 << size) - 0x01;
+    }
+    /* Only the NaN check (QNaN | SNaN) of vfpclassps is emulated */
+    template <int type>
+    static opmask_t fpclass(reg_t x)
+    {
+        static_assert(type == (0x01 | 0x80), "should not reach here");
+        return _mm256_movemask_ps(_mm256_cmp_ps(x, x, _CMP_UNORD_Q));
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return _mm256_loadu_ps((float const *)mem);
+    }
+    static reg_t maskz_loadu(opmask_t mask, void const *mem)
+    {
+        return _mm256_maskload_ps((float const *)mem,
+                                  convert_int_to_avx2_mask_32bit(mask));
+    }
+    static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
+    {
+        __m256i vmask = convert_int_to_avx2_mask_32bit(mask);
+        reg_t dst = _mm256_maskload_ps((float const *)mem, vmask);
+        return _mm256_blendv_ps(x, dst, _mm256_castsi256_ps(vmask));
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        __m256i vmask = convert_int_to_avx2_mask_32bit(mask);
+        return _mm256_blendv_ps(x, y, _mm256_castsi256_ps(vmask));
+    }
+    static void mask_storeu(void *mem, opmask_t mask, reg_t x)
+    {
+        return _mm256_maskstore_ps(
+                (float *)mem, convert_int_to_avx2_mask_32bit(mask), x);
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx2_double_compressstore32<avx2_vector<type_t>>(
+                left_addr, right_addr, k, reg);
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm256_min_ps(x, y);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm256_max_ps(x, y);
+    }
+    static reg_t permutexvar(__m256i idx, reg_t ymm)
+    {
+        return _mm256_permutevar8x32_ps(ymm, idx);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        return avx2_emu_reduce_max32<avx2_vector<type_t>>(v);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        return avx2_emu_reduce_min32<avx2_vector<type_t>>(v);
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm256_set1_ps(v);
+    }
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t ymm)
+    {
+        return _mm256_shuffle_ps(ymm, ymm, mask);
+    }
+    template <uint8_t mask>
+    static reg_t blend(reg_t x, reg_t y)
+    {
+        return _mm256_blend_ps(x, y, mask);
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        _mm256_storeu_ps((float *)mem, x);
+    }
+    static reg_t reverse(reg_t ymm)
+    {
+        const __m256i rev_index = _mm256_set_epi32(NETWORK_32BIT_AVX2_1);
+        return permutexvar(rev_index, ymm);
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_ymm_32bit<avx2_vector<type_t>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_ymm_32bit<avx2_vector<type_t>>(x);
+    }
+};
+
+#endif // AVX2_QSORT_32BIT
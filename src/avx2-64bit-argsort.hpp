@@ -0,0 +1,78 @@
+/*******************************************************************
+ * Copyright (C) 2022 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * Authors: Raghuveer Devulapalli <raghuveer.devulapalli@intel.com>
+ * ****************************************************************/
+
+#ifndef AVX2_ARGSORT_64BIT
+#define AVX2_ARGSORT_64BIT
+
+#include "avx2-32bit-half.hpp"
+#include "avx2-32bit-qsort.hpp"
+#include "avx2-64bit-qsort.hpp"
+#include "avx512-common-argsort.h"
+
+/*
+ * The indices are 64-bit, so a ymm register holds 4 of them and only 4 keys
+ * are gathered at a time: 32-bit keys are sorted in the lower half of a ymm
+ * register (avx2_half_vector), 64-bit keys in a full one.
+ */
+
+/* argsort methods for 32-bit and 64-bit dtypes */
+template <typename T>
+void avx2_argsort(T *arr, int64_t *arg, int64_t arrsize)
+{
+    using vectype = typename std::conditional<sizeof(T) == sizeof(int32_t),
+                                              avx2_half_vector<T>,
+                                              avx2_vector<T>>::type;
+    if (arrsize > 1) {
+        if constexpr (std::is_floating_point_v<T>) {
+            if (has_nan<avx2_vector<T>>(arr, arrsize)) {
+                std_argsort_withnan(arr, arg, 0, arrsize);
+                return;
+            }
+        }
+        argsort_64bit_<vectype, avx2_vector<int64_t>>(
+                arr, arg, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+    }
+}
+
+template <typename T>
+std::vector<int64_t> avx2_argsort(T *arr, int64_t arrsize)
+{
+    std::vector<int64_t> indices(arrsize);
+    std::iota(indices.begin(), indices.end(), 0);
+    avx2_argsort<T>(arr, indices.data(), arrsize);
+    return indices;
+}
+
+/* argselect methods for 32-bit and 64-bit dtypes */
+template <typename T>
+void avx2_argselect(T *arr, int64_t *arg, int64_t k, int64_t arrsize)
+{
+    using vectype = typename std::conditional<sizeof(T) == sizeof(int32_t),
+                                              avx2_half_vector<T>,
+                                              avx2_vector<T>>::type;
+
+    if (arrsize > 1) {
+        if constexpr (std::is_floating_point_v<T>) {
+            if (has_nan<avx2_vector<T>>(arr, arrsize)) {
+                std_argselect_withnan(arr, arg, k, 0, arrsize);
+                return;
+            }
+        }
+        argselect_64bit_<vectype, avx2_vector<int64_t>>(
+                arr, arg, k, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+    }
+}
+
+template <typename T>
+std::vector<int64_t> avx2_argselect(T *arr, int64_t k, int64_t arrsize)
+{
+    std::vector<int64_t> indices(arrsize);
+    std::iota(indices.begin(), indices.end(), 0);
+    avx2_argselect<T>(arr, indices.data(), k, arrsize);
+    return indices;
+}
+
+#endif // AVX2_ARGSORT_64BIT
@@ -0,0 +1,31 @@
+/*******************************************************************
+ * Copyright (C) 2022 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * Authors: Liu Zhuan <zhuan.liu@intel.com>
+ *          Tang Xi <xi.tang@intel.com>
+ * ****************************************************************/
+
+#ifndef AVX2_QSORT_64BIT_KV
+#define AVX2_QSORT_64BIT_KV
+
+#include "avx2-64bit-qsort.hpp"
+#include "avx512-common-keyvaluesort.h"
+
+template <typename T1, typename T2>
+void avx2_qsort_kv(T1 *keys, T2 *indexes, int64_t arrsize)
+{
+    if (arrsize > 1) {
+        if constexpr (std::is_floating_point_v<T1>) {
+            int64_t nan_count
+                    = replace_nan_with_inf<avx2_vector<double>>(keys, arrsize);
+            qsort_64bit_<avx2_vector<T1>, avx2_vector<T2>>(
+                    keys, indexes, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+            replace_inf_with_nan(keys, arrsize, nan_count);
+        }
+        else {
+            qsort_64bit_<avx2_vector<T1>, avx2_vector<T2>>(
+                    keys, indexes, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+        }
+    }
+}
+#endif // AVX2_QSORT_64BIT_KV
@@ -0,0 +1,476 @@
+/*******************************************************************
+ * Copyright (C) 2022 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * Authors: Raghuveer Devulapalli <raghuveer.devulapalli@intel.com>
+ * ****************************************************************/
+
+#ifndef AVX2_QSORT_64BIT
+#define AVX2_QSORT_64BIT
+
+#include "avx2-emu-funcs.hpp"
+#include "xss-network-qsort.hpp"
+#include "xss-network-ymm.hpp"
+
+template <>
+struct avx2_vector<int64_t> {
+    using type_t = int64_t;
+    using reg_t = __m256i;
+    using opmask_t = int32_t;
+    static const uint8_t numlanes = 4;
+    static constexpr int network_sort_threshold = 64;
+    static constexpr int partition_unroll_factor = 8;
+
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_MAX_INT64;
+    }
+    static type_t type_min()
+    {
+        return X86_SIMD_SORT_MIN_INT64;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm256_set1_epi64x(type_max());
+    }
+
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return x ^ 0xF;
+    }
+    static reg_t gt(reg_t x, reg_t y)
+    {
+        return _mm256_cmpgt_epi64(x, y);
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        return _mm256_movemask_pd(_mm256_castsi256_pd(gt(y, x))) ^ 0xF;
+    }
+    static opmask_t eq(reg_t x, reg_t y)
+    {
+        __m256i cmp = _mm256_cmpeq_epi64(x, y);
+        return _mm256_movemask_pd(_mm256_castsi256_pd(cmp));
+    }
+    static opmask_t get_partial_loadmask(int size)
+    {
+        return (0x01 << size) - 0x01;
+    }
+    template <int scale>
+    static reg_t
+    mask_i64gather(reg_t src, opmask_t mask, __m256i index, void const *base)
+    {
+        return _mm256_mask_i64gather_epi64(src,
+                                           (long long const *)base,
+                                           index,
+                                           convert_int_to_avx2_mask_64bit(mask),
+                                           scale);
+    }
+    template <int scale>
+    static reg_t i64gather(__m256i index, void const *base)
+    {
+        return _mm256_i64gather_epi64((long long const *)base, index, scale);
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return _mm256_loadu_si256((reg_t const *)mem);
+    }
+    static reg_t maskz_loadu(opmask_t mask, void const *mem)
+    {
+        return _mm256_maskload_epi64((long long const *)mem,
+                                     convert_int_to_avx2_mask_64bit(mask));
+    }
+    static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
+    {
+        __m256i vmask = convert_int_to_avx2_mask_64bit(mask);
+        reg_t dst = _mm256_maskload_epi64((long long const *)mem, vmask);
+        return _mm256_blendv_epi8(x, dst, vmask);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        return _mm256_blendv_epi8(x, y, convert_int_to_avx2_mask_64bit(mask));
+    }
+    static void mask_storeu(void *mem, opmask_t mask, reg_t x)
+    {
+        return _mm256_maskstore_epi64(
+                (long long *)mem, convert_int_to_avx2_mask_64bit(mask), x);
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx2_double_compressstore64<avx2_vector<type_t>>(
+                left_addr, right_addr, k, reg);
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm256_blendv_epi8(x, y, gt(x, y));
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm256_blendv_epi8(y, x, gt(x, y));
+    }
+    template <int32_t idx>
+    static reg_t permutexvar(reg_t ymm)
+    {
+        return _mm256_permute4x64_epi64(ymm, idx);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        return avx2_emu_reduce_max64<avx2_vector<type_t>>(v);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        return avx2_emu_reduce_min64<avx2_vector<type_t>>(v);
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm256_set1_epi64x(v);
+    }
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t ymm)
+    {
+        __m256d temp = _mm256_castsi256_pd(ymm);
+        return _mm256_castpd_si256(_mm256_shuffle_pd(temp, temp, mask & 0xF));
+    }
+    template <uint8_t mask>
+    static reg_t blend(reg_t x, reg_t y)
+    {
+        return _mm256_castpd_si256(_mm256_blend_pd(
+                _mm256_castsi256_pd(x), _mm256_castsi256_pd(y), mask));
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        _mm256_storeu_si256((reg_t *)mem, x);
+    }
+    static __m256i cast_to(reg_t v)
+    {
+        return v;
+    }
+    static reg_t cast_from(__m256i v)
+    {
+        return v;
+    }
+    static reg_t reverse(reg_t ymm)
+    {
+        return permutexvar<SHUFFLE_MASK(0, 1, 2, 3)>(ymm);
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_ymm_64bit<avx2_vector<type_t>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_ymm_64bit<avx2_vector<type_t>>(x);
+    }
+};
+template <>
+struct avx2_vector<uint64_t> {
+    using type_t = uint64_t;
+    using reg_t = __m256i;
+    using opmask_t = int32_t;
+    static const uint8_t numlanes = 4;
+    static constexpr int network_sort_threshold = 64;
+    static constexpr int partition_unroll_factor = 8;
+
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_MAX_UINT64;
+    }
+    static type_t type_min()
+    {
+        return 0;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm256_set1_epi64x(type_max());
+    }
+
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return x ^ 0xF;
+    }
+    static reg_t gt(reg_t x, reg_t y)
+    {
+        /* AVX2 only has a signed 64-bit compare: flip the sign bits */
+        const __m256i sign = _mm256_set1_epi64x(X86_SIMD_SORT_MIN_INT64);
+        return _mm256_cmpgt_epi64(_mm256_xor_si256(x, sign),
+                                  _mm256_xor_si256(y, sign));
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        return _mm256_movemask_pd(_mm256_castsi256_pd(gt(y, x))) ^ 0xF;
+    }
+    static opmask_t eq(reg_t x, reg_t y)
+    {
+        __m256i cmp = _mm256_cmpeq_epi64(x, y);
+        return _mm256_movemask_pd(_mm256_castsi256_pd(cmp));
+    }
+    static opmask_t get_partial_loadmask(int size)
+    {
+        return (0x01 << size) - 0x01;
+    }
+    template <int scale>
+    static reg_t
+    mask_i64gather(reg_t src, opmask_t mask, __m256i index, void const *base)
+    {
+        return _mm256_mask_i64gather_epi64(src,
+                                           (long long const *)base,
+                                           index,
+                                           convert_int_to_avx2_mask_64bit(mask),
+                                           scale);
+    }
+    template <int scale>
+    static reg_t i64gather(__m256i index, void const *base)
+    {
+        return _mm256_i64gather_epi64((long long const *)base, index, scale);
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return _mm256_loadu_si256((reg_t const *)mem);
+    }
+    static reg_t maskz_loadu(opmask_t mask, void const *mem)
+    {
+        return _mm256_maskload_epi64((long long const *)mem,
+                                     convert_int_to_avx2_mask_64bit(mask));
+    }
+    static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
+    {
+        __m256i vmask = convert_int_to_avx2_mask_64bit(mask);
+        reg_t dst = _mm256_maskload_epi64((long long const *)mem, vmask);
+        return _mm256_blendv_epi8(x, dst, vmask);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        return _mm256_blendv_epi8(x, y, convert_int_to_avx2_mask_64bit(mask));
+    }
+    static void mask_storeu(void *mem, opmask_t mask, reg_t x)
+    {
+        return _mm256_maskstore_epi64(
+                (long long *)mem, convert_int_to_avx2_mask_64bit(mask), x);
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx2_double_compressstore64<avx2_vector<type_t>>(
+                left_addr, right_addr, k, reg);
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm256_blendv_epi8(x, y, gt(x, y));
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm256_blendv_epi8(y, x, gt(x, y));
+    }
+    template <int32_t idx>
+    static reg_t permutexvar(reg_t ymm)
+    {
+        return _mm256_permute4x64_epi64(ymm, idx);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        return avx2_emu_reduce_max64<avx2_vector<type_t>>(v);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        return avx2_emu_reduce_min64<avx2_vector<type_t>>(v);
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm256_set1_epi64x(v);
+    }
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t ymm)
+    {
+        __m256d temp = _mm256_castsi256_pd(ymm);
+        return _mm256_castpd_si256(_mm256_shuffle_pd(temp, temp, mask & 0xF));
+    }
+    template <uint8_t mask>
+    static reg_t blend(reg_t x, reg_t y)
+    {
+        return _mm256_castpd_si256(_mm256_blend_pd(
+                _mm256_castsi256_pd(x), _mm256_castsi256_pd(y), mask));
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        _mm256_storeu_si256((reg_t *)mem, x);
+    }
+    static __m256i cast_to(reg_t v)
+    {
+        return v;
+    }
+    static reg_t cast_from(__m256i v)
+    {
+        return v;
+    }
+    static reg_t reverse(reg_t ymm)
+    {
+        return permutexvar<SHUFFLE_MASK(0, 1, 2, 3)>(ymm);
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_ymm_64bit<avx2_vector<type_t>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_ymm_64bit<avx2_vector<type_t>>(x);
+    }
+};
+template <>
+struct avx2_vector<double> {
+    using type_t = double;
+    using reg_t = __m256d;
+    using opmask_t = int32_t;
+    static const uint8_t numlanes = 4;
+    static constexpr int network_sort_threshold = 64;
+    static constexpr int partition_unroll_factor = 8;
+
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_INFINITY;
+    }
+    static type_t type_min()
+    {
+        return -X86_SIMD_SORT_INFINITY;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm256_set1_pd(type_max());
+    }
+
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return x ^ 0xF;
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        return _mm256_movemask_pd(_mm256_cmp_pd(x, y, _CMP_GE_OQ));
+    }
+    static opmask_t eq(reg_t x, reg_t y)
+    {
+        return _mm256_movemask_pd(_mm256_cmp_pd(x, y, _CMP_EQ_OQ));
+    }
+    static opmask_t get_partial_loadmask(int size)
+    {
+        return (0x01 << size) - 0x01;
+    }
+    /* Only the NaN check (QNaN | SNaN) of vfpclasspd is emulated */
+    template <int type>
+    static opmask_t fpclass(reg_t x)
+    {
+        static_assert(type == (0x01 | 0x80), "should not reach here");
+        return _mm256_movemask_pd(_mm256_cmp_pd(x, x, _CMP_UNORD_Q));
+    }
+    template <int scale>
+    static reg_t
+    mask_i64gather(reg_t src, opmask_t mask, __m256i index, void const *base)
+    {
+        return _mm256_mask_i64gather_pd(
+                src,
+                (double const *)base,
+                index,
+                _mm256_castsi256_pd(convert_int_to_avx2_mask_64bit(mask)),
+                scale);
+    }
+    template <int scale>
+    static reg_t i64gather(__m256i index, void const *base)
+    {
+        return _mm256_i64gather_pd((double const *)base, index, scale);
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return _mm256_loadu_pd((double const *)mem);
+    }
+    static reg_t maskz_loadu(opmask_t mask, void const *mem)
+    {
+        return _mm256_maskload_pd((double const *)mem,
+                                  convert_int_to_avx2_mask_64bit(mask));
+    }
+    static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
+    {
+        __m256i vmask = convert_int_to_avx2_mask_64bit(mask);
+        reg_t dst = _mm256_maskload_pd((double const *)mem, vmask);
+        return _mm256_blendv_pd(x, dst, _mm256_castsi256_pd(vmask));
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        __m256i vmask = convert_int_to_avx2_mask_64bit(mask);
+        return _mm256_blendv_pd(x, y, _mm256_castsi256_pd(vmask));
+    }
+    static void mask_storeu(void *mem, opmask_t mask, reg_t x)
+    {
+        return _mm256_maskstore_pd(
+                (double *)mem, convert_int_to_avx2_mask_64bit(mask), x);
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx2_double_compressstore64<avx2_vector<type_t>>(
+                left_addr, right_addr, k, reg);
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm256_min_pd(x, y);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm256_max_pd(x, y);
+    }
+    template <int32_t idx>
+    static reg_t permutexvar(reg_t ymm)
+    {
+        return _mm256_permute4x64_pd(ymm, idx);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        return avx2_emu_reduce_max64<avx2_vector<type_t>>(v);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        return avx2_emu_reduce_min64<avx2_vector<type_t>>(v);
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm256_set1_pd(v);
+    }
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t ymm)
+    {
+        return _mm256_shuffle_pd(ymm, ymm, mask & 0xF);
+    }
+    template <uint8_t mask>
+    static reg_t blend(reg_t x, reg_t y)
+    {
+        return _mm256_blend_pd(x, y, mask);
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        _mm256_storeu_pd((double *)mem, x);
+    }
+    static __m256i cast_to(reg_t v)
+    {
+        return _mm256_castpd_si256(v);
+    }
+    static reg_t cast_from(__m256i v)
+    {
+        return _mm256_castsi256_pd(v);
+    }
+    static reg_t reverse(reg_t ymm)
+    {
+        return permutexvar<SHUFFLE_MASK(0, 1, 2, 3)>(ymm);
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_ymm_64bit<avx2_vector<type_t>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_ymm_64bit<avx2_vector<type_t>>(x);
+    }
+};
+
+#endif // AVX2_QSORT_64BIT
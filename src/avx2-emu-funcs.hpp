@@ -0,0 +1,399 @@
+/*******************************************************************
+ * Copyright (C) 2022 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * Authors: Raghuveer Devulapalli <raghuveer.devulapalli@intel.com>
+ * ****************************************************************/
+
+#ifndef AVX2_EMU_FUNCS
+#define AVX2_EMU_FUNCS
+
+#include <array>
+
+#include "avx512-common-qsort.h"
+
+/*
+ * AVX2 has no opmask registers and no compressstore instruction. The AVX2
+ * vector types use a plain integer bitmask (one bit per lane) as their
+ * opmask_t and emulate the AVX-512 instructions used by the sorting code with
+ * the helpers and lookup tables defined here.
+ */
+
+/*
+ * compressstore LUTs: for every bitmask k, a permutation that moves the lanes
+ * with k == 0 to the front and the lanes with k == 1 to the back, keeping
+ * their relative order. The 64-bit table holds indices for
+ * _mm256_permutevar8x32 (two 32-bit indices per 64-bit lane).
+ */
+constexpr auto avx2_compressstore_lut32 = [] {
+    std::array<std::array<int32_t, 8>, 256> lut {};
+    for (int64_t k = 0; k < 256; k++) {
+        int pos = 0;
+        for (int j = 0; j < 8; j++) {
+            if (((k >> j) & 1) == 0) { lut[k][pos++] = j; }
+        }
+        for (int j = 0; j < 8; j++) {
+            if (((k >> j) & 1) == 1) { lut[k][pos++] = j; }
+        }
+    }
+    return lut;
+}();
+
+constexpr auto avx2_compressstore_lut64 = [] {
+    std::array<std::array<int32_t, 8>, 16> lut {};
+    for (int64_t k = 0; k < 16; k++) {
+        int pos = 0;
+        for (int j = 0; j < 4; j++) {
+            if (((k >> j) & 1) == 0) {
+                lut[k][pos++] = 2 * j;
+                lut[k][pos++] = 2 * j + 1;
+            }
+        }
+        for (int j = 0; j < 4; j++) {
+            if (((k >> j) & 1) == 1) {
+                lut[k][pos++] = 2 * j;
+                lut[k][pos++] = 2 * j + 1;
+            }
+        }
+    }
+    return lut;
+}();
+
+/*
+ * 16-bit lanes are compressed one 128-bit half at a time: for every 8-bit
+ * mask, the pshufb indices that move the (two byte) lanes with k == 0 to the
+ * front of the half and the lanes with k == 1 to the back.
+ */
+constexpr auto avx2_compressstore_lut16 = [] {
+    std::array<std::array<uint8_t, 16>, 256> lut {};
+    for (int64_t k = 0; k < 256; k++) {
+        int pos = 0;
+        for (int j = 0; j < 8; j++) {
+            if (((k >> j) & 1) == 0) {
+                lut[k][pos++] = 2 * j;
+                lut[k][pos++] = 2 * j + 1;
+            }
+        }
+        for (int j = 0; j < 8; j++) {
+            if (((k >> j) & 1) == 1) {
+                lut[k][pos++] = 2 * j;
+                lut[k][pos++] = 2 * j + 1;
+            }
+        }
+    }
+    return lut;
+}();
+
+/* Convert an integer bitmask into a vector mask usable by maskload/blendv */
+X86_SIMD_SORT_INLINE __m256i convert_int_to_avx2_mask_32bit(int32_t m)
+{
+    const __m256i bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    __m256i vm = _mm256_and_si256(_mm256_set1_epi32(m), bits);
+    return _mm256_cmpeq_epi32(vm, bits);
+}
+
+X86_SIMD_SORT_INLINE __m256i convert_int_to_avx2_mask_64bit(int32_t m)
+{
+    const __m256i bits = _mm256_setr_epi64x(1, 2, 4, 8);
+    __m256i vm = _mm256_and_si256(_mm256_set1_epi64x(m), bits);
+    return _mm256_cmpeq_epi64(vm, bits);
+}
+
+X86_SIMD_SORT_INLINE __m128i convert_int_to_avx2_mask_half(int32_t m)
+{
+    const __m128i bits = _mm_setr_epi32(1, 2, 4, 8);
+    __m128i vm = _mm_and_si128(_mm_set1_epi32(m), bits);
+    return _mm_cmpeq_epi32(vm, bits);
+}
+
+X86_SIMD_SORT_INLINE __m256i convert_int_to_avx2_mask_16bit(int32_t m)
+{
+    const __m256i bits = _mm256_setr_epi16(0x0001,
+                                           0x0002,
+                                           0x0004,
+                                           0x0008,
+                                           0x0010,
+                                           0x0020,
+                                           0x0040,
+                                           0x0080,
+                                           0x0100,
+                                           0x0200,
+                                           0x0400,
+                                           0x0800,
+                                           0x1000,
+                                           0x2000,
+                                           0x4000,
+                                           (int16_t)0x8000);
+    __m256i vm = _mm256_and_si256(_mm256_set1_epi16((int16_t)m), bits);
+    return _mm256_cmpeq_epi16(vm, bits);
+}
+
+/* The inverse of the above: one bit per 16-bit lane of a vector mask */
+X86_SIMD_SORT_INLINE int32_t convert_avx2_mask_to_int_16bit(__m256i vm)
+{
+    __m128i packed = _mm_packs_epi16(_mm256_castsi256_si128(vm),
+                                     _mm256_extracti128_si256(vm, 1));
+    return _mm_movemask_epi8(packed);
+}
+
+template <uint16_t mask>
+X86_SIMD_SORT_INLINE __m256i avx2_emu_blend16(__m256i x, __m256i y)
+{
+    /* vpblendw applies the same 8-bit immediate to both 128-bit halves */
+    if constexpr ((mask & 0xFF) == (mask >> 8)) {
+        return _mm256_blend_epi16(x, y, mask & 0xFF);
+    }
+    else if constexpr (mask == 0xFF00) {
+        return _mm256_blend_epi32(x, y, 0xF0);
+    }
+    else {
+        return _mm256_blendv_epi8(x, y, convert_int_to_avx2_mask_16bit(mask));
+    }
+}
+
+/*
+ * maskload/maskstore only exist for 32-bit and 64-bit lanes. Pairs of 16-bit
+ * lanes that are both in the mask go through the 32-bit versions, the rest
+ * (at most one lane for the prefix masks used by sort_n) one at a time.
+ */
+X86_SIMD_SORT_INLINE int32_t avx2_emu_unpaired_lanes16(int32_t mask)
+{
+    int32_t pairs = mask & (mask >> 1) & 0x5555;
+    return mask & ~(pairs | (pairs << 1));
+}
+
+template <typename vtype,
+          typename type_t = typename vtype::type_t,
+          typename reg_t = typename vtype::reg_t>
+X86_SIMD_SORT_INLINE reg_t avx2_emu_mask_loadu16(reg_t x,
+                                                 int32_t mask,
+                                                 void const *mem)
+{
+    __m256i vmask = convert_int_to_avx2_mask_16bit(mask);
+    __m256i pairs = _mm256_and_si256(vmask, _mm256_slli_epi32(vmask, 16));
+    reg_t dst = _mm256_maskload_epi32((int const *)mem, pairs);
+    int32_t unpaired = avx2_emu_unpaired_lanes16(mask);
+    if (unpaired != 0) {
+        type_t arr[vtype::numlanes];
+        vtype::storeu(arr, dst);
+        for (int ii = 0; ii < vtype::numlanes; ++ii) {
+            if ((unpaired >> ii) & 1) { arr[ii] = ((type_t const *)mem)[ii]; }
+        }
+        dst = vtype::loadu(arr);
+    }
+    return _mm256_blendv_epi8(x, dst, vmask);
+}
+
+template <typename vtype,
+          typename type_t = typename vtype::type_t,
+          typename reg_t = typename vtype::reg_t>
+X86_SIMD_SORT_INLINE void
+avx2_emu_mask_storeu16(void *mem, int32_t mask, reg_t x)
+{
+    __m256i vmask = convert_int_to_avx2_mask_16bit(mask);
+    __m256i pairs = _mm256_and_si256(vmask, _mm256_slli_epi32(vmask, 16));
+    _mm256_maskstore_epi32((int *)mem, pairs, x);
+    int32_t unpaired = avx2_emu_unpaired_lanes16(mask);
+    if (unpaired != 0) {
+        type_t arr[vtype::numlanes];
+        vtype::storeu(arr, x);
+        for (int ii = 0; ii < vtype::numlanes; ++ii) {
+            if ((unpaired >> ii) & 1) { ((type_t *)mem)[ii] = arr[ii]; }
+        }
+    }
+}
+
+/*
+ * Emulates the two mask_compressstoreu calls of a partition step: permute the
+ * lanes less than the pivot to the front and the rest to the back, then store
+ * the full register at both addresses. This writes past the compressed
+ * elements, which is safe since the partitioning code always has at least
+ * numlanes free slots at either store point (left_addr == right_addr when
+ * exactly numlanes are free, in which case both stores are identical).
+ */
+template <typename vtype,
+          typename type_t = typename vtype::type_t,
+          typename reg_t = typename vtype::reg_t>
+X86_SIMD_SORT_INLINE int avx2_double_compressstore32(type_t *left_addr,
+                                                     type_t *right_addr,
+                                                     int32_t k,
+                                                     reg_t reg)
+{
+    __m256i perm = _mm256_loadu_si256(
+            (const __m256i *)avx2_compressstore_lut32[k].data());
+    reg_t temp = vtype::permutexvar(perm, reg);
+    vtype::storeu(left_addr, temp);
+    vtype::storeu(right_addr, temp);
+    return _mm_popcnt_u32(k);
+}
+
+template <typename vtype,
+          typename type_t = typename vtype::type_t,
+          typename reg_t = typename vtype::reg_t>
+X86_SIMD_SORT_INLINE int avx2_double_compressstore64(type_t *left_addr,
+                                                     type_t *right_addr,
+                                                     int32_t k,
+                                                     reg_t reg)
+{
+    __m256i perm = _mm256_loadu_si256(
+            (const __m256i *)avx2_compressstore_lut64[k].data());
+    reg_t temp = vtype::cast_from(_mm256_permutevar8x32_epi32(
+            vtype::cast_to(reg), perm));
+    vtype::storeu(left_addr, temp);
+    vtype::storeu(right_addr, temp);
+    return _mm_popcnt_u32(k);
+}
+
+/*
+ * Same as above for 16 x 16-bit lanes, which would need a 64K entry table as
+ * a single permute. Each 128-bit half is compressed with pshufb instead and
+ * the halves are stored back to back: the lanes less than the pivot of the
+ * low half, then those of the high half at left_addr; the rest of the high
+ * half at the end of the right store, preceded by the rest of the low half.
+ * When left_addr == right_addr these stores would clobber each other, so the
+ * right side goes through a buffer and only its tail is copied over.
+ */
+template <typename vtype,
+          typename type_t = typename vtype::type_t,
+          typename reg_t = typename vtype::reg_t>
+X86_SIMD_SORT_INLINE int avx2_double_compressstore16(type_t *left_addr,
+                                                     type_t *right_addr,
+                                                     int32_t k,
+                                                     reg_t reg)
+{
+    const int32_t k_lo = k & 0xFF;
+    const int32_t k_hi = (k >> 8) & 0xFF;
+    __m128i lo = _mm_shuffle_epi8(
+            _mm256_castsi256_si128(reg),
+            _mm_loadu_si128((const __m128i *)avx2_compressstore_lut16[k_lo]
+                                    .data()));
+    __m128i hi = _mm_shuffle_epi8(
+            _mm256_extracti128_si256(reg, 1),
+            _mm_loadu_si128((const __m128i *)avx2_compressstore_lut16[k_hi]
+                                    .data()));
+    const int32_t amount_ge_pivot = _mm_popcnt_u32(k);
+    const int32_t lo_lt_pivot = 8 - _mm_popcnt_u32(k_lo);
+    const int32_t hi_ge_pivot = _mm_popcnt_u32(k_hi);
+
+    type_t buf[vtype::numlanes];
+    type_t *right = (left_addr == right_addr) ? buf : right_addr;
+    _mm_storeu_si128((__m128i *)left_addr, lo);
+    _mm_storeu_si128((__m128i *)(left_addr + lo_lt_pivot), hi);
+    _mm_storeu_si128((__m128i *)(right + 8), hi);
+    _mm_storeu_si128((__m128i *)(right + 8 - hi_ge_pivot), lo);
+    if (right == buf) {
+        std::copy(buf + vtype::numlanes - amount_ge_pivot,
+                  buf + vtype::numlanes,
+                  left_addr + vtype::numlanes - amount_ge_pivot);
+    }
+    return amount_ge_pivot;
+}
+
+template <typename vtype,
+          typename type_t = typename vtype::type_t,
+          typename reg_t = typename vtype::reg_t>
+X86_SIMD_SORT_INLINE type_t avx2_emu_reduce_max32(reg_t x)
+{
+    reg_t inter1 = vtype::max(
+            x, vtype::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(x));
+    reg_t inter2 = vtype::max(
+            inter1, vtype::template shuffle<SHUFFLE_MASK(1, 0, 3, 2)>(inter1));
+    type_t arr[vtype::numlanes];
+    vtype::storeu(arr, inter2);
+    return std::max(arr[0], arr[7]);
+}
+
+template <typename vtype,
+          typename type_t = typename vtype::type_t,
+          typename reg_t = typename vtype::reg_t>
+X86_SIMD_SORT_INLINE type_t avx2_emu_reduce_min32(reg_t x)
+{
+    reg_t inter1 = vtype::min(
+            x, vtype::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(x));
+    reg_t inter2 = vtype::min(
+            inter1, vtype::template shuffle<SHUFFLE_MASK(1, 0, 3, 2)>(inter1));
+    type_t arr[vtype::numlanes];
+    vtype::storeu(arr, inter2);
+    return std::min(arr[0], arr[7]);
+}
+
+template <typename vtype,
+          typename type_t = typename vtype::type_t,
+          typename reg_t = typename vtype::reg_t>
+X86_SIMD_SORT_INLINE type_t avx2_emu_reduce_max64(reg_t x)
+{
+    reg_t inter = vtype::max(
+            x, vtype::template shuffle<SHUFFLE_MASK(1, 1, 1, 1)>(x));
+    type_t arr[vtype::numlanes];
+    vtype::storeu(arr, inter);
+    return std::max(arr[0], arr[3]);
+}
+
+template <typename vtype,
+          typename type_t = typename vtype::type_t,
+          typename reg_t = typename vtype::reg_t>
+X86_SIMD_SORT_INLINE type_t avx2_emu_reduce_min64(reg_t x)
+{
+    reg_t inter = vtype::min(
+            x, vtype::template shuffle<SHUFFLE_MASK(1, 1, 1, 1)>(x));
+    type_t arr[vtype::numlanes];
+    vtype::storeu(arr, inter);
+    return std::min(arr[0], arr[3]);
+}
+
+template <typename vtype,
+          typename type_t = typename vtype::type_t,
+          typename reg_t = typename vtype::reg_t>
+X86_SIMD_SORT_INLINE type_t avx2_emu_reduce_max32_half(reg_t x)
+{
+    reg_t inter = vtype::max(
+            x, vtype::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(x));
+    type_t arr[vtype::numlanes];
+    vtype::storeu(arr, inter);
+    return std::max(arr[0], arr[3]);
+}
+
+template <typename vtype,
+          typename type_t = typename vtype::type_t,
+          typename reg_t = typename vtype::reg_t>
+X86_SIMD_SORT_INLINE type_t avx2_emu_reduce_min32_half(reg_t x)
+{
+    reg_t inter = vtype::min(
+            x, vtype::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(x));
+    type_t arr[vtype::numlanes];
+    vtype::storeu(arr, inter);
+    return std::min(arr[0], arr[3]);
+}
+
+template <typename vtype,
+          typename type_t = typename vtype::type_t,
+          typename reg_t = typename vtype::reg_t>
+X86_SIMD_SORT_INLINE type_t avx2_emu_reduce_max16(reg_t x)
+{
+    reg_t inter1 = vtype::max(
+            x, _mm256_permute4x64_epi64(x, SHUFFLE_MASK(1, 0, 3, 2)));
+    reg_t inter2 = vtype::max(
+            inter1, _mm256_shuffle_epi32(inter1, SHUFFLE_MASK(1, 0, 3, 2)));
+    reg_t inter3 = vtype::max(
+            inter2, vtype::template shuffle<SHUFFLE_MASK(1, 0, 3, 2)>(inter2));
+    reg_t inter4 = vtype::max(
+            inter3, vtype::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(inter3));
+    return (type_t)_mm256_extract_epi16(inter4, 0);
+}
+
+template <typename vtype,
+          typename type_t = typename vtype::type_t,
+          typename reg_t = typename vtype::reg_t>
+X86_SIMD_SORT_INLINE type_t avx2_emu_reduce_min16(reg_t x)
+{
+    reg_t inter1 = vtype::min(
+            x, _mm256_permute4x64_epi64(x, SHUFFLE_MASK(1, 0, 3, 2)));
+    reg_t inter2 = vtype::min(
+            inter1, _mm256_shuffle_epi32(inter1, SHUFFLE_MASK(1, 0, 3, 2)));
+    reg_t inter3 = vtype::min(
+            inter2, vtype::template shuffle<SHUFFLE_MASK(1, 0, 3, 2)>(inter2));
+    reg_t inter4 = vtype::min(
+            inter3, vtype::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(inter3));
+    return (type_t)_mm256_extract_epi16(inter4, 0);
+}
+
+#endif // AVX2_EMU_FUNCS
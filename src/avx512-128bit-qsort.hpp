@@ -0,0 +1,322 @@
+/*******************************************************************
+ * Copyright (C) 2023 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * ****************************************************************/
+
+#ifndef AVX512_QSORT_128BIT
+#define AVX512_QSORT_128BIT
+
+#include "avx512-64bit-common.h"
+#include "xss-network-qsort.hpp"
+
+/*
+ * Sorting 128-bit keys: unsigned __int128 and pairs of 64-bit words such as
+ * (hash_hi, hash_lo) or UUIDs, both compared high word first.
+ *
+ * A register holds 8 keys as two zmm registers, one with the high words and
+ * one with the low words of the keys. Keys are split into the two halves when
+ * loaded and interleaved again when stored, so the 64-bit bitonic networks
+ * and the quicksort partitioning run unchanged on the pair: compares combine
+ * the two halves into one opmask and every blend and permute is applied to
+ * both. Partitioning compresses both halves with the same mask.
+ */
+struct uint64_pair {
+    uint64_t hi;
+    uint64_t lo;
+};
+
+X86_SIMD_SORT_INLINE bool operator<(const uint64_pair &a, const uint64_pair &b)
+{
+    return a.hi < b.hi || (a.hi == b.hi && a.lo < b.lo);
+}
+X86_SIMD_SORT_INLINE bool operator>(const uint64_pair &a, const uint64_pair &b)
+{
+    return b < a;
+}
+X86_SIMD_SORT_INLINE bool operator==(const uint64_pair &a,
+                                     const uint64_pair &b)
+{
+    return a.hi == b.hi && a.lo == b.lo;
+}
+X86_SIMD_SORT_INLINE bool operator!=(const uint64_pair &a,
+                                     const uint64_pair &b)
+{
+    return !(a == b);
+}
+
+struct zmm_128bit_reg {
+    __m512i hi;
+    __m512i lo;
+};
+
+template <typename T>
+struct zmm_vector_128bit {
+    static_assert(sizeof(T) == 16);
+    using type_t = T;
+    using reg_t = zmm_128bit_reg;
+    using zmmi_t = __m512i;
+    using opmask_t = __mmask8;
+    static const uint8_t numlanes = 8;
+    static constexpr int network_sort_threshold = 256;
+    static constexpr int partition_unroll_factor = 0;
+    /* which of the two 64-bit words of a key in memory is the high one */
+    static constexpr int hi_word = std::is_same_v<T, uint64_pair> ? 0 : 1;
+
+    static type_t type_max()
+    {
+        type_t v;
+        std::memset(&v, 0xFF, sizeof(v));
+        return v;
+    }
+    static type_t type_min()
+    {
+        type_t v;
+        std::memset(&v, 0, sizeof(v));
+        return v;
+    }
+    static reg_t zmm_max()
+    {
+        return set1(type_max());
+    }
+    static zmmi_t
+    seti(int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8)
+    {
+        return _mm512_set_epi64(v1, v2, v3, v4, v5, v6, v7, v8);
+    }
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return _knot_mask8(x);
+    }
+    /* Split 2 x 4 interleaved keys into their high and low words */
+    static reg_t deinterleave(__m512i a, __m512i b)
+    {
+        __m512i even = _mm512_permutex2var_epi64(
+                a, _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14), b);
+        __m512i odd = _mm512_permutex2var_epi64(
+                a, _mm512_setr_epi64(1, 3, 5, 7, 9, 11, 13, 15), b);
+        if constexpr (hi_word == 0) { return {even, odd}; }
+        else {
+            return {odd, even};
+        }
+    }
+    static void interleave(reg_t x, __m512i &a, __m512i &b)
+    {
+        __m512i w0 = (hi_word == 0) ? x.hi : x.lo;
+        __m512i w1 = (hi_word == 0) ? x.lo : x.hi;
+        a = _mm512_permutex2var_epi64(
+                w0, _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11), w1);
+        b = _mm512_permutex2var_epi64(
+                w0, _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15), w1);
+    }
+    /* One bit per key to one bit per 64-bit word */
+    static __mmask16 word_mask(opmask_t mask)
+    {
+        uint32_t m = mask;
+        m = (m | (m << 4)) & 0x0F0F;
+        m = (m | (m << 2)) & 0x3333;
+        m = (m | (m << 1)) & 0x5555;
+        return (__mmask16)(m | (m << 1));
+    }
+    static opmask_t gt(reg_t x, reg_t y)
+    {
+        opmask_t hi_gt = _mm512_cmp_epu64_mask(x.hi, y.hi, _MM_CMPINT_NLE);
+        opmask_t hi_eq = _mm512_cmp_epu64_mask(x.hi, y.hi, _MM_CMPINT_EQ);
+        return hi_gt
+                | _mm512_mask_cmp_epu64_mask(
+                        hi_eq, x.lo, y.lo, _MM_CMPINT_NLE);
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        opmask_t hi_gt = _mm512_cmp_epu64_mask(x.hi, y.hi, _MM_CMPINT_NLE);
+        opmask_t hi_eq = _mm512_cmp_epu64_mask(x.hi, y.hi, _MM_CMPINT_EQ);
+        return hi_gt
+                | _mm512_mask_cmp_epu64_mask(
+                        hi_eq, x.lo, y.lo, _MM_CMPINT_NLT);
+    }
+    static opmask_t eq(reg_t x, reg_t y)
+    {
+        opmask_t hi_eq = _mm512_cmp_epu64_mask(x.hi, y.hi, _MM_CMPINT_EQ);
+        return _mm512_mask_cmp_epu64_mask(hi_eq, x.lo, y.lo, _MM_CMPINT_EQ);
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return deinterleave(_mm512_loadu_si512(mem),
+                            _mm512_loadu_si512((const char *)mem + 64));
+    }
+    static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
+    {
+        __m512i a, b;
+        interleave(x, a, b);
+        __mmask16 m = word_mask(mask);
+        a = _mm512_mask_loadu_epi64(a, (__mmask8)m, mem);
+        b = _mm512_mask_loadu_epi64(
+                b, (__mmask8)(m >> 8), (const char *)mem + 64);
+        return deinterleave(a, b);
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        __m512i a, b;
+        interleave(x, a, b);
+        _mm512_storeu_si512(mem, a);
+        _mm512_storeu_si512((char *)mem + 64, b);
+    }
+    static void mask_storeu(void *mem, opmask_t mask, reg_t x)
+    {
+        __m512i a, b;
+        interleave(x, a, b);
+        __mmask16 m = word_mask(mask);
+        _mm512_mask_storeu_epi64(mem, (__mmask8)m, a);
+        _mm512_mask_storeu_epi64((char *)mem + 64, (__mmask8)(m >> 8), b);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        return {_mm512_mask_mov_epi64(x.hi, mask, y.hi),
+                _mm512_mask_mov_epi64(x.lo, mask, y.lo)};
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return mask_mov(x, gt(x, y), y);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return mask_mov(y, gt(x, y), x);
+    }
+    static reg_t permutexvar(__m512i idx, reg_t x)
+    {
+        return {_mm512_permutexvar_epi64(idx, x.hi),
+                _mm512_permutexvar_epi64(idx, x.lo)};
+    }
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t x)
+    {
+        __m512d hi = _mm512_castsi512_pd(x.hi);
+        __m512d lo = _mm512_castsi512_pd(x.lo);
+        return {_mm512_castpd_si512(
+                        _mm512_shuffle_pd(hi, hi, (_MM_PERM_ENUM)mask)),
+                _mm512_castpd_si512(
+                        _mm512_shuffle_pd(lo, lo, (_MM_PERM_ENUM)mask))};
+    }
+    static reg_t reverse(reg_t x)
+    {
+        return permutexvar(seti(NETWORK_64BIT_2), x);
+    }
+    static reg_t set1(type_t v)
+    {
+        uint64_t words[2];
+        std::memcpy(words, &v, sizeof(words));
+        return {_mm512_set1_epi64(words[hi_word]),
+                _mm512_set1_epi64(words[1 - hi_word])};
+    }
+    static type_t reducemax(reg_t v)
+    {
+        type_t keys[numlanes];
+        storeu(keys, v);
+        return *std::max_element(keys, keys + numlanes);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        type_t keys[numlanes];
+        storeu(keys, v);
+        return *std::min_element(keys, keys + numlanes);
+    }
+    /* Stores the first n keys of reg compressed with k at mem */
+    static void compressstore_n(type_t *mem, opmask_t k, reg_t reg, int n)
+    {
+        reg_t packed = {_mm512_maskz_compress_epi64(k, reg.hi),
+                        _mm512_maskz_compress_epi64(k, reg.lo)};
+        mask_storeu(mem, (opmask_t)((1u << n) - 1), packed);
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        int amount_ge_pivot = _mm_popcnt_u32((int32_t)k);
+        compressstore_n(
+                left_addr, knot_opmask(k), reg, numlanes - amount_ge_pivot);
+        compressstore_n(right_addr + numlanes - amount_ge_pivot,
+                        k,
+                        reg,
+                        amount_ge_pivot);
+        return amount_ge_pivot;
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_zmm_64bit<zmm_vector_128bit<type_t>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_zmm_64bit<zmm_vector_128bit<type_t>>(x);
+    }
+};
+
+template <>
+inline void
+avx512_qsort(unsigned __int128 *arr, int64_t arrsize, bool descending)
+{
+    using vtype = zmm_vector_128bit<unsigned __int128>;
+    if (descending) { xss_qsort<descending_vector<vtype>>(arr, arrsize); }
+    else {
+        xss_qsort<vtype>(arr, arrsize);
+    }
+}
+
+template <>
+inline void avx512_qsort(uint64_pair *arr, int64_t arrsize, bool descending)
+{
+    using vtype = zmm_vector_128bit<uint64_pair>;
+    if (descending) { xss_qsort<descending_vector<vtype>>(arr, arrsize); }
+    else {
+        xss_qsort<vtype>(arr, arrsize);
+    }
+}
+
+template <>
+inline void avx512_qselect(unsigned __int128 *arr,
+                           int64_t k,
+                           int64_t arrsize,
+                           bool,
+                           bool descending)
+{
+    using vtype = zmm_vector_128bit<unsigned __int128>;
+    if (descending) {
+        xss_qselect<descending_vector<vtype>>(arr, k, arrsize, false);
+    }
+    else {
+        xss_qselect<vtype>(arr, k, arrsize, false);
+    }
+}
+
+template <>
+inline void avx512_qselect(
+        uint64_pair *arr, int64_t k, int64_t arrsize, bool, bool descending)
+{
+    using vtype = zmm_vector_128bit<uint64_pair>;
+    if (descending) {
+        xss_qselect<descending_vector<vtype>>(arr, k, arrsize, false);
+    }
+    else {
+        xss_qselect<vtype>(arr, k, arrsize, false);
+    }
+}
+
+template <>
+inline void avx512_partial_qsort(unsigned __int128 *arr,
+                                 int64_t k,
+                                 int64_t arrsize,
+                                 bool,
+                                 bool descending)
+{
+    avx512_qselect(arr, k - 1, arrsize, false, descending);
+    avx512_qsort(arr, k - 1, descending);
+}
+
+template <>
+inline void avx512_partial_qsort(
+        uint64_pair *arr, int64_t k, int64_t arrsize, bool, bool descending)
+{
+    avx512_qselect(arr, k - 1, arrsize, false, descending);
+    avx512_qsort(arr, k - 1, descending);
+}
+
+#endif // AVX512_QSORT_128BIT
@@ -0,0 +1,599 @@
+/*******************************************************************
+ * Copyright (C) 2023 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * ****************************************************************/
+
+#ifndef AVX512_ARGSORT_16BIT
+#define AVX512_ARGSORT_16BIT
+
+#include "avx512-16bit-qsort.hpp"
+#include "avx512-64bit-argsort.hpp"
+
+/*
+ * argsort for int16_t, uint16_t, and float16 and bfloat16 stored as uint16_t.
+ * The 64-bit indices fill a zmm register 8 at a time, so the keys are sorted 8
+ * at a time in an xmm register (AVX512VL + AVX512BW). bfloat16 keys are
+ * compared like zmm_vector<bfloat16> does. There is no 16-bit gather
+ * instruction: the keys are loaded one at a time.
+ */
+template <>
+struct xmm_vector<bfloat16> {
+    using type_t = uint16_t;
+    using reg_t = __m128i;
+    using zmmi_t = __m128i;
+    using opmask_t = __mmask8;
+    static const uint8_t numlanes = 8;
+
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_INFINITYBF16;
+    }
+    static type_t type_min()
+    {
+        return X86_SIMD_SORT_NEGINFINITYBF16;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm_set1_epi16(type_max());
+    }
+    static zmmi_t
+    seti(int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8)
+    {
+        return _mm_set_epi16(v1, v2, v3, v4, v5, v6, v7, v8);
+    }
+    static reg_t to_signed_order(reg_t x)
+    {
+        reg_t sign = _mm_srai_epi16(x, 15);
+        return _mm_xor_si128(x, _mm_and_si128(sign, _mm_set1_epi16(0x7FFF)));
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        return _mm_cmp_epi16_mask(
+                to_signed_order(x), to_signed_order(y), _MM_CMPINT_NLT);
+    }
+    static opmask_t eq(reg_t x, reg_t y)
+    {
+        return _mm_cmpeq_epi16_mask(x, y);
+    }
+    template <int scale>
+    static reg_t
+    mask_i64gather(reg_t src, opmask_t mask, __m512i index, void const *base)
+    {
+        int64_t idx[numlanes];
+        type_t vals[numlanes];
+        _mm512_storeu_si512(idx, index);
+        _mm_storeu_si128((__m128i *)vals, src);
+        for (int ii = 0; ii < numlanes; ++ii) {
+            if (mask & (1 << ii)) { vals[ii] = ((type_t *)base)[idx[ii]]; }
+        }
+        return _mm_loadu_si128((__m128i *)vals);
+    }
+    template <int scale>
+    static reg_t i64gather(__m512i index, void const *base)
+    {
+        int64_t idx[numlanes];
+        type_t vals[numlanes];
+        _mm512_storeu_si512(idx, index);
+        for (int ii = 0; ii < numlanes; ++ii) {
+            vals[ii] = ((type_t *)base)[idx[ii]];
+        }
+        return _mm_loadu_si128((__m128i *)vals);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm_mask_mov_epi16(y, ge(x, y), x);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        return _mm_mask_mov_epi16(x, mask, y);
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm_mask_mov_epi16(x, ge(x, y), y);
+    }
+    static reg_t permutexvar(__m128i idx, reg_t xmm)
+    {
+        return _mm_permutexvar_epi16(idx, xmm);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        reg_t x = to_signed_order(v);
+        x = _mm_max_epi16(x, _mm_shuffle_epi32(x, SHUFFLE_MASK(1, 0, 3, 2)));
+        x = _mm_max_epi16(x, _mm_shuffle_epi32(x, SHUFFLE_MASK(2, 3, 0, 1)));
+        x = _mm_max_epi16(x, _mm_srli_epi32(x, 16));
+        return bf16_to_signed_order(_mm_extract_epi16(x, 0));
+    }
+    static type_t reducemin(reg_t v)
+    {
+        reg_t x = to_signed_order(v);
+        x = _mm_min_epi16(x, _mm_shuffle_epi32(x, SHUFFLE_MASK(1, 0, 3, 2)));
+        x = _mm_min_epi16(x, _mm_shuffle_epi32(x, SHUFFLE_MASK(2, 3, 0, 1)));
+        x = _mm_min_epi16(x, _mm_srli_epi32(x, 16));
+        return bf16_to_signed_order(_mm_extract_epi16(x, 0));
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm_set1_epi16(v);
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        _mm_storeu_si128((__m128i *)mem, x);
+    }
+    /*
+     * The 64-bit networks only use SHUFFLE_MASK(1, 1, 1, 1), to swap
+     * neighbouring lanes
+     */
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t xmm)
+    {
+        static_assert(mask == 0b01010101);
+        xmm = _mm_shufflehi_epi16(xmm, SHUFFLE_MASK(2, 3, 0, 1));
+        return _mm_shufflelo_epi16(xmm, SHUFFLE_MASK(2, 3, 0, 1));
+    }
+    static reg_t reverse(reg_t xmm)
+    {
+        return permutexvar(seti(NETWORK_64BIT_2), xmm);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_zmm_64bit<xmm_vector<bfloat16>>(x);
+    }
+};
+
+template <>
+bool comparison_func<xmm_vector<bfloat16>>(const uint16_t &a,
+                                           const uint16_t &b)
+{
+    return bf16_to_signed_order(a) < bf16_to_signed_order(b);
+}
+
+template <>
+struct xmm_vector<int16_t> {
+    using type_t = int16_t;
+    using reg_t = __m128i;
+    using zmmi_t = __m128i;
+    using opmask_t = __mmask8;
+    static const uint8_t numlanes = 8;
+
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_MAX_INT16;
+    }
+    static type_t type_min()
+    {
+        return X86_SIMD_SORT_MIN_INT16;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm_set1_epi16(type_max());
+    }
+    static zmmi_t
+    seti(int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8)
+    {
+        return _mm_set_epi16(v1, v2, v3, v4, v5, v6, v7, v8);
+    }
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return _knot_mask8(x);
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        return _mm_cmp_epi16_mask(x, y, _MM_CMPINT_NLT);
+    }
+    static opmask_t eq(reg_t x, reg_t y)
+    {
+        return _mm_cmp_epi16_mask(x, y, _MM_CMPINT_EQ);
+    }
+    template <int scale>
+    static reg_t
+    mask_i64gather(reg_t src, opmask_t mask, __m512i index, void const *base)
+    {
+        int64_t idx[numlanes];
+        type_t vals[numlanes];
+        _mm512_storeu_si512(idx, index);
+        _mm_storeu_si128((__m128i *)vals, src);
+        for (int ii = 0; ii < numlanes; ++ii) {
+            if (mask & (1 << ii)) { vals[ii] = ((type_t *)base)[idx[ii]]; }
+        }
+        return _mm_loadu_si128((__m128i *)vals);
+    }
+    template <int scale>
+    static reg_t i64gather(__m512i index, void const *base)
+    {
+        int64_t idx[numlanes];
+        type_t vals[numlanes];
+        _mm512_storeu_si512(idx, index);
+        for (int ii = 0; ii < numlanes; ++ii) {
+            vals[ii] = ((type_t *)base)[idx[ii]];
+        }
+        return _mm_loadu_si128((__m128i *)vals);
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return _mm_loadu_si128((__m128i const *)mem);
+    }
+    static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
+    {
+        return _mm_mask_loadu_epi16(x, mask, mem);
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        _mm_storeu_si128((__m128i *)mem, x);
+    }
+    static void mask_storeu(void *mem, opmask_t mask, reg_t x)
+    {
+        _mm_mask_storeu_epi16(mem, mask, x);
+    }
+    static void mask_compressstoreu(void *mem, opmask_t mask, reg_t x)
+    {
+#ifdef __AVX512VBMI2__
+        _mm_mask_compressstoreu_epi16(mem, mask, x);
+#else
+        avx512_emu_mask_compressstoreu16(mem, mask, x);
+#endif
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx512_double_compressstore<xmm_vector<type_t>>(
+                left_addr, right_addr, k, reg);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm_max_epi16(x, y);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        return _mm_mask_mov_epi16(x, mask, y);
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm_min_epi16(x, y);
+    }
+    static reg_t permutexvar(__m128i idx, reg_t xmm)
+    {
+        return _mm_permutexvar_epi16(idx, xmm);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        v = max(v, _mm_shuffle_epi32(v, SHUFFLE_MASK(1, 0, 3, 2)));
+        v = max(v, _mm_shuffle_epi32(v, SHUFFLE_MASK(2, 3, 0, 1)));
+        v = max(v, _mm_shufflelo_epi16(v, SHUFFLE_MASK(2, 3, 0, 1)));
+        return _mm_extract_epi16(v, 0);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        v = min(v, _mm_shuffle_epi32(v, SHUFFLE_MASK(1, 0, 3, 2)));
+        v = min(v, _mm_shuffle_epi32(v, SHUFFLE_MASK(2, 3, 0, 1)));
+        v = min(v, _mm_shufflelo_epi16(v, SHUFFLE_MASK(2, 3, 0, 1)));
+        return _mm_extract_epi16(v, 0);
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm_set1_epi16(v);
+    }
+    /*
+     * The 64-bit networks only use SHUFFLE_MASK(1, 1, 1, 1), to swap
+     * neighbouring lanes
+     */
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t xmm)
+    {
+        static_assert(mask == 0b01010101);
+        xmm = _mm_shufflehi_epi16(xmm, SHUFFLE_MASK(2, 3, 0, 1));
+        return _mm_shufflelo_epi16(xmm, SHUFFLE_MASK(2, 3, 0, 1));
+    }
+    static reg_t reverse(reg_t xmm)
+    {
+        return permutexvar(seti(NETWORK_64BIT_2), xmm);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_zmm_64bit<xmm_vector<type_t>>(x);
+    }
+};
+template <>
+struct xmm_vector<uint16_t> {
+    using type_t = uint16_t;
+    using reg_t = __m128i;
+    using zmmi_t = __m128i;
+    using opmask_t = __mmask8;
+    static const uint8_t numlanes = 8;
+
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_MAX_UINT16;
+    }
+    static type_t type_min()
+    {
+        return 0;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm_set1_epi16(type_max());
+    }
+    static zmmi_t
+    seti(int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8)
+    {
+        return _mm_set_epi16(v1, v2, v3, v4, v5, v6, v7, v8);
+    }
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return _knot_mask8(x);
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        return _mm_cmp_epu16_mask(x, y, _MM_CMPINT_NLT);
+    }
+    static opmask_t eq(reg_t x, reg_t y)
+    {
+        return _mm_cmp_epu16_mask(x, y, _MM_CMPINT_EQ);
+    }
+    template <int scale>
+    static reg_t
+    mask_i64gather(reg_t src, opmask_t mask, __m512i index, void const *base)
+    {
+        int64_t idx[numlanes];
+        type_t vals[numlanes];
+        _mm512_storeu_si512(idx, index);
+        _mm_storeu_si128((__m128i *)vals, src);
+        for (int ii = 0; ii < numlanes; ++ii) {
+            if (mask & (1 << ii)) { vals[ii] = ((type_t *)base)[idx[ii]]; }
+        }
+        return _mm_loadu_si128((__m128i *)vals);
+    }
+    template <int scale>
+    static reg_t i64gather(__m512i index, void const *base)
+    {
+        int64_t idx[numlanes];
+        type_t vals[numlanes];
+        _mm512_storeu_si512(idx, index);
+        for (int ii = 0; ii < numlanes; ++ii) {
+            vals[ii] = ((type_t *)base)[idx[ii]];
+        }
+        return _mm_loadu_si128((__m128i *)vals);
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return _mm_loadu_si128((__m128i const *)mem);
+    }
+    static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
+    {
+        return _mm_mask_loadu_epi16(x, mask, mem);
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        _mm_storeu_si128((__m128i *)mem, x);
+    }
+    static void mask_storeu(void *mem, opmask_t mask, reg_t x)
+    {
+        _mm_mask_storeu_epi16(mem, mask, x);
+    }
+    static void mask_compressstoreu(void *mem, opmask_t mask, reg_t x)
+    {
+#ifdef __AVX512VBMI2__
+        _mm_mask_compressstoreu_epi16(mem, mask, x);
+#else
+        avx512_emu_mask_compressstoreu16(mem, mask, x);
+#endif
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx512_double_compressstore<xmm_vector<type_t>>(
+                left_addr, right_addr, k, reg);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm_max_epu16(x, y);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        return _mm_mask_mov_epi16(x, mask, y);
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm_min_epu16(x, y);
+    }
+    static reg_t permutexvar(__m128i idx, reg_t xmm)
+    {
+        return _mm_permutexvar_epi16(idx, xmm);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        v = max(v, _mm_shuffle_epi32(v, SHUFFLE_MASK(1, 0, 3, 2)));
+        v = max(v, _mm_shuffle_epi32(v, SHUFFLE_MASK(2, 3, 0, 1)));
+        v = max(v, _mm_shufflelo_epi16(v, SHUFFLE_MASK(2, 3, 0, 1)));
+        return _mm_extract_epi16(v, 0);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        v = min(v, _mm_shuffle_epi32(v, SHUFFLE_MASK(1, 0, 3, 2)));
+        v = min(v, _mm_shuffle_epi32(v, SHUFFLE_MASK(2, 3, 0, 1)));
+        v = min(v, _mm_shufflelo_epi16(v, SHUFFLE_MASK(2, 3, 0, 1)));
+        return _mm_extract_epi16(v, 0);
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm_set1_epi16(v);
+    }
+    /*
+     * The 64-bit networks only use SHUFFLE_MASK(1, 1, 1, 1), to swap
+     * neighbouring lanes
+     */
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t xmm)
+    {
+        static_assert(mask == 0b01010101);
+        xmm = _mm_shufflehi_epi16(xmm, SHUFFLE_MASK(2, 3, 0, 1));
+        return _mm_shufflelo_epi16(xmm, SHUFFLE_MASK(2, 3, 0, 1));
+    }
+    static reg_t reverse(reg_t xmm)
+    {
+        return permutexvar(seti(NETWORK_64BIT_2), xmm);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_zmm_64bit<xmm_vector<type_t>>(x);
+    }
+};
+
+/*
+ * float16 is sign-magnitude like bfloat16, so bf16_to_signed_order orders it
+ * too, and the only difference with xmm_vector<bfloat16> is the infinities.
+ * The loads and stores are the uint16_t ones, which avx512_qsort_kv_fp16
+ * needs as well.
+ */
+template <>
+struct xmm_vector<float16> : public xmm_vector<uint16_t> {
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_INFINITYH;
+    }
+    static type_t type_min()
+    {
+        return X86_SIMD_SORT_NEGINFINITYH;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm_set1_epi16(type_max());
+    }
+    static reg_t to_signed_order(reg_t x)
+    {
+        reg_t sign = _mm_srai_epi16(x, 15);
+        return _mm_xor_si128(x, _mm_and_si128(sign, _mm_set1_epi16(0x7FFF)));
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        return _mm_cmp_epi16_mask(
+                to_signed_order(x), to_signed_order(y), _MM_CMPINT_NLT);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm_mask_mov_epi16(y, ge(x, y), x);
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm_mask_mov_epi16(x, ge(x, y), y);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        reg_t x = to_signed_order(v);
+        x = _mm_max_epi16(x, _mm_shuffle_epi32(x, SHUFFLE_MASK(1, 0, 3, 2)));
+        x = _mm_max_epi16(x, _mm_shuffle_epi32(x, SHUFFLE_MASK(2, 3, 0, 1)));
+        x = _mm_max_epi16(x, _mm_srli_epi32(x, 16));
+        return bf16_to_signed_order(_mm_extract_epi16(x, 0));
+    }
+    static type_t reducemin(reg_t v)
+    {
+        reg_t x = to_signed_order(v);
+        x = _mm_min_epi16(x, _mm_shuffle_epi32(x, SHUFFLE_MASK(1, 0, 3, 2)));
+        x = _mm_min_epi16(x, _mm_shuffle_epi32(x, SHUFFLE_MASK(2, 3, 0, 1)));
+        x = _mm_min_epi16(x, _mm_srli_epi32(x, 16));
+        return bf16_to_signed_order(_mm_extract_epi16(x, 0));
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_zmm_64bit<xmm_vector<float16>>(x);
+    }
+};
+
+template <>
+bool comparison_func<xmm_vector<float16>>(const uint16_t &a, const uint16_t &b)
+{
+    return bf16_to_signed_order(a) < bf16_to_signed_order(b);
+}
+
+/* NAN's are sorted to the end */
+inline void avx512_argsort_bf16(uint16_t *arr, int64_t *arg, int64_t arrsize)
+{
+    if (arrsize > 1) {
+        if (has_nan<zmm_vector<bfloat16>>(arr, arrsize)) {
+            arrsize = move_nan_args_to_end(arr, arg, arrsize, is_a_nan_bf16);
+            if (arrsize <= 1) { return; }
+        }
+        argsort_64bit_<xmm_vector<bfloat16>, zmm_vector<int64_t>>(
+                arr, arg, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+    }
+}
+
+inline std::vector<int64_t> avx512_argsort_bf16(uint16_t *arr, int64_t arrsize)
+{
+    std::vector<int64_t> indices(arrsize);
+    std::iota(indices.begin(), indices.end(), 0);
+    avx512_argsort_bf16(arr, indices.data(), arrsize);
+    return indices;
+}
+
+inline void
+avx512_argselect_bf16(uint16_t *arr, int64_t *arg, int64_t k, int64_t arrsize)
+{
+    if (arrsize > 1) {
+        if (has_nan<zmm_vector<bfloat16>>(arr, arrsize)) {
+            arrsize = move_nan_args_to_end(arr, arg, arrsize, is_a_nan_bf16);
+            if (k >= arrsize) { return; }
+        }
+        argselect_64bit_<xmm_vector<bfloat16>, zmm_vector<int64_t>>(
+                arr, arg, k, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+    }
+}
+
+inline std::vector<int64_t>
+avx512_argselect_bf16(uint16_t *arr, int64_t k, int64_t arrsize)
+{
+    std::vector<int64_t> indices(arrsize);
+    std::iota(indices.begin(), indices.end(), 0);
+    avx512_argselect_bf16(arr, indices.data(), k, arrsize);
+    return indices;
+}
+
+/* float16 stored as uint16_t, NAN's are sorted to the end */
+inline void avx512_argsort_fp16(uint16_t *arr, int64_t *arg, int64_t arrsize)
+{
+    if (arrsize > 1) {
+        if (has_nan<zmm_vector<float16>>(arr, arrsize)) {
+            arrsize = move_nan_args_to_end(
+                    arr, arg, arrsize, is_a_nan<uint16_t>);
+            if (arrsize <= 1) { return; }
+        }
+        argsort_64bit_<xmm_vector<float16>, zmm_vector<int64_t>>(
+                arr, arg, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+    }
+}
+
+inline std::vector<int64_t> avx512_argsort_fp16(uint16_t *arr, int64_t arrsize)
+{
+    std::vector<int64_t> indices(arrsize);
+    std::iota(indices.begin(), indices.end(), 0);
+    avx512_argsort_fp16(arr, indices.data(), arrsize);
+    return indices;
+}
+
+inline void
+avx512_argselect_fp16(uint16_t *arr, int64_t *arg, int64_t k, int64_t arrsize)
+{
+    if (arrsize > 1) {
+        if (has_nan<zmm_vector<float16>>(arr, arrsize)) {
+            arrsize = move_nan_args_to_end(
+                    arr, arg, arrsize, is_a_nan<uint16_t>);
+            if (k >= arrsize) { return; }
+        }
+        argselect_64bit_<xmm_vector<float16>, zmm_vector<int64_t>>(
+                arr, arg, k, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+    }
+}
+
+inline std::vector<int64_t>
+avx512_argselect_fp16(uint16_t *arr, int64_t k, int64_t arrsize)
+{
+    std::vector<int64_t> indices(arrsize);
+    std::iota(indices.begin(), indices.end(), 0);
+    avx512_argselect_fp16(arr, indices.data(), k, arrsize);
+    return indices;
+}
+
+#endif // AVX512_ARGSORT_16BIT
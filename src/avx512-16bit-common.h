@@ -9,6 +9,7 @@
 
 #include "avx512-common-qsort.h"
 #include "xss-network-qsort.hpp"
+#include <vector>
 
 /*
  * Constants used in sorting 32 elements in a ZMM registers. Based on Bitonic
@@ -30,6 +31,121 @@ static const uint16_t network[6][32]
            {16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
             0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15}};
 
+/*
+ * mask_compressstoreu for 16-bit lanes without AVX512_VBMI2 (Skylake-X and
+ * Cascade Lake): widen each 256-bit half to 32-bit lanes, compress those with
+ * the AVX512F vpcompressd and narrow them back with a masked vpmovdw store.
+ */
+X86_SIMD_SORT_INLINE void
+avx512_emu_mask_compressstoreu16(void *mem, __mmask32 mask, __m512i x)
+{
+    uint16_t *dst = (uint16_t *)mem;
+    __mmask16 mask_lo = (__mmask16)(mask & 0xFFFF);
+    __mmask16 mask_hi = (__mmask16)(mask >> 16);
+    int32_t count_lo = _mm_popcnt_u32(mask_lo);
+    int32_t count_hi = _mm_popcnt_u32(mask_hi);
+    __m512i lo = _mm512_cvtepu16_epi32(_mm512_castsi512_si256(x));
+    __m512i hi = _mm512_cvtepu16_epi32(_mm512_extracti64x4_epi64(x, 1));
+    _mm512_mask_cvtepi32_storeu_epi16(dst,
+                                      (__mmask16)((1u << count_lo) - 1),
+                                      _mm512_maskz_compress_epi32(mask_lo, lo));
+    _mm512_mask_cvtepi32_storeu_epi16(dst + count_lo,
+                                      (__mmask16)((1u << count_hi) - 1),
+                                      _mm512_maskz_compress_epi32(mask_hi, hi));
+}
+
+/* Same for the 8 16-bit lanes of an xmm register */
+X86_SIMD_SORT_INLINE void
+avx512_emu_mask_compressstoreu16(void *mem, __mmask8 mask, __m128i x)
+{
+    int32_t count = _mm_popcnt_u32(mask);
+    _mm256_mask_cvtepi32_storeu_epi16(
+            mem,
+            (__mmask8)((1u << count) - 1),
+            _mm256_maskz_compress_epi32(mask, _mm256_cvtepu16_epi32(x)));
+}
+
+/*
+ * Maps the values of a 16-bit type to histogram buckets in ascending order and
+ * back: int16_t values are counted with the sign bit flipped.
+ */
+template <typename T>
+struct xss_16bit_buckets {
+    static constexpr uint16_t bias = std::is_signed_v<T> ? 0x8000 : 0;
+    static uint16_t bucket(T x)
+    {
+        return (uint16_t)x ^ bias;
+    }
+    static T value(uint16_t b)
+    {
+        return (T)(b ^ bias);
+    }
+};
+
+/*
+ * The histogram_sort_threshold of the 16-bit vtypes. Without AVX512_VBMI2 the
+ * counting sort wins from ~40k elements on Skylake-X (bench-qsort-skx.cpp).
+ * The partitioning is faster with AVX512_VBMI2 and the crossover hasn't been
+ * measured there yet, so that keeps a margin.
+ */
+#ifndef XSS_HISTOGRAM_SORT_THRESHOLD_16BIT
+#ifdef __AVX512VBMI2__
+#define XSS_HISTOGRAM_SORT_THRESHOLD_16BIT (1 << 17)
+#else
+#define XSS_HISTOGRAM_SORT_THRESHOLD_16BIT (1 << 16)
+#endif
+#endif
+
+/*
+ * Counting sort for uint16_t and int16_t, used by xss_qsort for arrays of more
+ * than histogram_sort_threshold elements: two passes over the array instead of
+ * O(n log n) partitioning. The 65536 32-bit counters (256 KB) stay in L2.
+ * buckets maps the values to the counters, see xss_16bit_buckets. Buckets are
+ * scanned 16 at a time to skip the empty ones and each run is written with
+ * 64-byte stores. The buckets are scanned from the top to sort in descending
+ * order. bench-qsort compares it with quicksort on the same arrays
+ * (avx512qsort vs avx512qsort_nohistogram, with AVX512_VBMI2) and so does
+ * bench-qsort-skx (without it).
+ */
+template <typename T,
+          bool descending = false,
+          typename buckets = xss_16bit_buckets<T>>
+X86_SIMD_SORT_INLINE void avx512_histogram_sort_16bit(T *arr, int64_t arrsize)
+{
+    std::vector<uint32_t> hist(1 << 16);
+    int64_t ii = 0;
+    for (; ii + 4 <= arrsize; ii += 4) {
+        uint64_t w;
+        std::memcpy(&w, arr + ii, sizeof(w));
+        hist[buckets::bucket((T)w)]++;
+        hist[buckets::bucket((T)(w >> 16))]++;
+        hist[buckets::bucket((T)(w >> 32))]++;
+        hist[buckets::bucket((T)(w >> 48))]++;
+    }
+    for (; ii < arrsize; ++ii) {
+        hist[buckets::bucket(arr[ii])]++;
+    }
+    T *dst = arr;
+    for (int32_t ii = 0; ii < (1 << 16); ii += 16) {
+        int32_t b = descending ? (1 << 16) - 16 - ii : ii;
+        __m512i counts = _mm512_loadu_si512(&hist[b]);
+        uint32_t nonzero = _mm512_test_epi32_mask(counts, counts);
+        while (nonzero) {
+            int32_t jj = descending ? 31 - __builtin_clz(nonzero)
+                                    : __builtin_ctz(nonzero);
+            nonzero &= ~(1u << jj);
+            int64_t count = hist[b + jj];
+            __m512i v = _mm512_set1_epi16(
+                    (int16_t)buckets::value((uint16_t)(b + jj)));
+            for (; count >= 32; count -= 32, dst += 32) {
+                _mm512_storeu_si512(dst, v);
+            }
+            _mm512_mask_storeu_epi16(dst, ((__mmask32)1 << count) - 1, v);
+            dst += count;
+        }
+    }
+}
+
 /*
  * Assumes zmm is random and performs a full sorting network defined in
  * https://en.wikipedia.org/wiki/Bitonic_sorter#/media/File:BitonicSort.svg
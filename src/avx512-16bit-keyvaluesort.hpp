@@ -0,0 +1,48 @@
+/*******************************************************************
+ * Copyright (C) 2023 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * ****************************************************************/
+
+#ifndef AVX512_QSORT_16BIT_KV
+#define AVX512_QSORT_16BIT_KV
+
+/*
+ * avx512_qsort_kv for int16_t and uint16_t keys, or values, paired with
+ * 16-bit, 32-bit or 64-bit values (keys). Both are sorted 8 at a time, the
+ * 16-bit side in an xmm register (AVX512VL + AVX512BW). avx512_qsort_kv_fp16
+ * sorts float16 keys stored as uint16_t the same way.
+ */
+#include "avx512-16bit-argsort.hpp"
+#include "avx512-64bit-keyvaluesort.hpp"
+
+/*
+ * NAN keys are sorted to the end with their values, descending = true sorts
+ * the other keys in descending order
+ */
+template <typename T2>
+void avx512_qsort_kv_fp16(uint16_t *keys,
+                          T2 *indexes,
+                          int64_t arrsize,
+                          bool descending = false)
+{
+    using keytype = xmm_vector<float16>;
+    using valtype = avx512_8lane_vector<T2>;
+    if (arrsize > 1) {
+        if (has_nan<zmm_vector<float16>>(keys, arrsize)) {
+            arrsize = move_nan_kv_to_end(
+                    keys, indexes, arrsize, is_a_nan<uint16_t>);
+            if (arrsize <= 1) { return; }
+        }
+        int64_t max_iters = 2 * (int64_t)log2(arrsize);
+        if (descending) {
+            qsort_64bit_<descending_vector<keytype>, valtype>(
+                    keys, indexes, 0, arrsize - 1, max_iters);
+        }
+        else {
+            qsort_64bit_<keytype, valtype>(
+                    keys, indexes, 0, arrsize - 1, max_iters);
+        }
+    }
+}
+
+#endif // AVX512_QSORT_16BIT_KV
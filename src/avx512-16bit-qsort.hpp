@@ -9,10 +9,6 @@
 
 #include "avx512-16bit-common.h"
 
-struct float16 {
-    uint16_t val;
-};
-
 template <>
 struct zmm_vector<float16> {
     using type_t = uint16_t;
@@ -74,6 +70,20 @@ struct zmm_vector<float16> {
                           exp_eq, mant_x, mant_y, _MM_CMPINT_NLT);
         return _kxor_mask32(mask_ge, neg);
     }
+    static opmask_t get_partial_loadmask(int size)
+    {
+        return ((0x1ull << size) - 0x1ull) & 0xFFFFFFFF;
+    }
+    /* only NAN's (0x01 | 0x80) are supported */
+    template <int type>
+    static opmask_t fpclass(reg_t x)
+    {
+        static_assert(type == (0x01 | 0x80), "should not reach here");
+        return _mm512_cmp_epu16_mask(
+                _mm512_and_si512(x, _mm512_set1_epi16(0x7FFF)),
+                _mm512_set1_epi16(X86_SIMD_SORT_INFINITYH),
+                _MM_CMPINT_NLE);
+    }
     static reg_t loadu(void const *mem)
     {
         return _mm512_loadu_si512(mem);
@@ -84,8 +94,25 @@ struct zmm_vector<float16> {
     }
     static void mask_compressstoreu(void *mem, opmask_t mask, reg_t x)
     {
+#ifdef __AVX512VBMI2__
         // AVX512_VBMI2
         return _mm512_mask_compressstoreu_epi16(mem, mask, x);
+#else
+        // AVX512BW
+        return avx512_emu_mask_compressstoreu16(mem, mask, x);
+#endif
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx512_double_compressstore<zmm_vector<float16>>(
+                left_addr, right_addr, k, reg);
+    }
+    static reg_t maskz_loadu(opmask_t mask, void const *mem)
+    {
+        return _mm512_maskz_loadu_epi16(mask, mem);
     }
     static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
     {
@@ -169,6 +196,169 @@ struct zmm_vector<float16> {
     }
 };
 
+/*
+ * bfloat16 is sign-magnitude: flipping the other 15 bits of the negative
+ * numbers gives an int16_t that orders like the float (-0 sorts before +0),
+ * so the comparisons are plain signed 16-bit ones. AVX512_BF16 only adds
+ * conversions and dot products, nothing that helps here.
+ */
+X86_SIMD_SORT_INLINE int16_t bf16_to_signed_order(uint16_t x)
+{
+    return x ^ (((int16_t)x >> 15) & 0x7FFF);
+}
+
+template <>
+struct zmm_vector<bfloat16> {
+    using type_t = uint16_t;
+    using reg_t = __m512i;
+    using halfreg_t = __m256i;
+    using opmask_t = __mmask32;
+    static const uint8_t numlanes = 32;
+    static constexpr int network_sort_threshold = 512;
+    static constexpr int partition_unroll_factor = 0;
+
+    static reg_t get_network(int index)
+    {
+        return _mm512_loadu_si512(&network[index - 1][0]);
+    }
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_INFINITYBF16;
+    }
+    static type_t type_min()
+    {
+        return X86_SIMD_SORT_NEGINFINITYBF16;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm512_set1_epi16(type_max());
+    }
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return _knot_mask32(x);
+    }
+    /* its own inverse */
+    static reg_t to_signed_order(reg_t x)
+    {
+        reg_t sign = _mm512_srai_epi16(x, 15);
+        return _mm512_xor_si512(
+                x, _mm512_and_si512(sign, _mm512_set1_epi16(0x7FFF)));
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        return _mm512_cmp_epi16_mask(
+                to_signed_order(x), to_signed_order(y), _MM_CMPINT_NLT);
+    }
+    static opmask_t get_partial_loadmask(int size)
+    {
+        return ((0x1ull << size) - 0x1ull) & 0xFFFFFFFF;
+    }
+    /* only NAN's (0x01 | 0x80) are supported */
+    template <int type>
+    static opmask_t fpclass(reg_t x)
+    {
+        static_assert(type == (0x01 | 0x80), "should not reach here");
+        return _mm512_cmp_epu16_mask(
+                _mm512_and_si512(x, _mm512_set1_epi16(0x7FFF)),
+                _mm512_set1_epi16(X86_SIMD_SORT_INFINITYBF16),
+                _MM_CMPINT_NLE);
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return _mm512_loadu_si512(mem);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm512_mask_mov_epi16(y, ge(x, y), x);
+    }
+    static void mask_compressstoreu(void *mem, opmask_t mask, reg_t x)
+    {
+#ifdef __AVX512VBMI2__
+        // AVX512_VBMI2
+        return _mm512_mask_compressstoreu_epi16(mem, mask, x);
+#else
+        // AVX512BW
+        return avx512_emu_mask_compressstoreu16(mem, mask, x);
+#endif
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx512_double_compressstore<zmm_vector<bfloat16>>(
+                left_addr, right_addr, k, reg);
+    }
+    static reg_t maskz_loadu(opmask_t mask, void const *mem)
+    {
+        return _mm512_maskz_loadu_epi16(mask, mem);
+    }
+    static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
+    {
+        // AVX512BW
+        return _mm512_mask_loadu_epi16(x, mask, mem);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        return _mm512_mask_mov_epi16(x, mask, y);
+    }
+    static void mask_storeu(void *mem, opmask_t mask, reg_t x)
+    {
+        return _mm512_mask_storeu_epi16(mem, mask, x);
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm512_mask_mov_epi16(x, ge(x, y), y);
+    }
+    static reg_t permutexvar(__m512i idx, reg_t zmm)
+    {
+        return _mm512_permutexvar_epi16(idx, zmm);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        reg_t x = to_signed_order(v);
+        __m512i lo = _mm512_cvtepi16_epi32(_mm512_extracti64x4_epi64(x, 0));
+        __m512i hi = _mm512_cvtepi16_epi32(_mm512_extracti64x4_epi64(x, 1));
+        int16_t ret = _mm512_reduce_max_epi32(_mm512_max_epi32(lo, hi));
+        return bf16_to_signed_order(ret);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        reg_t x = to_signed_order(v);
+        __m512i lo = _mm512_cvtepi16_epi32(_mm512_extracti64x4_epi64(x, 0));
+        __m512i hi = _mm512_cvtepi16_epi32(_mm512_extracti64x4_epi64(x, 1));
+        int16_t ret = _mm512_reduce_min_epi32(_mm512_min_epi32(lo, hi));
+        return bf16_to_signed_order(ret);
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm512_set1_epi16(v);
+    }
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t zmm)
+    {
+        zmm = _mm512_shufflehi_epi16(zmm, (_MM_PERM_ENUM)mask);
+        return _mm512_shufflelo_epi16(zmm, (_MM_PERM_ENUM)mask);
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        return _mm512_storeu_si512(mem, x);
+    }
+    static reg_t reverse(reg_t zmm)
+    {
+        const auto rev_index = get_network(4);
+        return permutexvar(rev_index, zmm);
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_zmm_16bit<zmm_vector<bfloat16>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_zmm_16bit<zmm_vector<bfloat16>>(x);
+    }
+};
+
 template <>
 struct zmm_vector<int16_t> {
     using type_t = int16_t;
@@ -178,6 +368,14 @@ struct zmm_vector<int16_t> {
     static const uint8_t numlanes = 32;
     static constexpr int network_sort_threshold = 512;
     static constexpr int partition_unroll_factor = 0;
+    static constexpr int64_t histogram_sort_threshold
+            = XSS_HISTOGRAM_SORT_THRESHOLD_16BIT;
+
+    template <bool descending = false>
+    static void histogram_sort(type_t *arr, int64_t arrsize)
+    {
+        avx512_histogram_sort_16bit<type_t, descending>(arr, arrsize);
+    }
 
     static reg_t get_network(int index)
     {
@@ -214,8 +412,31 @@ struct zmm_vector<int16_t> {
     }
     static void mask_compressstoreu(void *mem, opmask_t mask, reg_t x)
     {
+#ifdef __AVX512VBMI2__
         // AVX512_VBMI2
         return _mm512_mask_compressstoreu_epi16(mem, mask, x);
+#else
+        // AVX512BW
+        return avx512_emu_mask_compressstoreu16(mem, mask, x);
+#endif
+    }
+#ifdef __AVX512VBMI2__
+    static reg_t maskz_compress(opmask_t mask, reg_t x)
+    {
+        return _mm512_maskz_compress_epi16(mask, x);
+    }
+    static reg_t mask_expand(reg_t src, opmask_t mask, reg_t x)
+    {
+        return _mm512_mask_expand_epi16(src, mask, x);
+    }
+#endif
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx512_double_compressstore<zmm_vector<int16_t>>(
+                left_addr, right_addr, k, reg);
     }
     static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
     {
@@ -291,6 +512,14 @@ struct zmm_vector<uint16_t> {
     static const uint8_t numlanes = 32;
     static constexpr int network_sort_threshold = 512;
     static constexpr int partition_unroll_factor = 0;
+    static constexpr int64_t histogram_sort_threshold
+            = XSS_HISTOGRAM_SORT_THRESHOLD_16BIT;
+
+    template <bool descending = false>
+    static void histogram_sort(type_t *arr, int64_t arrsize)
+    {
+        avx512_histogram_sort_16bit<type_t, descending>(arr, arrsize);
+    }
 
     static reg_t get_network(int index)
     {
@@ -327,7 +556,31 @@ struct zmm_vector<uint16_t> {
     }
     static void mask_compressstoreu(void *mem, opmask_t mask, reg_t x)
     {
+#ifdef __AVX512VBMI2__
+        // AVX512_VBMI2
         return _mm512_mask_compressstoreu_epi16(mem, mask, x);
+#else
+        // AVX512BW
+        return avx512_emu_mask_compressstoreu16(mem, mask, x);
+#endif
+    }
+#ifdef __AVX512VBMI2__
+    static reg_t maskz_compress(opmask_t mask, reg_t x)
+    {
+        return _mm512_maskz_compress_epi16(mask, x);
+    }
+    static reg_t mask_expand(reg_t src, opmask_t mask, reg_t x)
+    {
+        return _mm512_mask_expand_epi16(src, mask, x);
+    }
+#endif
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx512_double_compressstore<zmm_vector<uint16_t>>(
+                left_addr, right_addr, k, reg);
     }
     static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
     {
@@ -442,13 +695,7 @@ int64_t replace_nan_with_inf<zmm_vector<float16>>(uint16_t *arr,
     return nan_count;
 }
 
-template <>
-bool is_a_nan<uint16_t>(uint16_t elem)
-{
-    return (elem & 0x7c00) == 0x7c00;
-}
-
-void avx512_qsort_fp16(uint16_t *arr, int64_t arrsize)
+inline void avx512_qsort_fp16(uint16_t *arr, int64_t arrsize)
 {
     if (arrsize > 1) {
         int64_t nan_count = replace_nan_with_inf<zmm_vector<float16>, uint16_t>(
@@ -459,7 +706,10 @@ void avx512_qsort_fp16(uint16_t *arr, int64_t arrsize)
     }
 }
 
-void avx512_qselect_fp16(uint16_t *arr, int64_t k, int64_t arrsize, bool hasnan)
+inline void avx512_qselect_fp16(uint16_t *arr,
+                                int64_t k,
+                                int64_t arrsize,
+                                bool hasnan = false)
 {
     int64_t indx_last_elem = arrsize - 1;
     if (UNLIKELY(hasnan)) {
@@ -470,4 +720,57 @@ void avx512_qselect_fp16(uint16_t *arr, int64_t k, int64_t arrsize, bool hasnan)
                 arr, k, 0, indx_last_elem, 2 * (int64_t)log2(indx_last_elem));
     }
 }
+
+inline void avx512_partial_qsort_fp16(uint16_t *arr,
+                                      int64_t k,
+                                      int64_t arrsize,
+                                      bool hasnan = false)
+{
+    avx512_qselect_fp16(arr, k - 1, arrsize, hasnan);
+    avx512_qsort_fp16(arr, k - 1);
+}
+
+template <>
+bool comparison_func<zmm_vector<bfloat16>>(const uint16_t &a,
+                                           const uint16_t &b)
+{
+    return bf16_to_signed_order(a) < bf16_to_signed_order(b);
+}
+
+/* bfloat16 stored as uint16_t, NAN's are sorted to the end */
+inline void avx512_qsort_bf16(uint16_t *arr, int64_t arrsize)
+{
+    if (arrsize > 1) {
+        int64_t nan_count = replace_nan_with_inf<zmm_vector<bfloat16>>(
+                arr, arrsize);
+        qsort_<zmm_vector<bfloat16>, uint16_t>(
+                arr, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+        replace_inf_with_nan(arr, arrsize, nan_count);
+    }
+}
+
+inline void avx512_qselect_bf16(uint16_t *arr,
+                                int64_t k,
+                                int64_t arrsize,
+                                bool hasnan = false)
+{
+    int64_t indx_last_elem = arrsize - 1;
+    if (UNLIKELY(hasnan)) {
+        indx_last_elem
+                = move_nans_to_end_of_array(arr, arrsize, is_a_nan_bf16);
+    }
+    if (indx_last_elem >= k) {
+        qselect_<zmm_vector<bfloat16>, uint16_t>(
+                arr, k, 0, indx_last_elem, 2 * (int64_t)log2(indx_last_elem));
+    }
+}
+
+inline void avx512_partial_qsort_bf16(uint16_t *arr,
+                                      int64_t k,
+                                      int64_t arrsize,
+                                      bool hasnan = false)
+{
+    avx512_qselect_bf16(arr, k - 1, arrsize, hasnan);
+    avx512_qsort_bf16(arr, k - 1);
+}
 #endif // AVX512_QSORT_16BIT
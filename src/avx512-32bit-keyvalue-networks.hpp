@@ -0,0 +1,117 @@
+#ifndef AVX512_32BIT_KEYVALUE_NETWORKS
+#define AVX512_32BIT_KEYVALUE_NETWORKS
+
+/*
+ * 16 pairs of 32-bit keys and 32-bit values. Same network as sort_zmm_32bit
+ * and bitonic_merge_zmm_32bit in avx512-32bit-qsort.hpp, with every shuffle
+ * and permute applied to the values as well.
+ */
+template <typename vtype1,
+          typename vtype2,
+          typename reg_t = typename vtype1::reg_t,
+          typename index_type = typename vtype2::reg_t>
+X86_SIMD_SORT_INLINE reg_t sort_zmm_32bit(reg_t key_zmm, index_type &index_zmm)
+{
+    key_zmm = cmp_merge<vtype1, vtype2>(
+            key_zmm,
+            vtype1::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(key_zmm),
+            index_zmm,
+            vtype2::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(index_zmm),
+            0xAAAA);
+    key_zmm = cmp_merge<vtype1, vtype2>(
+            key_zmm,
+            vtype1::template shuffle<SHUFFLE_MASK(0, 1, 2, 3)>(key_zmm),
+            index_zmm,
+            vtype2::template shuffle<SHUFFLE_MASK(0, 1, 2, 3)>(index_zmm),
+            0xCCCC);
+    key_zmm = cmp_merge<vtype1, vtype2>(
+            key_zmm,
+            vtype1::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(key_zmm),
+            index_zmm,
+            vtype2::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(index_zmm),
+            0xAAAA);
+    key_zmm = cmp_merge<vtype1, vtype2>(
+            key_zmm,
+            vtype1::permutexvar(_mm512_set_epi32(NETWORK_32BIT_3), key_zmm),
+            index_zmm,
+            vtype2::permutexvar(_mm512_set_epi32(NETWORK_32BIT_3), index_zmm),
+            0xF0F0);
+    key_zmm = cmp_merge<vtype1, vtype2>(
+            key_zmm,
+            vtype1::template shuffle<SHUFFLE_MASK(1, 0, 3, 2)>(key_zmm),
+            index_zmm,
+            vtype2::template shuffle<SHUFFLE_MASK(1, 0, 3, 2)>(index_zmm),
+            0xCCCC);
+    key_zmm = cmp_merge<vtype1, vtype2>(
+            key_zmm,
+            vtype1::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(key_zmm),
+            index_zmm,
+            vtype2::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(index_zmm),
+            0xAAAA);
+    key_zmm = cmp_merge<vtype1, vtype2>(
+            key_zmm,
+            vtype1::permutexvar(_mm512_set_epi32(NETWORK_32BIT_5), key_zmm),
+            index_zmm,
+            vtype2::permutexvar(_mm512_set_epi32(NETWORK_32BIT_5), index_zmm),
+            0xFF00);
+    key_zmm = cmp_merge<vtype1, vtype2>(
+            key_zmm,
+            vtype1::permutexvar(_mm512_set_epi32(NETWORK_32BIT_6), key_zmm),
+            index_zmm,
+            vtype2::permutexvar(_mm512_set_epi32(NETWORK_32BIT_6), index_zmm),
+            0xF0F0);
+    key_zmm = cmp_merge<vtype1, vtype2>(
+            key_zmm,
+            vtype1::template shuffle<SHUFFLE_MASK(1, 0, 3, 2)>(key_zmm),
+            index_zmm,
+            vtype2::template shuffle<SHUFFLE_MASK(1, 0, 3, 2)>(index_zmm),
+            0xCCCC);
+    key_zmm = cmp_merge<vtype1, vtype2>(
+            key_zmm,
+            vtype1::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(key_zmm),
+            index_zmm,
+            vtype2::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(index_zmm),
+            0xAAAA);
+    return key_zmm;
+}
+
+// Assumes zmm is bitonic and performs a recursive half cleaner
+template <typename vtype1,
+          typename vtype2,
+          typename reg_t = typename vtype1::reg_t,
+          typename index_type = typename vtype2::reg_t>
+X86_SIMD_SORT_INLINE reg_t bitonic_merge_zmm_32bit(reg_t key_zmm,
+                                                   index_type &index_zmm)
+{
+    // 1) half_cleaner[16]: compare 1-9, 2-10, 3-11 etc ..
+    key_zmm = cmp_merge<vtype1, vtype2>(
+            key_zmm,
+            vtype1::permutexvar(_mm512_set_epi32(NETWORK_32BIT_7), key_zmm),
+            index_zmm,
+            vtype2::permutexvar(_mm512_set_epi32(NETWORK_32BIT_7), index_zmm),
+            0xFF00);
+    // 2) half_cleaner[8]: compare 1-5, 2-6, 3-7 etc ..
+    key_zmm = cmp_merge<vtype1, vtype2>(
+            key_zmm,
+            vtype1::permutexvar(_mm512_set_epi32(NETWORK_32BIT_6), key_zmm),
+            index_zmm,
+            vtype2::permutexvar(_mm512_set_epi32(NETWORK_32BIT_6), index_zmm),
+            0xF0F0);
+    // 3) half_cleaner[4]
+    key_zmm = cmp_merge<vtype1, vtype2>(
+            key_zmm,
+            vtype1::template shuffle<SHUFFLE_MASK(1, 0, 3, 2)>(key_zmm),
+            index_zmm,
+            vtype2::template shuffle<SHUFFLE_MASK(1, 0, 3, 2)>(index_zmm),
+            0xCCCC);
+    // 3) half_cleaner[1]
+    key_zmm = cmp_merge<vtype1, vtype2>(
+            key_zmm,
+            vtype1::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(key_zmm),
+            index_zmm,
+            vtype2::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(index_zmm),
+            0xAAAA);
+    return key_zmm;
+}
+
+#endif // AVX512_32BIT_KEYVALUE_NETWORKS
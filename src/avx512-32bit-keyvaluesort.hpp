@@ -0,0 +1,18 @@
+/*******************************************************************
+ * Copyright (C) 2023 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * ****************************************************************/
+
+#ifndef AVX512_QSORT_32BIT_KV
+#define AVX512_QSORT_32BIT_KV
+
+/*
+ * avx512_qsort_kv for uint32_t, int32_t and float keys with 32-bit values:
+ * a register holds 16 key-value pairs, twice as many as with 64-bit keys and
+ * values.
+ */
+#include "avx512-32bit-qsort.hpp"
+#include "avx512-32bit-keyvalue-networks.hpp"
+#include "avx512-common-keyvaluesort.h"
+
+#endif // AVX512_QSORT_32BIT_KV
@@ -8,7 +8,7 @@
 #ifndef AVX512_QSORT_32BIT
 #define AVX512_QSORT_32BIT
 
-#include "avx512-common-qsort.h"
+#include "avx512-64bit-common.h"
 #include "xss-network-qsort.hpp"
 
 /*
@@ -61,6 +61,10 @@ struct zmm_vector<int32_t> {
     {
         return _mm512_cmp_epi32_mask(x, y, _MM_CMPINT_NLT);
     }
+    static opmask_t eq(reg_t x, reg_t y)
+    {
+        return _mm512_cmp_epi32_mask(x, y, _MM_CMPINT_EQ);
+    }
     template <int scale>
     static halfreg_t i64gather(__m512i index, void const *base)
     {
@@ -79,6 +83,22 @@ struct zmm_vector<int32_t> {
     {
         return _mm512_mask_compressstoreu_epi32(mem, mask, x);
     }
+    static reg_t maskz_compress(opmask_t mask, reg_t x)
+    {
+        return _mm512_maskz_compress_epi32(mask, x);
+    }
+    static reg_t mask_expand(reg_t src, opmask_t mask, reg_t x)
+    {
+        return _mm512_mask_expand_epi32(src, mask, x);
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx512_double_compressstore<zmm_vector<int32_t>>(
+                left_addr, right_addr, k, reg);
+    }
     static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
     {
         return _mm512_mask_loadu_epi32(x, mask, mem);
@@ -188,6 +208,10 @@ struct zmm_vector<uint32_t> {
     {
         return _mm512_cmp_epu32_mask(x, y, _MM_CMPINT_NLT);
     }
+    static opmask_t eq(reg_t x, reg_t y)
+    {
+        return _mm512_cmp_epu32_mask(x, y, _MM_CMPINT_EQ);
+    }
     static reg_t loadu(void const *mem)
     {
         return _mm512_loadu_si512(mem);
@@ -200,6 +224,22 @@ struct zmm_vector<uint32_t> {
     {
         return _mm512_mask_compressstoreu_epi32(mem, mask, x);
     }
+    static reg_t maskz_compress(opmask_t mask, reg_t x)
+    {
+        return _mm512_maskz_compress_epi32(mask, x);
+    }
+    static reg_t mask_expand(reg_t src, opmask_t mask, reg_t x)
+    {
+        return _mm512_mask_expand_epi32(src, mask, x);
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx512_double_compressstore<zmm_vector<uint32_t>>(
+                left_addr, right_addr, k, reg);
+    }
     static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
     {
         return _mm512_mask_loadu_epi32(x, mask, mem);
@@ -268,6 +308,7 @@ template <>
 struct zmm_vector<float> {
     using type_t = float;
     using reg_t = __m512;
+    using zmmi_t = __m512i;
     using halfreg_t = __m256;
     using opmask_t = __mmask16;
     static const uint8_t numlanes = 16;
@@ -295,6 +336,10 @@ struct zmm_vector<float> {
     {
         return _mm512_cmp_ps_mask(x, y, _CMP_GE_OQ);
     }
+    static opmask_t eq(reg_t x, reg_t y)
+    {
+        return _mm512_cmp_ps_mask(x, y, _CMP_EQ_OQ);
+    }
     static opmask_t get_partial_loadmask(int size)
     {
         return (0x0001 << size) - 0x0001;
@@ -327,6 +372,22 @@ struct zmm_vector<float> {
     {
         return _mm512_mask_compressstoreu_ps(mem, mask, x);
     }
+    static reg_t maskz_compress(opmask_t mask, reg_t x)
+    {
+        return _mm512_maskz_compress_ps(mask, x);
+    }
+    static reg_t mask_expand(reg_t src, opmask_t mask, reg_t x)
+    {
+        return _mm512_mask_expand_ps(src, mask, x);
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx512_double_compressstore<zmm_vector<float>>(
+                left_addr, right_addr, k, reg);
+    }
     static reg_t maskz_loadu(opmask_t mask, void const *mem)
     {
         return _mm512_maskz_loadu_ps(mask, mem);
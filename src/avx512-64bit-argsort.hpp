@@ -11,393 +11,333 @@
 #include "avx512-64bit-keyvalue-networks.hpp"
 #include "avx512-common-argsort.h"
 
-template <typename T>
-void std_argselect_withnan(
-        T *arr, int64_t *arg, int64_t k, int64_t left, int64_t right)
+template <typename vectype,
+          typename argtype = zmm_vector<int64_t>,
+          typename T>
+X86_SIMD_SORT_INLINE void xss_argsort(T *arr, int64_t *arg, int64_t arrsize)
 {
-    std::nth_element(arg + left,
-                     arg + k,
-                     arg + right,
-                     [arr](int64_t a, int64_t b) -> bool {
-                         if ((!std::isnan(arr[a])) && (!std::isnan(arr[b]))) {
-                             return arr[a] < arr[b];
-                         }
-                         else if (std::isnan(arr[a])) {
-                             return false;
-                         }
-                         else {
-                             return true;
-                         }
-                     });
+    if (arrsize > 1) {
+        if constexpr (std::is_floating_point_v<T>) {
+            if (has_nan<vectype>(arr, arrsize)) {
+                std_argsort_withnan<xss_is_descending<vectype>::value>(
+                        arr, arg, 0, arrsize);
+                return;
+            }
+        }
+        argsort_64bit_<vectype, argtype>(
+                arr, arg, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+    }
 }
 
-/* argsort using std::sort */
-template <typename T>
-void std_argsort_withnan(T *arr, int64_t *arg, int64_t left, int64_t right)
+template <typename vectype,
+          typename argtype = zmm_vector<int64_t>,
+          typename T>
+X86_SIMD_SORT_INLINE void
+xss_argselect(T *arr, int64_t *arg, int64_t k, int64_t arrsize)
 {
-    std::sort(arg + left,
-              arg + right,
-              [arr](int64_t left, int64_t right) -> bool {
-                  if ((!std::isnan(arr[left])) && (!std::isnan(arr[right]))) {
-                      return arr[left] < arr[right];
-                  }
-                  else if (std::isnan(arr[left])) {
-                      return false;
-                  }
-                  else {
-                      return true;
-                  }
-              });
+    if (arrsize > 1) {
+        if constexpr (std::is_floating_point_v<T>) {
+            if (has_nan<vectype>(arr, arrsize)) {
+                std_argselect_withnan<xss_is_descending<vectype>::value>(
+                        arr, arg, k, 0, arrsize);
+                return;
+            }
+        }
+        argselect_64bit_<vectype, argtype>(
+                arr, arg, k, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+    }
 }
 
-/* argsort using std::sort */
+/*
+ * Keys of the 256-bit argsort: a ymm register holds 4 indices, so 4 keys are
+ * gathered at a time, 32-bit ones into a xmm register.
+ */
 template <typename T>
-void std_argsort(T *arr, int64_t *arg, int64_t left, int64_t right)
-{
-    std::sort(arg + left,
-              arg + right,
-              [arr](int64_t left, int64_t right) -> bool {
-                  // sort indices according to corresponding array element
-                  return arr[left] < arr[right];
-              });
-}
+using avx512vl_arg_vector =
+        typename std::conditional<sizeof(T) == sizeof(int32_t),
+                                  xmm_vector<T>,
+                                  ymm_vector<T>>::type;
 
-template <typename vtype, typename type_t>
-X86_SIMD_SORT_INLINE void argsort_8_64bit(type_t *arr, int64_t *arg, int32_t N)
+/* See xss_avx512_qsort for XSS_AVX512_YMM_THRESHOLD */
+template <typename T, bool descending>
+X86_SIMD_SORT_INLINE void
+xss_avx512_argsort(T *arr, int64_t *arg, int64_t arrsize)
 {
-    using reg_t = typename vtype::reg_t;
-    typename vtype::opmask_t load_mask = (0x01 << N) - 0x01;
-    argzmm_t argzmm = argtype::maskz_loadu(load_mask, arg);
-    reg_t arrzmm = vtype::template mask_i64gather<sizeof(type_t)>(
-            vtype::zmm_max(), load_mask, argzmm, arr);
-    arrzmm = sort_zmm_64bit<vtype, argtype>(arrzmm, argzmm);
-    argtype::mask_storeu(arg, load_mask, argzmm);
+    if constexpr (xss_avx512_ymm_enabled<T>()) {
+        if (arrsize <= XSS_AVX512_YMM_THRESHOLD) {
+            xss_argsort<xss_order_vector<avx512vl_arg_vector<T>, descending>,
+                        ymm_vector<int64_t>>(arr, arg, arrsize);
+            return;
+        }
+    }
+    xss_argsort<xss_order_vector<avx512_8lane_vector<T>, descending>>(
+            arr, arg, arrsize);
 }
 
-template <typename vtype, typename type_t>
-X86_SIMD_SORT_INLINE void argsort_16_64bit(type_t *arr, int64_t *arg, int32_t N)
+template <typename T, bool descending>
+X86_SIMD_SORT_INLINE void
+xss_avx512_argselect(T *arr, int64_t *arg, int64_t k, int64_t arrsize)
 {
-    if (N <= 8) {
-        argsort_8_64bit<vtype>(arr, arg, N);
-        return;
+    if constexpr (xss_avx512_ymm_enabled<T>()) {
+        if (arrsize <= XSS_AVX512_YMM_THRESHOLD) {
+            xss_argselect<
+                    xss_order_vector<avx512vl_arg_vector<T>, descending>,
+                    ymm_vector<int64_t>>(arr, arg, k, arrsize);
+            return;
+        }
     }
-    using reg_t = typename vtype::reg_t;
-    typename vtype::opmask_t load_mask = (0x01 << (N - 8)) - 0x01;
-    argzmm_t argzmm1 = argtype::loadu(arg);
-    argzmm_t argzmm2 = argtype::maskz_loadu(load_mask, arg + 8);
-    reg_t arrzmm1 = vtype::template i64gather<sizeof(type_t)>(argzmm1, arr);
-    reg_t arrzmm2 = vtype::template mask_i64gather<sizeof(type_t)>(
-            vtype::zmm_max(), load_mask, argzmm2, arr);
-    arrzmm1 = sort_zmm_64bit<vtype, argtype>(arrzmm1, argzmm1);
-    arrzmm2 = sort_zmm_64bit<vtype, argtype>(arrzmm2, argzmm2);
-    bitonic_merge_two_zmm_64bit<vtype, argtype>(
-            arrzmm1, arrzmm2, argzmm1, argzmm2);
-    argtype::storeu(arg, argzmm1);
-    argtype::mask_storeu(arg + 8, load_mask, argzmm2);
+    xss_argselect<xss_order_vector<avx512_8lane_vector<T>, descending>>(
+            arr, arg, k, arrsize);
 }
 
-template <typename vtype, typename type_t>
-X86_SIMD_SORT_INLINE void argsort_32_64bit(type_t *arr, int64_t *arg, int32_t N)
+/*
+ * argsort methods for 32-bit and 64-bit dtypes, and 16-bit integers with
+ * avx512-16bit-argsort.hpp. descending = true sorts in descending order, the
+ * indices of NAN's still go to the end.
+ */
+template <typename T>
+void avx512_argsort(T *arr,
+                    int64_t *arg,
+                    int64_t arrsize,
+                    bool descending = false)
 {
-    if (N <= 16) {
-        argsort_16_64bit<vtype>(arr, arg, N);
-        return;
-    }
-    using reg_t = typename vtype::reg_t;
-    using opmask_t = typename vtype::opmask_t;
-    reg_t arrzmm[4];
-    argzmm_t argzmm[4];
-
-X86_SIMD_SORT_UNROLL_LOOP(2)
-    for (int ii = 0; ii < 2; ++ii) {
-        argzmm[ii] = argtype::loadu(arg + 8 * ii);
-        arrzmm[ii] = vtype::template i64gather<sizeof(type_t)>(argzmm[ii], arr);
-        arrzmm[ii] = sort_zmm_64bit<vtype, argtype>(arrzmm[ii], argzmm[ii]);
-    }
-
-    uint64_t combined_mask = (0x1ull << (N - 16)) - 0x1ull;
-    opmask_t load_mask[2] = {0xFF, 0xFF};
-X86_SIMD_SORT_UNROLL_LOOP(2)
-    for (int ii = 0; ii < 2; ++ii) {
-        load_mask[ii] = (combined_mask >> (ii * 8)) & 0xFF;
-        argzmm[ii + 2] = argtype::maskz_loadu(load_mask[ii], arg + 16 + 8 * ii);
-        arrzmm[ii + 2] = vtype::template mask_i64gather<sizeof(type_t)>(
-                vtype::zmm_max(), load_mask[ii], argzmm[ii + 2], arr);
-        arrzmm[ii + 2] = sort_zmm_64bit<vtype, argtype>(arrzmm[ii + 2],
-                                                        argzmm[ii + 2]);
+    if (descending) { xss_avx512_argsort<T, true>(arr, arg, arrsize); }
+    else {
+        xss_avx512_argsort<T, false>(arr, arg, arrsize);
     }
+}
 
-    bitonic_merge_two_zmm_64bit<vtype, argtype>(
-            arrzmm[0], arrzmm[1], argzmm[0], argzmm[1]);
-    bitonic_merge_two_zmm_64bit<vtype, argtype>(
-            arrzmm[2], arrzmm[3], argzmm[2], argzmm[3]);
-    bitonic_merge_four_zmm_64bit<vtype, argtype>(arrzmm, argzmm);
-
-    argtype::storeu(arg, argzmm[0]);
-    argtype::storeu(arg + 8, argzmm[1]);
-    argtype::mask_storeu(arg + 16, load_mask[0], argzmm[2]);
-    argtype::mask_storeu(arg + 24, load_mask[1], argzmm[3]);
+template <typename T>
+std::vector<int64_t>
+avx512_argsort(T *arr, int64_t arrsize, bool descending = false)
+{
+    std::vector<int64_t> indices(arrsize);
+    std::iota(indices.begin(), indices.end(), 0);
+    avx512_argsort<T>(arr, indices.data(), arrsize, descending);
+    return indices;
 }
 
-template <typename vtype, typename type_t>
-X86_SIMD_SORT_INLINE void argsort_64_64bit(type_t *arr, int64_t *arg, int32_t N)
+/* argselect methods, same dtypes as argsort */
+template <typename T>
+void avx512_argselect(T *arr,
+                      int64_t *arg,
+                      int64_t k,
+                      int64_t arrsize,
+                      bool descending = false)
 {
-    if (N <= 32) {
-        argsort_32_64bit<vtype>(arr, arg, N);
-        return;
+    if (descending) {
+        xss_avx512_argselect<T, true>(arr, arg, k, arrsize);
     }
-    using reg_t = typename vtype::reg_t;
-    using opmask_t = typename vtype::opmask_t;
-    reg_t arrzmm[8];
-    argzmm_t argzmm[8];
-
-X86_SIMD_SORT_UNROLL_LOOP(4)
-    for (int ii = 0; ii < 4; ++ii) {
-        argzmm[ii] = argtype::loadu(arg + 8 * ii);
-        arrzmm[ii] = vtype::template i64gather<sizeof(type_t)>(argzmm[ii], arr);
-        arrzmm[ii] = sort_zmm_64bit<vtype, argtype>(arrzmm[ii], argzmm[ii]);
+    else {
+        xss_avx512_argselect<T, false>(arr, arg, k, arrsize);
     }
+}
 
-    opmask_t load_mask[4] = {0xFF, 0xFF, 0xFF, 0xFF};
-    uint64_t combined_mask = (0x1ull << (N - 32)) - 0x1ull;
-X86_SIMD_SORT_UNROLL_LOOP(4)
-    for (int ii = 0; ii < 4; ++ii) {
-        load_mask[ii] = (combined_mask >> (ii * 8)) & 0xFF;
-        argzmm[ii + 4] = argtype::maskz_loadu(load_mask[ii], arg + 32 + 8 * ii);
-        arrzmm[ii + 4] = vtype::template mask_i64gather<sizeof(type_t)>(
-                vtype::zmm_max(), load_mask[ii], argzmm[ii + 4], arr);
-        arrzmm[ii + 4] = sort_zmm_64bit<vtype, argtype>(arrzmm[ii + 4],
-                                                        argzmm[ii + 4]);
-    }
+template <typename T>
+std::vector<int64_t> avx512_argselect(T *arr,
+                                      int64_t k,
+                                      int64_t arrsize,
+                                      bool descending = false)
+{
+    std::vector<int64_t> indices(arrsize);
+    std::iota(indices.begin(), indices.end(), 0);
+    avx512_argselect<T>(arr, indices.data(), k, arrsize, descending);
+    return indices;
+}
 
-X86_SIMD_SORT_UNROLL_LOOP(4)
-    for (int ii = 0; ii < 8; ii = ii + 2) {
-        bitonic_merge_two_zmm_64bit<vtype, argtype>(
-                arrzmm[ii], arrzmm[ii + 1], argzmm[ii], argzmm[ii + 1]);
-    }
-    bitonic_merge_four_zmm_64bit<vtype, argtype>(arrzmm, argzmm);
-    bitonic_merge_four_zmm_64bit<vtype, argtype>(arrzmm + 4, argzmm + 4);
-    bitonic_merge_eight_zmm_64bit<vtype, argtype>(arrzmm, argzmm);
+/*
+ * 256-bit argsort and argselect for 32-bit and 64-bit dtypes, on ymm
+ * registers with AVX-512VL opmasks like avx512vl_qsort
+ */
+template <typename T>
+void avx512vl_argsort(T *arr, int64_t *arg, int64_t arrsize)
+{
+    xss_argsort<avx512vl_arg_vector<T>, ymm_vector<int64_t>>(
+            arr, arg, arrsize);
+}
 
-X86_SIMD_SORT_UNROLL_LOOP(4)
-    for (int ii = 0; ii < 4; ++ii) {
-        argtype::storeu(arg + 8 * ii, argzmm[ii]);
-    }
-X86_SIMD_SORT_UNROLL_LOOP(4)
-    for (int ii = 0; ii < 4; ++ii) {
-        argtype::mask_storeu(arg + 32 + 8 * ii, load_mask[ii], argzmm[ii + 4]);
-    }
+template <typename T>
+std::vector<int64_t> avx512vl_argsort(T *arr, int64_t arrsize)
+{
+    std::vector<int64_t> indices(arrsize);
+    std::iota(indices.begin(), indices.end(), 0);
+    avx512vl_argsort<T>(arr, indices.data(), arrsize);
+    return indices;
 }
 
-/* arsort 128 doesn't seem to make much of a difference to perf*/
-//template <typename vtype, typename type_t>
-//X86_SIMD_SORT_INLINE void
-//argsort_128_64bit(type_t *arr, int64_t *arg, int32_t N)
-//{
-//    if (N <= 64) {
-//        argsort_64_64bit<vtype>(arr, arg, N);
-//        return;
-//    }
-//    using reg_t = typename vtype::reg_t;
-//    using opmask_t = typename vtype::opmask_t;
-//    reg_t arrzmm[16];
-//    argzmm_t argzmm[16];
-//
-//X86_SIMD_SORT_UNROLL_LOOP(8)
-//    for (int ii = 0; ii < 8; ++ii) {
-//        argzmm[ii] = argtype::loadu(arg + 8*ii);
-//        arrzmm[ii] = vtype::template i64gather<sizeof(type_t)>(argzmm[ii], arr);
-//        arrzmm[ii] = sort_zmm_64bit<vtype, argtype>(arrzmm[ii], argzmm[ii]);
-//    }
-//
-//    opmask_t load_mask[8] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
-//    if (N != 128) {
-//    uint64_t combined_mask = (0x1ull << (N - 64)) - 0x1ull;
-//X86_SIMD_SORT_UNROLL_LOOP(8)
-//        for (int ii = 0; ii < 8; ++ii) {
-//            load_mask[ii] = (combined_mask >> (ii*8)) & 0xFF;
-//        }
-//    }
-//X86_SIMD_SORT_UNROLL_LOOP(8)
-//    for (int ii = 0; ii < 8; ++ii) {
-//        argzmm[ii+8] = argtype::maskz_loadu(load_mask[ii], arg + 64 + 8*ii);
-//        arrzmm[ii+8] = vtype::template mask_i64gather<sizeof(type_t)>(vtype::zmm_max(), load_mask[ii], argzmm[ii+8], arr);
-//        arrzmm[ii+8] = sort_zmm_64bit<vtype, argtype>(arrzmm[ii+8], argzmm[ii+8]);
-//    }
-//
-//X86_SIMD_SORT_UNROLL_LOOP(8)
-//    for (int ii = 0; ii < 16; ii = ii + 2) {
-//        bitonic_merge_two_zmm_64bit<vtype, argtype>(arrzmm[ii], arrzmm[ii + 1], argzmm[ii], argzmm[ii + 1]);
-//    }
-//    bitonic_merge_four_zmm_64bit<vtype, argtype>(arrzmm, argzmm);
-//    bitonic_merge_four_zmm_64bit<vtype, argtype>(arrzmm + 4, argzmm + 4);
-//    bitonic_merge_four_zmm_64bit<vtype, argtype>(arrzmm + 8, argzmm + 8);
-//    bitonic_merge_four_zmm_64bit<vtype, argtype>(arrzmm + 12, argzmm + 12);
-//    bitonic_merge_eight_zmm_64bit<vtype, argtype>(arrzmm, argzmm);
-//    bitonic_merge_eight_zmm_64bit<vtype, argtype>(arrzmm+8, argzmm+8);
-//    bitonic_merge_sixteen_zmm_64bit<vtype, argtype>(arrzmm, argzmm);
-//
-//X86_SIMD_SORT_UNROLL_LOOP(8)
-//    for (int ii = 0; ii < 8; ++ii) {
-//        argtype::storeu(arg + 8*ii, argzmm[ii]);
-//    }
-//X86_SIMD_SORT_UNROLL_LOOP(8)
-//    for (int ii = 0; ii < 8; ++ii) {
-//        argtype::mask_storeu(arg + 64 + 8*ii, load_mask[ii], argzmm[ii + 8]);
-//    }
-//}
+template <typename T>
+void avx512vl_argselect(T *arr, int64_t *arg, int64_t k, int64_t arrsize)
+{
+    xss_argselect<avx512vl_arg_vector<T>, ymm_vector<int64_t>>(
+            arr, arg, k, arrsize);
+}
 
-template <typename vtype, typename type_t>
-type_t get_pivot_64bit(type_t *arr,
-                       int64_t *arg,
-                       const int64_t left,
-                       const int64_t right)
+template <typename T>
+std::vector<int64_t> avx512vl_argselect(T *arr, int64_t k, int64_t arrsize)
 {
-    if (right - left >= vtype::numlanes) {
-        // median of 8
-        int64_t size = (right - left) / 8;
-        using reg_t = typename vtype::reg_t;
-        // TODO: Use gather here too:
-        __m512i rand_index = _mm512_set_epi64(arg[left + size],
-                                              arg[left + 2 * size],
-                                              arg[left + 3 * size],
-                                              arg[left + 4 * size],
-                                              arg[left + 5 * size],
-                                              arg[left + 6 * size],
-                                              arg[left + 7 * size],
-                                              arg[left + 8 * size]);
-        reg_t rand_vec
-                = vtype::template i64gather<sizeof(type_t)>(rand_index, arr);
-        // pivot will never be a nan, since there are no nan's!
-        reg_t sort = sort_zmm_64bit<vtype>(rand_vec);
-        return ((type_t *)&sort)[4];
-    }
-    else {
-        return arr[arg[right]];
-    }
+    std::vector<int64_t> indices(arrsize);
+    std::iota(indices.begin(), indices.end(), 0);
+    avx512vl_argselect<T>(arr, indices.data(), k, arrsize);
+    return indices;
 }
 
-template <typename vtype, typename type_t>
-inline void argsort_64bit_(type_t *arr,
-                           int64_t *arg,
-                           int64_t left,
-                           int64_t right,
-                           int64_t max_iters)
+/*
+ * Writes the indices of the valid values to valid_args and the others to
+ * null_args, both in increasing order: each byte of the validity bitmap is
+ * the opmask that compresses 8 indices to one side or the other.
+ */
+X86_SIMD_SORT_INLINE void split_null_args(const uint8_t *validity,
+                                          int64_t arrsize,
+                                          int64_t *valid_args,
+                                          int64_t *null_args)
 {
-    /*
-     * Resort to std::sort if quicksort isnt making any progress
-     */
-    if (max_iters <= 0) {
-        std_argsort(arr, arg, left, right + 1);
-        return;
-    }
-    /*
-     * Base case: use bitonic networks to sort arrays <= 64
-     */
-    if (right + 1 - left <= 64) {
-        argsort_64_64bit<vtype>(arr, arg + left, (int32_t)(right + 1 - left));
-        return;
+    using vtype = zmm_vector<int64_t>;
+    const __m512i eight = _mm512_set1_epi64(8);
+    __m512i index = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+    for (int64_t ii = 0; ii < arrsize; ii += 8) {
+        int64_t num = std::min<int64_t>(8, arrsize - ii);
+        __mmask8 valid = get_validity_mask<vtype>(validity, ii, num);
+        __mmask8 null = (__mmask8)(~valid & (0xFF >> (8 - num)));
+        vtype::mask_compressstoreu(valid_args, valid, index);
+        vtype::mask_compressstoreu(null_args, null, index);
+        valid_args += _mm_popcnt_u32(valid);
+        null_args += _mm_popcnt_u32(null);
+        index = _mm512_add_epi64(index, eight);
     }
-    type_t pivot = get_pivot_64bit<vtype>(arr, arg, left, right);
-    type_t smallest = vtype::type_max();
-    type_t biggest = vtype::type_min();
-    int64_t pivot_index = partition_avx512_unrolled<vtype, 4>(
-            arr, arg, left, right + 1, pivot, &smallest, &biggest);
-    if (pivot != smallest)
-        argsort_64bit_<vtype>(arr, arg, left, pivot_index - 1, max_iters - 1);
-    if (pivot != biggest)
-        argsort_64bit_<vtype>(arr, arg, pivot_index, right, max_iters - 1);
 }
 
+/* has_nan, but only looks at the valid values */
 template <typename vtype, typename type_t>
-static void argselect_64bit_(type_t *arr,
-                             int64_t *arg,
-                             int64_t pos,
-                             int64_t left,
-                             int64_t right,
-                             int64_t max_iters)
+X86_SIMD_SORT_INLINE bool
+has_valid_nan(type_t *arr, const uint8_t *validity, int64_t arrsize)
 {
-    /*
-     * Resort to std::sort if quicksort isnt making any progress
-     */
-    if (max_iters <= 0) {
-        std_argsort(arr, arg, left, right + 1);
-        return;
+    for (int64_t ii = 0; ii < arrsize; ii += vtype::numlanes) {
+        int64_t num = std::min<int64_t>(vtype::numlanes, arrsize - ii);
+        auto valid = get_validity_mask<vtype>(validity, ii, num);
+        auto in = vtype::maskz_loadu(valid, arr + ii);
+        if (vtype::template fpclass<0x01 | 0x80>(in) & valid) { return true; }
     }
-    /*
-     * Base case: use bitonic networks to sort arrays <= 64
-     */
-    if (right + 1 - left <= 64) {
-        argsort_64_64bit<vtype>(arr, arg + left, (int32_t)(right + 1 - left));
-        return;
-    }
-    type_t pivot = get_pivot_64bit<vtype>(arr, arg, left, right);
-    type_t smallest = vtype::type_max();
-    type_t biggest = vtype::type_min();
-    int64_t pivot_index = partition_avx512_unrolled<vtype, 4>(
-            arr, arg, left, right + 1, pivot, &smallest, &biggest);
-    if ((pivot != smallest) && (pos < pivot_index))
-        argselect_64bit_<vtype>(
-                arr, arg, pos, left, pivot_index - 1, max_iters - 1);
-    else if ((pivot != biggest) && (pos >= pivot_index))
-        argselect_64bit_<vtype>(
-                arr, arg, pos, pivot_index, right, max_iters - 1);
+    return false;
 }
 
-/* argsort methods for 32-bit and 64-bit dtypes */
+/*
+ * argsort of a nullable column with an Arrow style validity bitmap (see
+ * get_validity_mask): arg gets the indices of the nulls, in increasing order,
+ * before (nulls_first) or after the indices that sort the valid values. arg
+ * doesn't have to be initialized. Returns the number of valid values.
+ */
 template <typename T>
-void avx512_argsort(T *arr, int64_t *arg, int64_t arrsize)
+int64_t avx512_argsort(T *arr,
+                       int64_t *arg,
+                       const uint8_t *validity,
+                       int64_t arrsize,
+                       bool nulls_first = false)
 {
-    using vectype = typename std::conditional<sizeof(T) == sizeof(int32_t),
-                                              ymm_vector<T>,
-                                              zmm_vector<T>>::type;
-    if (arrsize > 1) {
+    using vectype = avx512_8lane_vector<T>;
+    int64_t num_valid = count_valid(validity, arrsize);
+    int64_t *valid_args = nulls_first ? arg + arrsize - num_valid : arg;
+    int64_t *null_args = nulls_first ? arg : arg + num_valid;
+    split_null_args(validity, arrsize, valid_args, null_args);
+    if (num_valid > 1) {
         if constexpr (std::is_floating_point_v<T>) {
-            if (has_nan<vectype>(arr, arrsize)) {
-                std_argsort_withnan(arr, arg, 0, arrsize);
-                return;
+            if (has_valid_nan<vectype>(arr, validity, arrsize)) {
+                std_argsort_withnan(arr, valid_args, 0, num_valid);
+                return num_valid;
             }
         }
-        argsort_64bit_<vectype>(
-                arr, arg, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+        int64_t max_iters = 2 * (int64_t)log2(num_valid);
+        argsort_64bit_<vectype, zmm_vector<int64_t>>(
+                arr, valid_args, 0, num_valid - 1, max_iters);
     }
+    return num_valid;
 }
 
 template <typename T>
-std::vector<int64_t> avx512_argsort(T *arr, int64_t arrsize)
+std::vector<int64_t> avx512_argsort(T *arr,
+                                    const uint8_t *validity,
+                                    int64_t arrsize,
+                                    bool nulls_first = false)
 {
     std::vector<int64_t> indices(arrsize);
-    std::iota(indices.begin(), indices.end(), 0);
-    avx512_argsort<T>(arr, indices.data(), arrsize);
+    avx512_argsort<T>(arr, indices.data(), validity, arrsize, nulls_first);
     return indices;
 }
 
-/* argselect methods for 32-bit and 64-bit dtypes */
-template <typename T>
-void avx512_argselect(T *arr, int64_t *arg, int64_t k, int64_t arrsize)
+/*
+ * argsort and argselect for datetime64 and timedelta64 stored as int64_t,
+ * with the indices of NaT at the end. The NaT's are counted first. If there
+ * are any, a single pass like move_value_to_end_of_array compresses the other
+ * indices to the front and the ones of NaT to a buffer of that size, which is
+ * copied behind them.
+ */
+X86_SIMD_SORT_INLINE int64_t move_nat_args_to_end(int64_t *arr,
+                                                  int64_t *arg,
+                                                  int64_t arrsize)
 {
-    using vectype = typename std::conditional<sizeof(T) == sizeof(int32_t),
-                                              ymm_vector<T>,
-                                              zmm_vector<T>>::type;
-
-    if (arrsize > 1) {
-        if constexpr (std::is_floating_point_v<T>) {
-            if (has_nan<vectype>(arr, arrsize)) {
-                std_argselect_withnan(arr, arg, k, 0, arrsize);
-                return;
-            }
+    using vtype = zmm_vector<int64_t>;
+    using opmask_t = typename vtype::opmask_t;
+    using reg_t = typename vtype::reg_t;
+    const reg_t nat_vec = vtype::set1(X86_SIMD_SORT_NAT);
+    int64_t num_nat = 0;
+    for (int64_t ii = 0; ii < arrsize; ii += vtype::numlanes) {
+        int64_t num = std::min<int64_t>(vtype::numlanes, arrsize - ii);
+        opmask_t loadmask = (opmask_t)(~0ull >> (64 - num));
+        reg_t in = vtype::maskz_loadu(loadmask, arr + ii);
+        num_nat += _mm_popcnt_u32((int32_t)(loadmask & vtype::eq(in, nat_vec)));
+    }
+    if (num_nat == 0) { return arrsize; }
+    std::vector<int64_t> nat_args(num_nat);
+    int64_t l_store = 0;
+    int64_t nat_store = 0;
+    for (int64_t ii = 0; ii < arrsize; ii += vtype::numlanes) {
+        int64_t num = std::min<int64_t>(vtype::numlanes, arrsize - ii);
+        opmask_t loadmask = (opmask_t)(~0ull >> (64 - num));
+        reg_t args = vtype::maskz_loadu(loadmask, arg + ii);
+        reg_t in = vtype::template mask_i64gather<sizeof(int64_t)>(
+                nat_vec, loadmask, args, arr);
+        opmask_t nat = loadmask & vtype::eq(in, nat_vec);
+        opmask_t keep = loadmask & vtype::knot_opmask(nat);
+        vtype::mask_compressstoreu(nat_args.data() + nat_store, nat, args);
+        nat_store += _mm_popcnt_u32((int32_t)nat);
+        if (l_store != ii || keep != loadmask) {
+            vtype::mask_compressstoreu(arg + l_store, keep, args);
         }
-        argselect_64bit_<vectype>(
-                arr, arg, k, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+        l_store += _mm_popcnt_u32((int32_t)keep);
     }
+    std::copy(nat_args.begin(), nat_args.end(), arg + l_store);
+    return l_store;
 }
 
-template <typename T>
-std::vector<int64_t> avx512_argselect(T *arr, int64_t k, int64_t arrsize)
+inline void
+avx512_argsort_datetime(int64_t *arr, int64_t *arg, int64_t arrsize)
+{
+    avx512_argsort<int64_t>(arr, arg, move_nat_args_to_end(arr, arg, arrsize));
+}
+
+inline std::vector<int64_t> avx512_argsort_datetime(int64_t *arr,
+                                                    int64_t arrsize)
+{
+    std::vector<int64_t> indices(arrsize);
+    std::iota(indices.begin(), indices.end(), 0);
+    avx512_argsort_datetime(arr, indices.data(), arrsize);
+    return indices;
+}
+
+inline void avx512_argselect_datetime(int64_t *arr,
+                                      int64_t *arg,
+                                      int64_t k,
+                                      int64_t arrsize)
+{
+    arrsize = move_nat_args_to_end(arr, arg, arrsize);
+    if (k < arrsize) { avx512_argselect<int64_t>(arr, arg, k, arrsize); }
+}
+
+inline std::vector<int64_t>
+avx512_argselect_datetime(int64_t *arr, int64_t k, int64_t arrsize)
 {
     std::vector<int64_t> indices(arrsize);
     std::iota(indices.begin(), indices.end(), 0);
-    avx512_argselect<T>(arr, indices.data(), k, arrsize);
+    avx512_argselect_datetime(arr, indices.data(), k, arrsize);
     return indices;
 }
 
@@ -7,6 +7,7 @@
 #ifndef AVX512_64BIT_COMMON
 #define AVX512_64BIT_COMMON
 #include "avx512-common-qsort.h"
+#include "xss-network-ymm.hpp"
 
 /*
  * Constants used in sorting 8 elements in a ZMM registers. Based on Bitonic
@@ -32,6 +33,8 @@ struct ymm_vector<float> {
     using zmmi_t = __m256i;
     using opmask_t = __mmask8;
     static const uint8_t numlanes = 8;
+    static constexpr int network_sort_threshold = 256;
+    static constexpr int partition_unroll_factor = 4;
 
     static type_t type_max()
     {
@@ -151,23 +154,52 @@ struct ymm_vector<float> {
     {
         return _mm256_set1_ps(v);
     }
-    template <uint8_t mask, bool = (mask == 0b01010101)>
+    /*
+     * The 64-bit argsort networks use SHUFFLE_MASK(1, 1, 1, 1) on their key
+     * registers to swap neighbouring 64-bit lanes, which for 32-bit keys
+     * means swapping neighbouring 32-bit lanes. All other masks are used as
+     * 32-bit in-lane shuffles by the ymm sorting network.
+     */
+    template <uint8_t mask>
     static reg_t shuffle(reg_t zmm)
     {
-        /* Hack!: have to make shuffles within 128-bit lanes work for both
-         * 32-bit and 64-bit */
-        return _mm256_shuffle_ps(zmm, zmm, 0b10110001);
-        //if constexpr (mask == 0b01010101) {
-        //}
-        //else {
-        //    /* Not used, so far */
-        //    return _mm256_shuffle_ps(zmm, zmm, mask);
-        //}
+        if constexpr (mask == 0b01010101) {
+            return _mm256_shuffle_ps(zmm, zmm, SHUFFLE_MASK(2, 3, 0, 1));
+        }
+        else {
+            return _mm256_shuffle_ps(zmm, zmm, mask);
+        }
+    }
+    template <uint8_t mask>
+    static reg_t blend(reg_t x, reg_t y)
+    {
+        return _mm256_blend_ps(x, y, mask);
     }
     static void storeu(void *mem, reg_t x)
     {
         _mm256_storeu_ps((float *)mem, x);
     }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx512_double_compressstore<ymm_vector<type_t>>(
+                left_addr, right_addr, k, reg);
+    }
+    static reg_t reverse(reg_t ymm)
+    {
+        const __m256i rev_index = _mm256_set_epi32(NETWORK_32BIT_AVX2_1);
+        return permutexvar(rev_index, ymm);
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_ymm_32bit<ymm_vector<type_t>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_ymm_32bit<ymm_vector<type_t>>(x);
+    }
 };
 template <>
 struct ymm_vector<uint32_t> {
@@ -176,6 +208,8 @@ struct ymm_vector<uint32_t> {
     using zmmi_t = __m256i;
     using opmask_t = __mmask8;
     static const uint8_t numlanes = 8;
+    static constexpr int network_sort_threshold = 256;
+    static constexpr int partition_unroll_factor = 4;
 
     static type_t type_max()
     {
@@ -286,17 +320,47 @@ struct ymm_vector<uint32_t> {
     {
         return _mm256_set1_epi32(v);
     }
-    template <uint8_t mask, bool = (mask == 0b01010101)>
+    /* See ymm_vector<float>::shuffle */
+    template <uint8_t mask>
     static reg_t shuffle(reg_t zmm)
     {
-        /* Hack!: have to make shuffles within 128-bit lanes work for both
-         * 32-bit and 64-bit */
-        return _mm256_shuffle_epi32(zmm, 0b10110001);
+        if constexpr (mask == 0b01010101) {
+            return _mm256_shuffle_epi32(zmm, SHUFFLE_MASK(2, 3, 0, 1));
+        }
+        else {
+            return _mm256_shuffle_epi32(zmm, mask);
+        }
+    }
+    template <uint8_t mask>
+    static reg_t blend(reg_t x, reg_t y)
+    {
+        return _mm256_blend_epi32(x, y, mask);
     }
     static void storeu(void *mem, reg_t x)
     {
         _mm256_storeu_si256((__m256i *)mem, x);
     }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx512_double_compressstore<ymm_vector<type_t>>(
+                left_addr, right_addr, k, reg);
+    }
+    static reg_t reverse(reg_t ymm)
+    {
+        const __m256i rev_index = _mm256_set_epi32(NETWORK_32BIT_AVX2_1);
+        return permutexvar(rev_index, ymm);
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_ymm_32bit<ymm_vector<type_t>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_ymm_32bit<ymm_vector<type_t>>(x);
+    }
 };
 template <>
 struct ymm_vector<int32_t> {
@@ -305,6 +369,8 @@ struct ymm_vector<int32_t> {
     using zmmi_t = __m256i;
     using opmask_t = __mmask8;
     static const uint8_t numlanes = 8;
+    static constexpr int network_sort_threshold = 256;
+    static constexpr int partition_unroll_factor = 4;
 
     static type_t type_max()
     {
@@ -415,27 +481,55 @@ struct ymm_vector<int32_t> {
     {
         return _mm256_set1_epi32(v);
     }
-    template <uint8_t mask, bool = (mask == 0b01010101)>
+    /* See ymm_vector<float>::shuffle */
+    template <uint8_t mask>
     static reg_t shuffle(reg_t zmm)
     {
-        /* Hack!: have to make shuffles within 128-bit lanes work for both
-         * 32-bit and 64-bit */
-        return _mm256_shuffle_epi32(zmm, 0b10110001);
+        if constexpr (mask == 0b01010101) {
+            return _mm256_shuffle_epi32(zmm, SHUFFLE_MASK(2, 3, 0, 1));
+        }
+        else {
+            return _mm256_shuffle_epi32(zmm, mask);
+        }
+    }
+    template <uint8_t mask>
+    static reg_t blend(reg_t x, reg_t y)
+    {
+        return _mm256_blend_epi32(x, y, mask);
     }
     static void storeu(void *mem, reg_t x)
     {
         _mm256_storeu_si256((__m256i *)mem, x);
     }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx512_double_compressstore<ymm_vector<type_t>>(
+                left_addr, right_addr, k, reg);
+    }
+    static reg_t reverse(reg_t ymm)
+    {
+        const __m256i rev_index = _mm256_set_epi32(NETWORK_32BIT_AVX2_1);
+        return permutexvar(rev_index, ymm);
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_ymm_32bit<ymm_vector<type_t>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_ymm_32bit<ymm_vector<type_t>>(x);
+    }
 };
 template <>
-struct zmm_vector<int64_t> {
+struct ymm_vector<int64_t> {
     using type_t = int64_t;
-    using reg_t = __m512i;
-    using zmmi_t = __m512i;
-    using halfreg_t = __m512i;
+    using reg_t = __m256i;
     using opmask_t = __mmask8;
-    static const uint8_t numlanes = 8;
-    static constexpr int network_sort_threshold = 256;
+    static const uint8_t numlanes = 4;
+    static constexpr int network_sort_threshold = 64;
     static constexpr int partition_unroll_factor = 8;
 
     static type_t type_max()
@@ -448,127 +542,138 @@ struct zmm_vector<int64_t> {
     }
     static reg_t zmm_max()
     {
-        return _mm512_set1_epi64(type_max());
-    } // TODO: this should broadcast bits as is?
-
-    static zmmi_t
-    seti(int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8)
-    {
-        return _mm512_set_epi64(v1, v2, v3, v4, v5, v6, v7, v8);
-    }
-    static opmask_t kxor_opmask(opmask_t x, opmask_t y)
-    {
-        return _kxor_mask8(x, y);
+        return _mm256_set1_epi64x(type_max());
     }
+
     static opmask_t knot_opmask(opmask_t x)
     {
-        return _knot_mask8(x);
-    }
-    static opmask_t le(reg_t x, reg_t y)
-    {
-        return _mm512_cmp_epi64_mask(x, y, _MM_CMPINT_LE);
+        return x ^ 0x0F;
     }
     static opmask_t ge(reg_t x, reg_t y)
     {
-        return _mm512_cmp_epi64_mask(x, y, _MM_CMPINT_NLT);
+        return _mm256_cmp_epi64_mask(x, y, _MM_CMPINT_NLT);
     }
     static opmask_t eq(reg_t x, reg_t y)
     {
-        return _mm512_cmp_epi64_mask(x, y, _MM_CMPINT_EQ);
+        return _mm256_cmp_epi64_mask(x, y, _MM_CMPINT_EQ);
     }
     template <int scale>
     static reg_t
-    mask_i64gather(reg_t src, opmask_t mask, __m512i index, void const *base)
+    mask_i64gather(reg_t src, opmask_t mask, __m256i index, void const *base)
     {
-        return _mm512_mask_i64gather_epi64(src, mask, index, base, scale);
+        return _mm256_mmask_i64gather_epi64(src, mask, index, base, scale);
     }
     template <int scale>
-    static reg_t i64gather(__m512i index, void const *base)
+    static reg_t i64gather(__m256i index, void const *base)
     {
-        return _mm512_i64gather_epi64(index, base, scale);
+        return _mm256_i64gather_epi64(
+                (long long int const *)base, index, scale);
+    }
+    static opmask_t get_partial_loadmask(int size)
+    {
+        return (0x01 << size) - 0x01;
     }
     static reg_t loadu(void const *mem)
     {
-        return _mm512_loadu_si512(mem);
+        return _mm256_loadu_si256((reg_t const *)mem);
     }
     static reg_t max(reg_t x, reg_t y)
     {
-        return _mm512_max_epi64(x, y);
+        return _mm256_max_epi64(x, y);
     }
     static void mask_compressstoreu(void *mem, opmask_t mask, reg_t x)
     {
-        return _mm512_mask_compressstoreu_epi64(mem, mask, x);
+        return _mm256_mask_compressstoreu_epi64(mem, mask, x);
     }
     static reg_t maskz_loadu(opmask_t mask, void const *mem)
     {
-        return _mm512_maskz_loadu_epi64(mask, mem);
+        return _mm256_maskz_loadu_epi64(mask, mem);
     }
     static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
     {
-        return _mm512_mask_loadu_epi64(x, mask, mem);
+        return _mm256_mask_loadu_epi64(x, mask, mem);
     }
     static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
     {
-        return _mm512_mask_mov_epi64(x, mask, y);
+        return _mm256_mask_mov_epi64(x, mask, y);
     }
     static void mask_storeu(void *mem, opmask_t mask, reg_t x)
     {
-        return _mm512_mask_storeu_epi64(mem, mask, x);
+        return _mm256_mask_storeu_epi64(mem, mask, x);
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx512_double_compressstore<ymm_vector<type_t>>(
+                left_addr, right_addr, k, reg);
     }
     static reg_t min(reg_t x, reg_t y)
     {
-        return _mm512_min_epi64(x, y);
+        return _mm256_min_epi64(x, y);
     }
-    static reg_t permutexvar(__m512i idx, reg_t zmm)
+    template <int32_t idx>
+    static reg_t permutexvar(reg_t ymm)
     {
-        return _mm512_permutexvar_epi64(idx, zmm);
+        return _mm256_permute4x64_epi64(ymm, idx);
     }
     static type_t reducemax(reg_t v)
     {
-        return _mm512_reduce_max_epi64(v);
+        __m128i v128 = _mm_max_epi64(_mm256_castsi256_si128(v),
+                                     _mm256_extracti128_si256(v, 1));
+        __m128i v64 = _mm_max_epi64(
+                v128, _mm_shuffle_epi32(v128, _MM_SHUFFLE(1, 0, 3, 2)));
+        return (type_t)_mm_cvtsi128_si64(v64);
     }
     static type_t reducemin(reg_t v)
     {
-        return _mm512_reduce_min_epi64(v);
+        __m128i v128 = _mm_min_epi64(_mm256_castsi256_si128(v),
+                                     _mm256_extracti128_si256(v, 1));
+        __m128i v64 = _mm_min_epi64(
+                v128, _mm_shuffle_epi32(v128, _MM_SHUFFLE(1, 0, 3, 2)));
+        return (type_t)_mm_cvtsi128_si64(v64);
     }
     static reg_t set1(type_t v)
     {
-        return _mm512_set1_epi64(v);
+        return _mm256_set1_epi64x(v);
     }
     template <uint8_t mask>
-    static reg_t shuffle(reg_t zmm)
+    static reg_t shuffle(reg_t ymm)
     {
-        __m512d temp = _mm512_castsi512_pd(zmm);
-        return _mm512_castpd_si512(
-                _mm512_shuffle_pd(temp, temp, (_MM_PERM_ENUM)mask));
+        __m256d temp = _mm256_castsi256_pd(ymm);
+        return _mm256_castpd_si256(_mm256_shuffle_pd(temp, temp, mask & 0xF));
+    }
+    template <uint8_t mask>
+    static reg_t blend(reg_t x, reg_t y)
+    {
+        return _mm256_castpd_si256(_mm256_blend_pd(
+                _mm256_castsi256_pd(x), _mm256_castsi256_pd(y), mask));
     }
     static void storeu(void *mem, reg_t x)
     {
-        _mm512_storeu_si512(mem, x);
+        _mm256_storeu_si256((reg_t *)mem, x);
     }
-    static reg_t reverse(reg_t zmm)
+    static reg_t reverse(reg_t ymm)
     {
-        const zmmi_t rev_index = seti(NETWORK_64BIT_2);
-        return permutexvar(rev_index, zmm);
+        return permutexvar<SHUFFLE_MASK(0, 1, 2, 3)>(ymm);
     }
     static reg_t bitonic_merge(reg_t x)
     {
-        return bitonic_merge_zmm_64bit<zmm_vector<type_t>>(x);
+        return bitonic_merge_ymm_64bit<ymm_vector<type_t>>(x);
     }
     static reg_t sort_vec(reg_t x)
     {
-        return sort_zmm_64bit<zmm_vector<type_t>>(x);
+        return sort_ymm_64bit<ymm_vector<type_t>>(x);
     }
 };
 template <>
-struct zmm_vector<uint64_t> {
+struct ymm_vector<uint64_t> {
     using type_t = uint64_t;
-    using reg_t = __m512i;
-    using zmmi_t = __m512i;
-    using halfreg_t = __m512i;
+    using reg_t = __m256i;
     using opmask_t = __mmask8;
-    static const uint8_t numlanes = 8;
-    static constexpr int network_sort_threshold = 256;
+    static const uint8_t numlanes = 4;
+    static constexpr int network_sort_threshold = 64;
     static constexpr int partition_unroll_factor = 8;
 
     static type_t type_max()
@@ -581,115 +686,138 @@ struct zmm_vector<uint64_t> {
     }
     static reg_t zmm_max()
     {
-        return _mm512_set1_epi64(type_max());
+        return _mm256_set1_epi64x(type_max());
     }
 
-    static zmmi_t
-    seti(int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8)
+    static opmask_t knot_opmask(opmask_t x)
     {
-        return _mm512_set_epi64(v1, v2, v3, v4, v5, v6, v7, v8);
+        return x ^ 0x0F;
     }
-    template <int scale>
-    static reg_t
-    mask_i64gather(reg_t src, opmask_t mask, __m512i index, void const *base)
+    static opmask_t ge(reg_t x, reg_t y)
     {
-        return _mm512_mask_i64gather_epi64(src, mask, index, base, scale);
+        return _mm256_cmp_epu64_mask(x, y, _MM_CMPINT_NLT);
     }
-    template <int scale>
-    static reg_t i64gather(__m512i index, void const *base)
+    static opmask_t eq(reg_t x, reg_t y)
     {
-        return _mm512_i64gather_epi64(index, base, scale);
+        return _mm256_cmp_epu64_mask(x, y, _MM_CMPINT_EQ);
     }
-    static opmask_t knot_opmask(opmask_t x)
+    template <int scale>
+    static reg_t
+    mask_i64gather(reg_t src, opmask_t mask, __m256i index, void const *base)
     {
-        return _knot_mask8(x);
+        return _mm256_mmask_i64gather_epi64(src, mask, index, base, scale);
     }
-    static opmask_t ge(reg_t x, reg_t y)
+    template <int scale>
+    static reg_t i64gather(__m256i index, void const *base)
     {
-        return _mm512_cmp_epu64_mask(x, y, _MM_CMPINT_NLT);
+        return _mm256_i64gather_epi64(
+                (long long int const *)base, index, scale);
     }
-    static opmask_t eq(reg_t x, reg_t y)
+    static opmask_t get_partial_loadmask(int size)
     {
-        return _mm512_cmp_epu64_mask(x, y, _MM_CMPINT_EQ);
+        return (0x01 << size) - 0x01;
     }
     static reg_t loadu(void const *mem)
     {
-        return _mm512_loadu_si512(mem);
+        return _mm256_loadu_si256((reg_t const *)mem);
     }
     static reg_t max(reg_t x, reg_t y)
     {
-        return _mm512_max_epu64(x, y);
+        return _mm256_max_epu64(x, y);
     }
     static void mask_compressstoreu(void *mem, opmask_t mask, reg_t x)
     {
-        return _mm512_mask_compressstoreu_epi64(mem, mask, x);
+        return _mm256_mask_compressstoreu_epi64(mem, mask, x);
+    }
+    static reg_t maskz_loadu(opmask_t mask, void const *mem)
+    {
+        return _mm256_maskz_loadu_epi64(mask, mem);
     }
     static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
     {
-        return _mm512_mask_loadu_epi64(x, mask, mem);
+        return _mm256_mask_loadu_epi64(x, mask, mem);
     }
     static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
     {
-        return _mm512_mask_mov_epi64(x, mask, y);
+        return _mm256_mask_mov_epi64(x, mask, y);
     }
     static void mask_storeu(void *mem, opmask_t mask, reg_t x)
     {
-        return _mm512_mask_storeu_epi64(mem, mask, x);
+        return _mm256_mask_storeu_epi64(mem, mask, x);
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx512_double_compressstore<ymm_vector<type_t>>(
+                left_addr, right_addr, k, reg);
     }
     static reg_t min(reg_t x, reg_t y)
     {
-        return _mm512_min_epu64(x, y);
+        return _mm256_min_epu64(x, y);
     }
-    static reg_t permutexvar(__m512i idx, reg_t zmm)
+    template <int32_t idx>
+    static reg_t permutexvar(reg_t ymm)
     {
-        return _mm512_permutexvar_epi64(idx, zmm);
+        return _mm256_permute4x64_epi64(ymm, idx);
     }
     static type_t reducemax(reg_t v)
     {
-        return _mm512_reduce_max_epu64(v);
+        __m128i v128 = _mm_max_epu64(_mm256_castsi256_si128(v),
+                                     _mm256_extracti128_si256(v, 1));
+        __m128i v64 = _mm_max_epu64(
+                v128, _mm_shuffle_epi32(v128, _MM_SHUFFLE(1, 0, 3, 2)));
+        return (type_t)_mm_cvtsi128_si64(v64);
     }
     static type_t reducemin(reg_t v)
     {
-        return _mm512_reduce_min_epu64(v);
+        __m128i v128 = _mm_min_epu64(_mm256_castsi256_si128(v),
+                                     _mm256_extracti128_si256(v, 1));
+        __m128i v64 = _mm_min_epu64(
+                v128, _mm_shuffle_epi32(v128, _MM_SHUFFLE(1, 0, 3, 2)));
+        return (type_t)_mm_cvtsi128_si64(v64);
     }
     static reg_t set1(type_t v)
     {
-        return _mm512_set1_epi64(v);
+        return _mm256_set1_epi64x(v);
     }
     template <uint8_t mask>
-    static reg_t shuffle(reg_t zmm)
+    static reg_t shuffle(reg_t ymm)
     {
-        __m512d temp = _mm512_castsi512_pd(zmm);
-        return _mm512_castpd_si512(
-                _mm512_shuffle_pd(temp, temp, (_MM_PERM_ENUM)mask));
+        __m256d temp = _mm256_castsi256_pd(ymm);
+        return _mm256_castpd_si256(_mm256_shuffle_pd(temp, temp, mask & 0xF));
+    }
+    template <uint8_t mask>
+    static reg_t blend(reg_t x, reg_t y)
+    {
+        return _mm256_castpd_si256(_mm256_blend_pd(
+                _mm256_castsi256_pd(x), _mm256_castsi256_pd(y), mask));
     }
     static void storeu(void *mem, reg_t x)
     {
-        _mm512_storeu_si512(mem, x);
+        _mm256_storeu_si256((reg_t *)mem, x);
     }
-    static reg_t reverse(reg_t zmm)
+    static reg_t reverse(reg_t ymm)
     {
-        const zmmi_t rev_index = seti(NETWORK_64BIT_2);
-        return permutexvar(rev_index, zmm);
+        return permutexvar<SHUFFLE_MASK(0, 1, 2, 3)>(ymm);
     }
     static reg_t bitonic_merge(reg_t x)
     {
-        return bitonic_merge_zmm_64bit<zmm_vector<type_t>>(x);
+        return bitonic_merge_ymm_64bit<ymm_vector<type_t>>(x);
     }
     static reg_t sort_vec(reg_t x)
     {
-        return sort_zmm_64bit<zmm_vector<type_t>>(x);
+        return sort_ymm_64bit<ymm_vector<type_t>>(x);
     }
 };
 template <>
-struct zmm_vector<double> {
+struct ymm_vector<double> {
     using type_t = double;
-    using reg_t = __m512d;
-    using zmmi_t = __m512i;
-    using halfreg_t = __m512d;
+    using reg_t = __m256d;
     using opmask_t = __mmask8;
-    static const uint8_t numlanes = 8;
-    static constexpr int network_sort_threshold = 256;
+    static const uint8_t numlanes = 4;
+    static constexpr int network_sort_threshold = 64;
     static constexpr int partition_unroll_factor = 8;
 
     static type_t type_max()
@@ -702,30 +830,31 @@ struct zmm_vector<double> {
     }
     static reg_t zmm_max()
     {
-        return _mm512_set1_pd(type_max());
+        return _mm256_set1_pd(type_max());
     }
 
-    static zmmi_t
-    seti(int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8)
+    static opmask_t knot_opmask(opmask_t x)
     {
-        return _mm512_set_epi64(v1, v2, v3, v4, v5, v6, v7, v8);
+        return x ^ 0x0F;
     }
-
-    static reg_t maskz_loadu(opmask_t mask, void const *mem)
+    static opmask_t ge(reg_t x, reg_t y)
     {
-        return _mm512_maskz_loadu_pd(mask, mem);
+        return _mm256_cmp_pd_mask(x, y, _CMP_GE_OQ);
     }
-    static opmask_t knot_opmask(opmask_t x)
+    static opmask_t eq(reg_t x, reg_t y)
     {
-        return _knot_mask8(x);
+        return _mm256_cmp_pd_mask(x, y, _CMP_EQ_OQ);
     }
-    static opmask_t ge(reg_t x, reg_t y)
+    template <int scale>
+    static reg_t
+    mask_i64gather(reg_t src, opmask_t mask, __m256i index, void const *base)
     {
-        return _mm512_cmp_pd_mask(x, y, _CMP_GE_OQ);
+        return _mm256_mmask_i64gather_pd(src, mask, index, base, scale);
     }
-    static opmask_t eq(reg_t x, reg_t y)
+    template <int scale>
+    static reg_t i64gather(__m256i index, void const *base)
     {
-        return _mm512_cmp_pd_mask(x, y, _CMP_EQ_OQ);
+        return _mm256_i64gather_pd((double const *)base, index, scale);
     }
     static opmask_t get_partial_loadmask(int size)
     {
@@ -734,30 +863,832 @@ struct zmm_vector<double> {
     template <int type>
     static opmask_t fpclass(reg_t x)
     {
-        return _mm512_fpclass_pd_mask(x, type);
+        return _mm256_fpclass_pd_mask(x, type);
     }
-    template <int scale>
-    static reg_t
-    mask_i64gather(reg_t src, opmask_t mask, __m512i index, void const *base)
+    static reg_t loadu(void const *mem)
     {
-        return _mm512_mask_i64gather_pd(src, mask, index, base, scale);
+        return _mm256_loadu_pd((double const *)mem);
     }
-    template <int scale>
-    static reg_t i64gather(__m512i index, void const *base)
+    static reg_t max(reg_t x, reg_t y)
     {
-        return _mm512_i64gather_pd(index, base, scale);
+        return _mm256_max_pd(x, y);
     }
-    static reg_t loadu(void const *mem)
+    static void mask_compressstoreu(void *mem, opmask_t mask, reg_t x)
     {
-        return _mm512_loadu_pd(mem);
+        return _mm256_mask_compressstoreu_pd(mem, mask, x);
     }
-    static reg_t max(reg_t x, reg_t y)
+    static reg_t maskz_loadu(opmask_t mask, void const *mem)
     {
-        return _mm512_max_pd(x, y);
+        return _mm256_maskz_loadu_pd(mask, mem);
     }
-    static void mask_compressstoreu(void *mem, opmask_t mask, reg_t x)
+    static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
     {
-        return _mm512_mask_compressstoreu_pd(mem, mask, x);
+        return _mm256_mask_loadu_pd(x, mask, mem);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        return _mm256_mask_mov_pd(x, mask, y);
+    }
+    static void mask_storeu(void *mem, opmask_t mask, reg_t x)
+    {
+        return _mm256_mask_storeu_pd(mem, mask, x);
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx512_double_compressstore<ymm_vector<type_t>>(
+                left_addr, right_addr, k, reg);
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm256_min_pd(x, y);
+    }
+    template <int32_t idx>
+    static reg_t permutexvar(reg_t ymm)
+    {
+        return _mm256_permute4x64_pd(ymm, idx);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        __m128d v128 = _mm_max_pd(_mm256_castpd256_pd128(v),
+                                  _mm256_extractf128_pd(v, 1));
+        __m128d v64 = _mm_max_pd(v128, _mm_permute_pd(v128, 0b01));
+        return _mm_cvtsd_f64(v64);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        __m128d v128 = _mm_min_pd(_mm256_castpd256_pd128(v),
+                                  _mm256_extractf128_pd(v, 1));
+        __m128d v64 = _mm_min_pd(v128, _mm_permute_pd(v128, 0b01));
+        return _mm_cvtsd_f64(v64);
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm256_set1_pd(v);
+    }
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t ymm)
+    {
+        return _mm256_shuffle_pd(ymm, ymm, mask & 0xF);
+    }
+    template <uint8_t mask>
+    static reg_t blend(reg_t x, reg_t y)
+    {
+        return _mm256_blend_pd(x, y, mask);
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        _mm256_storeu_pd((double *)mem, x);
+    }
+    static reg_t reverse(reg_t ymm)
+    {
+        return permutexvar<SHUFFLE_MASK(0, 1, 2, 3)>(ymm);
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_ymm_64bit<ymm_vector<type_t>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_ymm_64bit<ymm_vector<type_t>>(x);
+    }
+};
+/*
+ * 4 x 32-bit keys in a xmm register with AVX-512VL opmasks, for the 256-bit
+ * argsort: a ymm register of 64-bit indices gathers four 32-bit keys. The
+ * masks follow the 4 x 64-bit convention of ymm_vector<int64_t>, so the same
+ * 4-lane networks sort both.
+ */
+template <>
+struct xmm_vector<int32_t> {
+    using type_t = int32_t;
+    using reg_t = __m128i;
+    using opmask_t = __mmask8;
+    static const uint8_t numlanes = 4;
+
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_MAX_INT32;
+    }
+    static type_t type_min()
+    {
+        return X86_SIMD_SORT_MIN_INT32;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm_set1_epi32(type_max());
+    }
+
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return x ^ 0x0F;
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        return _mm_cmp_epi32_mask(x, y, _MM_CMPINT_NLT);
+    }
+    static opmask_t eq(reg_t x, reg_t y)
+    {
+        return _mm_cmp_epi32_mask(x, y, _MM_CMPINT_EQ);
+    }
+    template <int scale>
+    static reg_t
+    mask_i64gather(reg_t src, opmask_t mask, __m256i index, void const *base)
+    {
+        return _mm256_mmask_i64gather_epi32(src, mask, index, base, scale);
+    }
+    template <int scale>
+    static reg_t i64gather(__m256i index, void const *base)
+    {
+        return _mm256_i64gather_epi32((int const *)base, index, scale);
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return _mm_loadu_si128((reg_t const *)mem);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        return _mm_mask_mov_epi32(x, mask, y);
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm_min_epi32(x, y);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm_max_epi32(x, y);
+    }
+    template <int32_t idx>
+    static reg_t permutexvar(reg_t xmm)
+    {
+        return _mm_shuffle_epi32(xmm, idx);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        v = max(v, permutexvar<SHUFFLE_MASK(1, 0, 3, 2)>(v));
+        v = max(v, permutexvar<SHUFFLE_MASK(2, 3, 0, 1)>(v));
+        return _mm_cvtsi128_si32(v);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        v = min(v, permutexvar<SHUFFLE_MASK(1, 0, 3, 2)>(v));
+        v = min(v, permutexvar<SHUFFLE_MASK(2, 3, 0, 1)>(v));
+        return _mm_cvtsi128_si32(v);
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm_set1_epi32(v);
+    }
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t xmm)
+    {
+        if constexpr (mask == 0b01010101) {
+            return _mm_shuffle_epi32(xmm, SHUFFLE_MASK(2, 3, 0, 1));
+        }
+        else {
+            return _mm_shuffle_epi32(xmm, mask);
+        }
+    }
+    template <uint8_t mask>
+    static reg_t blend(reg_t x, reg_t y)
+    {
+        return _mm_blend_epi32(x, y, mask);
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        _mm_storeu_si128((reg_t *)mem, x);
+    }
+    static reg_t reverse(reg_t xmm)
+    {
+        return permutexvar<SHUFFLE_MASK(0, 1, 2, 3)>(xmm);
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_ymm_64bit<xmm_vector<type_t>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_ymm_64bit<xmm_vector<type_t>>(x);
+    }
+};
+template <>
+struct xmm_vector<uint32_t> {
+    using type_t = uint32_t;
+    using reg_t = __m128i;
+    using opmask_t = __mmask8;
+    static const uint8_t numlanes = 4;
+
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_MAX_UINT32;
+    }
+    static type_t type_min()
+    {
+        return 0;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm_set1_epi32(type_max());
+    }
+
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return x ^ 0x0F;
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        return _mm_cmp_epu32_mask(x, y, _MM_CMPINT_NLT);
+    }
+    static opmask_t eq(reg_t x, reg_t y)
+    {
+        return _mm_cmp_epu32_mask(x, y, _MM_CMPINT_EQ);
+    }
+    template <int scale>
+    static reg_t
+    mask_i64gather(reg_t src, opmask_t mask, __m256i index, void const *base)
+    {
+        return _mm256_mmask_i64gather_epi32(src, mask, index, base, scale);
+    }
+    template <int scale>
+    static reg_t i64gather(__m256i index, void const *base)
+    {
+        return _mm256_i64gather_epi32((int const *)base, index, scale);
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return _mm_loadu_si128((reg_t const *)mem);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        return _mm_mask_mov_epi32(x, mask, y);
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm_min_epu32(x, y);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm_max_epu32(x, y);
+    }
+    template <int32_t idx>
+    static reg_t permutexvar(reg_t xmm)
+    {
+        return _mm_shuffle_epi32(xmm, idx);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        v = max(v, permutexvar<SHUFFLE_MASK(1, 0, 3, 2)>(v));
+        v = max(v, permutexvar<SHUFFLE_MASK(2, 3, 0, 1)>(v));
+        return (type_t)_mm_cvtsi128_si32(v);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        v = min(v, permutexvar<SHUFFLE_MASK(1, 0, 3, 2)>(v));
+        v = min(v, permutexvar<SHUFFLE_MASK(2, 3, 0, 1)>(v));
+        return (type_t)_mm_cvtsi128_si32(v);
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm_set1_epi32(v);
+    }
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t xmm)
+    {
+        if constexpr (mask == 0b01010101) {
+            return _mm_shuffle_epi32(xmm, SHUFFLE_MASK(2, 3, 0, 1));
+        }
+        else {
+            return _mm_shuffle_epi32(xmm, mask);
+        }
+    }
+    template <uint8_t mask>
+    static reg_t blend(reg_t x, reg_t y)
+    {
+        return _mm_blend_epi32(x, y, mask);
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        _mm_storeu_si128((reg_t *)mem, x);
+    }
+    static reg_t reverse(reg_t xmm)
+    {
+        return permutexvar<SHUFFLE_MASK(0, 1, 2, 3)>(xmm);
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_ymm_64bit<xmm_vector<type_t>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_ymm_64bit<xmm_vector<type_t>>(x);
+    }
+};
+template <>
+struct xmm_vector<float> {
+    using type_t = float;
+    using reg_t = __m128;
+    using opmask_t = __mmask8;
+    static const uint8_t numlanes = 4;
+
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_INFINITYF;
+    }
+    static type_t type_min()
+    {
+        return -X86_SIMD_SORT_INFINITYF;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm_set1_ps(type_max());
+    }
+
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return x ^ 0x0F;
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        return _mm_cmp_ps_mask(x, y, _CMP_GE_OQ);
+    }
+    static opmask_t eq(reg_t x, reg_t y)
+    {
+        return _mm_cmp_ps_mask(x, y, _CMP_EQ_OQ);
+    }
+    static opmask_t get_partial_loadmask(int size)
+    {
+        return (0x01 << size) - 0x01;
+    }
+    template <int type>
+    static opmask_t fpclass(reg_t x)
+    {
+        return _mm_fpclass_ps_mask(x, type);
+    }
+    template <int scale>
+    static reg_t
+    mask_i64gather(reg_t src, opmask_t mask, __m256i index, void const *base)
+    {
+        return _mm256_mmask_i64gather_ps(src, mask, index, base, scale);
+    }
+    template <int scale>
+    static reg_t i64gather(__m256i index, void const *base)
+    {
+        return _mm256_i64gather_ps((float const *)base, index, scale);
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return _mm_loadu_ps((float const *)mem);
+    }
+    static reg_t maskz_loadu(opmask_t mask, void const *mem)
+    {
+        return _mm_maskz_loadu_ps(mask, mem);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        return _mm_mask_mov_ps(x, mask, y);
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm_min_ps(x, y);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm_max_ps(x, y);
+    }
+    template <int32_t idx>
+    static reg_t permutexvar(reg_t xmm)
+    {
+        return _mm_permute_ps(xmm, idx);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        v = max(v, permutexvar<SHUFFLE_MASK(1, 0, 3, 2)>(v));
+        v = max(v, permutexvar<SHUFFLE_MASK(2, 3, 0, 1)>(v));
+        return _mm_cvtss_f32(v);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        v = min(v, permutexvar<SHUFFLE_MASK(1, 0, 3, 2)>(v));
+        v = min(v, permutexvar<SHUFFLE_MASK(2, 3, 0, 1)>(v));
+        return _mm_cvtss_f32(v);
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm_set1_ps(v);
+    }
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t xmm)
+    {
+        if constexpr (mask == 0b01010101) {
+            return _mm_permute_ps(xmm, SHUFFLE_MASK(2, 3, 0, 1));
+        }
+        else {
+            return _mm_permute_ps(xmm, mask);
+        }
+    }
+    template <uint8_t mask>
+    static reg_t blend(reg_t x, reg_t y)
+    {
+        return _mm_blend_ps(x, y, mask);
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        _mm_storeu_ps((float *)mem, x);
+    }
+    static reg_t reverse(reg_t xmm)
+    {
+        return permutexvar<SHUFFLE_MASK(0, 1, 2, 3)>(xmm);
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_ymm_64bit<xmm_vector<type_t>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_ymm_64bit<xmm_vector<type_t>>(x);
+    }
+};
+template <>
+struct zmm_vector<int64_t> {
+    using type_t = int64_t;
+    using reg_t = __m512i;
+    using zmmi_t = __m512i;
+    using halfreg_t = __m512i;
+    using opmask_t = __mmask8;
+    static const uint8_t numlanes = 8;
+    static constexpr int network_sort_threshold = 256;
+    static constexpr int partition_unroll_factor = 8;
+
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_MAX_INT64;
+    }
+    static type_t type_min()
+    {
+        return X86_SIMD_SORT_MIN_INT64;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm512_set1_epi64(type_max());
+    } // TODO: this should broadcast bits as is?
+
+    static zmmi_t
+    seti(int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8)
+    {
+        return _mm512_set_epi64(v1, v2, v3, v4, v5, v6, v7, v8);
+    }
+    static opmask_t kxor_opmask(opmask_t x, opmask_t y)
+    {
+        return _kxor_mask8(x, y);
+    }
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return _knot_mask8(x);
+    }
+    static opmask_t le(reg_t x, reg_t y)
+    {
+        return _mm512_cmp_epi64_mask(x, y, _MM_CMPINT_LE);
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        return _mm512_cmp_epi64_mask(x, y, _MM_CMPINT_NLT);
+    }
+    static opmask_t eq(reg_t x, reg_t y)
+    {
+        return _mm512_cmp_epi64_mask(x, y, _MM_CMPINT_EQ);
+    }
+    template <int scale>
+    static reg_t
+    mask_i64gather(reg_t src, opmask_t mask, __m512i index, void const *base)
+    {
+        return _mm512_mask_i64gather_epi64(src, mask, index, base, scale);
+    }
+    template <int scale>
+    static reg_t i64gather(__m512i index, void const *base)
+    {
+        return _mm512_i64gather_epi64(index, base, scale);
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return _mm512_loadu_si512(mem);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm512_max_epi64(x, y);
+    }
+    static void mask_compressstoreu(void *mem, opmask_t mask, reg_t x)
+    {
+        return _mm512_mask_compressstoreu_epi64(mem, mask, x);
+    }
+    static reg_t maskz_compress(opmask_t mask, reg_t x)
+    {
+        return _mm512_maskz_compress_epi64(mask, x);
+    }
+    static reg_t mask_expand(reg_t src, opmask_t mask, reg_t x)
+    {
+        return _mm512_mask_expand_epi64(src, mask, x);
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx512_double_compressstore<zmm_vector<int64_t>>(
+                left_addr, right_addr, k, reg);
+    }
+    static reg_t maskz_loadu(opmask_t mask, void const *mem)
+    {
+        return _mm512_maskz_loadu_epi64(mask, mem);
+    }
+    static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
+    {
+        return _mm512_mask_loadu_epi64(x, mask, mem);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        return _mm512_mask_mov_epi64(x, mask, y);
+    }
+    static void mask_storeu(void *mem, opmask_t mask, reg_t x)
+    {
+        return _mm512_mask_storeu_epi64(mem, mask, x);
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm512_min_epi64(x, y);
+    }
+    static reg_t permutexvar(__m512i idx, reg_t zmm)
+    {
+        return _mm512_permutexvar_epi64(idx, zmm);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        return _mm512_reduce_max_epi64(v);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        return _mm512_reduce_min_epi64(v);
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm512_set1_epi64(v);
+    }
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t zmm)
+    {
+        __m512d temp = _mm512_castsi512_pd(zmm);
+        return _mm512_castpd_si512(
+                _mm512_shuffle_pd(temp, temp, (_MM_PERM_ENUM)mask));
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        _mm512_storeu_si512(mem, x);
+    }
+    static reg_t reverse(reg_t zmm)
+    {
+        const zmmi_t rev_index = seti(NETWORK_64BIT_2);
+        return permutexvar(rev_index, zmm);
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_zmm_64bit<zmm_vector<type_t>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_zmm_64bit<zmm_vector<type_t>>(x);
+    }
+};
+template <>
+struct zmm_vector<uint64_t> {
+    using type_t = uint64_t;
+    using reg_t = __m512i;
+    using zmmi_t = __m512i;
+    using halfreg_t = __m512i;
+    using opmask_t = __mmask8;
+    static const uint8_t numlanes = 8;
+    static constexpr int network_sort_threshold = 256;
+    static constexpr int partition_unroll_factor = 8;
+
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_MAX_UINT64;
+    }
+    static type_t type_min()
+    {
+        return 0;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm512_set1_epi64(type_max());
+    }
+
+    static zmmi_t
+    seti(int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8)
+    {
+        return _mm512_set_epi64(v1, v2, v3, v4, v5, v6, v7, v8);
+    }
+    template <int scale>
+    static reg_t
+    mask_i64gather(reg_t src, opmask_t mask, __m512i index, void const *base)
+    {
+        return _mm512_mask_i64gather_epi64(src, mask, index, base, scale);
+    }
+    template <int scale>
+    static reg_t i64gather(__m512i index, void const *base)
+    {
+        return _mm512_i64gather_epi64(index, base, scale);
+    }
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return _knot_mask8(x);
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        return _mm512_cmp_epu64_mask(x, y, _MM_CMPINT_NLT);
+    }
+    static opmask_t eq(reg_t x, reg_t y)
+    {
+        return _mm512_cmp_epu64_mask(x, y, _MM_CMPINT_EQ);
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return _mm512_loadu_si512(mem);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm512_max_epu64(x, y);
+    }
+    static void mask_compressstoreu(void *mem, opmask_t mask, reg_t x)
+    {
+        return _mm512_mask_compressstoreu_epi64(mem, mask, x);
+    }
+    static reg_t maskz_compress(opmask_t mask, reg_t x)
+    {
+        return _mm512_maskz_compress_epi64(mask, x);
+    }
+    static reg_t mask_expand(reg_t src, opmask_t mask, reg_t x)
+    {
+        return _mm512_mask_expand_epi64(src, mask, x);
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx512_double_compressstore<zmm_vector<uint64_t>>(
+                left_addr, right_addr, k, reg);
+    }
+    static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
+    {
+        return _mm512_mask_loadu_epi64(x, mask, mem);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        return _mm512_mask_mov_epi64(x, mask, y);
+    }
+    static void mask_storeu(void *mem, opmask_t mask, reg_t x)
+    {
+        return _mm512_mask_storeu_epi64(mem, mask, x);
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm512_min_epu64(x, y);
+    }
+    static reg_t permutexvar(__m512i idx, reg_t zmm)
+    {
+        return _mm512_permutexvar_epi64(idx, zmm);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        return _mm512_reduce_max_epu64(v);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        return _mm512_reduce_min_epu64(v);
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm512_set1_epi64(v);
+    }
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t zmm)
+    {
+        __m512d temp = _mm512_castsi512_pd(zmm);
+        return _mm512_castpd_si512(
+                _mm512_shuffle_pd(temp, temp, (_MM_PERM_ENUM)mask));
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        _mm512_storeu_si512(mem, x);
+    }
+    static reg_t reverse(reg_t zmm)
+    {
+        const zmmi_t rev_index = seti(NETWORK_64BIT_2);
+        return permutexvar(rev_index, zmm);
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return bitonic_merge_zmm_64bit<zmm_vector<type_t>>(x);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_zmm_64bit<zmm_vector<type_t>>(x);
+    }
+};
+template <>
+struct zmm_vector<double> {
+    using type_t = double;
+    using reg_t = __m512d;
+    using zmmi_t = __m512i;
+    using halfreg_t = __m512d;
+    using opmask_t = __mmask8;
+    static const uint8_t numlanes = 8;
+    static constexpr int network_sort_threshold = 256;
+    static constexpr int partition_unroll_factor = 8;
+
+    static type_t type_max()
+    {
+        return X86_SIMD_SORT_INFINITY;
+    }
+    static type_t type_min()
+    {
+        return -X86_SIMD_SORT_INFINITY;
+    }
+    static reg_t zmm_max()
+    {
+        return _mm512_set1_pd(type_max());
+    }
+
+    static zmmi_t
+    seti(int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8)
+    {
+        return _mm512_set_epi64(v1, v2, v3, v4, v5, v6, v7, v8);
+    }
+
+    static reg_t maskz_loadu(opmask_t mask, void const *mem)
+    {
+        return _mm512_maskz_loadu_pd(mask, mem);
+    }
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return _knot_mask8(x);
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        return _mm512_cmp_pd_mask(x, y, _CMP_GE_OQ);
+    }
+    static opmask_t eq(reg_t x, reg_t y)
+    {
+        return _mm512_cmp_pd_mask(x, y, _CMP_EQ_OQ);
+    }
+    static opmask_t get_partial_loadmask(int size)
+    {
+        return (0x01 << size) - 0x01;
+    }
+    template <int type>
+    static opmask_t fpclass(reg_t x)
+    {
+        return _mm512_fpclass_pd_mask(x, type);
+    }
+    template <int scale>
+    static reg_t
+    mask_i64gather(reg_t src, opmask_t mask, __m512i index, void const *base)
+    {
+        return _mm512_mask_i64gather_pd(src, mask, index, base, scale);
+    }
+    template <int scale>
+    static reg_t i64gather(__m512i index, void const *base)
+    {
+        return _mm512_i64gather_pd(index, base, scale);
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return _mm512_loadu_pd(mem);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm512_max_pd(x, y);
+    }
+    static void mask_compressstoreu(void *mem, opmask_t mask, reg_t x)
+    {
+        return _mm512_mask_compressstoreu_pd(mem, mask, x);
+    }
+    static reg_t maskz_compress(opmask_t mask, reg_t x)
+    {
+        return _mm512_maskz_compress_pd(mask, x);
+    }
+    static reg_t mask_expand(reg_t src, opmask_t mask, reg_t x)
+    {
+        return _mm512_mask_expand_pd(src, mask, x);
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx512_double_compressstore<zmm_vector<double>>(
+                left_addr, right_addr, k, reg);
     }
     static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
     {
@@ -10,4 +10,31 @@
 #include "avx512-64bit-common.h"
 #include "xss-network-qsort.hpp"
 
+/*
+ * datetime64 and timedelta64 stored as int64_t: NaT (INT64_MIN) is sorted to
+ * the end as in NumPy, instead of to the front
+ */
+inline void avx512_qsort_datetime(int64_t *arr, int64_t arrsize)
+{
+    arrsize = move_value_to_end_of_array<zmm_vector<int64_t>>(
+            arr, arrsize, (int64_t)X86_SIMD_SORT_NAT);
+    avx512_qsort<int64_t>(arr, arrsize);
+}
+
+inline void avx512_qselect_datetime(int64_t *arr, int64_t k, int64_t arrsize)
+{
+    arrsize = move_value_to_end_of_array<zmm_vector<int64_t>>(
+            arr, arrsize, (int64_t)X86_SIMD_SORT_NAT);
+    if (k < arrsize) { avx512_qselect<int64_t>(arr, k, arrsize); }
+}
+
+inline void
+avx512_partial_qsort_datetime(int64_t *arr, int64_t k, int64_t arrsize)
+{
+    arrsize = move_value_to_end_of_array<zmm_vector<int64_t>>(
+            arr, arrsize, (int64_t)X86_SIMD_SORT_NAT);
+    if (k - 1 < arrsize) { avx512_qselect<int64_t>(arr, k - 1, arrsize); }
+    avx512_qsort<int64_t>(arr, std::min(k - 1, arrsize));
+}
+
 #endif // AVX512_QSORT_64BIT
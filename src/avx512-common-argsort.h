@@ -7,23 +7,33 @@
 #ifndef AVX512_ARGSORT_COMMON
 #define AVX512_ARGSORT_COMMON
 
-#include "avx512-64bit-common.h"
+#include "avx512-common-qsort.h"
+#include "xss-network-keyvaluesort.hpp"
 #include <numeric>
 #include <stdio.h>
 #include <vector>
 
-using argtype = zmm_vector<int64_t>;
-using argzmm_t = typename argtype::reg_t;
+/*
+ * The argsort routines below are written against two vector types: vtype
+ * holds the keys, gathered from the array through the indices, and argtype
+ * holds the 64-bit indices themselves. Both must have the same number of
+ * lanes: zmm_vector<int64_t> with 8 lanes for AVX-512 and
+ * avx2_vector<int64_t> with 4 lanes for AVX2.
+ */
 
 /*
  * Parition one ZMM register based on the pivot and returns the index of the
  * last element that is less than equal to the pivot.
  */
-template <typename vtype, typename type_t, typename reg_t>
+template <typename vtype,
+          typename argtype,
+          typename type_t,
+          typename reg_t,
+          typename argreg_t = typename argtype::reg_t>
 static inline int32_t partition_vec(type_t *arg,
                                     int64_t left,
                                     int64_t right,
-                                    const argzmm_t arg_vec,
+                                    const argreg_t arg_vec,
                                     const reg_t curr_vec,
                                     const reg_t pivot_vec,
                                     reg_t *smallest_vec,
@@ -31,11 +41,8 @@ static inline int32_t partition_vec(type_t *arg,
 {
     /* which elements are larger than the pivot */
     typename vtype::opmask_t gt_mask = vtype::ge(curr_vec, pivot_vec);
-    int32_t amount_gt_pivot = _mm_popcnt_u32((int32_t)gt_mask);
-    argtype::mask_compressstoreu(
-            arg + left, vtype::knot_opmask(gt_mask), arg_vec);
-    argtype::mask_compressstoreu(
-            arg + right - amount_gt_pivot, gt_mask, arg_vec);
+    int32_t amount_gt_pivot = argtype::double_compressstore(
+            arg + left, arg + right - argtype::numlanes, gt_mask, arg_vec);
     *smallest_vec = vtype::min(curr_vec, *smallest_vec);
     *biggest_vec = vtype::max(curr_vec, *biggest_vec);
     return amount_gt_pivot;
@@ -44,7 +51,7 @@ static inline int32_t partition_vec(type_t *arg,
  * Parition an array based on the pivot and returns the index of the
  * last element that is less than equal to the pivot.
  */
-template <typename vtype, typename type_t>
+template <typename vtype, typename argtype, typename type_t>
 static inline int64_t partition_avx512(type_t *arr,
                                        int64_t *arg,
                                        int64_t left,
@@ -69,31 +76,32 @@ static inline int64_t partition_avx512(type_t *arr,
         return left; /* less than vtype::numlanes elements in the array */
 
     using reg_t = typename vtype::reg_t;
+    using argreg_t = typename argtype::reg_t;
     reg_t pivot_vec = vtype::set1(pivot);
     reg_t min_vec = vtype::set1(*smallest);
     reg_t max_vec = vtype::set1(*biggest);
 
     if (right - left == vtype::numlanes) {
-        argzmm_t argvec = argtype::loadu(arg + left);
+        argreg_t argvec = argtype::loadu(arg + left);
         reg_t vec = vtype::template i64gather<sizeof(type_t)>(argvec, arr);
-        int32_t amount_gt_pivot = partition_vec<vtype>(arg,
-                                                       left,
-                                                       left + vtype::numlanes,
-                                                       argvec,
-                                                       vec,
-                                                       pivot_vec,
-                                                       &min_vec,
-                                                       &max_vec);
+        int32_t amount_gt_pivot = partition_vec<vtype, argtype>(arg,
+                                                                left,
+                                                                left + vtype::numlanes,
+                                                                argvec,
+                                                                vec,
+                                                                pivot_vec,
+                                                                &min_vec,
+                                                                &max_vec);
         *smallest = vtype::reducemin(min_vec);
         *biggest = vtype::reducemax(max_vec);
         return left + (vtype::numlanes - amount_gt_pivot);
     }
 
     // first and last vtype::numlanes values are partitioned at the end
-    argzmm_t argvec_left = argtype::loadu(arg + left);
+    argreg_t argvec_left = argtype::loadu(arg + left);
     reg_t vec_left
             = vtype::template i64gather<sizeof(type_t)>(argvec_left, arr);
-    argzmm_t argvec_right = argtype::loadu(arg + (right - vtype::numlanes));
+    argreg_t argvec_right = argtype::loadu(arg + (right - vtype::numlanes));
     reg_t vec_right
             = vtype::template i64gather<sizeof(type_t)>(argvec_right, arr);
     // store points of the vectors
@@ -103,7 +111,7 @@ static inline int64_t partition_avx512(type_t *arr,
     left += vtype::numlanes;
     right -= vtype::numlanes;
     while (right - left != 0) {
-        argzmm_t arg_vec;
+        argreg_t arg_vec;
         reg_t curr_vec;
         /*
          * if fewer elements are stored on the right side of the array,
@@ -122,37 +130,37 @@ static inline int64_t partition_avx512(type_t *arr,
         }
         // partition the current vector and save it on both sides of the array
         int32_t amount_gt_pivot
-                = partition_vec<vtype>(arg,
-                                       l_store,
-                                       r_store + vtype::numlanes,
-                                       arg_vec,
-                                       curr_vec,
-                                       pivot_vec,
-                                       &min_vec,
-                                       &max_vec);
+                = partition_vec<vtype, argtype>(arg,
+                                                l_store,
+                                                r_store + vtype::numlanes,
+                                                arg_vec,
+                                                curr_vec,
+                                                pivot_vec,
+                                                &min_vec,
+                                                &max_vec);
         ;
         r_store -= amount_gt_pivot;
         l_store += (vtype::numlanes - amount_gt_pivot);
     }
 
     /* partition and save vec_left and vec_right */
-    int32_t amount_gt_pivot = partition_vec<vtype>(arg,
-                                                   l_store,
-                                                   r_store + vtype::numlanes,
-                                                   argvec_left,
-                                                   vec_left,
-                                                   pivot_vec,
-                                                   &min_vec,
-                                                   &max_vec);
+    int32_t amount_gt_pivot = partition_vec<vtype, argtype>(arg,
+                                                            l_store,
+                                                            r_store + vtype::numlanes,
+                                                            argvec_left,
+                                                            vec_left,
+                                                            pivot_vec,
+                                                            &min_vec,
+                                                            &max_vec);
     l_store += (vtype::numlanes - amount_gt_pivot);
-    amount_gt_pivot = partition_vec<vtype>(arg,
-                                           l_store,
-                                           l_store + vtype::numlanes,
-                                           argvec_right,
-                                           vec_right,
-                                           pivot_vec,
-                                           &min_vec,
-                                           &max_vec);
+    amount_gt_pivot = partition_vec<vtype, argtype>(arg,
+                                                    l_store,
+                                                    l_store + vtype::numlanes,
+                                                    argvec_right,
+                                                    vec_right,
+                                                    pivot_vec,
+                                                    &min_vec,
+                                                    &max_vec);
     l_store += (vtype::numlanes - amount_gt_pivot);
     *smallest = vtype::reducemin(min_vec);
     *biggest = vtype::reducemax(max_vec);
@@ -160,6 +168,7 @@ static inline int64_t partition_avx512(type_t *arr,
 }
 
 template <typename vtype,
+          typename argtype,
           int num_unroll,
           typename type_t = typename vtype::type_t>
 static inline int64_t partition_avx512_unrolled(type_t *arr,
@@ -171,7 +180,7 @@ static inline int64_t partition_avx512_unrolled(type_t *arr,
                                                 type_t *biggest)
 {
     if (right - left <= 8 * num_unroll * vtype::numlanes) {
-        return partition_avx512<vtype>(
+        return partition_avx512<vtype, argtype>(
                 arr, arg, left, right, pivot, smallest, biggest);
     }
     /* make array length divisible by vtype::numlanes , shortening the array */
@@ -191,13 +200,14 @@ static inline int64_t partition_avx512_unrolled(type_t *arr,
         return left; /* less than vtype::numlanes elements in the array */
 
     using reg_t = typename vtype::reg_t;
+    using argreg_t = typename argtype::reg_t;
     reg_t pivot_vec = vtype::set1(pivot);
     reg_t min_vec = vtype::set1(*smallest);
     reg_t max_vec = vtype::set1(*biggest);
 
     // first and last vtype::numlanes values are partitioned at the end
     reg_t vec_left[num_unroll], vec_right[num_unroll];
-    argzmm_t argvec_left[num_unroll], argvec_right[num_unroll];
+    argreg_t argvec_left[num_unroll], argvec_right[num_unroll];
 X86_SIMD_SORT_UNROLL_LOOP(8)
     for (int ii = 0; ii < num_unroll; ++ii) {
         argvec_left[ii] = argtype::loadu(arg + left + vtype::numlanes * ii);
@@ -215,7 +225,7 @@ X86_SIMD_SORT_UNROLL_LOOP(8)
     left += num_unroll * vtype::numlanes;
     right -= num_unroll * vtype::numlanes;
     while (right - left != 0) {
-        argzmm_t arg_vec[num_unroll];
+        argreg_t arg_vec[num_unroll];
         reg_t curr_vec[num_unroll];
         /*
          * if fewer elements are stored on the right side of the array,
@@ -245,14 +255,14 @@ X86_SIMD_SORT_UNROLL_LOOP(8)
 X86_SIMD_SORT_UNROLL_LOOP(8)
         for (int ii = 0; ii < num_unroll; ++ii) {
             int32_t amount_gt_pivot
-                    = partition_vec<vtype>(arg,
-                                           l_store,
-                                           r_store + vtype::numlanes,
-                                           arg_vec[ii],
-                                           curr_vec[ii],
-                                           pivot_vec,
-                                           &min_vec,
-                                           &max_vec);
+                    = partition_vec<vtype, argtype>(arg,
+                                                    l_store,
+                                                    r_store + vtype::numlanes,
+                                                    arg_vec[ii],
+                                                    curr_vec[ii],
+                                                    pivot_vec,
+                                                    &min_vec,
+                                                    &max_vec);
             l_store += (vtype::numlanes - amount_gt_pivot);
             r_store -= amount_gt_pivot;
         }
@@ -262,28 +272,28 @@ X86_SIMD_SORT_UNROLL_LOOP(8)
 X86_SIMD_SORT_UNROLL_LOOP(8)
     for (int ii = 0; ii < num_unroll; ++ii) {
         int32_t amount_gt_pivot
-                = partition_vec<vtype>(arg,
-                                       l_store,
-                                       r_store + vtype::numlanes,
-                                       argvec_left[ii],
-                                       vec_left[ii],
-                                       pivot_vec,
-                                       &min_vec,
-                                       &max_vec);
+                = partition_vec<vtype, argtype>(arg,
+                                                l_store,
+                                                r_store + vtype::numlanes,
+                                                argvec_left[ii],
+                                                vec_left[ii],
+                                                pivot_vec,
+                                                &min_vec,
+                                                &max_vec);
         l_store += (vtype::numlanes - amount_gt_pivot);
         r_store -= amount_gt_pivot;
     }
 X86_SIMD_SORT_UNROLL_LOOP(8)
     for (int ii = 0; ii < num_unroll; ++ii) {
         int32_t amount_gt_pivot
-                = partition_vec<vtype>(arg,
-                                       l_store,
-                                       r_store + vtype::numlanes,
-                                       argvec_right[ii],
-                                       vec_right[ii],
-                                       pivot_vec,
-                                       &min_vec,
-                                       &max_vec);
+                = partition_vec<vtype, argtype>(arg,
+                                                l_store,
+                                                r_store + vtype::numlanes,
+                                                argvec_right[ii],
+                                                vec_right[ii],
+                                                pivot_vec,
+                                                &min_vec,
+                                                &max_vec);
         l_store += (vtype::numlanes - amount_gt_pivot);
         r_store -= amount_gt_pivot;
     }
@@ -291,4 +301,180 @@ X86_SIMD_SORT_UNROLL_LOOP(8)
     *biggest = vtype::reducemax(max_vec);
     return l_store;
 }
+/* NAN's go to the end, also with descending = true */
+template <bool descending = false, typename T>
+X86_SIMD_SORT_INLINE void std_argselect_withnan(
+        T *arr, int64_t *arg, int64_t k, int64_t left, int64_t right)
+{
+    std::nth_element(arg + left,
+                     arg + k,
+                     arg + right,
+                     [arr](int64_t a, int64_t b) -> bool {
+                         if ((!std::isnan(arr[a])) && (!std::isnan(arr[b]))) {
+                             return descending ? arr[b] < arr[a]
+                                               : arr[a] < arr[b];
+                         }
+                         else if (std::isnan(arr[a])) {
+                             return false;
+                         }
+                         else {
+                             return true;
+                         }
+                     });
+}
+
+/* argsort using std::sort, NAN's go to the end */
+template <bool descending = false, typename T>
+X86_SIMD_SORT_INLINE void
+std_argsort_withnan(T *arr, int64_t *arg, int64_t left, int64_t right)
+{
+    std::sort(arg + left,
+              arg + right,
+              [arr](int64_t left, int64_t right) -> bool {
+                  if ((!std::isnan(arr[left])) && (!std::isnan(arr[right]))) {
+                      return descending ? arr[right] < arr[left]
+                                        : arr[left] < arr[right];
+                  }
+                  else if (std::isnan(arr[left])) {
+                      return false;
+                  }
+                  else {
+                      return true;
+                  }
+              });
+}
+
+/* argsort using std::sort */
+template <typename vtype, typename T>
+X86_SIMD_SORT_INLINE void
+std_argsort(T *arr, int64_t *arg, int64_t left, int64_t right)
+{
+    std::sort(arg + left,
+              arg + right,
+              [arr](int64_t left, int64_t right) -> bool {
+                  // sort indices according to corresponding array element
+                  return comparison_func<vtype>(arr[left], arr[right]);
+              });
+}
+
+/*
+ * Moves the indices of the NAN's to the end of arg and returns the number of
+ * the other ones, for the types std::isnan doesn't know about
+ */
+template <typename T, typename F>
+X86_SIMD_SORT_INLINE int64_t move_nan_args_to_end(T *arr,
+                                                  int64_t *arg,
+                                                  int64_t arrsize,
+                                                  F is_nan)
+{
+    int64_t jj = arrsize - 1;
+    int64_t ii = 0;
+    while (ii <= jj) {
+        if (is_nan(arr[arg[ii]])) {
+            std::swap(arg[ii], arg[jj]);
+            jj -= 1;
+        }
+        else {
+            ii += 1;
+        }
+    }
+    return ii;
+}
+
+template <typename vtype, typename argtype, typename type_t>
+X86_SIMD_SORT_INLINE type_t get_pivot_64bit(type_t *arr,
+                                            int64_t *arg,
+                                            const int64_t left,
+                                            const int64_t right)
+{
+    if (right - left >= vtype::numlanes) {
+        // median of vtype::numlanes
+        int64_t size = (right - left) / vtype::numlanes;
+        using reg_t = typename vtype::reg_t;
+        int64_t samples[vtype::numlanes];
+        for (int i = 0; i < vtype::numlanes; ++i) {
+            samples[i] = arg[left + (i + 1) * size];
+        }
+        reg_t rand_vec = vtype::template i64gather<sizeof(type_t)>(
+                argtype::loadu(samples), arr);
+        // pivot will never be a nan, since there are no nan's!
+        type_t sorted[vtype::numlanes];
+        vtype::storeu(sorted, vtype::sort_vec(rand_vec));
+        return sorted[vtype::numlanes / 2];
+    }
+    else {
+        return arr[arg[right]];
+    }
+}
+
+template <typename vtype, typename argtype, typename type_t>
+static void argsort_64bit_(type_t *arr,
+                           int64_t *arg,
+                           int64_t left,
+                           int64_t right,
+                           int64_t max_iters)
+{
+    /*
+     * Resort to std::sort if quicksort isnt making any progress
+     */
+    if (max_iters <= 0) {
+        std_argsort<vtype>(arr, arg, left, right + 1);
+        return;
+    }
+    /*
+     * Base case: use bitonic networks to sort arrays <= 8 registers
+     */
+    if (right + 1 - left <= 8 * vtype::numlanes) {
+        argsort_n<vtype, argtype, 8 * vtype::numlanes>(
+                arr, arg + left, (int32_t)(right + 1 - left));
+        return;
+    }
+    type_t pivot = get_pivot_64bit<vtype, argtype>(arr, arg, left, right);
+    type_t smallest = vtype::type_max();
+    type_t biggest = vtype::type_min();
+    int64_t pivot_index = partition_avx512_unrolled<vtype, argtype, 4>(
+            arr, arg, left, right + 1, pivot, &smallest, &biggest);
+    if (pivot != smallest)
+        argsort_64bit_<vtype, argtype>(
+                arr, arg, left, pivot_index - 1, max_iters - 1);
+    if (pivot != biggest)
+        argsort_64bit_<vtype, argtype>(
+                arr, arg, pivot_index, right, max_iters - 1);
+}
+
+template <typename vtype, typename argtype, typename type_t>
+static void argselect_64bit_(type_t *arr,
+                             int64_t *arg,
+                             int64_t pos,
+                             int64_t left,
+                             int64_t right,
+                             int64_t max_iters)
+{
+    /*
+     * Resort to std::sort if quicksort isnt making any progress
+     */
+    if (max_iters <= 0) {
+        std_argsort<vtype>(arr, arg, left, right + 1);
+        return;
+    }
+    /*
+     * Base case: use bitonic networks to sort arrays <= 8 registers
+     */
+    if (right + 1 - left <= 8 * vtype::numlanes) {
+        argsort_n<vtype, argtype, 8 * vtype::numlanes>(
+                arr, arg + left, (int32_t)(right + 1 - left));
+        return;
+    }
+    type_t pivot = get_pivot_64bit<vtype, argtype>(arr, arg, left, right);
+    type_t smallest = vtype::type_max();
+    type_t biggest = vtype::type_min();
+    int64_t pivot_index = partition_avx512_unrolled<vtype, argtype, 4>(
+            arr, arg, left, right + 1, pivot, &smallest, &biggest);
+    if ((pivot != smallest) && (pos < pivot_index))
+        argselect_64bit_<vtype, argtype>(
+                arr, arg, pos, left, pivot_index - 1, max_iters - 1);
+    else if ((pivot != biggest) && (pos >= pivot_index))
+        argselect_64bit_<vtype, argtype>(
+                arr, arg, pos, pivot_index, right, max_iters - 1);
+}
 #endif // AVX512_ARGSORT_COMMON
@@ -0,0 +1,180 @@
+/*******************************************************************
+ * Copyright (C) 2022 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * Authors: Liu Zhuan <zhuan.liu@intel.com>
+ *          Tang Xi <xi.tang@intel.com>
+ * ****************************************************************/
+
+#ifndef AVX512_KEYVALUESORT_COMMON
+#define AVX512_KEYVALUESORT_COMMON
+
+#include "avx512-common-qsort.h"
+#include "xss-network-keyvaluesort.hpp"
+
+/*
+ * Key-value quicksort shared by the AVX-512 and AVX2 backends: vtype1 sorts
+ * the keys and vtype2 moves the values along with them. Both vector types
+ * need the same number of lanes.
+ */
+
+template <typename vtype1,
+          typename vtype2,
+          typename type1_t = typename vtype1::type_t,
+          typename type2_t = typename vtype2::type_t>
+void heapify(type1_t *keys, type2_t *indexes, int64_t idx, int64_t size)
+{
+    int64_t i = idx;
+    while (true) {
+        int64_t j = 2 * i + 1;
+        if (j >= size || j < 0) { break; }
+        int k = j + 1;
+        if (k < size && comparison_func<vtype1>(keys[j], keys[k])) { j = k; }
+        if (comparison_func<vtype1>(keys[j], keys[i])) { break; }
+        std::swap(keys[i], keys[j]);
+        std::swap(indexes[i], indexes[j]);
+        i = j;
+    }
+}
+template <typename vtype1,
+          typename vtype2,
+          typename type1_t = typename vtype1::type_t,
+          typename type2_t = typename vtype2::type_t>
+void heap_sort(type1_t *keys, type2_t *indexes, int64_t size)
+{
+    for (int64_t i = size / 2 - 1; i >= 0; i--) {
+        heapify<vtype1, vtype2>(keys, indexes, i, size);
+    }
+    for (int64_t i = size - 1; i > 0; i--) {
+        std::swap(keys[0], keys[i]);
+        std::swap(indexes[0], indexes[i]);
+        heapify<vtype1, vtype2>(keys, indexes, 0, i);
+    }
+}
+
+template <typename vtype1,
+          typename vtype2,
+          typename type1_t = typename vtype1::type_t,
+          typename type2_t = typename vtype2::type_t>
+void qsort_64bit_(type1_t *keys,
+                  type2_t *indexes,
+                  int64_t left,
+                  int64_t right,
+                  int64_t max_iters)
+{
+    /*
+     * Resort to std::sort if quicksort isnt making any progress
+     */
+    if (max_iters <= 0) {
+        //std::sort(keys+left,keys+right+1);
+        heap_sort<vtype1, vtype2>(
+                keys + left, indexes + left, right - left + 1);
+        return;
+    }
+    /*
+     * Base case: use bitonic networks to sort arrays <= 16 registers
+     */
+    if (right + 1 - left <= 16 * vtype1::numlanes) {
+        kvsort_n<vtype1, vtype2, 16 * vtype1::numlanes>(
+                keys + left, indexes + left, (int32_t)(right + 1 - left));
+        return;
+    }
+
+    type1_t pivot = get_pivot<vtype1>(keys, left, right);
+    type1_t smallest = vtype1::type_max();
+    type1_t biggest = vtype1::type_min();
+    int64_t pivot_index = partition_avx512_kv<vtype1, vtype2>(
+            keys, indexes, left, right + 1, pivot, &smallest, &biggest);
+    if (pivot != smallest) {
+        qsort_64bit_<vtype1, vtype2>(
+                keys, indexes, left, pivot_index - 1, max_iters - 1);
+    }
+    if (pivot != biggest) {
+        qsort_64bit_<vtype1, vtype2>(
+                keys, indexes, pivot_index, right, max_iters - 1);
+    }
+}
+
+template <typename keytype, typename valtype, typename T1, typename T2>
+X86_SIMD_SORT_INLINE void xss_qsort_kv(T1 *keys, T2 *indexes, int64_t arrsize)
+{
+    if (arrsize > 1) {
+        if constexpr (!std::is_integral_v<T1>) {
+            int64_t nan_count = replace_nan_with_inf<keytype>(keys, arrsize);
+            qsort_64bit_<keytype, valtype>(
+                    keys, indexes, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+            replace_inf_with_nan(keys, arrsize, nan_count);
+        }
+        else {
+            qsort_64bit_<keytype, valtype>(
+                    keys, indexes, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+        }
+    }
+}
+
+/*
+ * Moves the pairs whose key is a NAN to the end and returns the number of the
+ * other ones, for the key types std::isnan doesn't know about
+ */
+template <typename T1, typename T2, typename F>
+X86_SIMD_SORT_INLINE int64_t move_nan_kv_to_end(T1 *keys,
+                                                T2 *indexes,
+                                                int64_t arrsize,
+                                                F is_nan)
+{
+    int64_t jj = arrsize - 1;
+    int64_t ii = 0;
+    while (ii <= jj) {
+        if (is_nan(keys[ii])) {
+            std::swap(keys[ii], keys[jj]);
+            std::swap(indexes[ii], indexes[jj]);
+            jj -= 1;
+        }
+        else {
+            ii += 1;
+        }
+    }
+    return ii;
+}
+
+/* The vector types avx512_qsort_kv sorts T1 keys and T2 values with */
+template <typename T1, typename T2>
+struct avx512_kv_vectors {
+    static constexpr bool both_32bit = sizeof(T1) == 4 && sizeof(T2) == 4;
+    using keytype = typename std::conditional<both_32bit,
+                                              zmm_vector<T1>,
+                                              avx512_8lane_vector<T1>>::type;
+    using valtype = typename std::conditional<both_32bit,
+                                              zmm_vector<T2>,
+                                              avx512_8lane_vector<T2>>::type;
+};
+
+/*
+ * Sorts keys and moves values along with them. 32-bit keys with 32-bit values
+ * are sorted 16 pairs per zmm register (avx512-32bit-keyvaluesort.hpp). Every
+ * other combination is sorted 8 pairs at a time, with the keys and the values
+ * each in the register that holds 8 of them, like in argsort: 64-bit types in
+ * a zmm, 32-bit types in a ymm (avx512-64bit-keyvaluesort.hpp) and 16-bit
+ * types in an xmm (avx512-16bit-keyvaluesort.hpp). descending = true sorts
+ * the keys in descending order, NAN's still go to the end.
+ *
+ * Keys that are not integers are floating point, std::is_floating_point_v is
+ * false for _Float16 unless c++-23.
+ */
+template <typename T1, typename T2>
+void avx512_qsort_kv(T1 *keys,
+                     T2 *indexes,
+                     int64_t arrsize,
+                     bool descending = false)
+{
+    using keytype = typename avx512_kv_vectors<T1, T2>::keytype;
+    using valtype = typename avx512_kv_vectors<T1, T2>::valtype;
+    if (descending) {
+        xss_qsort_kv<descending_vector<keytype>, valtype>(
+                keys, indexes, arrsize);
+    }
+    else {
+        xss_qsort_kv<keytype, valtype>(keys, indexes, arrsize);
+    }
+}
+
+#endif // AVX512_KEYVALUESORT_COMMON
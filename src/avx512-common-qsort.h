@@ -41,11 +41,14 @@
 #include <cstring>
 #include <immintrin.h>
 #include <limits>
+#include <type_traits>
 
 #define X86_SIMD_SORT_INFINITY std::numeric_limits<double>::infinity()
 #define X86_SIMD_SORT_INFINITYF std::numeric_limits<float>::infinity()
 #define X86_SIMD_SORT_INFINITYH 0x7c00
 #define X86_SIMD_SORT_NEGINFINITYH 0xfc00
+#define X86_SIMD_SORT_INFINITYBF16 0x7f80
+#define X86_SIMD_SORT_NEGINFINITYBF16 0xff80
 #define X86_SIMD_SORT_MAX_UINT16 std::numeric_limits<uint16_t>::max()
 #define X86_SIMD_SORT_MAX_INT16 std::numeric_limits<int16_t>::max()
 #define X86_SIMD_SORT_MIN_INT16 std::numeric_limits<int16_t>::min()
@@ -55,6 +58,8 @@
 #define X86_SIMD_SORT_MAX_UINT64 std::numeric_limits<uint64_t>::max()
 #define X86_SIMD_SORT_MAX_INT64 std::numeric_limits<int64_t>::max()
 #define X86_SIMD_SORT_MIN_INT64 std::numeric_limits<int64_t>::min()
+/* NumPy's NaT (not a time) for datetime64 and timedelta64 */
+#define X86_SIMD_SORT_NAT X86_SIMD_SORT_MIN_INT64
 #define ZMM_MAX_DOUBLE _mm512_set1_pd(X86_SIMD_SORT_INFINITY)
 #define ZMM_MAX_UINT64 _mm512_set1_epi64(X86_SIMD_SORT_MAX_UINT64)
 #define ZMM_MAX_INT64 _mm512_set1_epi64(X86_SIMD_SORT_MAX_INT64)
@@ -106,14 +111,60 @@ struct zmm_vector;
 template <typename type>
 struct ymm_vector;
 
+template <typename type>
+struct xmm_vector;
+
+/*
+ * The AVX-512 vector type with 8 lanes of T, to pair T with 8 64-bit indices
+ * or values in a zmm register: argsort and mixed width key-value sort
+ */
+template <typename T>
+using avx512_8lane_vector = typename std::conditional<
+        sizeof(T) == sizeof(int64_t),
+        zmm_vector<T>,
+        typename std::conditional<sizeof(T) == sizeof(int32_t),
+                                  ymm_vector<T>,
+                                  xmm_vector<T>>::type>::type;
+
+template <typename type>
+struct avx2_vector;
+
+template <typename type>
+struct avx2_half_vector;
+
+/*
+ * Tag for half-precision floats stored as uint16_t, for compilers and CPUs
+ * without _Float16 / AVX512-FP16: vtype<float16>::type_t is uint16_t.
+ */
+struct float16 {
+    uint16_t val;
+};
+
+/* Same for bfloat16: vtype<bfloat16>::type_t is uint16_t */
+struct bfloat16 {
+    uint16_t val;
+};
+
+/* bfloat16 is the upper half of a float: 8 exponent and 7 mantissa bits */
+X86_SIMD_SORT_INLINE bool is_a_nan_bf16(uint16_t elem)
+{
+    return (elem & 0x7fff) > X86_SIMD_SORT_INFINITYBF16;
+}
+
 template <typename T>
-bool is_a_nan(T elem)
+X86_SIMD_SORT_INLINE bool is_a_nan(T elem)
 {
     return std::isnan(elem);
 }
 
+template <>
+inline bool is_a_nan<uint16_t>(uint16_t elem)
+{
+    return (elem & 0x7fff) > X86_SIMD_SORT_INFINITYH;
+}
+
 template <typename vtype, typename T>
-int64_t replace_nan_with_inf(T *arr, int64_t arrsize)
+X86_SIMD_SORT_INLINE int64_t replace_nan_with_inf(T *arr, int64_t arrsize)
 {
     int64_t nan_count = 0;
     using opmask_t = typename vtype::opmask_t;
@@ -138,7 +189,7 @@ int64_t replace_nan_with_inf(T *arr, int64_t arrsize)
 }
 
 template <typename vtype, typename type_t>
-bool has_nan(type_t *arr, int64_t arrsize)
+X86_SIMD_SORT_INLINE bool has_nan(type_t *arr, int64_t arrsize)
 {
     using opmask_t = typename vtype::opmask_t;
     using reg_t = typename vtype::reg_t;
@@ -165,7 +216,8 @@ bool has_nan(type_t *arr, int64_t arrsize)
 }
 
 template <typename type_t>
-void replace_inf_with_nan(type_t *arr, int64_t arrsize, int64_t nan_count)
+X86_SIMD_SORT_INLINE void
+replace_inf_with_nan(type_t *arr, int64_t arrsize, int64_t nan_count)
 {
     for (int64_t ii = arrsize - 1; nan_count > 0; --ii) {
         if constexpr (std::is_floating_point_v<type_t>) {
@@ -180,16 +232,18 @@ void replace_inf_with_nan(type_t *arr, int64_t arrsize, int64_t nan_count)
 
 /*
  * Sort all the NAN's to end of the array and return the index of the last elem
- * in the array which is not a nan
+ * in the array which is not a nan. is_nan defaults to is_a_nan<T>.
  */
-template <typename T>
-int64_t move_nans_to_end_of_array(T *arr, int64_t arrsize)
+template <typename T, typename F>
+X86_SIMD_SORT_INLINE int64_t move_nans_to_end_of_array(T *arr,
+                                                       int64_t arrsize,
+                                                       F is_nan)
 {
     int64_t jj = arrsize - 1;
     int64_t ii = 0;
     int64_t count = 0;
     while (ii <= jj) {
-        if (is_a_nan(arr[ii])) {
+        if (is_nan(arr[ii])) {
             std::swap(arr[ii], arr[jj]);
             jj -= 1;
             count++;
@@ -201,10 +255,164 @@ int64_t move_nans_to_end_of_array(T *arr, int64_t arrsize)
     return arrsize - count - 1;
 }
 
+template <typename T>
+X86_SIMD_SORT_INLINE int64_t move_nans_to_end_of_array(T *arr, int64_t arrsize)
+{
+    return move_nans_to_end_of_array(arr, arrsize, is_a_nan<T>);
+}
+
+/*
+ * Vector version of move_nans_to_end_of_array for a sentinel value such as
+ * NaT: compresses the other values to the front in a single pass, writing
+ * only once the first sentinel has been seen, and fills the rest of the array
+ * with the sentinel. Returns the number of other values.
+ */
+template <typename vtype, typename type_t>
+X86_SIMD_SORT_INLINE int64_t move_value_to_end_of_array(type_t *arr,
+                                                        int64_t arrsize,
+                                                        type_t value)
+{
+    using opmask_t = typename vtype::opmask_t;
+    using reg_t = typename vtype::reg_t;
+    const reg_t value_vec = vtype::set1(value);
+    int64_t l_store = 0;
+    for (int64_t ii = 0; ii < arrsize; ii += vtype::numlanes) {
+        int64_t num = std::min<int64_t>(vtype::numlanes, arrsize - ii);
+        opmask_t loadmask = (opmask_t)(~0ull >> (64 - num));
+        reg_t in = vtype::maskz_loadu(loadmask, arr + ii);
+        opmask_t keep = loadmask & vtype::knot_opmask(vtype::eq(in, value_vec));
+        if (l_store != ii || keep != loadmask) {
+            vtype::mask_compressstoreu(arr + l_store, keep, in);
+        }
+        l_store += _mm_popcnt_u32((int32_t)keep);
+    }
+    std::fill(arr + l_store, arr + arrsize, value);
+    return l_store;
+}
+
+template <typename vtype, typename type_t>
+X86_SIMD_SORT_INLINE bool has_value(type_t *arr, int64_t arrsize, type_t value)
+{
+    using opmask_t = typename vtype::opmask_t;
+    using reg_t = typename vtype::reg_t;
+    const reg_t value_vec = vtype::set1(value);
+    for (int64_t ii = 0; ii < arrsize; ii += vtype::numlanes) {
+        int64_t num = std::min<int64_t>(vtype::numlanes, arrsize - ii);
+        opmask_t loadmask = (opmask_t)(~0ull >> (64 - num));
+        reg_t in = vtype::maskz_loadu(loadmask, arr + ii);
+        if (loadmask & vtype::eq(in, value_vec)) { return true; }
+    }
+    return false;
+}
+
+/*
+ * Arrow style validity bitmaps: arr[ii] is valid (not null) if bit ii % 8 of
+ * validity[ii / 8] is set. Returns the bits of arr[start, start + num) as an
+ * opmask, start has to be a multiple of vtype::numlanes (and so of 8).
+ */
+template <typename vtype>
+X86_SIMD_SORT_INLINE typename vtype::opmask_t
+get_validity_mask(const uint8_t *validity, int64_t start, int64_t num)
+{
+    uint64_t bits = 0;
+    if (num >= vtype::numlanes) {
+        std::memcpy(&bits, validity + start / 8, vtype::numlanes / 8);
+    }
+    else {
+        std::memcpy(&bits, validity + start / 8, (num + 7) / 8);
+        bits &= ~0ull >> (64 - num);
+    }
+    return (typename vtype::opmask_t)bits;
+}
+
+X86_SIMD_SORT_INLINE int64_t count_valid(const uint8_t *validity,
+                                         int64_t arrsize)
+{
+    int64_t count = 0;
+    int64_t ii = 0;
+    for (; ii + 64 <= arrsize; ii += 64) {
+        uint64_t bits;
+        std::memcpy(&bits, validity + ii / 8, sizeof(bits));
+        count += _mm_popcnt_u64(bits);
+    }
+    for (; ii < arrsize; ++ii) {
+        count += (validity[ii / 8] >> (ii % 8)) & 1;
+    }
+    return count;
+}
+
+/*
+ * Compresses the valid values to the front of arr, loading them with the
+ * validity bits as the opmask, and returns their number. Like
+ * move_value_to_end_of_array it doesn't write anything before the first null.
+ * What is left in the other slots is unspecified.
+ */
+template <typename vtype, typename type_t>
+X86_SIMD_SORT_INLINE int64_t move_nulls_to_end(type_t *arr,
+                                               int64_t arrsize,
+                                               const uint8_t *validity)
+{
+    using opmask_t = typename vtype::opmask_t;
+    int64_t l_store = 0;
+    for (int64_t ii = 0; ii < arrsize; ii += vtype::numlanes) {
+        int64_t num = std::min<int64_t>(vtype::numlanes, arrsize - ii);
+        opmask_t valid = get_validity_mask<vtype>(validity, ii, num);
+        int32_t num_valid = _mm_popcnt_u32((int32_t)valid);
+        if (l_store != ii || num_valid != num) {
+            vtype::mask_compressstoreu(
+                    arr + l_store,
+                    valid,
+                    vtype::mask_loadu(vtype::zmm_max(), valid, arr + ii));
+        }
+        l_store += num_valid;
+    }
+    return l_store;
+}
+
+/* Same, but compresses the valid values to the back and returns the nulls */
+template <typename vtype, typename type_t>
+X86_SIMD_SORT_INLINE int64_t move_nulls_to_front(type_t *arr,
+                                                 int64_t arrsize,
+                                                 const uint8_t *validity)
+{
+    using opmask_t = typename vtype::opmask_t;
+    int64_t r_store = arrsize;
+    int64_t ii = arrsize - arrsize % vtype::numlanes;
+    if (ii == arrsize) { ii -= vtype::numlanes; }
+    for (; ii >= 0; ii -= vtype::numlanes) {
+        int64_t num = std::min<int64_t>(vtype::numlanes, arrsize - ii);
+        opmask_t valid = get_validity_mask<vtype>(validity, ii, num);
+        int32_t num_valid = _mm_popcnt_u32((int32_t)valid);
+        if (r_store != ii + num || num_valid != num) {
+            vtype::mask_compressstoreu(
+                    arr + r_store - num_valid,
+                    valid,
+                    vtype::mask_loadu(vtype::zmm_max(), valid, arr + ii));
+        }
+        r_store -= num_valid;
+    }
+    return r_store;
+}
+
+/* True for descending_vector<vtype>, see below */
+template <typename vtype, typename = void>
+struct xss_is_descending : std::false_type {
+};
+
+template <typename vtype>
+struct xss_is_descending<vtype, std::void_t<typename vtype::ascending_vtype>>
+    : std::true_type {
+};
+
 template <typename vtype, typename T = typename vtype::type_t>
-bool comparison_func(const T &a, const T &b)
+X86_SIMD_SORT_INLINE bool comparison_func(const T &a, const T &b)
 {
-    return a < b;
+    if constexpr (xss_is_descending<vtype>::value) {
+        return comparison_func<typename vtype::ascending_vtype>(b, a);
+    }
+    else {
+        return a < b;
+    }
 }
 
 /*
@@ -226,6 +434,138 @@ static inline reg_t cmp_merge(reg_t in1, reg_t in2, opmask_t mask)
     reg_t max = vtype::max(in2, in1);
     return vtype::mask_mov(min, mask, max); // 0 -> min, 1 -> max
 }
+/*
+ * Stores the elements of reg that are less than the pivot (k == 0) at
+ * left_addr and the ones greater than or equal to it (k == 1) at the end of
+ * the numlanes wide block starting at right_addr. Returns popcnt(k).
+ */
+template <typename vtype,
+          typename type_t = typename vtype::type_t,
+          typename reg_t = typename vtype::reg_t,
+          typename opmask_t = typename vtype::opmask_t>
+X86_SIMD_SORT_INLINE int avx512_double_compressstore(type_t *left_addr,
+                                                     type_t *right_addr,
+                                                     opmask_t k,
+                                                     reg_t reg)
+{
+    int amount_ge_pivot = _mm_popcnt_u32((int32_t)k);
+    vtype::mask_compressstoreu(left_addr, vtype::knot_opmask(k), reg);
+    vtype::mask_compressstoreu(
+            right_addr + vtype::numlanes - amount_ge_pivot, k, reg);
+    return amount_ge_pivot;
+}
+
+/*
+ * Same as avx512_double_compressstore, but compresses into a register and
+ * writes it out with two full width stores. vpcompress with a memory operand
+ * is microcoded on AMD Zen4 and much slower than this there. Overwriting the
+ * slots past the compressed elements is safe for the same reason as in
+ * avx2_double_compressstore32: the partitioning code always has at least
+ * numlanes free slots at both store points.
+ */
+template <typename vtype,
+          typename type_t = typename vtype::type_t,
+          typename reg_t = typename vtype::reg_t,
+          typename opmask_t = typename vtype::opmask_t>
+X86_SIMD_SORT_INLINE int avx512_double_compress_to_register(type_t *left_addr,
+                                                            type_t *right_addr,
+                                                            opmask_t k,
+                                                            reg_t reg)
+{
+    int amount_ge_pivot = _mm_popcnt_u32((int32_t)k);
+    opmask_t high_lanes
+            = (opmask_t)(~0ull << (vtype::numlanes - amount_ge_pivot));
+    reg_t temp = vtype::mask_expand(
+            vtype::maskz_compress(vtype::knot_opmask(k), reg),
+            high_lanes,
+            vtype::maskz_compress(k, reg));
+    vtype::storeu(left_addr, temp);
+    vtype::storeu(right_addr, temp);
+    return amount_ge_pivot;
+}
+
+/*
+ * vtype that partitions with avx512_double_compress_to_register, everything
+ * else is inherited from the ZMM vtype it wraps. Used on AMD Zen4, see
+ * zmm_partition_vector below.
+ */
+template <typename vtype>
+struct zmm_vector_regcompress : public vtype {
+    using type_t = typename vtype::type_t;
+    using reg_t = typename vtype::reg_t;
+    using opmask_t = typename vtype::opmask_t;
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx512_double_compress_to_register<vtype>(
+                left_addr, right_addr, k, reg);
+    }
+};
+
+/*
+ * vtype that sorts in descending order: the comparisons, min/max and their
+ * reductions, the padding and the single register networks are those of the
+ * vtype it wraps with the order reversed, so the partitioning and the sorting
+ * networks written against vtype sort in descending order without any extra
+ * pass over the array. The networks of a single register are the wrapped
+ * ones followed by a reverse, since they are not written against vtype.
+ * NaN's are replaced with -inf (zmm_max) and so still end up last.
+ */
+template <typename vtype>
+struct descending_vector : public vtype {
+    using ascending_vtype = vtype;
+    using type_t = typename vtype::type_t;
+    using reg_t = typename vtype::reg_t;
+    using opmask_t = typename vtype::opmask_t;
+
+    static type_t type_max()
+    {
+        return vtype::type_min();
+    }
+    static type_t type_min()
+    {
+        return vtype::type_max();
+    }
+    static reg_t zmm_max()
+    {
+        return vtype::set1(vtype::type_min());
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        return vtype::ge(y, x);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return vtype::min(x, y);
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return vtype::max(x, y);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        return vtype::reducemin(v);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        return vtype::reducemax(v);
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        return vtype::reverse(vtype::bitonic_merge(x));
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return vtype::reverse(vtype::sort_vec(x));
+    }
+    static void histogram_sort(type_t *arr, int64_t arrsize)
+    {
+        vtype::template histogram_sort<true>(arr, arrsize);
+    }
+};
+
 /*
  * Parition one ZMM register based on the pivot and returns the
  * number of elements that are greater than or equal to the pivot.
@@ -241,11 +581,8 @@ static inline int32_t partition_vec(type_t *arr,
 {
     /* which elements are larger than or equal to the pivot */
     typename vtype::opmask_t ge_mask = vtype::ge(curr_vec, pivot_vec);
-    int32_t amount_ge_pivot = _mm_popcnt_u32((int32_t)ge_mask);
-    vtype::mask_compressstoreu(
-            arr + left, vtype::knot_opmask(ge_mask), curr_vec);
-    vtype::mask_compressstoreu(
-            arr + right - amount_ge_pivot, ge_mask, curr_vec);
+    int32_t amount_ge_pivot = vtype::double_compressstore(
+            arr + left, arr + right - vtype::numlanes, ge_mask, curr_vec);
     *smallest_vec = vtype::min(curr_vec, *smallest_vec);
     *biggest_vec = vtype::max(curr_vec, *biggest_vec);
     return amount_ge_pivot;
@@ -539,22 +876,20 @@ static inline int32_t partition_vec(type_t1 *keys,
 {
     /* which elements are larger than the pivot */
     typename vtype1::opmask_t gt_mask = vtype1::ge(keys_vec, pivot_vec);
-    int32_t amount_gt_pivot = _mm_popcnt_u32((int32_t)gt_mask);
-    vtype1::mask_compressstoreu(
-            keys + left, vtype1::knot_opmask(gt_mask), keys_vec);
-    vtype1::mask_compressstoreu(
-            keys + right - amount_gt_pivot, gt_mask, keys_vec);
-    vtype2::mask_compressstoreu(
-            indexes + left, vtype2::knot_opmask(gt_mask), indexes_vec);
-    vtype2::mask_compressstoreu(
-            indexes + right - amount_gt_pivot, gt_mask, indexes_vec);
+    int32_t amount_gt_pivot = vtype1::double_compressstore(
+            keys + left, keys + right - vtype1::numlanes, gt_mask, keys_vec);
+    vtype2::double_compressstore(indexes + left,
+                                 indexes + right - vtype2::numlanes,
+                                 gt_mask,
+                                 indexes_vec);
     *smallest_vec = vtype1::min(keys_vec, *smallest_vec);
     *biggest_vec = vtype1::max(keys_vec, *biggest_vec);
     return amount_gt_pivot;
 }
 /*
  * Parition an array based on the pivot and returns the index of the
- * last element that is less than equal to the pivot.
+ * last element that is less than equal to the pivot. Not an overload of
+ * partition_avx512: with int64_t values the argsort one would be picked.
  */
 template <typename vtype1,
           typename vtype2,
@@ -562,19 +897,19 @@ template <typename vtype1,
           typename type_t2 = typename vtype2::type_t,
           typename zmm_t1 = typename vtype1::reg_t,
           typename zmm_t2 = typename vtype2::reg_t>
-static inline int64_t partition_avx512(type_t1 *keys,
-                                       type_t2 *indexes,
-                                       int64_t left,
-                                       int64_t right,
-                                       type_t1 pivot,
-                                       type_t1 *smallest,
-                                       type_t1 *biggest)
+static inline int64_t partition_avx512_kv(type_t1 *keys,
+                                          type_t2 *indexes,
+                                          int64_t left,
+                                          int64_t right,
+                                          type_t1 pivot,
+                                          type_t1 *smallest,
+                                          type_t1 *biggest)
 {
     /* make array length divisible by vtype1::numlanes , shortening the array */
     for (int32_t i = (right - left) % vtype1::numlanes; i > 0; --i) {
-        *smallest = std::min(*smallest, keys[left]);
-        *biggest = std::max(*biggest, keys[left]);
-        if (keys[left] > pivot) {
+        *smallest = std::min(*smallest, keys[left], comparison_func<vtype1>);
+        *biggest = std::max(*biggest, keys[left], comparison_func<vtype1>);
+        if (comparison_func<vtype1>(pivot, keys[left])) {
             right--;
             std::swap(keys[left], keys[right]);
             std::swap(indexes[left], indexes[right]);
@@ -702,8 +1037,8 @@ X86_SIMD_SORT_INLINE type_t get_pivot_scalar(type_t *arr,
     }
 
     auto vec = vtype::loadu(samples);
-    vec = vtype::sort_vec(vec);
-    return ((type_t *)&vec)[numSamples / 2];
+    vtype::storeu(samples, vtype::sort_vec(vec));
+    return samples[numSamples / 2];
 }
 
 template <typename vtype, typename type_t>
@@ -746,8 +1081,8 @@ X86_SIMD_SORT_INLINE type_t get_pivot_16bit(type_t *arr,
                           arr[left + 30 * size],
                           arr[left + 31 * size]};
     typename vtype::reg_t rand_vec = vtype::loadu(vec_arr);
-    typename vtype::reg_t sort = vtype::sort_vec(rand_vec);
-    return ((type_t *)&sort)[16];
+    vtype::storeu(vec_arr, vtype::sort_vec(rand_vec));
+    return vec_arr[16];
 }
 
 template <typename vtype, typename type_t>
@@ -780,9 +1115,10 @@ X86_SIMD_SORT_INLINE type_t get_pivot_32bit(type_t *arr,
     ymm_t rand_vec2
             = vtype::template i64gather<sizeof(type_t)>(rand_index2, arr);
     zmm_t rand_vec = vtype::merge(rand_vec1, rand_vec2);
-    zmm_t sort = vtype::sort_vec(rand_vec);
+    type_t samples[16];
+    vtype::storeu(samples, vtype::sort_vec(rand_vec));
     // pivot will never be a nan, since there are no nan's!
-    return ((type_t *)&sort)[8];
+    return samples[8];
 }
 
 template <typename vtype, typename type_t>
@@ -802,9 +1138,10 @@ X86_SIMD_SORT_INLINE type_t get_pivot_64bit(type_t *arr,
                                           left + 7 * size,
                                           left + 8 * size);
     zmm_t rand_vec = vtype::template i64gather<sizeof(type_t)>(rand_index, arr);
+    type_t samples[8];
     // pivot will never be a nan, since there are no nan's!
-    zmm_t sort = vtype::sort_vec(rand_vec);
-    return ((type_t *)&sort)[4];
+    vtype::storeu(samples, vtype::sort_vec(rand_vec));
+    return samples[4];
 }
 
 template <typename vtype, typename type_t>
@@ -812,11 +1149,13 @@ X86_SIMD_SORT_INLINE type_t get_pivot(type_t *arr,
                                       const int64_t left,
                                       const int64_t right)
 {
-    if constexpr (vtype::numlanes == 8)
+    /* The gather based pivots below need 512-bit registers */
+    constexpr bool is_zmm = sizeof(typename vtype::reg_t) == 64;
+    if constexpr (is_zmm && vtype::numlanes == 8)
         return get_pivot_64bit<vtype>(arr, left, right);
-    else if constexpr (vtype::numlanes == 16)
+    else if constexpr (is_zmm && vtype::numlanes == 16)
         return get_pivot_32bit<vtype>(arr, left, right);
-    else if constexpr (vtype::numlanes == 32)
+    else if constexpr (is_zmm && vtype::numlanes == 32)
         return get_pivot_16bit<vtype>(arr, left, right);
     else
         return get_pivot_scalar<vtype>(arr, left, right);
@@ -825,6 +1164,22 @@ X86_SIMD_SORT_INLINE type_t get_pivot(type_t *arr,
 template <typename vtype, int64_t maxN>
 X86_SIMD_SORT_INLINE void sort_n(typename vtype::type_t *arr, int N);
 
+/*
+ * Sort arr[left, right] with std::sort. The lambda gives every vtype its own
+ * std::sort instantiation with internal linkage, so copies compiled for
+ * different ISAs never get merged by the linker.
+ */
+template <typename vtype, typename type_t>
+X86_SIMD_SORT_INLINE void
+std_sort_fallback(type_t *arr, int64_t left, int64_t right)
+{
+    std::sort(arr + left,
+              arr + right + 1,
+              [](const type_t &a, const type_t &b) -> bool {
+                  return comparison_func<vtype>(a, b);
+              });
+}
+
 template <typename vtype, typename type_t>
 static void qsort_(type_t *arr, int64_t left, int64_t right, int64_t max_iters)
 {
@@ -832,7 +1187,7 @@ static void qsort_(type_t *arr, int64_t left, int64_t right, int64_t max_iters)
      * Resort to std::sort if quicksort isnt making any progress
      */
     if (max_iters <= 0) {
-        std::sort(arr + left, arr + right + 1);
+        std_sort_fallback<vtype>(arr, left, right);
         return;
     }
     /*
@@ -852,9 +1207,14 @@ static void qsort_(type_t *arr, int64_t left, int64_t right, int64_t max_iters)
             = partition_avx512_unrolled<vtype, vtype::partition_unroll_factor>(
                     arr, left, right + 1, pivot, &smallest, &biggest);
 
-    if (pivot != smallest)
+    /*
+     * Compared with comparison_func, since vtypes like the totalOrder one of
+     * avx512-totalorder-qsort.hpp order values that operator== mixes up
+     */
+    if (comparison_func<vtype>(smallest, pivot))
         qsort_<vtype>(arr, left, pivot_index - 1, max_iters - 1);
-    if (pivot != biggest) qsort_<vtype>(arr, pivot_index, right, max_iters - 1);
+    if (comparison_func<vtype>(pivot, biggest))
+        qsort_<vtype>(arr, pivot_index, right, max_iters - 1);
 }
 
 template <typename vtype, typename type_t>
@@ -868,7 +1228,7 @@ static void qselect_(type_t *arr,
      * Resort to std::sort if quicksort isnt making any progress
      */
     if (max_iters <= 0) {
-        std::sort(arr + left, arr + right + 1);
+        std_sort_fallback<vtype>(arr, left, right);
         return;
     }
     /*
@@ -888,36 +1248,65 @@ static void qselect_(type_t *arr,
             = partition_avx512_unrolled<vtype, vtype::partition_unroll_factor>(
                     arr, left, right + 1, pivot, &smallest, &biggest);
 
-    if ((pivot != smallest) && (pos < pivot_index))
+    if (comparison_func<vtype>(smallest, pivot) && (pos < pivot_index))
         qselect_<vtype>(arr, pos, left, pivot_index - 1, max_iters - 1);
-    else if ((pivot != biggest) && (pos >= pivot_index))
+    else if (comparison_func<vtype>(pivot, biggest) && (pos >= pivot_index))
         qselect_<vtype>(arr, pos, pivot_index, right, max_iters - 1);
 }
 
-// Regular quicksort routines:
-template <typename T>
-void avx512_qsort(T *arr, int64_t arrsize)
+/*
+ * A vtype can define histogram_sort(arr, arrsize) and histogram_sort_threshold
+ * to counting sort arrays with more elements than the threshold instead of
+ * partitioning them, see avx512-16bit-common.h. histogram_sort<true> must sort
+ * in descending order, for descending_vector. histogram_sort counts with
+ * 32-bit counters, which limits it to arrays of at most UINT32_MAX elements.
+ * Only xss_qsort uses it: quickselect only partitions what contains k and
+ * stays faster than even the counting pass alone.
+ */
+template <typename vtype, typename = void>
+struct xss_has_histogram_sort : std::false_type {
+};
+
+template <typename vtype>
+struct xss_has_histogram_sort<
+        vtype,
+        std::void_t<decltype(vtype::histogram_sort_threshold)>>
+    : std::true_type {
+};
+
+template <typename vtype>
+X86_SIMD_SORT_INLINE bool xss_use_histogram_sort(int64_t arrsize)
 {
+    return arrsize > vtype::histogram_sort_threshold
+            && arrsize <= (int64_t)UINT32_MAX;
+}
+
+// Regular quicksort routines, shared by the AVX-512 and AVX2 entry points:
+template <typename vtype, typename T>
+X86_SIMD_SORT_INLINE void xss_qsort(T *arr, int64_t arrsize)
+{
+    if constexpr (xss_has_histogram_sort<vtype>::value) {
+        if (xss_use_histogram_sort<vtype>(arrsize)) {
+            vtype::histogram_sort(arr, arrsize);
+            return;
+        }
+    }
     if (arrsize > 1) {
         /* std::is_floating_point_v<_Float16> == False, unless c++-23*/
         if constexpr (std::is_floating_point_v<T>) {
-            int64_t nan_count
-                    = replace_nan_with_inf<zmm_vector<T>>(arr, arrsize);
-            qsort_<zmm_vector<T>, T>(
-                    arr, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+            int64_t nan_count = replace_nan_with_inf<vtype>(arr, arrsize);
+            qsort_<vtype, T>(arr, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
             replace_inf_with_nan(arr, arrsize, nan_count);
         }
         else {
-            qsort_<zmm_vector<T>, T>(
-                    arr, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+            qsort_<vtype, T>(arr, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
         }
     }
 }
 
-void avx512_qsort_fp16(uint16_t *arr, int64_t arrsize);
-
-template <typename T>
-void avx512_qselect(T *arr, int64_t k, int64_t arrsize, bool hasnan = false)
+template <typename vtype, typename T>
+X86_SIMD_SORT_INLINE void
+xss_qselect(T *arr, int64_t k, int64_t arrsize, bool hasnan)
 {
     int64_t indx_last_elem = arrsize - 1;
     /* std::is_floating_point_v<_Float16> == False, unless c++-23*/
@@ -927,30 +1316,196 @@ void avx512_qselect(T *arr, int64_t k, int64_t arrsize, bool hasnan = false)
         }
     }
     if (indx_last_elem >= k) {
-        qselect_<zmm_vector<T>, T>(
+        qselect_<vtype, T>(
                 arr, k, 0, indx_last_elem, 2 * (int64_t)log2(indx_last_elem));
     }
 }
 
-void avx512_qselect_fp16(uint16_t *arr,
-                         int64_t k,
-                         int64_t arrsize,
-                         bool hasnan = false);
+template <typename vtype, typename T>
+X86_SIMD_SORT_INLINE void
+xss_partial_qsort(T *arr, int64_t k, int64_t arrsize, bool hasnan)
+{
+    xss_qselect<vtype, T>(arr, k - 1, arrsize, hasnan);
+    xss_qsort<vtype, T>(arr, k - 1);
+}
+
+/*
+ * The vtype used by the avx512_* entry points below. Building with
+ * -DXSS_AVX512_COMPRESS_TO_REGISTER (implied by -march=znver4) partitions
+ * without compressstore, which is much faster on AMD Zen4. 16-bit types then
+ * need AVX512_VBMI2, which Zen4 has.
+ */
+#if defined(__znver4__) && !defined(XSS_AVX512_COMPRESS_TO_REGISTER)
+#define XSS_AVX512_COMPRESS_TO_REGISTER
+#endif
+#ifdef XSS_AVX512_COMPRESS_TO_REGISTER
+template <typename T>
+using zmm_partition_vector = zmm_vector_regcompress<zmm_vector<T>>;
+#else
+template <typename T>
+using zmm_partition_vector = zmm_vector<T>;
+#endif
+
+/*
+ * Building with -DXSS_AVX512_YMM_THRESHOLD=N makes avx512_qsort,
+ * avx512_qselect, avx512_argsort and avx512_argselect handle 32-bit and
+ * 64-bit arrays of at most N elements with the 256-bit avx512vl_* routines,
+ * so sorting small and medium arrays does not lower the core frequency on
+ * CPUs that throttle for 512-bit instructions. Disabled by default in the
+ * headers; the compiled library does this at runtime on those CPUs.
+ */
+#ifndef XSS_AVX512_YMM_THRESHOLD
+#define XSS_AVX512_YMM_THRESHOLD 0
+#endif
+
+template <typename T>
+constexpr bool xss_avx512_ymm_enabled()
+{
+    return XSS_AVX512_YMM_THRESHOLD > 0 && sizeof(T) >= 4;
+}
+
+/* vtype, or descending_vector<vtype> to sort in descending order */
+template <typename vtype, bool descending>
+using xss_order_vector = typename std::
+        conditional<descending, descending_vector<vtype>, vtype>::type;
+
+template <typename T, bool descending>
+X86_SIMD_SORT_INLINE void xss_avx512_qsort(T *arr, int64_t arrsize)
+{
+    if constexpr (xss_avx512_ymm_enabled<T>()) {
+        if (arrsize <= XSS_AVX512_YMM_THRESHOLD) {
+            xss_qsort<xss_order_vector<ymm_vector<T>, descending>, T>(
+                    arr, arrsize);
+            return;
+        }
+    }
+    xss_qsort<xss_order_vector<zmm_partition_vector<T>, descending>, T>(
+            arr, arrsize);
+}
+
+template <typename T, bool descending>
+X86_SIMD_SORT_INLINE void
+xss_avx512_qselect(T *arr, int64_t k, int64_t arrsize, bool hasnan)
+{
+    if constexpr (xss_avx512_ymm_enabled<T>()) {
+        if (arrsize <= XSS_AVX512_YMM_THRESHOLD) {
+            xss_qselect<xss_order_vector<ymm_vector<T>, descending>, T>(
+                    arr, k, arrsize, hasnan);
+            return;
+        }
+    }
+    xss_qselect<xss_order_vector<zmm_partition_vector<T>, descending>, T>(
+            arr, k, arrsize, hasnan);
+}
+
+/*
+ * descending = true sorts (selects) in descending order. NaN's still go to
+ * the end of the array.
+ */
+template <typename T>
+void avx512_qsort(T *arr, int64_t arrsize, bool descending = false)
+{
+    if (descending) { xss_avx512_qsort<T, true>(arr, arrsize); }
+    else {
+        xss_avx512_qsort<T, false>(arr, arrsize);
+    }
+}
+
+template <typename T>
+void avx512_qselect(T *arr,
+                    int64_t k,
+                    int64_t arrsize,
+                    bool hasnan = false,
+                    bool descending = false)
+{
+    if (descending) { xss_avx512_qselect<T, true>(arr, k, arrsize, hasnan); }
+    else {
+        xss_avx512_qselect<T, false>(arr, k, arrsize, hasnan);
+    }
+}
+
+template <typename T>
+inline void avx512_partial_qsort(T *arr,
+                                 int64_t k,
+                                 int64_t arrsize,
+                                 bool hasnan = false,
+                                 bool descending = false)
+{
+    avx512_qselect<T>(arr, k - 1, arrsize, hasnan, descending);
+    avx512_qsort<T>(arr, k - 1, descending);
+}
+
+/*
+ * Sorts the valid values of a nullable column with an Arrow style validity
+ * bitmap (see get_validity_mask) and places them after the nulls if
+ * nulls_first, else before them. Returns the number of valid values, the
+ * values left in the null slots are unspecified. validity isn't modified.
+ */
+template <typename T>
+int64_t avx512_qsort(T *arr,
+                     const uint8_t *validity,
+                     int64_t arrsize,
+                     bool nulls_first = false)
+{
+    if (nulls_first) {
+        int64_t num_null
+                = move_nulls_to_front<zmm_vector<T>>(arr, arrsize, validity);
+        avx512_qsort<T>(arr + num_null, arrsize - num_null);
+        return arrsize - num_null;
+    }
+    int64_t num_valid
+            = move_nulls_to_end<zmm_vector<T>>(arr, arrsize, validity);
+    avx512_qsort<T>(arr, num_valid);
+    return num_valid;
+}
+
+/*
+ * 256-bit versions of the above for 32-bit and 64-bit types: same algorithm,
+ * but on ymm registers with AVX-512VL opmasks. On Skylake-SP and Cascade Lake
+ * this avoids the frequency drop that 512-bit instructions cause. Available
+ * once avx512-32bit-qsort.hpp / avx512-64bit-qsort.hpp are included.
+ */
+template <typename T>
+void avx512vl_qsort(T *arr, int64_t arrsize)
+{
+    xss_qsort<ymm_vector<T>, T>(arr, arrsize);
+}
+
+template <typename T>
+void avx512vl_qselect(T *arr, int64_t k, int64_t arrsize, bool hasnan = false)
+{
+    xss_qselect<ymm_vector<T>, T>(arr, k, arrsize, hasnan);
+}
 
 template <typename T>
 inline void
-avx512_partial_qsort(T *arr, int64_t k, int64_t arrsize, bool hasnan = false)
+avx512vl_partial_qsort(T *arr, int64_t k, int64_t arrsize, bool hasnan = false)
 {
-    avx512_qselect<T>(arr, k - 1, arrsize, hasnan);
-    avx512_qsort<T>(arr, k - 1);
+    xss_partial_qsort<ymm_vector<T>, T>(arr, k, arrsize, hasnan);
 }
-inline void avx512_partial_qsort_fp16(uint16_t *arr,
-                                      int64_t k,
-                                      int64_t arrsize,
-                                      bool hasnan = false)
+
+/*
+ * AVX2 versions of the above, available for 16-bit, 32-bit and 64-bit types
+ * once avx2-16bit-qsort.hpp / avx2-32bit-qsort.hpp / avx2-64bit-qsort.hpp are
+ * included.
+ */
+template <typename T>
+void avx2_qsort(T *arr, int64_t arrsize)
+{
+    xss_qsort<avx2_vector<T>, T>(arr, arrsize);
+}
+
+template <typename T>
+void avx2_qselect(T *arr, int64_t k, int64_t arrsize, bool hasnan = false)
+{
+    xss_qselect<avx2_vector<T>, T>(arr, k, arrsize, hasnan);
+}
+
+template <typename T>
+inline void
+avx2_partial_qsort(T *arr, int64_t k, int64_t arrsize, bool hasnan = false)
 {
-    avx512_qselect_fp16(arr, k - 1, arrsize, hasnan);
-    avx512_qsort_fp16(arr, k - 1);
+    xss_partial_qsort<avx2_vector<T>, T>(arr, k, arrsize, hasnan);
 }
 
 #endif // AVX512_QSORT_COMMON
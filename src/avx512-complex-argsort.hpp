@@ -0,0 +1,70 @@
+/*******************************************************************
+ * Copyright (C) 2023 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * ****************************************************************/
+
+#ifndef AVX512_ARGSORT_COMPLEX
+#define AVX512_ARGSORT_COMPLEX
+
+#include "avx512-64bit-argsort.hpp"
+#include "avx512-complex-qsort.hpp"
+
+/*
+ * argsort methods for std::complex<float> and std::complex<double>, 8 values
+ * at a time next to their indices. Like avx512_qsort, the indices of the
+ * values with a NaN part are moved to the end and sorted with complex_lt.
+ */
+template <typename vtype, typename T>
+X86_SIMD_SORT_INLINE void
+xss_argsort_complex(std::complex<T> *arr, int64_t *arg, int64_t arrsize)
+{
+    if (arrsize > 1) {
+        int64_t num_valid = arrsize;
+        if (has_nan<vtype>(arr, arrsize)) {
+            num_valid = move_nan_args_to_end(
+                    arr, arg, arrsize, complex_isnan<T>);
+            std::sort(arg + num_valid,
+                      arg + arrsize,
+                      [arr](int64_t left, int64_t right) -> bool {
+                          return comparison_func<vtype>(arr[left],
+                                                        arr[right]);
+                      });
+        }
+        if (num_valid > 1) {
+            argsort_64bit_<vtype, zmm_vector<int64_t>>(
+                    arr, arg, 0, num_valid - 1, 2 * (int64_t)log2(num_valid));
+        }
+    }
+}
+
+template <>
+inline void avx512_argsort(std::complex<float> *arr,
+                           int64_t *arg,
+                           int64_t arrsize,
+                           bool descending)
+{
+    using vtype = complex_vector<ymm_vector<float>>;
+    if (descending) {
+        xss_argsort_complex<descending_vector<vtype>>(arr, arg, arrsize);
+    }
+    else {
+        xss_argsort_complex<vtype>(arr, arg, arrsize);
+    }
+}
+
+template <>
+inline void avx512_argsort(std::complex<double> *arr,
+                           int64_t *arg,
+                           int64_t arrsize,
+                           bool descending)
+{
+    using vtype = complex_vector<zmm_vector<double>>;
+    if (descending) {
+        xss_argsort_complex<descending_vector<vtype>>(arr, arg, arrsize);
+    }
+    else {
+        xss_argsort_complex<vtype>(arr, arg, arrsize);
+    }
+}
+
+#endif // AVX512_ARGSORT_COMPLEX
@@ -0,0 +1,400 @@
+/*******************************************************************
+ * Copyright (C) 2023 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * ****************************************************************/
+
+#ifndef AVX512_QSORT_COMPLEX
+#define AVX512_QSORT_COMPLEX
+
+#include "avx512-32bit-qsort.hpp"
+#include "avx512-64bit-qsort.hpp"
+#include <complex>
+
+/*
+ * Sorting std::complex<float> and std::complex<double> in the NumPy order:
+ * lexicographically by (real, imag), with the values that have a NaN part at
+ * the end in the order R + Rj < R + nanj < nan + Rj < nan + nanj.
+ *
+ * Like the 128-bit keys, a register holds the real and the imaginary parts of
+ * its values in two registers of the component vtype: vtype is
+ * zmm_vector<float> (16 lanes, 32-bit networks), ymm_vector<float> (8 lanes,
+ * for argsort) or zmm_vector<double> (8 lanes). Values are split when loaded
+ * and interleaved again when stored. Compares combine the two parts into one
+ * opmask and assume there are no NaN's, which are moved out of the way first.
+ */
+template <typename T>
+X86_SIMD_SORT_INLINE bool complex_lt(const std::complex<T> &a,
+                                     const std::complex<T> &b)
+{
+    /* Same as the complex LT of NumPy's npysort */
+    T ar = a.real(), ai = a.imag(), br = b.real(), bi = b.imag();
+    if (ar < br) { return ai == ai || bi != bi; }
+    else if (ar > br) {
+        return bi != bi && ai == ai;
+    }
+    else if (ar == br || (ar != ar && br != br)) {
+        return ai < bi || (bi != bi && ai == ai);
+    }
+    else {
+        return br != br;
+    }
+}
+
+template <typename T>
+X86_SIMD_SORT_INLINE bool complex_isnan(const std::complex<T> &elem)
+{
+    return std::isnan(elem.real()) || std::isnan(elem.imag());
+}
+
+template <typename vtype>
+struct complex_reg {
+    typename vtype::reg_t re;
+    typename vtype::reg_t im;
+};
+
+template <typename vtype>
+struct complex_vector {
+    using comp_t = typename vtype::type_t;
+    using comp_reg_t = typename vtype::reg_t;
+    using type_t = std::complex<comp_t>;
+    using reg_t = complex_reg<vtype>;
+    using zmmi_t = typename vtype::zmmi_t;
+    using opmask_t = typename vtype::opmask_t;
+    static const uint8_t numlanes = vtype::numlanes;
+    static constexpr int network_sort_threshold = 256;
+    static constexpr int partition_unroll_factor = 0;
+
+    static type_t type_max()
+    {
+        return type_t(vtype::type_max(), vtype::type_max());
+    }
+    static type_t type_min()
+    {
+        return type_t(vtype::type_min(), vtype::type_min());
+    }
+    static reg_t zmm_max()
+    {
+        return set1(type_max());
+    }
+    template <typename... Ints>
+    static zmmi_t seti(Ints... v)
+    {
+        return vtype::seti(v...);
+    }
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return vtype::knot_opmask(x);
+    }
+    static opmask_t get_partial_loadmask(int size)
+    {
+        return (opmask_t)((1ull << size) - 1);
+    }
+    /* Split 2 x numlanes / 2 interleaved values into real and imag parts */
+    static reg_t deinterleave(comp_reg_t a, comp_reg_t b)
+    {
+        if constexpr (sizeof(comp_t) == 8) {
+            const __m512i even = _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14);
+            const __m512i odd = _mm512_add_epi64(even, _mm512_set1_epi64(1));
+            return {_mm512_permutex2var_pd(a, even, b),
+                    _mm512_permutex2var_pd(a, odd, b)};
+        }
+        else if constexpr (numlanes == 16) {
+            const __m512i even = _mm512_setr_epi32(
+                    0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+            const __m512i odd = _mm512_add_epi32(even, _mm512_set1_epi32(1));
+            return {_mm512_permutex2var_ps(a, even, b),
+                    _mm512_permutex2var_ps(a, odd, b)};
+        }
+        else {
+            const __m256i even = _mm256_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14);
+            const __m256i odd = _mm256_add_epi32(even, _mm256_set1_epi32(1));
+            return {_mm256_permutex2var_ps(a, even, b),
+                    _mm256_permutex2var_ps(a, odd, b)};
+        }
+    }
+    static void interleave(reg_t x, comp_reg_t &a, comp_reg_t &b)
+    {
+        if constexpr (sizeof(comp_t) == 8) {
+            a = _mm512_permutex2var_pd(
+                    x.re, _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11), x.im);
+            b = _mm512_permutex2var_pd(
+                    x.re, _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15), x.im);
+        }
+        else if constexpr (numlanes == 16) {
+            const __m512i lo = _mm512_setr_epi32(
+                    0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+            const __m512i hi = _mm512_add_epi32(lo, _mm512_set1_epi32(8));
+            a = _mm512_permutex2var_ps(x.re, lo, x.im);
+            b = _mm512_permutex2var_ps(x.re, hi, x.im);
+        }
+        else {
+            a = _mm256_permutex2var_ps(
+                    x.re, _mm256_setr_epi32(0, 8, 1, 9, 2, 10, 3, 11), x.im);
+            b = _mm256_permutex2var_ps(
+                    x.re, _mm256_setr_epi32(4, 12, 5, 13, 6, 14, 7, 15), x.im);
+        }
+    }
+    /* One bit per value to one bit per real and imag part */
+    static uint32_t part_mask(opmask_t mask)
+    {
+        uint32_t m = mask;
+        m = (m | (m << 8)) & 0x00FF00FF;
+        m = (m | (m << 4)) & 0x0F0F0F0F;
+        m = (m | (m << 2)) & 0x33333333;
+        m = (m | (m << 1)) & 0x55555555;
+        return m | (m << 1);
+    }
+    static opmask_t gt(reg_t x, reg_t y)
+    {
+        opmask_t re_gt = vtype::knot_opmask(vtype::ge(y.re, x.re));
+        opmask_t re_eq = vtype::eq(x.re, y.re);
+        opmask_t im_gt = vtype::knot_opmask(vtype::ge(y.im, x.im));
+        return re_gt | (re_eq & im_gt);
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        opmask_t re_gt = vtype::knot_opmask(vtype::ge(y.re, x.re));
+        opmask_t re_eq = vtype::eq(x.re, y.re);
+        opmask_t im_ge = vtype::ge(x.im, y.im);
+        return re_gt | (re_eq & im_ge);
+    }
+    static opmask_t eq(reg_t x, reg_t y)
+    {
+        return vtype::eq(x.re, y.re) & vtype::eq(x.im, y.im);
+    }
+    template <int type>
+    static opmask_t fpclass(reg_t x)
+    {
+        return vtype::template fpclass<type>(x.re)
+                | vtype::template fpclass<type>(x.im);
+    }
+    /* gathers scale by at most 8, complex<double> indexes its parts instead */
+    template <int scale>
+    static reg_t i64gather(__m512i index, void const *base)
+    {
+        constexpr int s = scale > 8 ? 8 : scale;
+        if constexpr (scale > 8) { index = _mm512_slli_epi64(index, 1); }
+        return {vtype::template i64gather<s>(index, base),
+                vtype::template i64gather<s>(
+                        index, (const char *)base + sizeof(comp_t))};
+    }
+    template <int scale>
+    static reg_t
+    mask_i64gather(reg_t src, opmask_t mask, __m512i index, void const *base)
+    {
+        constexpr int s = scale > 8 ? 8 : scale;
+        if constexpr (scale > 8) { index = _mm512_slli_epi64(index, 1); }
+        return {vtype::template mask_i64gather<s>(src.re, mask, index, base),
+                vtype::template mask_i64gather<s>(
+                        src.im,
+                        mask,
+                        index,
+                        (const char *)base + sizeof(comp_t))};
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return deinterleave(
+                vtype::loadu(mem),
+                vtype::loadu((const char *)mem + sizeof(comp_reg_t)));
+    }
+    static reg_t maskz_loadu(opmask_t mask, void const *mem)
+    {
+        uint32_t m = part_mask(mask);
+        return deinterleave(
+                vtype::maskz_loadu((opmask_t)m, mem),
+                vtype::maskz_loadu((opmask_t)(m >> numlanes),
+                                   (const char *)mem + sizeof(comp_reg_t)));
+    }
+    static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
+    {
+        comp_reg_t a, b;
+        interleave(x, a, b);
+        uint32_t m = part_mask(mask);
+        a = vtype::mask_loadu(a, (opmask_t)m, mem);
+        b = vtype::mask_loadu(b,
+                              (opmask_t)(m >> numlanes),
+                              (const char *)mem + sizeof(comp_reg_t));
+        return deinterleave(a, b);
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        comp_reg_t a, b;
+        interleave(x, a, b);
+        vtype::storeu(mem, a);
+        vtype::storeu((char *)mem + sizeof(comp_reg_t), b);
+    }
+    static void mask_storeu(void *mem, opmask_t mask, reg_t x)
+    {
+        comp_reg_t a, b;
+        interleave(x, a, b);
+        uint32_t m = part_mask(mask);
+        vtype::mask_storeu(mem, (opmask_t)m, a);
+        vtype::mask_storeu(
+                (char *)mem + sizeof(comp_reg_t), (opmask_t)(m >> numlanes), b);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        return {vtype::mask_mov(x.re, mask, y.re),
+                vtype::mask_mov(x.im, mask, y.im)};
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return mask_mov(x, gt(x, y), y);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return mask_mov(y, gt(x, y), x);
+    }
+    template <typename index_t>
+    static reg_t permutexvar(index_t idx, reg_t x)
+    {
+        return {vtype::permutexvar(idx, x.re), vtype::permutexvar(idx, x.im)};
+    }
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t x)
+    {
+        return {vtype::template shuffle<mask>(x.re),
+                vtype::template shuffle<mask>(x.im)};
+    }
+    static reg_t reverse(reg_t x)
+    {
+        return {vtype::reverse(x.re), vtype::reverse(x.im)};
+    }
+    static reg_t set1(type_t v)
+    {
+        return {vtype::set1(v.real()), vtype::set1(v.imag())};
+    }
+    static type_t reducemax(reg_t v)
+    {
+        type_t vals[numlanes];
+        storeu(vals, v);
+        return *std::max_element(vals, vals + numlanes, complex_lt<comp_t>);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        type_t vals[numlanes];
+        storeu(vals, v);
+        return *std::min_element(vals, vals + numlanes, complex_lt<comp_t>);
+    }
+    /* Stores the first n values of reg compressed with k at mem */
+    static void compressstore_n(type_t *mem, opmask_t k, reg_t reg, int n)
+    {
+        reg_t packed = {vtype::maskz_compress(k, reg.re),
+                        vtype::maskz_compress(k, reg.im)};
+        mask_storeu(mem, get_partial_loadmask(n), packed);
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        int amount_ge_pivot = _mm_popcnt_u32((int32_t)k);
+        compressstore_n(
+                left_addr, knot_opmask(k), reg, numlanes - amount_ge_pivot);
+        compressstore_n(right_addr + numlanes - amount_ge_pivot,
+                        k,
+                        reg,
+                        amount_ge_pivot);
+        return amount_ge_pivot;
+    }
+    static reg_t bitonic_merge(reg_t x)
+    {
+        if constexpr (numlanes == 16) {
+            return bitonic_merge_zmm_32bit<complex_vector<vtype>>(x);
+        }
+        else {
+            return bitonic_merge_zmm_64bit<complex_vector<vtype>>(x);
+        }
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        if constexpr (numlanes == 16) {
+            return sort_zmm_32bit<complex_vector<vtype>>(x);
+        }
+        else {
+            return sort_zmm_64bit<complex_vector<vtype>>(x);
+        }
+    }
+};
+
+template <>
+inline bool comparison_func<complex_vector<zmm_vector<float>>>(
+        const std::complex<float> &a, const std::complex<float> &b)
+{
+    return complex_lt(a, b);
+}
+
+template <>
+inline bool comparison_func<complex_vector<ymm_vector<float>>>(
+        const std::complex<float> &a, const std::complex<float> &b)
+{
+    return complex_lt(a, b);
+}
+
+template <>
+inline bool comparison_func<complex_vector<zmm_vector<double>>>(
+        const std::complex<double> &a, const std::complex<double> &b)
+{
+    return complex_lt(a, b);
+}
+
+/*
+ * NaN's can't be replaced with inf here like for float and double: NumPy
+ * orders the values with a NaN part by their other part. Move them to the end,
+ * sort the rest with the vector code and the (usually few) NaN's with
+ * complex_lt.
+ */
+template <typename vtype, typename T>
+X86_SIMD_SORT_INLINE void xss_qsort_complex(std::complex<T> *arr,
+                                            int64_t arrsize)
+{
+    if (arrsize > 1) {
+        int64_t num_valid = arrsize;
+        if (has_nan<vtype>(arr, arrsize)) {
+            num_valid = move_nans_to_end_of_array(
+                                arr, arrsize, complex_isnan<T>)
+                    + 1;
+            std::sort(arr + num_valid,
+                      arr + arrsize,
+                      [](const std::complex<T> &a, const std::complex<T> &b) {
+                          return comparison_func<vtype>(a, b);
+                      });
+        }
+        if (num_valid > 1) {
+            qsort_<vtype, std::complex<T>>(
+                    arr, 0, num_valid - 1, 2 * (int64_t)log2(num_valid));
+        }
+    }
+}
+
+/*
+ * With descending = true the values with a NaN part are still at the end, in
+ * the reverse of the order above.
+ */
+template <>
+inline void
+avx512_qsort(std::complex<float> *arr, int64_t arrsize, bool descending)
+{
+    using vtype = complex_vector<zmm_vector<float>>;
+    if (descending) {
+        xss_qsort_complex<descending_vector<vtype>>(arr, arrsize);
+    }
+    else {
+        xss_qsort_complex<vtype>(arr, arrsize);
+    }
+}
+
+template <>
+inline void
+avx512_qsort(std::complex<double> *arr, int64_t arrsize, bool descending)
+{
+    using vtype = complex_vector<zmm_vector<double>>;
+    if (descending) {
+        xss_qsort_complex<descending_vector<vtype>>(arr, arrsize);
+    }
+    else {
+        xss_qsort_complex<vtype>(arr, arrsize);
+    }
+}
+
+#endif // AVX512_QSORT_COMPLEX
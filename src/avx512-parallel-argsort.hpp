@@ -0,0 +1,159 @@
+/*******************************************************************
+ * Copyright (C) 2023 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * ****************************************************************/
+
+#ifndef AVX512_PARALLEL_ARGSORT
+#define AVX512_PARALLEL_ARGSORT
+
+#include "avx512-64bit-argsort.hpp"
+#include "avx512-parallel-qsort.hpp"
+
+/*
+ * Multithreaded argsort, with the parallel quicksort of
+ * avx512-parallel-qsort.hpp: the top levels of the index array are
+ * partitioned by all the threads at once, and the subarrays left are
+ * argsorted by argsort_64bit_ in tasks. Where avx512_argsort falls back to
+ * std::sort if there are NaN's, their indices are moved to the end by one
+ * more parallel partition instead and the others are argsorted as usual.
+ */
+template <typename vtype, typename argtype, typename type_t>
+struct xss_argsort_kernel {
+    type_t *arr;
+    int64_t *arg;
+
+    type_t pivot(int64_t left, int64_t right) const
+    {
+        return get_pivot_64bit<vtype, argtype>(arr, arg, left, right);
+    }
+    int64_t partition(int64_t begin,
+                      int64_t end,
+                      type_t pivot,
+                      type_t *smallest,
+                      type_t *biggest) const
+    {
+        return partition_avx512_unrolled<vtype, argtype, 4>(
+                arr, arg, begin, end, pivot, smallest, biggest);
+    }
+    void swap(int64_t ii, int64_t jj, int64_t num) const
+    {
+        std::swap_ranges(arg + ii, arg + ii + num, arg + jj);
+    }
+    void sort(int64_t left, int64_t right, int64_t max_iters) const
+    {
+        argsort_64bit_<vtype, argtype>(arr, arg, left, right, max_iters);
+    }
+};
+
+/* has_nan on all the threads */
+template <typename vtype, typename T>
+X86_SIMD_SORT_INLINE bool
+xss_parallel_has_nan(xss_executor &executor, T *arr, int64_t arrsize)
+{
+    int num_chunks = xss_num_chunks(executor, arrsize);
+    std::vector<char> found(num_chunks);
+    xss_parallel_for(executor, num_chunks, [&](int ii) {
+        int64_t begin = arrsize * ii / num_chunks;
+        int64_t end = arrsize * (ii + 1) / num_chunks;
+        found[ii] = has_nan<vtype>(arr + begin, end - begin);
+    });
+    return std::find(found.begin(), found.end(), true) != found.end();
+}
+
+template <typename vtype, typename T>
+X86_SIMD_SORT_INLINE void xss_parallel_argsort(xss_executor &executor,
+                                               T *arr,
+                                               int64_t *arg,
+                                               int64_t arrsize)
+{
+    int64_t num_valid = arrsize;
+    if constexpr (std::is_floating_point_v<T>) {
+        if (xss_parallel_has_nan<vtype>(executor, arr, arrsize)) {
+            T smallest = 0, biggest = 0;
+            num_valid = xss_parallel_partition<vtype>(
+                    executor,
+                    0,
+                    arrsize,
+                    &smallest,
+                    &biggest,
+                    [arr, arg](int64_t begin, int64_t end, T *, T *) {
+                        return begin
+                                + move_nan_args_to_end(
+                                        arr,
+                                        arg + begin,
+                                        end - begin,
+                                        [](T x) { return x != x; });
+                    },
+                    [arg](int64_t ii, int64_t jj, int64_t num) {
+                        std::swap_ranges(arg + ii, arg + ii + num, arg + jj);
+                    });
+        }
+    }
+    xss_parallel_sort<vtype>(
+            executor,
+            xss_argsort_kernel<vtype, zmm_vector<int64_t>, T> {arr, arg},
+            num_valid);
+}
+
+/*
+ * avx512_argsort on several threads, same dtypes. arg holds the indices to
+ * sort, like with avx512_argsort, and the keys come out in the same order.
+ * The tasks run on executor, or on xss_default_executor.
+ */
+template <typename T>
+void avx512_argsort_parallel(T *arr,
+                             int64_t *arg,
+                             int64_t arrsize,
+                             xss_executor &executor,
+                             bool descending = false)
+{
+    using vectype = avx512_8lane_vector<T>;
+    if (arrsize <= XSS_PARALLEL_CUTOFF || executor.concurrency() <= 1) {
+        avx512_argsort<T>(arr, arg, arrsize, descending);
+    }
+    else if (descending) {
+        xss_parallel_argsort<descending_vector<vectype>>(
+                executor, arr, arg, arrsize);
+    }
+    else {
+        xss_parallel_argsort<vectype>(executor, arr, arg, arrsize);
+    }
+}
+
+template <typename T>
+void avx512_argsort_parallel(T *arr,
+                             int64_t *arg,
+                             int64_t arrsize,
+                             bool descending = false)
+{
+    avx512_argsort_parallel<T>(
+            arr, arg, arrsize, xss_default_executor(), descending);
+}
+
+template <typename T>
+std::vector<int64_t> avx512_argsort_parallel(T *arr,
+                                             int64_t arrsize,
+                                             xss_executor &executor,
+                                             bool descending = false)
+{
+    std::vector<int64_t> indices(arrsize);
+    int num_chunks = xss_num_chunks(executor, arrsize);
+    xss_parallel_for(executor, num_chunks, [&](int ii) {
+        int64_t begin = arrsize * ii / num_chunks;
+        int64_t end = arrsize * (ii + 1) / num_chunks;
+        std::iota(indices.begin() + begin, indices.begin() + end, begin);
+    });
+    avx512_argsort_parallel<T>(
+            arr, indices.data(), arrsize, executor, descending);
+    return indices;
+}
+
+template <typename T>
+std::vector<int64_t>
+avx512_argsort_parallel(T *arr, int64_t arrsize, bool descending = false)
+{
+    return avx512_argsort_parallel<T>(
+            arr, arrsize, xss_default_executor(), descending);
+}
+
+#endif // AVX512_PARALLEL_ARGSORT
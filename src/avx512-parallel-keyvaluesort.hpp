@@ -0,0 +1,104 @@
+/*******************************************************************
+ * Copyright (C) 2023 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * ****************************************************************/
+
+#ifndef AVX512_PARALLEL_KEYVALUESORT
+#define AVX512_PARALLEL_KEYVALUESORT
+
+#include "avx512-common-keyvaluesort.h"
+#include "avx512-parallel-qsort.hpp"
+
+/*
+ * Multithreaded key-value sort, with the parallel quicksort of
+ * avx512-parallel-qsort.hpp. Every partition moves the keys and the values
+ * together: each thread partitions both arrays of its chunk with
+ * partition_avx512_kv, and the misplaced pairs are swapped in both arrays.
+ * The subarrays are sorted by qsort_64bit_ in tasks. Needs the same headers
+ * as avx512_qsort_kv for the types of the keys and values.
+ */
+template <typename vtype1, typename vtype2, typename type1_t, typename type2_t>
+struct xss_kv_kernel {
+    type1_t *keys;
+    type2_t *values;
+
+    type1_t pivot(int64_t left, int64_t right) const
+    {
+        return get_pivot<vtype1, type1_t>(keys, left, right);
+    }
+    int64_t partition(int64_t begin,
+                      int64_t end,
+                      type1_t pivot,
+                      type1_t *smallest,
+                      type1_t *biggest) const
+    {
+        return partition_avx512_kv<vtype1, vtype2>(
+                keys, values, begin, end, pivot, smallest, biggest);
+    }
+    void swap(int64_t ii, int64_t jj, int64_t num) const
+    {
+        std::swap_ranges(keys + ii, keys + ii + num, keys + jj);
+        std::swap_ranges(values + ii, values + ii + num, values + jj);
+    }
+    void sort(int64_t left, int64_t right, int64_t max_iters) const
+    {
+        qsort_64bit_<vtype1, vtype2>(keys, values, left, right, max_iters);
+    }
+};
+
+template <typename keytype, typename valtype, typename T1, typename T2>
+X86_SIMD_SORT_INLINE void xss_parallel_qsort_kv(xss_executor &executor,
+                                                T1 *keys,
+                                                T2 *values,
+                                                int64_t arrsize)
+{
+    int64_t nan_count = 0;
+    if constexpr (!std::is_integral_v<T1>) {
+        nan_count = xss_parallel_replace_nan_with_inf<keytype>(
+                executor, keys, arrsize);
+    }
+    xss_parallel_sort<keytype>(
+            executor,
+            xss_kv_kernel<keytype, valtype, T1, T2> {keys, values},
+            arrsize);
+    replace_inf_with_nan(keys, arrsize, nan_count);
+}
+
+/*
+ * avx512_qsort_kv on several threads, same key and value types. The tasks run
+ * on executor, or on xss_default_executor. The keys come out the same as
+ * with avx512_qsort_kv, each still paired with its value.
+ */
+template <typename T1, typename T2>
+void avx512_qsort_kv_parallel(T1 *keys,
+                              T2 *values,
+                              int64_t arrsize,
+                              xss_executor &executor,
+                              bool descending = false)
+{
+    using keytype = typename avx512_kv_vectors<T1, T2>::keytype;
+    using valtype = typename avx512_kv_vectors<T1, T2>::valtype;
+    if (arrsize <= XSS_PARALLEL_CUTOFF || executor.concurrency() <= 1) {
+        avx512_qsort_kv<T1, T2>(keys, values, arrsize, descending);
+    }
+    else if (descending) {
+        xss_parallel_qsort_kv<descending_vector<keytype>, valtype>(
+                executor, keys, values, arrsize);
+    }
+    else {
+        xss_parallel_qsort_kv<keytype, valtype>(
+                executor, keys, values, arrsize);
+    }
+}
+
+template <typename T1, typename T2>
+void avx512_qsort_kv_parallel(T1 *keys,
+                              T2 *values,
+                              int64_t arrsize,
+                              bool descending = false)
+{
+    avx512_qsort_kv_parallel<T1, T2>(
+            keys, values, arrsize, xss_default_executor(), descending);
+}
+
+#endif // AVX512_PARALLEL_KEYVALUESORT
@@ -0,0 +1,402 @@
+/*******************************************************************
+ * Copyright (C) 2023 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * ****************************************************************/
+
+#ifndef AVX512_PARALLEL_QSORT
+#define AVX512_PARALLEL_QSORT
+
+#include "avx512-common-qsort.h"
+#include "xss-thread-pool.hpp"
+#include <utility>
+#include <vector>
+
+/*
+ * Multithreaded quicksort, on the executor of xss-thread-pool.hpp. The top
+ * levels, down to about one subarray per thread, are each partitioned by all
+ * the threads at once (xss_parallel_partition below), so the first pass over
+ * the array doesn't run on a single core. The subarrays left are then handed
+ * to the pool as tasks, which keep partitioning with the serial kernel and
+ * submitting one side, until the pieces are small enough to be sorted by the
+ * serial quicksort. Arrays of at most XSS_PARALLEL_CUTOFF elements are sorted
+ * on the calling thread.
+ */
+#ifndef XSS_PARALLEL_CUTOFF
+#define XSS_PARALLEL_CUTOFF 100000
+#endif
+
+/* How many threads share a pass over size elements, at least 1 */
+X86_SIMD_SORT_INLINE int xss_num_chunks(xss_executor &executor, int64_t size)
+{
+    int64_t num = size / (XSS_PARALLEL_CUTOFF / 4);
+    return (int)std::max<int64_t>(
+            1, std::min<int64_t>(num, executor.concurrency()));
+}
+
+/* Runs func(0), ..., func(num - 1) in parallel, func(0) on this thread */
+template <typename F>
+X86_SIMD_SORT_INLINE void
+xss_parallel_for(xss_executor &executor, int num, const F &func)
+{
+    xss_task_group group(executor);
+    for (int ii = 1; ii < num; ++ii) {
+        group.run([&func, ii]() { func(ii); });
+    }
+    func(0);
+    group.wait();
+}
+
+/*
+ * Swaps the elements number begin to end of the runs in a with the same ones
+ * of the runs in b, where runs are [first, second) ranges of the array.
+ */
+template <typename S>
+X86_SIMD_SORT_INLINE void
+xss_swap_runs(const std::vector<std::pair<int64_t, int64_t>> &a,
+              const std::vector<std::pair<int64_t, int64_t>> &b,
+              int64_t begin,
+              int64_t end,
+              const S &swap)
+{
+    if (begin >= end) { return; }
+    size_t ia = 0, ib = 0;
+    int64_t offset_a = begin, offset_b = begin;
+    while (offset_a >= a[ia].second - a[ia].first) {
+        offset_a -= a[ia].second - a[ia].first;
+        ++ia;
+    }
+    while (offset_b >= b[ib].second - b[ib].first) {
+        offset_b -= b[ib].second - b[ib].first;
+        ++ib;
+    }
+    while (begin < end) {
+        int64_t num = std::min({end - begin,
+                                a[ia].second - a[ia].first - offset_a,
+                                b[ib].second - b[ib].first - offset_b});
+        swap(a[ia].first + offset_a, b[ib].first + offset_b, num);
+        begin += num;
+        offset_a += num;
+        offset_b += num;
+        if (offset_a == a[ia].second - a[ia].first) {
+            ++ia;
+            offset_a = 0;
+        }
+        if (offset_b == b[ib].second - b[ib].first) {
+            ++ib;
+            offset_b = 0;
+        }
+    }
+}
+
+/*
+ * Partitions [left, right) like partition_avx512 with all the threads of the
+ * executor: every thread partitions its own chunk with
+ * partition(begin, end, &smallest, &biggest), which returns the index of the
+ * first element of the chunk that is not less than the pivot. The elements
+ * left on the wrong side of the final split are then swapped in parallel with
+ * swap(i, j, num), which swaps the num elements from i with the ones from j.
+ * Returns the index of the first element not less than the pivot.
+ */
+template <typename vtype, typename type_t, typename P, typename S>
+X86_SIMD_SORT_INLINE int64_t xss_parallel_partition(xss_executor &executor,
+                                                    int64_t left,
+                                                    int64_t right,
+                                                    type_t *smallest,
+                                                    type_t *biggest,
+                                                    const P &partition,
+                                                    const S &swap)
+{
+    int num_chunks = xss_num_chunks(executor, right - left);
+    std::vector<int64_t> bounds(num_chunks + 1);
+    std::vector<int64_t> mids(num_chunks);
+    std::vector<type_t> smallests(num_chunks, *smallest);
+    std::vector<type_t> biggests(num_chunks, *biggest);
+    for (int ii = 0; ii <= num_chunks; ++ii) {
+        bounds[ii] = left + (right - left) * ii / num_chunks;
+    }
+    xss_parallel_for(executor, num_chunks, [&](int ii) {
+        mids[ii] = partition(
+                bounds[ii], bounds[ii + 1], &smallests[ii], &biggests[ii]);
+    });
+
+    int64_t mid = left;
+    for (int ii = 0; ii < num_chunks; ++ii) {
+        mid += mids[ii] - bounds[ii];
+        *smallest = std::min(*smallest, smallests[ii], comparison_func<vtype>);
+        *biggest = std::max(*biggest, biggests[ii], comparison_func<vtype>);
+    }
+    /* Runs of elements >= pivot before mid, and < pivot from mid on */
+    std::vector<std::pair<int64_t, int64_t>> ge_runs, lt_runs;
+    int64_t num_swaps = 0;
+    for (int ii = 0; ii < num_chunks; ++ii) {
+        int64_t ge_end = std::min(bounds[ii + 1], mid);
+        if (mids[ii] < ge_end) {
+            ge_runs.emplace_back(mids[ii], ge_end);
+            num_swaps += ge_end - mids[ii];
+        }
+        int64_t lt_begin = std::max(bounds[ii], mid);
+        if (lt_begin < mids[ii]) { lt_runs.emplace_back(lt_begin, mids[ii]); }
+    }
+    int num_swap_chunks = xss_num_chunks(executor, num_swaps);
+    xss_parallel_for(executor, num_swap_chunks, [&](int ii) {
+        xss_swap_runs(ge_runs,
+                      lt_runs,
+                      num_swaps * ii / num_swap_chunks,
+                      num_swaps * (ii + 1) / num_swap_chunks,
+                      swap);
+    });
+    return mid;
+}
+
+/* A subarray [left, right] left to sort and its quicksort budget */
+struct xss_subarray {
+    int64_t left;
+    int64_t right;
+    int64_t max_iters;
+};
+
+/*
+ * Grain of the tasks: subarrays are split until they are at most this big,
+ * about 8 per thread
+ */
+X86_SIMD_SORT_INLINE int64_t xss_parallel_grain(xss_executor &executor,
+                                                int64_t arrsize)
+{
+    return std::max<int64_t>(XSS_PARALLEL_CUTOFF / 4,
+                             arrsize / (8 * executor.concurrency()));
+}
+
+/* qsort_, or the counting sort of the vtype when it has one */
+template <typename vtype, typename type_t>
+X86_SIMD_SORT_INLINE void
+xss_qsort_range(type_t *arr, int64_t left, int64_t right, int64_t max_iters)
+{
+    if constexpr (xss_has_histogram_sort<vtype>::value) {
+        if (xss_use_histogram_sort<vtype>(right + 1 - left)) {
+            vtype::histogram_sort(arr + left, right + 1 - left);
+            return;
+        }
+    }
+    qsort_<vtype>(arr, left, right, max_iters);
+}
+
+/*
+ * The parallel quicksort below runs the serial routines through a kernel,
+ * which knows what is being sorted: an array here, the indices of one for
+ * argsort or the keys and values for key-value sort. It has
+ *   type_t pivot(left, right)
+ *   int64_t partition(begin, end, pivot, &smallest, &biggest), like
+ *           partition_avx512 on [begin, end)
+ *   void swap(ii, jj, num), swapping [ii, ii + num) with [jj, jj + num)
+ *   void sort(left, right, max_iters), the serial quicksort of [left, right]
+ */
+template <typename vtype, typename type_t>
+struct xss_qsort_kernel {
+    type_t *arr;
+
+    type_t pivot(int64_t left, int64_t right) const
+    {
+        return get_pivot<vtype, type_t>(arr, left, right);
+    }
+    int64_t partition(int64_t begin,
+                      int64_t end,
+                      type_t pivot,
+                      type_t *smallest,
+                      type_t *biggest) const
+    {
+        return partition_avx512_unrolled<vtype,
+                                         vtype::partition_unroll_factor>(
+                arr, begin, end, pivot, smallest, biggest);
+    }
+    void swap(int64_t ii, int64_t jj, int64_t num) const
+    {
+        std::swap_ranges(arr + ii, arr + ii + num, arr + jj);
+    }
+    void sort(int64_t left, int64_t right, int64_t max_iters) const
+    {
+        xss_qsort_range<vtype>(arr, left, right, max_iters);
+    }
+};
+
+template <typename vtype, typename kernel_t>
+static void qsort_task_(xss_task_group &group,
+                        const kernel_t &kernel,
+                        int64_t left,
+                        int64_t right,
+                        int64_t max_iters,
+                        int64_t grain)
+{
+    using type_t = typename vtype::type_t;
+    while (right + 1 - left > grain && max_iters > 0) {
+        type_t pivot = kernel.pivot(left, right);
+        type_t smallest = vtype::type_max();
+        type_t biggest = vtype::type_min();
+        int64_t pivot_index = kernel.partition(
+                left, right + 1, pivot, &smallest, &biggest);
+        max_iters -= 1;
+        if (pivot == smallest && pivot == biggest) { return; }
+        if (pivot == smallest) {
+            left = pivot_index;
+            continue;
+        }
+        if (pivot != biggest) {
+            group.run([&group, kernel, pivot_index, right, max_iters, grain]() {
+                qsort_task_<vtype>(
+                        group, kernel, pivot_index, right, max_iters, grain);
+            });
+        }
+        right = pivot_index - 1;
+    }
+    kernel.sort(left, right, max_iters);
+}
+
+/*
+ * Partitions the subarrays bigger than split_size in parallel and appends the
+ * others to subarrays
+ */
+template <typename vtype, typename kernel_t>
+static void parallel_qsort_(xss_executor &executor,
+                            const kernel_t &kernel,
+                            int64_t left,
+                            int64_t right,
+                            int64_t max_iters,
+                            int64_t split_size,
+                            std::vector<xss_subarray> &subarrays)
+{
+    using type_t = typename vtype::type_t;
+    if (right + 1 - left <= split_size || max_iters <= 0) {
+        subarrays.push_back({left, right, max_iters});
+        return;
+    }
+    type_t pivot = kernel.pivot(left, right);
+    type_t smallest = vtype::type_max();
+    type_t biggest = vtype::type_min();
+    int64_t pivot_index = xss_parallel_partition<vtype>(
+            executor,
+            left,
+            right + 1,
+            &smallest,
+            &biggest,
+            [&kernel, pivot](int64_t begin,
+                             int64_t end,
+                             type_t *chunk_smallest,
+                             type_t *chunk_biggest) {
+                return kernel.partition(
+                        begin, end, pivot, chunk_smallest, chunk_biggest);
+            },
+            [&kernel](int64_t ii, int64_t jj, int64_t num) {
+                kernel.swap(ii, jj, num);
+            });
+
+    if (pivot != smallest)
+        parallel_qsort_<vtype>(executor,
+                               kernel,
+                               left,
+                               pivot_index - 1,
+                               max_iters - 1,
+                               split_size,
+                               subarrays);
+    if (pivot != biggest)
+        parallel_qsort_<vtype>(executor,
+                               kernel,
+                               pivot_index,
+                               right,
+                               max_iters - 1,
+                               split_size,
+                               subarrays);
+}
+
+/* Sorts [0, arrsize) with the kernel on all the threads of the executor */
+template <typename vtype, typename kernel_t>
+X86_SIMD_SORT_INLINE void xss_parallel_sort(xss_executor &executor,
+                                            const kernel_t &kernel,
+                                            int64_t arrsize)
+{
+    if (arrsize <= 1) { return; }
+    std::vector<xss_subarray> subarrays;
+    int64_t split_size = std::max<int64_t>(
+            XSS_PARALLEL_CUTOFF, arrsize / executor.concurrency());
+    parallel_qsort_<vtype>(executor,
+                           kernel,
+                           0,
+                           arrsize - 1,
+                           2 * (int64_t)log2(arrsize),
+                           split_size,
+                           subarrays);
+
+    int64_t grain = xss_parallel_grain(executor, arrsize);
+    xss_task_group group(executor);
+    for (const xss_subarray &sub : subarrays) {
+        group.run([&group, &kernel, sub, grain]() {
+            qsort_task_<vtype>(
+                    group, kernel, sub.left, sub.right, sub.max_iters, grain);
+        });
+    }
+    group.wait();
+}
+
+/* replace_nan_with_inf on all the threads */
+template <typename vtype, typename T>
+X86_SIMD_SORT_INLINE int64_t xss_parallel_replace_nan_with_inf(
+        xss_executor &executor, T *arr, int64_t arrsize)
+{
+    int num_chunks = xss_num_chunks(executor, arrsize);
+    std::vector<int64_t> nan_counts(num_chunks);
+    xss_parallel_for(executor, num_chunks, [&](int ii) {
+        int64_t begin = arrsize * ii / num_chunks;
+        int64_t end = arrsize * (ii + 1) / num_chunks;
+        nan_counts[ii] = replace_nan_with_inf<vtype>(arr + begin, end - begin);
+    });
+    int64_t nan_count = 0;
+    for (int64_t count : nan_counts) {
+        nan_count += count;
+    }
+    return nan_count;
+}
+
+template <typename vtype, typename T>
+X86_SIMD_SORT_INLINE void
+xss_parallel_qsort(xss_executor &executor, T *arr, int64_t arrsize)
+{
+    int64_t nan_count = 0;
+    if constexpr (std::is_floating_point_v<T>) {
+        nan_count = xss_parallel_replace_nan_with_inf<vtype>(
+                executor, arr, arrsize);
+    }
+    xss_parallel_sort<vtype>(
+            executor, xss_qsort_kernel<vtype, T> {arr}, arrsize);
+    replace_inf_with_nan(arr, arrsize, nan_count);
+}
+
+/*
+ * avx512_qsort on several threads, for 16-bit, 32-bit and 64-bit dtypes. The
+ * tasks run on executor, or on a pool with one thread per core shared by the
+ * whole process (xss_default_executor). The result is the same as with
+ * avx512_qsort, including NaN's at the end and descending.
+ */
+template <typename T>
+void avx512_qsort_parallel(T *arr,
+                           int64_t arrsize,
+                           xss_executor &executor,
+                           bool descending = false)
+{
+    if (arrsize <= XSS_PARALLEL_CUTOFF || executor.concurrency() <= 1) {
+        avx512_qsort<T>(arr, arrsize, descending);
+    }
+    else if (descending) {
+        xss_parallel_qsort<descending_vector<zmm_partition_vector<T>>>(
+                executor, arr, arrsize);
+    }
+    else {
+        xss_parallel_qsort<zmm_partition_vector<T>>(executor, arr, arrsize);
+    }
+}
+
+template <typename T>
+void avx512_qsort_parallel(T *arr, int64_t arrsize, bool descending = false)
+{
+    avx512_qsort_parallel<T>(
+            arr, arrsize, xss_default_executor(), descending);
+}
+
+#endif // AVX512_PARALLEL_QSORT
@@ -0,0 +1,177 @@
+/*******************************************************************
+ * Copyright (C) 2023 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * ****************************************************************/
+
+#ifndef AVX512_ARGSORT_STABLE
+#define AVX512_ARGSORT_STABLE
+
+#include "avx512-64bit-argsort.hpp"
+#include "avx512-64bit-qsort.hpp"
+
+/*
+ * Stable argsort: the indices of equal values stay in increasing order, as
+ * with NumPy's kind='stable'. Equal here means equal as compared by argsort,
+ * so -0.0 and +0.0 tie and so do all NaN's, which go to the end.
+ *
+ * For 32-bit keys, every key is mapped to an unsigned integer in the same
+ * order and packed with its index into one 64-bit word, key in the upper
+ * half. The words are unique, so sorting them with the 64-bit quicksort
+ * gives the stable order, and the indices are the lower halves. The words
+ * are built in arg itself, which takes arrays of up to 2^32 values.
+ *
+ * 64-bit keys don't leave room for the index: they are argsorted as usual
+ * and every run of equal keys then has its indices sorted, which is the
+ * only thing an unstable argsort can get wrong.
+ */
+template <typename T, bool descending>
+struct stable_argsort_key32 {
+    static_assert(sizeof(T) == 4);
+    static constexpr uint32_t msb = 0x80000000u;
+    static constexpr uint32_t invert = descending ? 0xFFFFFFFFu : 0u;
+
+    /* sign(x) | 0x80..0 for floats and 0x80..0 for signed integers */
+    static constexpr uint32_t flip(uint32_t bits)
+    {
+        if constexpr (std::is_floating_point_v<T>) {
+            return (uint32_t)((int32_t)bits >> 31) | msb;
+        }
+        else if constexpr (std::is_signed_v<T>) {
+            return msb;
+        }
+        else {
+            return 0;
+        }
+    }
+    static uint32_t key(T x)
+    {
+        if constexpr (std::is_floating_point_v<T>) {
+            /* turns -0.0 into +0.0 */
+            x += (T)0;
+            if (x != x) { return 0xFFFFFFFFu; }
+        }
+        uint32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        return bits ^ flip(bits) ^ invert;
+    }
+    static __m512i key(const T *arr)
+    {
+        __m512i bits;
+        __mmask16 nan = 0;
+        if constexpr (std::is_floating_point_v<T>) {
+            __m512 x = _mm512_add_ps(_mm512_loadu_ps(arr), _mm512_setzero_ps());
+            nan = _mm512_cmp_ps_mask(x, x, _CMP_UNORD_Q);
+            bits = _mm512_castps_si512(x);
+            __m512i sign = _mm512_srai_epi32(bits, 31);
+            /* bits ^ (sign | msb), inverted if descending */
+            bits = _mm512_ternarylogic_epi32(bits,
+                                             sign,
+                                             _mm512_set1_epi32(msb),
+                                             descending ? 0xE1 : 0x1E);
+        }
+        else {
+            bits = _mm512_xor_si512(_mm512_loadu_si512(arr),
+                                    _mm512_set1_epi32(flip(0) ^ invert));
+        }
+        return _mm512_mask_mov_epi32(bits, nan, _mm512_set1_epi32(-1));
+    }
+
+    static void to_words(const T *arr, uint64_t *words, int64_t arrsize)
+    {
+        const __m512i sixteen = _mm512_set1_epi64(16);
+        __m512i index_lo = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+        __m512i index_hi = _mm512_set_epi64(15, 14, 13, 12, 11, 10, 9, 8);
+        int64_t ii = 0;
+        for (; ii + 16 <= arrsize; ii += 16) {
+            __m512i keys = key(arr + ii);
+            __m512i lo = _mm512_cvtepu32_epi64(_mm512_castsi512_si256(keys));
+            __m512i hi
+                    = _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(keys, 1));
+            _mm512_storeu_si512(
+                    words + ii,
+                    _mm512_or_si512(_mm512_slli_epi64(lo, 32), index_lo));
+            _mm512_storeu_si512(
+                    words + ii + 8,
+                    _mm512_or_si512(_mm512_slli_epi64(hi, 32), index_hi));
+            index_lo = _mm512_add_epi64(index_lo, sixteen);
+            index_hi = _mm512_add_epi64(index_hi, sixteen);
+        }
+        for (; ii < arrsize; ++ii) {
+            words[ii] = (uint64_t)key(arr[ii]) << 32 | (uint64_t)ii;
+        }
+    }
+};
+
+template <typename T>
+X86_SIMD_SORT_INLINE bool same_key(T a, T b)
+{
+    return a == b || (a != a && b != b);
+}
+
+/* Sorts the indices of each run of equal keys in an argsorted array */
+template <typename T>
+X86_SIMD_SORT_INLINE void
+sort_tied_args(const T *arr, int64_t *arg, int64_t arrsize)
+{
+    int64_t ii = 0;
+    while (ii < arrsize) {
+        T value = arr[arg[ii]];
+        int64_t jj = ii + 1;
+        while (jj < arrsize && same_key(arr[arg[jj]], value)) {
+            ++jj;
+        }
+        if (jj - ii > 1) { avx512_qsort<int64_t>(arg + ii, jj - ii); }
+        ii = jj;
+    }
+}
+
+template <typename T, bool descending>
+X86_SIMD_SORT_INLINE void
+xss_argsort_stable(T *arr, int64_t *arg, int64_t arrsize)
+{
+    if constexpr (sizeof(T) == 4) {
+        if (arrsize <= ((int64_t)1 << 32)) {
+            uint64_t *words = (uint64_t *)arg;
+            stable_argsort_key32<T, descending>::to_words(arr, words, arrsize);
+            avx512_qsort<uint64_t>(words, arrsize);
+            for (int64_t ii = 0; ii < arrsize; ++ii) {
+                arg[ii] = (int64_t)(words[ii] & 0xFFFFFFFFu);
+            }
+            return;
+        }
+    }
+    std::iota(arg, arg + arrsize, 0);
+    avx512_argsort<T>(arr, arg, arrsize, descending);
+    sort_tied_args(arr, arg, arrsize);
+}
+
+/*
+ * Stable argsort of 32-bit and 64-bit dtypes, NAN's at the end. Unlike
+ * avx512_argsort, arg doesn't have to be initialized: it gets the indices
+ * that sort arr. descending = true keeps the indices of equal values in
+ * increasing order as well.
+ */
+template <typename T>
+void avx512_argsort_stable(T *arr,
+                           int64_t *arg,
+                           int64_t arrsize,
+                           bool descending = false)
+{
+    static_assert(sizeof(T) == 4 || sizeof(T) == 8,
+                  "avx512_argsort_stable takes 32-bit and 64-bit dtypes");
+    if (descending) { xss_argsort_stable<T, true>(arr, arg, arrsize); }
+    else {
+        xss_argsort_stable<T, false>(arr, arg, arrsize);
+    }
+}
+
+template <typename T>
+std::vector<int64_t>
+avx512_argsort_stable(T *arr, int64_t arrsize, bool descending = false)
+{
+    std::vector<int64_t> indices(arrsize);
+    avx512_argsort_stable<T>(arr, indices.data(), arrsize, descending);
+    return indices;
+}
+
+#endif // AVX512_ARGSORT_STABLE
@@ -0,0 +1,387 @@
+/*******************************************************************
+ * Copyright (C) 2023 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * ****************************************************************/
+
+#ifndef AVX512_QSORT_TOTALORDER
+#define AVX512_QSORT_TOTALORDER
+
+#include "avx512-16bit-qsort.hpp"
+#include "avx512-32bit-qsort.hpp"
+#include "avx512-64bit-qsort.hpp"
+
+/*
+ * Sorting float, double and half (stored as uint16_t) in the IEEE 754
+ * totalOrder: -0.0 before +0.0 and every bit pattern, NaN payloads included,
+ * kept as it is. Instead of replacing NaN's with inf and writing quiet NaN's
+ * back, the values are sorted as signed integer keys in the same order with
+ * the integer vtype of the same width.
+ *
+ * Flipping the magnitude bits of the negative values gives the totalOrder
+ * -NaN < -inf < ... < -0 < +0 < ... < +inf < +NaN as signed integers. NaN's of
+ * either sign are then grouped at one end by rotating the keys: with
+ * nans_first = false the 2^mantissa_bits - 1 smallest keys (the negative
+ * NaN's) wrap around to the top. Either way the NaN's end up in the order
+ * +NaN's by increasing payload, then -NaN's by decreasing payload.
+ */
+template <typename T>
+struct totalorder_traits;
+
+template <>
+struct totalorder_traits<float16> {
+    using type_t = uint16_t;
+    using int_t = int16_t;
+    static constexpr int mantissa_bits = 10;
+};
+
+template <>
+struct totalorder_traits<float> {
+    using type_t = float;
+    using int_t = int32_t;
+    static constexpr int mantissa_bits = 23;
+};
+
+template <>
+struct totalorder_traits<double> {
+    using type_t = double;
+    using int_t = int64_t;
+    static constexpr int mantissa_bits = 52;
+};
+
+/*
+ * vtype of the keys of T: the registers hold keys, which the loads, gathers,
+ * set1 and the reductions map the values to and the stores map back. The
+ * array keeps its values, so the sort needs no pass over it besides its own.
+ * Everything else is inherited from the integer vtype, the scalars are
+ * compared with comparison_func.
+ */
+template <typename T, bool nans_first>
+struct zmm_vector_totalorder
+    : public zmm_partition_vector<typename totalorder_traits<T>::int_t> {
+    using int_t = typename totalorder_traits<T>::int_t;
+    using uint_t = std::make_unsigned_t<int_t>;
+    using vtype = zmm_vector<int_t>;
+    using type_t = typename totalorder_traits<T>::type_t;
+    using reg_t = typename vtype::reg_t;
+    using opmask_t = typename vtype::opmask_t;
+    static constexpr uint_t nan_range
+            = ((uint_t)1 << totalorder_traits<T>::mantissa_bits) - 1;
+    static constexpr uint_t rotation
+            = nans_first ? nan_range : (uint_t)(0 - nan_range);
+
+    static int_t flip_negatives(int_t x)
+    {
+        return (int_t)(x
+                       ^ ((x >> (8 * sizeof(int_t) - 1))
+                          & std::numeric_limits<int_t>::max()));
+    }
+    /* x ^ (sign(x) & 0x7f..f) in one vpternlog */
+    static reg_t flip_negatives(reg_t x)
+    {
+        const reg_t magnitude = vtype::set1(std::numeric_limits<int_t>::max());
+        reg_t sign;
+        if constexpr (sizeof(int_t) == 2) { sign = _mm512_srai_epi16(x, 15); }
+        else if constexpr (sizeof(int_t) == 4) {
+            sign = _mm512_srai_epi32(x, 31);
+        }
+        else {
+            sign = _mm512_srai_epi64(x, 63);
+        }
+        return _mm512_ternarylogic_epi32(x, sign, magnitude, 0x78);
+    }
+    static reg_t add(reg_t x, uint_t v)
+    {
+        if constexpr (sizeof(int_t) == 2) {
+            return _mm512_add_epi16(x, vtype::set1((int_t)v));
+        }
+        else if constexpr (sizeof(int_t) == 4) {
+            return _mm512_add_epi32(x, vtype::set1((int_t)v));
+        }
+        else {
+            return _mm512_add_epi64(x, vtype::set1((int_t)v));
+        }
+    }
+    static int_t to_key(type_t v)
+    {
+        int_t x;
+        std::memcpy(&x, &v, sizeof(x));
+        return (int_t)(uint_t)((uint_t)flip_negatives(x) + rotation);
+    }
+    static type_t from_key(int_t key)
+    {
+        int_t x = flip_negatives((int_t)(uint_t)((uint_t)key - rotation));
+        type_t v;
+        std::memcpy(&v, &x, sizeof(v));
+        return v;
+    }
+    static reg_t to_key(reg_t x)
+    {
+        return add(flip_negatives(x), rotation);
+    }
+    static reg_t from_key(reg_t x)
+    {
+        return flip_negatives(add(x, (uint_t)(0 - rotation)));
+    }
+
+    static type_t type_max()
+    {
+        return from_key(vtype::type_max());
+    }
+    static type_t type_min()
+    {
+        return from_key(vtype::type_min());
+    }
+    static reg_t set1(type_t v)
+    {
+        return vtype::set1(to_key(v));
+    }
+    static type_t reducemax(reg_t v)
+    {
+        return from_key(vtype::reducemax(v));
+    }
+    static type_t reducemin(reg_t v)
+    {
+        return from_key(vtype::reducemin(v));
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return to_key(vtype::loadu(mem));
+    }
+    /* x already holds keys, mapping them back and forth keeps them */
+    static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
+    {
+        return to_key(vtype::mask_loadu(from_key(x), mask, mem));
+    }
+    template <int scale>
+    static auto i64gather(__m512i index, void const *base)
+    {
+        if constexpr (sizeof(int_t) == 8) {
+            return to_key(vtype::template i64gather<scale>(index, base));
+        }
+        else {
+            /* 8 of the 16 keys of get_pivot_32bit */
+            static_assert(sizeof(int_t) == 4);
+            __m256i x = vtype::template i64gather<scale>(index, base);
+            __m256i sign = _mm256_srai_epi32(x, 31);
+            x = _mm256_ternarylogic_epi32(
+                    x, sign, _mm256_set1_epi32(INT32_MAX), 0x78);
+            return _mm256_add_epi32(x, _mm256_set1_epi32((int_t)rotation));
+        }
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        vtype::storeu(mem, from_key(x));
+    }
+    static void mask_storeu(void *mem, opmask_t mask, reg_t x)
+    {
+        vtype::mask_storeu(mem, mask, from_key(x));
+    }
+    static void mask_compressstoreu(void *mem, opmask_t mask, reg_t x)
+    {
+        vtype::mask_compressstoreu(mem, mask, from_key(x));
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+#ifdef XSS_AVX512_COMPRESS_TO_REGISTER
+        return avx512_double_compress_to_register<vtype>(
+                left_addr, right_addr, k, from_key(reg));
+#else
+        return avx512_double_compressstore<vtype>(
+                left_addr, right_addr, k, from_key(reg));
+#endif
+    }
+    /* Only used with the 16-bit keys, which have histogram_sort_threshold */
+    static uint16_t bucket(type_t x)
+    {
+        return (uint16_t)to_key(x) ^ 0x8000;
+    }
+    static type_t value(uint16_t b)
+    {
+        return from_key((int_t)(b ^ 0x8000));
+    }
+    template <bool descending = false>
+    static void histogram_sort(type_t *arr, int64_t arrsize)
+    {
+        avx512_histogram_sort_16bit<type_t, descending, zmm_vector_totalorder>(
+                arr, arrsize);
+    }
+};
+
+template <>
+inline bool comparison_func<zmm_vector_totalorder<float16, false>>(
+        const uint16_t &a, const uint16_t &b)
+{
+    using vtype = zmm_vector_totalorder<float16, false>;
+    return vtype::to_key(a) < vtype::to_key(b);
+}
+
+template <>
+inline bool comparison_func<zmm_vector_totalorder<float16, true>>(
+        const uint16_t &a, const uint16_t &b)
+{
+    using vtype = zmm_vector_totalorder<float16, true>;
+    return vtype::to_key(a) < vtype::to_key(b);
+}
+
+template <>
+inline bool comparison_func<zmm_vector_totalorder<float, false>>(
+        const float &a, const float &b)
+{
+    using vtype = zmm_vector_totalorder<float, false>;
+    return vtype::to_key(a) < vtype::to_key(b);
+}
+
+template <>
+inline bool comparison_func<zmm_vector_totalorder<float, true>>(
+        const float &a, const float &b)
+{
+    using vtype = zmm_vector_totalorder<float, true>;
+    return vtype::to_key(a) < vtype::to_key(b);
+}
+
+template <>
+inline bool comparison_func<zmm_vector_totalorder<double, false>>(
+        const double &a, const double &b)
+{
+    using vtype = zmm_vector_totalorder<double, false>;
+    return vtype::to_key(a) < vtype::to_key(b);
+}
+
+template <>
+inline bool comparison_func<zmm_vector_totalorder<double, true>>(
+        const double &a, const double &b)
+{
+    using vtype = zmm_vector_totalorder<double, true>;
+    return vtype::to_key(a) < vtype::to_key(b);
+}
+
+/*
+ * xss_qsort without the NaN replacement, the keys order the NaN's. k ==
+ * arrsize sorts the whole array.
+ */
+template <typename T, bool nans_first>
+X86_SIMD_SORT_INLINE void xss_partial_qsort_totalorder(
+        typename totalorder_traits<T>::type_t *arr, int64_t k, int64_t arrsize)
+{
+    using vtype = zmm_vector_totalorder<T, nans_first>;
+    if (k < arrsize) {
+        xss_qselect<vtype>(arr, k - 1, arrsize, false);
+        arrsize = k - 1;
+    }
+    if constexpr (xss_has_histogram_sort<vtype>::value) {
+        if (xss_use_histogram_sort<vtype>(arrsize)) {
+            vtype::histogram_sort(arr, arrsize);
+            return;
+        }
+    }
+    if (arrsize > 1) {
+        qsort_<vtype>(arr, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+    }
+}
+
+template <typename T, bool nans_first>
+X86_SIMD_SORT_INLINE void xss_qselect_totalorder(
+        typename totalorder_traits<T>::type_t *arr, int64_t k, int64_t arrsize)
+{
+    xss_qselect<zmm_vector_totalorder<T, nans_first>>(arr, k, arrsize, false);
+}
+
+template <typename T>
+X86_SIMD_SORT_INLINE void
+xss_partial_qsort_totalorder(typename totalorder_traits<T>::type_t *arr,
+                             int64_t k,
+                             int64_t arrsize,
+                             bool nans_first)
+{
+    if (nans_first) {
+        xss_partial_qsort_totalorder<T, true>(arr, k, arrsize);
+    }
+    else {
+        xss_partial_qsort_totalorder<T, false>(arr, k, arrsize);
+    }
+}
+
+template <typename T>
+X86_SIMD_SORT_INLINE void
+xss_qselect_totalorder(typename totalorder_traits<T>::type_t *arr,
+                       int64_t k,
+                       int64_t arrsize,
+                       bool nans_first)
+{
+    if (nans_first) { xss_qselect_totalorder<T, true>(arr, k, arrsize); }
+    else {
+        xss_qselect_totalorder<T, false>(arr, k, arrsize);
+    }
+}
+
+inline void
+avx512_qsort_totalorder(float *arr, int64_t arrsize, bool nans_first = false)
+{
+    xss_partial_qsort_totalorder<float>(arr, arrsize, arrsize, nans_first);
+}
+
+inline void
+avx512_qsort_totalorder(double *arr, int64_t arrsize, bool nans_first = false)
+{
+    xss_partial_qsort_totalorder<double>(arr, arrsize, arrsize, nans_first);
+}
+
+inline void avx512_qsort_fp16_totalorder(uint16_t *arr,
+                                         int64_t arrsize,
+                                         bool nans_first = false)
+{
+    xss_partial_qsort_totalorder<float16>(arr, arrsize, arrsize, nans_first);
+}
+
+inline void avx512_qselect_totalorder(float *arr,
+                                      int64_t k,
+                                      int64_t arrsize,
+                                      bool nans_first = false)
+{
+    xss_qselect_totalorder<float>(arr, k, arrsize, nans_first);
+}
+
+inline void avx512_qselect_totalorder(double *arr,
+                                      int64_t k,
+                                      int64_t arrsize,
+                                      bool nans_first = false)
+{
+    xss_qselect_totalorder<double>(arr, k, arrsize, nans_first);
+}
+
+inline void avx512_qselect_fp16_totalorder(uint16_t *arr,
+                                           int64_t k,
+                                           int64_t arrsize,
+                                           bool nans_first = false)
+{
+    xss_qselect_totalorder<float16>(arr, k, arrsize, nans_first);
+}
+
+inline void avx512_partial_qsort_totalorder(float *arr,
+                                            int64_t k,
+                                            int64_t arrsize,
+                                            bool nans_first = false)
+{
+    xss_partial_qsort_totalorder<float>(arr, k, arrsize, nans_first);
+}
+
+inline void avx512_partial_qsort_totalorder(double *arr,
+                                            int64_t k,
+                                            int64_t arrsize,
+                                            bool nans_first = false)
+{
+    xss_partial_qsort_totalorder<double>(arr, k, arrsize, nans_first);
+}
+
+inline void avx512_partial_qsort_fp16_totalorder(uint16_t *arr,
+                                                 int64_t k,
+                                                 int64_t arrsize,
+                                                 bool nans_first = false)
+{
+    xss_partial_qsort_totalorder<float16>(arr, k, arrsize, nans_first);
+}
+
+#endif // AVX512_QSORT_TOTALORDER
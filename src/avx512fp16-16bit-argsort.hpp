@@ -0,0 +1,236 @@
+/*******************************************************************
+ * Copyright (C) 2023 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * ****************************************************************/
+
+#ifndef AVX512FP16_ARGSORT_16BIT
+#define AVX512FP16_ARGSORT_16BIT
+
+#include "avx512-64bit-argsort.hpp"
+#include "avx512fp16-16bit-qsort.hpp"
+
+/*
+ * argsort uses 8 x 64-bit indices per zmm register, so the _Float16 keys are
+ * sorted 8 at a time in the lower 128 bits with native AVX512-FP16 compares.
+ * There is no 16-bit gather instruction: the keys are loaded one at a time.
+ * The same vtype sorts _Float16 keys in avx512_qsort_kv, include
+ * avx512-64bit-keyvaluesort.hpp as well for that.
+ */
+template <>
+struct xmm_vector<_Float16> {
+    using type_t = _Float16;
+    using reg_t = __m128h;
+    using zmmi_t = __m128i;
+    using opmask_t = __mmask8;
+    static const uint8_t numlanes = 8;
+
+    static type_t type_max()
+    {
+        return zmm_vector<_Float16>::type_max();
+    }
+    static type_t type_min()
+    {
+        return zmm_vector<_Float16>::type_min();
+    }
+    static reg_t zmm_max()
+    {
+        return _mm_set1_ph(type_max());
+    }
+    static zmmi_t
+    seti(int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8)
+    {
+        return _mm_set_epi16(v1, v2, v3, v4, v5, v6, v7, v8);
+    }
+    static opmask_t knot_opmask(opmask_t x)
+    {
+        return _knot_mask8(x);
+    }
+    static opmask_t ge(reg_t x, reg_t y)
+    {
+        return _mm_cmp_ph_mask(x, y, _CMP_GE_OQ);
+    }
+    static opmask_t eq(reg_t x, reg_t y)
+    {
+        return _mm_cmp_ph_mask(x, y, _CMP_EQ_OQ);
+    }
+    template <int scale>
+    static reg_t
+    mask_i64gather(reg_t src, opmask_t mask, __m512i index, void const *base)
+    {
+        int64_t idx[numlanes];
+        type_t vals[numlanes];
+        _mm512_storeu_si512(idx, index);
+        _mm_storeu_ph(vals, src);
+        for (int ii = 0; ii < numlanes; ++ii) {
+            if (mask & (1 << ii)) { vals[ii] = ((type_t *)base)[idx[ii]]; }
+        }
+        return _mm_loadu_ph(vals);
+    }
+    template <int scale>
+    static reg_t i64gather(__m512i index, void const *base)
+    {
+        int64_t idx[numlanes];
+        type_t vals[numlanes];
+        _mm512_storeu_si512(idx, index);
+        for (int ii = 0; ii < numlanes; ++ii) {
+            vals[ii] = ((type_t *)base)[idx[ii]];
+        }
+        return _mm_loadu_ph(vals);
+    }
+    static opmask_t get_partial_loadmask(int size)
+    {
+        return (0x01 << size) - 0x01;
+    }
+    template <int type>
+    static opmask_t fpclass(reg_t x)
+    {
+        return _mm_fpclass_ph_mask(x, type);
+    }
+    static reg_t loadu(void const *mem)
+    {
+        return _mm_loadu_ph(mem);
+    }
+    static reg_t maskz_loadu(opmask_t mask, void const *mem)
+    {
+        return _mm_castsi128_ph(_mm_maskz_loadu_epi16(mask, mem));
+    }
+    static reg_t mask_loadu(reg_t x, opmask_t mask, void const *mem)
+    {
+        return _mm_castsi128_ph(
+                _mm_mask_loadu_epi16(_mm_castph_si128(x), mask, mem));
+    }
+    static void storeu(void *mem, reg_t x)
+    {
+        _mm_storeu_ph(mem, x);
+    }
+    static void mask_storeu(void *mem, opmask_t mask, reg_t x)
+    {
+        _mm_mask_storeu_epi16(mem, mask, _mm_castph_si128(x));
+    }
+    static void mask_compressstoreu(void *mem, opmask_t mask, reg_t x)
+    {
+        _mm_mask_compressstoreu_epi16(mem, mask, _mm_castph_si128(x));
+    }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx512_double_compressstore<xmm_vector<type_t>>(
+                left_addr, right_addr, k, reg);
+    }
+    static reg_t max(reg_t x, reg_t y)
+    {
+        return _mm_max_ph(x, y);
+    }
+    static reg_t mask_mov(reg_t x, opmask_t mask, reg_t y)
+    {
+        return _mm_castsi128_ph(_mm_mask_mov_epi16(
+                _mm_castph_si128(x), mask, _mm_castph_si128(y)));
+    }
+    static reg_t min(reg_t x, reg_t y)
+    {
+        return _mm_min_ph(x, y);
+    }
+    static reg_t permutexvar(__m128i idx, reg_t xmm)
+    {
+        return _mm_permutexvar_ph(idx, xmm);
+    }
+    static type_t reducemax(reg_t v)
+    {
+        return _mm_reduce_max_ph(v);
+    }
+    static type_t reducemin(reg_t v)
+    {
+        return _mm_reduce_min_ph(v);
+    }
+    static reg_t set1(type_t v)
+    {
+        return _mm_set1_ph(v);
+    }
+    /*
+     * The 64-bit networks only use SHUFFLE_MASK(1, 1, 1, 1), to swap
+     * neighbouring lanes
+     */
+    template <uint8_t mask>
+    static reg_t shuffle(reg_t xmm)
+    {
+        static_assert(mask == 0b01010101);
+        __m128i temp = _mm_shufflehi_epi16(_mm_castph_si128(xmm),
+                                           SHUFFLE_MASK(2, 3, 0, 1));
+        return _mm_castsi128_ph(
+                _mm_shufflelo_epi16(temp, SHUFFLE_MASK(2, 3, 0, 1)));
+    }
+    static reg_t reverse(reg_t xmm)
+    {
+        return permutexvar(seti(NETWORK_64BIT_2), xmm);
+    }
+    static reg_t sort_vec(reg_t x)
+    {
+        return sort_zmm_64bit<xmm_vector<type_t>>(x);
+    }
+};
+
+/* argsort methods for _Float16, NAN's are sorted to the end */
+template <typename vtype>
+X86_SIMD_SORT_INLINE void
+xss_argsort_fp16(_Float16 *arr, int64_t *arg, int64_t arrsize)
+{
+    if (arrsize > 1) {
+        if (has_nan<zmm_vector<_Float16>>(arr, arrsize)) {
+            arrsize = move_nan_args_to_end(
+                    arr, arg, arrsize, is_a_nan<_Float16>);
+            if (arrsize <= 1) { return; }
+        }
+        argsort_64bit_<vtype, zmm_vector<int64_t>>(
+                arr, arg, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+    }
+}
+
+template <typename vtype>
+X86_SIMD_SORT_INLINE void
+xss_argselect_fp16(_Float16 *arr, int64_t *arg, int64_t k, int64_t arrsize)
+{
+    if (arrsize > 1) {
+        if (has_nan<zmm_vector<_Float16>>(arr, arrsize)) {
+            arrsize = move_nan_args_to_end(
+                    arr, arg, arrsize, is_a_nan<_Float16>);
+            if (k >= arrsize) { return; }
+        }
+        argselect_64bit_<vtype, zmm_vector<int64_t>>(
+                arr, arg, k, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+    }
+}
+
+template <>
+inline void avx512_argsort(_Float16 *arr,
+                           int64_t *arg,
+                           int64_t arrsize,
+                           bool descending)
+{
+    using vtype = xmm_vector<_Float16>;
+    if (descending) {
+        xss_argsort_fp16<descending_vector<vtype>>(arr, arg, arrsize);
+    }
+    else {
+        xss_argsort_fp16<vtype>(arr, arg, arrsize);
+    }
+}
+
+template <>
+inline void avx512_argselect(_Float16 *arr,
+                             int64_t *arg,
+                             int64_t k,
+                             int64_t arrsize,
+                             bool descending)
+{
+    using vtype = xmm_vector<_Float16>;
+    if (descending) {
+        xss_argselect_fp16<descending_vector<vtype>>(arr, arg, k, arrsize);
+    }
+    else {
+        xss_argselect_fp16<vtype>(arr, arg, k, arrsize);
+    }
+}
+
+#endif // AVX512FP16_ARGSORT_16BIT
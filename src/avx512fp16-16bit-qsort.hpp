@@ -76,6 +76,14 @@ struct zmm_vector<_Float16> {
         // AVX512_VBMI2
         return _mm512_mask_compressstoreu_epi16(mem, mask, temp);
     }
+    static int double_compressstore(type_t *left_addr,
+                                    type_t *right_addr,
+                                    opmask_t k,
+                                    reg_t reg)
+    {
+        return avx512_double_compressstore<zmm_vector<_Float16>>(
+                left_addr, right_addr, k, reg);
+    }
     static reg_t maskz_loadu(opmask_t mask, void const *mem)
     {
         return _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(mask, mem));
@@ -147,7 +155,7 @@ bool is_a_nan<_Float16>(_Float16 elem)
 {
     Fp16Bits temp;
     temp.f_ = elem;
-    return (temp.i_ & 0x7c00) == 0x7c00;
+    return (temp.i_ & 0x7fff) > X86_SIMD_SORT_INFINITYH;
 }
 
 template <>
@@ -157,16 +165,65 @@ void replace_inf_with_nan(_Float16 *arr, int64_t arrsize, int64_t nan_count)
 }
 
 /* Specialized template function for _Float16 qsort_*/
-template <>
-void avx512_qsort(_Float16 *arr, int64_t arrsize)
+template <typename vtype>
+X86_SIMD_SORT_INLINE void xss_qsort_fp16(_Float16 *arr, int64_t arrsize)
 {
     if (arrsize > 1) {
-        int64_t nan_count
-                = replace_nan_with_inf<zmm_vector<_Float16>, _Float16>(arr,
-                                                                       arrsize);
-        qsort_<zmm_vector<_Float16>, _Float16>(
+        int64_t nan_count = replace_nan_with_inf<vtype, _Float16>(arr, arrsize);
+        qsort_<vtype, _Float16>(
                 arr, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
         replace_inf_with_nan(arr, arrsize, nan_count);
     }
 }
+
+template <typename vtype>
+X86_SIMD_SORT_INLINE void
+xss_qselect_fp16(_Float16 *arr, int64_t k, int64_t arrsize, bool hasnan)
+{
+    int64_t indx_last_elem = arrsize - 1;
+    if (UNLIKELY(hasnan)) {
+        indx_last_elem = move_nans_to_end_of_array(arr, arrsize);
+    }
+    if (indx_last_elem >= k) {
+        qselect_<vtype, _Float16>(
+                arr, k, 0, indx_last_elem, 2 * (int64_t)log2(indx_last_elem));
+    }
+}
+
+template <>
+inline void avx512_qsort(_Float16 *arr, int64_t arrsize, bool descending)
+{
+    using vtype = zmm_vector<_Float16>;
+    if (descending) { xss_qsort_fp16<descending_vector<vtype>>(arr, arrsize); }
+    else {
+        xss_qsort_fp16<vtype>(arr, arrsize);
+    }
+}
+
+template <>
+inline void avx512_qselect(_Float16 *arr,
+                           int64_t k,
+                           int64_t arrsize,
+                           bool hasnan,
+                           bool descending)
+{
+    using vtype = zmm_vector<_Float16>;
+    if (descending) {
+        xss_qselect_fp16<descending_vector<vtype>>(arr, k, arrsize, hasnan);
+    }
+    else {
+        xss_qselect_fp16<vtype>(arr, k, arrsize, hasnan);
+    }
+}
+
+template <>
+inline void avx512_partial_qsort(_Float16 *arr,
+                                 int64_t k,
+                                 int64_t arrsize,
+                                 bool hasnan,
+                                 bool descending)
+{
+    avx512_qselect(arr, k - 1, arrsize, hasnan, descending);
+    avx512_qsort(arr, k - 1, descending);
+}
 #endif // AVX512FP16_QSORT_16BIT
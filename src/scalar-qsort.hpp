@@ -0,0 +1,476 @@
+/*******************************************************************
+ * Copyright (C) 2023 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * ****************************************************************/
+
+#ifndef SCALAR_QSORT
+#define SCALAR_QSORT
+
+#include <array>
+#include <numeric>
+#include <vector>
+
+#include "avx512-common-qsort.h"
+
+/*
+ * Portable quicksort for CPUs without AVX2, with the same API and NAN
+ * semantics as the avx2_* and avx512_* routines. Needs nothing beyond the
+ * x86-64 baseline (SSE2): the partitioning is branchless BlockQuicksort [1]
+ * and small arrays are sorted with a sorting network, so both mostly compile
+ * to cmov/min/max instead of hard to predict branches.
+ *
+ * [1] BlockQuicksort: How Branch Mispredictions don't affect Quicksort,
+ *     Edelkamp and Weiss, https://arxiv.org/abs/1604.06697
+ *
+ * Everything has internal linkage (X86_SIMD_SORT_INLINE), so the copy in the
+ * baseline built dispatcher of libx86simdsort never gets merged with one
+ * compiled for a newer ISA elsewhere.
+ *
+ * The algorithms are written once against an accessor that defines what an
+ * element is: a key (scalar_keys), an index into a key array (scalar_args)
+ * or a key with a value moved along with it (scalar_keyvalues).
+ */
+
+template <typename T>
+struct scalar_keys {
+    using key_t = T;
+    T *arr;
+
+    key_t key(int64_t i) const
+    {
+        return arr[i];
+    }
+    void swap(int64_t i, int64_t j)
+    {
+        std::swap(arr[i], arr[j]);
+    }
+    /* compare and exchange, i < j */
+    void coex(int64_t i, int64_t j)
+    {
+        T a = arr[i];
+        T b = arr[j];
+        arr[i] = std::min(a, b);
+        arr[j] = std::max(a, b);
+    }
+};
+
+template <typename T>
+struct scalar_args {
+    using key_t = T;
+    T *arr;
+    int64_t *arg;
+
+    key_t key(int64_t i) const
+    {
+        return arr[arg[i]];
+    }
+    void swap(int64_t i, int64_t j)
+    {
+        std::swap(arg[i], arg[j]);
+    }
+    void coex(int64_t i, int64_t j)
+    {
+        int64_t a = arg[i];
+        int64_t b = arg[j];
+        bool exchange = arr[b] < arr[a];
+        arg[i] = exchange ? b : a;
+        arg[j] = exchange ? a : b;
+    }
+};
+
+template <typename T1, typename T2>
+struct scalar_keyvalues {
+    using key_t = T1;
+    T1 *keys;
+    T2 *values;
+
+    key_t key(int64_t i) const
+    {
+        return keys[i];
+    }
+    void swap(int64_t i, int64_t j)
+    {
+        std::swap(keys[i], keys[j]);
+        std::swap(values[i], values[j]);
+    }
+    void coex(int64_t i, int64_t j)
+    {
+        T1 key_a = keys[i];
+        T1 key_b = keys[j];
+        T2 val_a = values[i];
+        T2 val_b = values[j];
+        bool exchange = key_b < key_a;
+        keys[i] = exchange ? key_b : key_a;
+        keys[j] = exchange ? key_a : key_b;
+        values[i] = exchange ? val_b : val_a;
+        values[j] = exchange ? val_a : val_b;
+    }
+};
+
+/*
+ * Batcher's odd-even mergesort network for 16 elements (63 comparators, all
+ * of them (i, j) with i < j). Sorting n < 16 elements only needs the
+ * comparators with j < n: the others would compare against padding that is
+ * larger than everything and never move an element.
+ */
+constexpr int scalar_network_size = 16;
+constexpr auto scalar_network = [] {
+    std::array<std::array<uint8_t, 2>, 63> net {};
+    const int n = scalar_network_size;
+    int pos = 0;
+    for (int p = 1; p < n; p <<= 1) {
+        for (int k = p; k >= 1; k >>= 1) {
+            for (int j = k % p; j + k < n; j += 2 * k) {
+                for (int i = 0; i < std::min(k, n - j - k); i++) {
+                    if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+                        net[pos][0] = i + j;
+                        net[pos][1] = i + j + k;
+                        pos++;
+                    }
+                }
+            }
+        }
+    }
+    return net;
+}();
+
+template <typename accessor_t>
+X86_SIMD_SORT_INLINE void
+scalar_sort_network(accessor_t &acc, int64_t left, int32_t N)
+{
+    for (const auto &cmp : scalar_network) {
+        if (cmp[1] < N) { acc.coex(left + cmp[0], left + cmp[1]); }
+    }
+}
+
+template <typename accessor_t>
+X86_SIMD_SORT_INLINE void
+scalar_heapify(accessor_t &acc, int64_t left, int64_t idx, int64_t size)
+{
+    int64_t i = idx;
+    while (true) {
+        int64_t j = 2 * i + 1;
+        if (j >= size) { break; }
+        int64_t k = j + 1;
+        if (k < size && acc.key(left + j) < acc.key(left + k)) { j = k; }
+        if (acc.key(left + j) < acc.key(left + i)) { break; }
+        acc.swap(left + i, left + j);
+        i = j;
+    }
+}
+
+/* Fallback when quicksort isn't making any progress */
+template <typename accessor_t>
+X86_SIMD_SORT_INLINE void
+scalar_heap_sort(accessor_t &acc, int64_t left, int64_t right)
+{
+    int64_t size = right + 1 - left;
+    for (int64_t i = size / 2 - 1; i >= 0; i--) {
+        scalar_heapify(acc, left, i, size);
+    }
+    for (int64_t i = size - 1; i > 0; i--) {
+        acc.swap(left, left + i);
+        scalar_heapify(acc, left, 0, i);
+    }
+}
+
+/* median of 16 evenly spaced samples */
+template <typename accessor_t, typename key_t = typename accessor_t::key_t>
+X86_SIMD_SORT_INLINE key_t scalar_get_pivot(const accessor_t &acc,
+                                            const int64_t left,
+                                            const int64_t right)
+{
+    key_t samples[scalar_network_size];
+    int64_t delta = (right - left) / scalar_network_size;
+    for (int i = 0; i < scalar_network_size; i++) {
+        samples[i] = acc.key(left + i * delta);
+    }
+    scalar_keys<key_t> sample_acc {samples};
+    scalar_sort_network(sample_acc, 0, scalar_network_size);
+    return samples[scalar_network_size / 2];
+}
+
+/*
+ * Partition arr[left, right) so that the elements for which goes_left(key)
+ * is true come first, and return the index of the first other element.
+ * BlockQuicksort: the first pass over a block of each side only records the
+ * offsets of the misplaced elements, without branching on the comparison,
+ * and the second pass swaps them pairwise. Whatever is left (less than two
+ * blocks, plus a block with unswapped elements) is partitioned with a
+ * branchless Lomuto loop.
+ */
+template <typename accessor_t, typename predicate_t>
+X86_SIMD_SORT_INLINE int64_t scalar_partition(accessor_t &acc,
+                                              int64_t left,
+                                              int64_t right,
+                                              predicate_t goes_left)
+{
+    constexpr int64_t block = 64;
+    uint8_t offsets_l[block];
+    uint8_t offsets_r[block];
+    int64_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+    while (right - left >= 2 * block) {
+        if (num_l == 0) {
+            start_l = 0;
+            for (int64_t i = 0; i < block; ++i) {
+                offsets_l[num_l] = i;
+                num_l += !goes_left(acc.key(left + i));
+            }
+        }
+        if (num_r == 0) {
+            start_r = 0;
+            for (int64_t i = 0; i < block; ++i) {
+                offsets_r[num_r] = i;
+                num_r += goes_left(acc.key(right - 1 - i));
+            }
+        }
+        int64_t num = std::min(num_l, num_r);
+        for (int64_t j = 0; j < num; ++j) {
+            acc.swap(left + offsets_l[start_l + j],
+                     right - 1 - offsets_r[start_r + j]);
+        }
+        num_l -= num;
+        num_r -= num;
+        start_l += num;
+        start_r += num;
+        if (num_l == 0) { left += block; }
+        if (num_r == 0) { right -= block; }
+    }
+
+    /*
+     * [store, ii) never goes left, so swapping unconditionally and only
+     * advancing store for the elements that go left is still a partition
+     */
+    int64_t store = left;
+    for (int64_t ii = left; ii < right; ++ii) {
+        bool move_left = goes_left(acc.key(ii));
+        acc.swap(store, ii);
+        store += move_left;
+    }
+    return store;
+}
+
+/*
+ * Partition arr[left, right] around a pivot from the array. When no element
+ * is less than the pivot, the pivot is the minimum: partition again around
+ * "equal to the pivot" so that arrays with many duplicates keep making
+ * progress, and report the equal elements in *num_equal.
+ */
+template <typename accessor_t, typename key_t = typename accessor_t::key_t>
+X86_SIMD_SORT_INLINE int64_t scalar_partition_around_pivot(accessor_t &acc,
+                                                           int64_t left,
+                                                           int64_t right,
+                                                           int64_t *num_equal)
+{
+    key_t pivot = scalar_get_pivot(acc, left, right);
+    int64_t pivot_index = scalar_partition(
+            acc, left, right + 1, [pivot](key_t k) { return k < pivot; });
+    *num_equal = 0;
+    if (pivot_index == left) {
+        pivot_index = scalar_partition(
+                acc, left, right + 1, [pivot](key_t k) {
+                    return !(pivot < k);
+                });
+        *num_equal = pivot_index - left;
+    }
+    return pivot_index;
+}
+
+template <typename accessor_t>
+static void scalar_qsort_(accessor_t &acc,
+                          int64_t left,
+                          int64_t right,
+                          int64_t max_iters)
+{
+    if (max_iters <= 0) {
+        scalar_heap_sort(acc, left, right);
+        return;
+    }
+    if (right + 1 - left <= scalar_network_size) {
+        scalar_sort_network(acc, left, (int32_t)(right + 1 - left));
+        return;
+    }
+    int64_t num_equal;
+    int64_t pivot_index
+            = scalar_partition_around_pivot(acc, left, right, &num_equal);
+    if (num_equal == 0) {
+        scalar_qsort_(acc, left, pivot_index - 1, max_iters - 1);
+    }
+    scalar_qsort_(acc, pivot_index, right, max_iters - 1);
+}
+
+template <typename accessor_t>
+static void scalar_qselect_(accessor_t &acc,
+                            int64_t pos,
+                            int64_t left,
+                            int64_t right,
+                            int64_t max_iters)
+{
+    if (max_iters <= 0) {
+        scalar_heap_sort(acc, left, right);
+        return;
+    }
+    if (right + 1 - left <= scalar_network_size) {
+        scalar_sort_network(acc, left, (int32_t)(right + 1 - left));
+        return;
+    }
+    int64_t num_equal;
+    int64_t pivot_index
+            = scalar_partition_around_pivot(acc, left, right, &num_equal);
+    if (pos < pivot_index) {
+        if (num_equal == 0) {
+            scalar_qselect_(acc, pos, left, pivot_index - 1, max_iters - 1);
+        }
+    }
+    else {
+        scalar_qselect_(acc, pos, pivot_index, right, max_iters - 1);
+    }
+}
+
+template <typename T>
+X86_SIMD_SORT_INLINE int64_t scalar_replace_nan_with_inf(T *arr,
+                                                         int64_t arrsize)
+{
+    int64_t nan_count = 0;
+    for (int64_t ii = 0; ii < arrsize; ++ii) {
+        bool isnan = std::isnan(arr[ii]);
+        nan_count += isnan;
+        arr[ii] = isnan ? std::numeric_limits<T>::infinity() : arr[ii];
+    }
+    return nan_count;
+}
+
+/* Move the indices of NAN's to the end and return how many there were */
+template <typename T>
+X86_SIMD_SORT_INLINE int64_t scalar_move_nan_args_to_end(T *arr,
+                                                         int64_t *arg,
+                                                         int64_t arrsize)
+{
+    scalar_args<T> acc {arr, arg};
+    int64_t num_not_nan = scalar_partition(
+            acc, 0, arrsize, [](T k) { return !std::isnan(k); });
+    return arrsize - num_not_nan;
+}
+
+/* Counting sort for 8-bit integers, see avx512-8bit-qsort.hpp */
+template <typename T>
+X86_SIMD_SORT_INLINE void scalar_countsort_8bit(T *arr, int64_t arrsize)
+{
+    constexpr uint8_t bias = std::is_signed_v<T> ? 0x80 : 0;
+    int64_t hist[256] = {};
+    for (int64_t ii = 0; ii < arrsize; ++ii) {
+        hist[(uint8_t)arr[ii] ^ bias]++;
+    }
+    for (int b = 0; b < 256; ++b) {
+        arr = std::fill_n(arr, hist[b], (T)(b ^ bias));
+    }
+}
+
+template <typename T>
+X86_SIMD_SORT_INLINE void scalar_qsort(T *arr, int64_t arrsize)
+{
+    if (arrsize > 1) {
+        scalar_keys<T> acc {arr};
+        if constexpr (sizeof(T) == 1) { scalar_countsort_8bit(arr, arrsize); }
+        else if constexpr (std::is_floating_point_v<T>) {
+            int64_t nan_count = scalar_replace_nan_with_inf(arr, arrsize);
+            scalar_qsort_(acc, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+            replace_inf_with_nan(arr, arrsize, nan_count);
+        }
+        else {
+            scalar_qsort_(acc, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+        }
+    }
+}
+
+template <typename T>
+X86_SIMD_SORT_INLINE void
+scalar_qselect(T *arr, int64_t k, int64_t arrsize, bool hasnan = false)
+{
+    int64_t indx_last_elem = arrsize - 1;
+    if constexpr (std::is_floating_point_v<T>) {
+        if (UNLIKELY(hasnan)) {
+            indx_last_elem = move_nans_to_end_of_array(arr, arrsize);
+        }
+    }
+    if (indx_last_elem >= k) {
+        scalar_keys<T> acc {arr};
+        scalar_qselect_(
+                acc, k, 0, indx_last_elem, 2 * (int64_t)log2(indx_last_elem));
+    }
+}
+
+template <typename T>
+X86_SIMD_SORT_INLINE void
+scalar_partial_qsort(T *arr, int64_t k, int64_t arrsize, bool hasnan = false)
+{
+    scalar_qselect<T>(arr, k - 1, arrsize, hasnan);
+    scalar_qsort<T>(arr, k - 1);
+}
+
+template <typename T>
+X86_SIMD_SORT_INLINE void scalar_argsort(T *arr, int64_t *arg, int64_t arrsize)
+{
+    if (arrsize > 1) {
+        if constexpr (std::is_floating_point_v<T>) {
+            arrsize -= scalar_move_nan_args_to_end(arr, arg, arrsize);
+            if (arrsize <= 1) { return; }
+        }
+        scalar_args<T> acc {arr, arg};
+        scalar_qsort_(acc, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+    }
+}
+
+template <typename T>
+X86_SIMD_SORT_INLINE std::vector<int64_t> scalar_argsort(T *arr,
+                                                        int64_t arrsize)
+{
+    std::vector<int64_t> indices(arrsize);
+    std::iota(indices.begin(), indices.end(), 0);
+    scalar_argsort<T>(arr, indices.data(), arrsize);
+    return indices;
+}
+
+template <typename T>
+X86_SIMD_SORT_INLINE void
+scalar_argselect(T *arr, int64_t *arg, int64_t k, int64_t arrsize)
+{
+    if (arrsize > 1) {
+        if constexpr (std::is_floating_point_v<T>) {
+            arrsize -= scalar_move_nan_args_to_end(arr, arg, arrsize);
+            if (k >= arrsize) { return; }
+        }
+        scalar_args<T> acc {arr, arg};
+        scalar_qselect_(
+                acc, k, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+    }
+}
+
+template <typename T>
+X86_SIMD_SORT_INLINE std::vector<int64_t>
+scalar_argselect(T *arr, int64_t k, int64_t arrsize)
+{
+    std::vector<int64_t> indices(arrsize);
+    std::iota(indices.begin(), indices.end(), 0);
+    scalar_argselect<T>(arr, indices.data(), k, arrsize);
+    return indices;
+}
+
+template <typename T1, typename T2>
+X86_SIMD_SORT_INLINE void scalar_qsort_kv(T1 *keys, T2 *values, int64_t arrsize)
+{
+    if (arrsize > 1) {
+        scalar_keyvalues<T1, T2> acc {keys, values};
+        if constexpr (std::is_floating_point_v<T1>) {
+            int64_t nan_count = scalar_replace_nan_with_inf(keys, arrsize);
+            scalar_qsort_(acc, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+            replace_inf_with_nan(keys, arrsize, nan_count);
+        }
+        else {
+            scalar_qsort_(acc, 0, arrsize - 1, 2 * (int64_t)log2(arrsize));
+        }
+    }
+}
+
+#endif // SCALAR_QSORT
@@ -0,0 +1,386 @@
+#ifndef XSS_KEYVALUE_NETWORKS
+#define XSS_KEYVALUE_NETWORKS
+
+#include "avx512-common-qsort.h"
+
+/*
+ * Bitonic networks that sort keys together with a second register of 64-bit
+ * values (the indices for argsort). They mirror xss-network-qsort.hpp:
+ * vtype1 handles the keys, vtype2 the values, and every compare-exchange of
+ * the keys is applied to the values as well. Registers hold 16 (AVX-512,
+ * 32-bit keys and values), 8 (AVX-512) or 4 (AVX2) key-value pairs.
+ */
+
+/* 16 pairs: defined in avx512-32bit-keyvalue-networks.hpp */
+template <typename vtype1,
+          typename vtype2,
+          typename reg_t,
+          typename index_type>
+X86_SIMD_SORT_INLINE reg_t sort_zmm_32bit(reg_t key_zmm, index_type &index_zmm);
+
+template <typename vtype1,
+          typename vtype2,
+          typename reg_t,
+          typename index_type>
+X86_SIMD_SORT_INLINE reg_t bitonic_merge_zmm_32bit(reg_t key_zmm,
+                                                   index_type &index_zmm);
+
+/* 8 pairs: defined in avx512-64bit-keyvalue-networks.hpp */
+template <typename vtype1,
+          typename vtype2,
+          typename reg_t,
+          typename index_type>
+X86_SIMD_SORT_INLINE reg_t sort_zmm_64bit(reg_t key_zmm, index_type &index_zmm);
+
+template <typename vtype1,
+          typename vtype2,
+          typename reg_t,
+          typename index_type>
+X86_SIMD_SORT_INLINE reg_t bitonic_merge_zmm_64bit(reg_t key_zmm,
+                                                   index_type &index_zmm);
+
+/*
+ * 4 pairs. Assumes key_ymm is random and performs a full sorting network
+ * defined in https://en.wikipedia.org/wiki/Bitonic_sorter#/media/File:BitonicSort.svg
+ */
+template <typename vtype1,
+          typename vtype2,
+          typename reg_t = typename vtype1::reg_t,
+          typename index_type = typename vtype2::reg_t>
+X86_SIMD_SORT_INLINE reg_t sort_ymm_64bit(reg_t key_ymm, index_type &index_ymm)
+{
+    key_ymm = cmp_merge<vtype1, vtype2>(
+            key_ymm,
+            vtype1::template shuffle<SHUFFLE_MASK(1, 1, 1, 1)>(key_ymm),
+            index_ymm,
+            vtype2::template shuffle<SHUFFLE_MASK(1, 1, 1, 1)>(index_ymm),
+            0xA);
+    key_ymm = cmp_merge<vtype1, vtype2>(
+            key_ymm,
+            vtype1::template permutexvar<SHUFFLE_MASK(0, 1, 2, 3)>(key_ymm),
+            index_ymm,
+            vtype2::template permutexvar<SHUFFLE_MASK(0, 1, 2, 3)>(index_ymm),
+            0xC);
+    key_ymm = cmp_merge<vtype1, vtype2>(
+            key_ymm,
+            vtype1::template shuffle<SHUFFLE_MASK(1, 1, 1, 1)>(key_ymm),
+            index_ymm,
+            vtype2::template shuffle<SHUFFLE_MASK(1, 1, 1, 1)>(index_ymm),
+            0xA);
+    return key_ymm;
+}
+
+// Assumes key_ymm is bitonic and performs a recursive half cleaner
+template <typename vtype1,
+          typename vtype2,
+          typename reg_t = typename vtype1::reg_t,
+          typename index_type = typename vtype2::reg_t>
+X86_SIMD_SORT_INLINE reg_t bitonic_merge_ymm_64bit(reg_t key_ymm,
+                                                   index_type &index_ymm)
+{
+    // 1) half_cleaner[4]: compare 0-2, 1-3
+    key_ymm = cmp_merge<vtype1, vtype2>(
+            key_ymm,
+            vtype1::template permutexvar<SHUFFLE_MASK(1, 0, 3, 2)>(key_ymm),
+            index_ymm,
+            vtype2::template permutexvar<SHUFFLE_MASK(1, 0, 3, 2)>(index_ymm),
+            0xC);
+    // 2) half_cleaner[1]
+    key_ymm = cmp_merge<vtype1, vtype2>(
+            key_ymm,
+            vtype1::template shuffle<SHUFFLE_MASK(1, 1, 1, 1)>(key_ymm),
+            index_ymm,
+            vtype2::template shuffle<SHUFFLE_MASK(1, 1, 1, 1)>(index_ymm),
+            0xA);
+    return key_ymm;
+}
+
+template <typename vtype1,
+          typename vtype2,
+          typename reg_t = typename vtype1::reg_t,
+          typename index_type = typename vtype2::reg_t>
+X86_SIMD_SORT_INLINE reg_t sort_vec_dispatch(reg_t key, index_type &index)
+{
+    static_assert(vtype1::numlanes == vtype2::numlanes);
+    if constexpr (vtype1::numlanes == 16) {
+        return sort_zmm_32bit<vtype1, vtype2, reg_t, index_type>(key, index);
+    }
+    else if constexpr (vtype1::numlanes == 8) {
+        return sort_zmm_64bit<vtype1, vtype2, reg_t, index_type>(key, index);
+    }
+    else {
+        static_assert(vtype1::numlanes == 4);
+        return sort_ymm_64bit<vtype1, vtype2>(key, index);
+    }
+}
+
+template <typename vtype1,
+          typename vtype2,
+          typename reg_t = typename vtype1::reg_t,
+          typename index_type = typename vtype2::reg_t>
+X86_SIMD_SORT_INLINE reg_t bitonic_merge_dispatch(reg_t key, index_type &index)
+{
+    if constexpr (vtype1::numlanes == 16) {
+        return bitonic_merge_zmm_32bit<vtype1, vtype2, reg_t, index_type>(
+                key, index);
+    }
+    else if constexpr (vtype1::numlanes == 8) {
+        return bitonic_merge_zmm_64bit<vtype1, vtype2, reg_t, index_type>(
+                key, index);
+    }
+    else {
+        return bitonic_merge_ymm_64bit<vtype1, vtype2>(key, index);
+    }
+}
+
+template <typename vtype1,
+          typename vtype2,
+          int64_t numVecs,
+          typename reg_t = typename vtype1::reg_t,
+          typename index_type = typename vtype2::reg_t>
+X86_SIMD_SORT_INLINE void bitonic_clean_n_vec(reg_t *keys, index_type *indexes)
+{
+X86_SIMD_SORT_UNROLL_LOOP(64)
+    for (int num = numVecs / 2; num >= 2; num /= 2) {
+X86_SIMD_SORT_UNROLL_LOOP(64)
+        for (int j = 0; j < numVecs; j += num) {
+X86_SIMD_SORT_UNROLL_LOOP(64)
+            for (int i = 0; i < num / 2; i++) {
+                COEX<vtype1, vtype2>(keys[i + j],
+                                     keys[i + j + num / 2],
+                                     indexes[i + j],
+                                     indexes[i + j + num / 2]);
+            }
+        }
+    }
+}
+
+template <typename vtype1,
+          typename vtype2,
+          int64_t numVecs,
+          typename reg_t = typename vtype1::reg_t,
+          typename index_type = typename vtype2::reg_t>
+X86_SIMD_SORT_INLINE void bitonic_merge_n_vec(reg_t *keys, index_type *indexes)
+{
+    /*
+     * Do the reverse part. Unlike the keys-only version, the upper half is
+     * reversed back afterwards: otherwise the padding lanes, which hold the
+     * maximum key, can end up ahead of real elements equal to the maximum and
+     * get stored in their place.
+     */
+    if constexpr (numVecs > 1) {
+// Reverse upper half
+X86_SIMD_SORT_UNROLL_LOOP(64)
+        for (int i = 0; i < numVecs / 2; i++) {
+            reg_t key_rev = vtype1::reverse(keys[numVecs - i - 1]);
+            index_type index_rev = vtype2::reverse(indexes[numVecs - i - 1]);
+            COEX<vtype1, vtype2>(keys[i], key_rev, indexes[i], index_rev);
+            keys[numVecs - i - 1] = vtype1::reverse(key_rev);
+            indexes[numVecs - i - 1] = vtype2::reverse(index_rev);
+        }
+    }
+
+    // Call cleaner
+    bitonic_clean_n_vec<vtype1, vtype2, numVecs>(keys, indexes);
+
+// Now do bitonic_merge
+X86_SIMD_SORT_UNROLL_LOOP(64)
+    for (int i = 0; i < numVecs; i++) {
+        keys[i] = bitonic_merge_dispatch<vtype1, vtype2>(keys[i], indexes[i]);
+    }
+}
+
+template <typename vtype1,
+          typename vtype2,
+          int64_t numVecs,
+          int64_t numPer = 2,
+          typename reg_t = typename vtype1::reg_t,
+          typename index_type = typename vtype2::reg_t>
+X86_SIMD_SORT_INLINE void bitonic_fullmerge_n_vec(reg_t *keys,
+                                                  index_type *indexes)
+{
+    if constexpr (numPer > numVecs)
+        return;
+    else {
+X86_SIMD_SORT_UNROLL_LOOP(64)
+        for (int i = 0; i < numVecs / numPer; i++) {
+            bitonic_merge_n_vec<vtype1, vtype2, numPer>(keys + i * numPer,
+                                                        indexes + i * numPer);
+        }
+        bitonic_fullmerge_n_vec<vtype1, vtype2, numVecs, numPer * 2>(keys,
+                                                                     indexes);
+    }
+}
+
+/*
+ * Sorts the N <= numVecs * vtype::numlanes elements of arr indexed by arg,
+ * permuting arg only. The keys are gathered from arr through the indices.
+ */
+template <typename vtype,
+          typename argtype,
+          int numVecs,
+          typename type_t = typename vtype::type_t>
+X86_SIMD_SORT_INLINE void argsort_n_vec(type_t *arr, int64_t *arg, int32_t N)
+{
+    using reg_t = typename vtype::reg_t;
+    using argreg_t = typename argtype::reg_t;
+    static_assert(vtype::numlanes == argtype::numlanes);
+    if constexpr (numVecs > 1) {
+        if (N * 2 <= numVecs * vtype::numlanes) {
+            argsort_n_vec<vtype, argtype, numVecs / 2>(arr, arg, N);
+            return;
+        }
+    }
+
+    reg_t keys[numVecs];
+    argreg_t indexes[numVecs];
+
+    // Generate masks for loading and storing
+    typename vtype::opmask_t ioMasks[numVecs - numVecs / 2];
+X86_SIMD_SORT_UNROLL_LOOP(64)
+    for (int i = numVecs / 2, j = 0; i < numVecs; i++, j++) {
+        int64_t num_to_read
+                = std::min((int64_t)std::max(0, N - i * vtype::numlanes),
+                           (int64_t)vtype::numlanes);
+        ioMasks[j] = ((0x1ull << num_to_read) - 0x1ull);
+    }
+
+// Unmasked part of the load
+X86_SIMD_SORT_UNROLL_LOOP(64)
+    for (int i = 0; i < numVecs / 2; i++) {
+        indexes[i] = argtype::loadu(arg + i * vtype::numlanes);
+        keys[i] = vtype::template i64gather<sizeof(type_t)>(indexes[i], arr);
+    }
+// Masked part of the load
+X86_SIMD_SORT_UNROLL_LOOP(64)
+    for (int i = numVecs / 2, j = 0; i < numVecs; i++, j++) {
+        indexes[i] = argtype::maskz_loadu(ioMasks[j],
+                                          arg + i * vtype::numlanes);
+        keys[i] = vtype::template mask_i64gather<sizeof(type_t)>(
+                vtype::zmm_max(), ioMasks[j], indexes[i], arr);
+    }
+
+// Sort each loaded vector
+X86_SIMD_SORT_UNROLL_LOOP(64)
+    for (int i = 0; i < numVecs; i++) {
+        keys[i] = sort_vec_dispatch<vtype, argtype>(keys[i], indexes[i]);
+    }
+
+    // Run the full merger
+    bitonic_fullmerge_n_vec<vtype, argtype, numVecs>(keys, indexes);
+
+// Unmasked part of the store
+X86_SIMD_SORT_UNROLL_LOOP(64)
+    for (int i = 0; i < numVecs / 2; i++) {
+        argtype::storeu(arg + i * vtype::numlanes, indexes[i]);
+    }
+// Masked part of the store
+X86_SIMD_SORT_UNROLL_LOOP(64)
+    for (int i = numVecs / 2, j = 0; i < numVecs; i++, j++) {
+        argtype::mask_storeu(
+                arg + i * vtype::numlanes, ioMasks[j], indexes[i]);
+    }
+}
+
+/* Sorts the N <= numVecs * vtype1::numlanes keys and their values */
+template <typename vtype1,
+          typename vtype2,
+          int numVecs,
+          typename type1_t = typename vtype1::type_t,
+          typename type2_t = typename vtype2::type_t>
+X86_SIMD_SORT_INLINE void
+kvsort_n_vec(type1_t *keys, type2_t *indexes, int32_t N)
+{
+    using reg_t = typename vtype1::reg_t;
+    using index_type = typename vtype2::reg_t;
+    static_assert(vtype1::numlanes == vtype2::numlanes);
+    if constexpr (numVecs > 1) {
+        if (N * 2 <= numVecs * vtype1::numlanes) {
+            kvsort_n_vec<vtype1, vtype2, numVecs / 2>(keys, indexes, N);
+            return;
+        }
+    }
+
+    reg_t key_vecs[numVecs];
+    index_type index_vecs[numVecs];
+
+    // Generate masks for loading and storing
+    typename vtype1::opmask_t ioMasks[numVecs - numVecs / 2];
+X86_SIMD_SORT_UNROLL_LOOP(64)
+    for (int i = numVecs / 2, j = 0; i < numVecs; i++, j++) {
+        int64_t num_to_read
+                = std::min((int64_t)std::max(0, N - i * vtype1::numlanes),
+                           (int64_t)vtype1::numlanes);
+        ioMasks[j] = ((0x1ull << num_to_read) - 0x1ull);
+    }
+
+// Unmasked part of the load
+X86_SIMD_SORT_UNROLL_LOOP(64)
+    for (int i = 0; i < numVecs / 2; i++) {
+        key_vecs[i] = vtype1::loadu(keys + i * vtype1::numlanes);
+        index_vecs[i] = vtype2::loadu(indexes + i * vtype1::numlanes);
+    }
+// Masked part of the load
+X86_SIMD_SORT_UNROLL_LOOP(64)
+    for (int i = numVecs / 2, j = 0; i < numVecs; i++, j++) {
+        key_vecs[i] = vtype1::mask_loadu(
+                vtype1::zmm_max(), ioMasks[j], keys + i * vtype1::numlanes);
+        index_vecs[i] = vtype2::mask_loadu(vtype2::zmm_max(),
+                                           ioMasks[j],
+                                           indexes + i * vtype1::numlanes);
+    }
+
+// Sort each loaded vector
+X86_SIMD_SORT_UNROLL_LOOP(64)
+    for (int i = 0; i < numVecs; i++) {
+        key_vecs[i] = sort_vec_dispatch<vtype1, vtype2>(key_vecs[i],
+                                                        index_vecs[i]);
+    }
+
+    // Run the full merger
+    bitonic_fullmerge_n_vec<vtype1, vtype2, numVecs>(key_vecs, index_vecs);
+
+// Unmasked part of the store
+X86_SIMD_SORT_UNROLL_LOOP(64)
+    for (int i = 0; i < numVecs / 2; i++) {
+        vtype1::storeu(keys + i * vtype1::numlanes, key_vecs[i]);
+        vtype2::storeu(indexes + i * vtype1::numlanes, index_vecs[i]);
+    }
+// Masked part of the store
+X86_SIMD_SORT_UNROLL_LOOP(64)
+    for (int i = numVecs / 2, j = 0; i < numVecs; i++, j++) {
+        vtype1::mask_storeu(
+                keys + i * vtype1::numlanes, ioMasks[j], key_vecs[i]);
+        vtype2::mask_storeu(
+                indexes + i * vtype1::numlanes, ioMasks[j], index_vecs[i]);
+    }
+}
+
+template <typename vtype, typename argtype, int64_t maxN>
+X86_SIMD_SORT_INLINE void
+argsort_n(typename vtype::type_t *arr, int64_t *arg, int N)
+{
+    constexpr int numVecs = maxN / vtype::numlanes;
+    constexpr bool isMultiple = (maxN == (vtype::numlanes * numVecs));
+    constexpr bool powerOfTwo = (numVecs != 0 && !(numVecs & (numVecs - 1)));
+    static_assert(powerOfTwo == true && isMultiple == true,
+                  "maxN must be vtype::numlanes times a power of 2");
+
+    argsort_n_vec<vtype, argtype, numVecs>(arr, arg, N);
+}
+
+template <typename vtype1, typename vtype2, int64_t maxN>
+X86_SIMD_SORT_INLINE void kvsort_n(typename vtype1::type_t *keys,
+                                   typename vtype2::type_t *indexes,
+                                   int N)
+{
+    constexpr int numVecs = maxN / vtype1::numlanes;
+    constexpr bool isMultiple = (maxN == (vtype1::numlanes * numVecs));
+    constexpr bool powerOfTwo = (numVecs != 0 && !(numVecs & (numVecs - 1)));
+    static_assert(powerOfTwo == true && isMultiple == true,
+                  "maxN must be vtype1::numlanes times a power of 2");
+
+    kvsort_n_vec<vtype1, vtype2, numVecs>(keys, indexes, N);
+}
+
+#endif // XSS_KEYVALUE_NETWORKS
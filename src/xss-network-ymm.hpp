@@ -0,0 +1,189 @@
+/*******************************************************************
+ * Copyright (C) 2022 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * Authors: Raghuveer Devulapalli <raghuveer.devulapalli@intel.com>
+ * ****************************************************************/
+
+#ifndef XSS_NETWORK_YMM
+#define XSS_NETWORK_YMM
+
+#include "avx512-common-qsort.h"
+
+/*
+ * Sorting networks for a single 256-bit register. These only need min, max,
+ * shuffle, permutexvar and an immediate blend from the vtype, so they are
+ * shared by the AVX2 vtypes (avx2_vector) and the AVX-512VL vtypes
+ * (ymm_vector).
+ */
+
+/*
+ * Constants used in sorting 8 elements in a YMM registers. Based on Bitonic
+ * sorting network (see
+ * https://en.wikipedia.org/wiki/Bitonic_sorter#/media/File:BitonicSort.svg)
+ */
+// YMM                       7, 6, 5, 4, 3, 2, 1, 0
+#define NETWORK_32BIT_AVX2_1 0, 1, 2, 3, 4, 5, 6, 7
+#define NETWORK_32BIT_AVX2_2 3, 2, 1, 0, 7, 6, 5, 4
+
+/*
+ * Same as cmp_merge<vtype>, but with the mask as an immediate so it compiles
+ * to a single blend instead of a mask conversion and blendv.
+ */
+template <typename vtype, int mask, typename reg_t = typename vtype::reg_t>
+X86_SIMD_SORT_INLINE reg_t cmp_merge_avx2(reg_t in1, reg_t in2)
+{
+    reg_t min = vtype::min(in2, in1);
+    reg_t max = vtype::max(in2, in1);
+    return vtype::template blend<mask>(min, max); // 0 -> min, 1 -> max
+}
+
+/*
+ * Assumes ymm is random and performs a full sorting network defined in
+ * https://en.wikipedia.org/wiki/Bitonic_sorter#/media/File:BitonicSort.svg
+ */
+template <typename vtype, typename reg_t = typename vtype::reg_t>
+X86_SIMD_SORT_INLINE reg_t sort_ymm_32bit(reg_t ymm)
+{
+    ymm = cmp_merge_avx2<vtype, 0xAA>(
+            ymm, vtype::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(ymm));
+    ymm = cmp_merge_avx2<vtype, 0xCC>(
+            ymm, vtype::template shuffle<SHUFFLE_MASK(0, 1, 2, 3)>(ymm));
+    ymm = cmp_merge_avx2<vtype, 0xAA>(
+            ymm, vtype::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(ymm));
+    ymm = cmp_merge_avx2<vtype, 0xF0>(
+            ymm,
+            vtype::permutexvar(_mm256_set_epi32(NETWORK_32BIT_AVX2_1), ymm));
+    ymm = cmp_merge_avx2<vtype, 0xCC>(
+            ymm, vtype::template shuffle<SHUFFLE_MASK(1, 0, 3, 2)>(ymm));
+    ymm = cmp_merge_avx2<vtype, 0xAA>(
+            ymm, vtype::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(ymm));
+    return ymm;
+}
+
+// Assumes ymm is bitonic and performs a recursive half cleaner
+template <typename vtype, typename reg_t = typename vtype::reg_t>
+X86_SIMD_SORT_INLINE reg_t bitonic_merge_ymm_32bit(reg_t ymm)
+{
+    // 1) half_cleaner[8]: compare 0-4, 1-5, 2-6, 3-7
+    ymm = cmp_merge_avx2<vtype, 0xF0>(
+            ymm,
+            vtype::permutexvar(_mm256_set_epi32(NETWORK_32BIT_AVX2_2), ymm));
+    // 2) half_cleaner[4]
+    ymm = cmp_merge_avx2<vtype, 0xCC>(
+            ymm, vtype::template shuffle<SHUFFLE_MASK(1, 0, 3, 2)>(ymm));
+    // 3) half_cleaner[1]
+    ymm = cmp_merge_avx2<vtype, 0xAA>(
+            ymm, vtype::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(ymm));
+    return ymm;
+}
+
+/*
+ * Assumes ymm is random and performs a full sorting network defined in
+ * https://en.wikipedia.org/wiki/Bitonic_sorter#/media/File:BitonicSort.svg
+ */
+template <typename vtype, typename reg_t = typename vtype::reg_t>
+X86_SIMD_SORT_INLINE reg_t sort_ymm_64bit(reg_t ymm)
+{
+    ymm = cmp_merge_avx2<vtype, 0xA>(
+            ymm, vtype::template shuffle<SHUFFLE_MASK(1, 1, 1, 1)>(ymm));
+    ymm = cmp_merge_avx2<vtype, 0xC>(
+            ymm,
+            vtype::template permutexvar<SHUFFLE_MASK(0, 1, 2, 3)>(ymm));
+    ymm = cmp_merge_avx2<vtype, 0xA>(
+            ymm, vtype::template shuffle<SHUFFLE_MASK(1, 1, 1, 1)>(ymm));
+    return ymm;
+}
+
+// Assumes ymm is bitonic and performs a recursive half cleaner
+template <typename vtype, typename reg_t = typename vtype::reg_t>
+X86_SIMD_SORT_INLINE reg_t bitonic_merge_ymm_64bit(reg_t ymm)
+{
+    // 1) half_cleaner[4]: compare 0-2, 1-3
+    ymm = cmp_merge_avx2<vtype, 0xC>(
+            ymm,
+            vtype::template permutexvar<SHUFFLE_MASK(1, 0, 3, 2)>(ymm));
+    // 2) half_cleaner[1]
+    ymm = cmp_merge_avx2<vtype, 0xA>(
+            ymm, vtype::template shuffle<SHUFFLE_MASK(1, 1, 1, 1)>(ymm));
+    return ymm;
+}
+
+/*
+ * 16 x 16-bit lanes in a YMM register. AVX2 has no 16-bit permutexvar, so the
+ * permutes below are built from a byte shuffle within each 128-bit lane, a
+ * 32-bit shuffle and a 64-bit permute across the two lanes. vtype::shuffle
+ * takes care of permutes within groups of 4 lanes.
+ */
+// pshufb indices (bytes 31 ... 0) that reverse the 16-bit lanes of each half
+#define NETWORK_16BIT_AVX2_1 \
+    1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, \
+            7, 6, 9, 8, 11, 10, 13, 12, 15, 14
+
+// reverse the order of the lanes in each 128-bit half: i -> i ^ 7
+X86_SIMD_SORT_INLINE __m256i ymm_16bit_reverse8(__m256i ymm)
+{
+    return _mm256_shuffle_epi8(ymm, _mm256_set_epi8(NETWORK_16BIT_AVX2_1));
+}
+
+// swap adjacent groups of 4 lanes: i -> i ^ 4
+X86_SIMD_SORT_INLINE __m256i ymm_16bit_swap4(__m256i ymm)
+{
+    return _mm256_shuffle_epi32(ymm, SHUFFLE_MASK(1, 0, 3, 2));
+}
+
+// swap the two 128-bit halves: i -> i ^ 8
+X86_SIMD_SORT_INLINE __m256i ymm_16bit_swap8(__m256i ymm)
+{
+    return _mm256_permute4x64_epi64(ymm, SHUFFLE_MASK(1, 0, 3, 2));
+}
+
+/*
+ * Assumes ymm is random and performs a full sorting network defined in
+ * https://en.wikipedia.org/wiki/Bitonic_sorter#/media/File:BitonicSort.svg
+ */
+template <typename vtype, typename reg_t = typename vtype::reg_t>
+X86_SIMD_SORT_INLINE reg_t sort_ymm_16bit(reg_t ymm)
+{
+    // sort pairs
+    ymm = cmp_merge_avx2<vtype, 0xAAAA>(
+            ymm, vtype::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(ymm));
+    // merge pairs into sorted groups of 4
+    ymm = cmp_merge_avx2<vtype, 0xCCCC>(
+            ymm, vtype::template shuffle<SHUFFLE_MASK(0, 1, 2, 3)>(ymm));
+    ymm = cmp_merge_avx2<vtype, 0xAAAA>(
+            ymm, vtype::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(ymm));
+    // merge groups of 4 into sorted groups of 8
+    ymm = cmp_merge_avx2<vtype, 0xF0F0>(ymm, ymm_16bit_reverse8(ymm));
+    ymm = cmp_merge_avx2<vtype, 0xCCCC>(
+            ymm, vtype::template shuffle<SHUFFLE_MASK(1, 0, 3, 2)>(ymm));
+    ymm = cmp_merge_avx2<vtype, 0xAAAA>(
+            ymm, vtype::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(ymm));
+    // merge the two groups of 8
+    ymm = cmp_merge_avx2<vtype, 0xFF00>(
+            ymm, ymm_16bit_reverse8(ymm_16bit_swap8(ymm)));
+    ymm = cmp_merge_avx2<vtype, 0xF0F0>(ymm, ymm_16bit_swap4(ymm));
+    ymm = cmp_merge_avx2<vtype, 0xCCCC>(
+            ymm, vtype::template shuffle<SHUFFLE_MASK(1, 0, 3, 2)>(ymm));
+    ymm = cmp_merge_avx2<vtype, 0xAAAA>(
+            ymm, vtype::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(ymm));
+    return ymm;
+}
+
+// Assumes ymm is bitonic and performs a recursive half cleaner
+template <typename vtype, typename reg_t = typename vtype::reg_t>
+X86_SIMD_SORT_INLINE reg_t bitonic_merge_ymm_16bit(reg_t ymm)
+{
+    // 1) half_cleaner[16]: compare 0-8, 1-9, ...
+    ymm = cmp_merge_avx2<vtype, 0xFF00>(ymm, ymm_16bit_swap8(ymm));
+    // 2) half_cleaner[8]
+    ymm = cmp_merge_avx2<vtype, 0xF0F0>(ymm, ymm_16bit_swap4(ymm));
+    // 3) half_cleaner[4]
+    ymm = cmp_merge_avx2<vtype, 0xCCCC>(
+            ymm, vtype::template shuffle<SHUFFLE_MASK(1, 0, 3, 2)>(ymm));
+    // 4) half_cleaner[1]
+    ymm = cmp_merge_avx2<vtype, 0xAAAA>(
+            ymm, vtype::template shuffle<SHUFFLE_MASK(2, 3, 0, 1)>(ymm));
+    return ymm;
+}
+
+#endif // XSS_NETWORK_YMM
@@ -0,0 +1,233 @@
+/*******************************************************************
+ * Copyright (C) 2023 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ * ****************************************************************/
+
+#ifndef XSS_THREAD_POOL
+#define XSS_THREAD_POOL
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * What the parallel sorts run their tasks on. submit() may run the task on
+ * any thread, including the calling one. Tasks submit more tasks but never
+ * wait for them: only the thread that called the sort waits, so any pool
+ * that eventually runs every task it is given will do. concurrency() is the
+ * number of tasks it runs at the same time, which sets how finely the work is
+ * split.
+ *
+ * The thread that called the sort calls run_pending() while it waits. If that
+ * thread is one of the executor's own, run_pending() should run a task that
+ * is still queued and return true, or return false if there is none: the
+ * waiting thread then keeps working instead of holding up the tasks it waits
+ * for. An executor that keeps the default, which runs nothing, must not be
+ * given a sort from inside one of its own tasks, since every one of its
+ * threads could end up waiting.
+ */
+struct xss_executor {
+    virtual ~xss_executor() = default;
+    virtual int concurrency() const = 0;
+    virtual void submit(std::function<void()> task) = 0;
+    virtual bool run_pending()
+    {
+        return false;
+    }
+};
+
+/*
+ * The built-in executor: a work-stealing pool. Each worker has its own queue
+ * and runs the tasks it submits last in, first out, so it keeps working on
+ * the subarray it just partitioned. An idle worker steals the oldest task of
+ * another queue, which is the biggest one left there. Tasks submitted from
+ * outside the pool are spread over the queues. A worker that waits for a sort
+ * it called runs queued tasks meanwhile, so the sorts can be called from the
+ * pool's own tasks, even with a single worker.
+ */
+class xss_thread_pool : public xss_executor {
+public:
+    explicit xss_thread_pool(int num_threads
+                             = (int)std::thread::hardware_concurrency())
+    {
+        num_threads = std::max(num_threads, 1);
+        for (int ii = 0; ii < num_threads; ++ii) {
+            queues.emplace_back(new task_queue);
+        }
+        for (int ii = 0; ii < num_threads; ++ii) {
+            workers.emplace_back([this, ii]() { work(ii); });
+        }
+    }
+    ~xss_thread_pool() override
+    {
+        {
+            std::lock_guard<std::mutex> guard(sleep_lock);
+            stop = true;
+        }
+        wake.notify_all();
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+    }
+    xss_thread_pool(const xss_thread_pool &) = delete;
+    xss_thread_pool &operator=(const xss_thread_pool &) = delete;
+
+    int concurrency() const override
+    {
+        return (int)workers.size();
+    }
+    void submit(std::function<void()> task) override
+    {
+        size_t index = current_pool == this
+                ? current_index
+                : next_queue.fetch_add(1, std::memory_order_relaxed)
+                        % queues.size();
+        {
+            std::lock_guard<std::mutex> guard(queues[index]->lock);
+            queues[index]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> guard(sleep_lock);
+            ++num_queued;
+        }
+        wake.notify_one();
+    }
+    /* Only on the workers: other threads just wait for them */
+    bool run_pending() override
+    {
+        if (current_pool != this) { return false; }
+        std::function<void()> task;
+        if (!pop(current_index, task) && !steal(current_index, task)) {
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> guard(sleep_lock);
+            --num_queued;
+        }
+        task();
+        return true;
+    }
+
+private:
+    struct task_queue {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    bool pop(size_t index, std::function<void()> &task)
+    {
+        task_queue &queue = *queues[index];
+        std::lock_guard<std::mutex> guard(queue.lock);
+        if (queue.tasks.empty()) { return false; }
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+    bool steal(size_t index, std::function<void()> &task)
+    {
+        for (size_t ii = 1; ii < queues.size(); ++ii) {
+            task_queue &queue = *queues[(index + ii) % queues.size()];
+            std::lock_guard<std::mutex> guard(queue.lock);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+    void work(size_t index)
+    {
+        current_pool = this;
+        current_index = index;
+        while (true) {
+            std::function<void()> task;
+            if (pop(index, task) || steal(index, task)) {
+                {
+                    std::lock_guard<std::mutex> guard(sleep_lock);
+                    --num_queued;
+                }
+                task();
+                continue;
+            }
+            std::unique_lock<std::mutex> guard(sleep_lock);
+            wake.wait(guard, [this]() { return stop || num_queued > 0; });
+            if (stop && num_queued == 0) { return; }
+        }
+    }
+
+    std::vector<std::unique_ptr<task_queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> next_queue {0};
+    std::mutex sleep_lock;
+    std::condition_variable wake;
+    int64_t num_queued = 0;
+    bool stop = false;
+    static inline thread_local xss_thread_pool *current_pool = nullptr;
+    static inline thread_local size_t current_index = 0;
+};
+
+/* One pool per process, with a worker per hardware thread */
+inline xss_executor &xss_default_executor()
+{
+    static xss_thread_pool pool;
+    return pool;
+}
+
+/*
+ * Runs tasks on an executor and waits for all of them, including the ones
+ * they run in turn through the same group. wait() runs the executor's queued
+ * tasks while there are any, and otherwise sleeps until the group is done.
+ * The sleep is bounded: a task may be queued meanwhile that only this thread
+ * is free to run.
+ */
+class xss_task_group {
+public:
+    explicit xss_task_group(xss_executor &executor) : executor(executor) {}
+    ~xss_task_group()
+    {
+        wait();
+    }
+
+    template <typename F>
+    void run(F task)
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            ++num_pending;
+        }
+        executor.submit([this, task]() mutable {
+            task();
+            std::lock_guard<std::mutex> guard(lock);
+            if (--num_pending == 0) { done.notify_all(); }
+        });
+    }
+    void wait()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        while (num_pending > 0) {
+            guard.unlock();
+            bool ran = executor.run_pending();
+            guard.lock();
+            if (!ran && num_pending > 0) {
+                done.wait_for(guard, std::chrono::milliseconds(1));
+            }
+        }
+    }
+
+private:
+    xss_executor &executor;
+    std::mutex lock;
+    std::condition_variable done;
+    int64_t num_pending = 0;
+};
+
+#endif // XSS_THREAD_POOL
@@ -0,0 +1,203 @@
+/*******************************************
+ * * Copyright (C) 2023 Intel Corporation
+ * * SPDX-License-Identifier: BSD-3-Clause
+ * *******************************************/
+
+#include "avx2-64bit-argsort.hpp"
+#include "avx2-64bit-keyvaluesort.hpp"
+
+#include "test-argsort-common.h"
+
+template <typename T>
+class avx2argsort : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(avx2argsort);
+
+TYPED_TEST_P(avx2argsort, test_random)
+{
+    if (!__builtin_cpu_supports("avx2")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx2";
+    }
+    std::vector<TypeParam> arr;
+    for (int64_t size = 0; size <= 1024; ++size) {
+        /* Random array */
+        arr = get_uniform_rand_array<TypeParam>(size);
+        std::vector<int64_t> inx1 = std_argsort(arr);
+        std::vector<int64_t> inx2
+                = avx2_argsort<TypeParam>(arr.data(), arr.size());
+        std::vector<TypeParam> sort1, sort2;
+        for (auto jj = 0; jj < size; ++jj) {
+            sort1.push_back(arr[inx1[jj]]);
+            sort2.push_back(arr[inx2[jj]]);
+        }
+        EXPECT_EQ(sort1, sort2) << "Array size =" << size;
+        EXPECT_UNIQUE(inx2)
+        arr.clear();
+    }
+}
+
+TYPED_TEST_P(avx2argsort, test_small_range)
+{
+    if (!__builtin_cpu_supports("avx2")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx2";
+    }
+    std::vector<TypeParam> arr;
+    for (int64_t size = 0; size <= 1024; ++size) {
+        /* array with a handful of distinct values */
+        arr = get_uniform_rand_array<TypeParam>(size, 20, 1);
+        std::vector<int64_t> inx1 = std_argsort(arr);
+        std::vector<int64_t> inx2
+                = avx2_argsort<TypeParam>(arr.data(), arr.size());
+        std::vector<TypeParam> sort1, sort2;
+        for (auto jj = 0; jj < size; ++jj) {
+            sort1.push_back(arr[inx1[jj]]);
+            sort2.push_back(arr[inx2[jj]]);
+        }
+        EXPECT_EQ(sort1, sort2) << "Array size =" << size;
+        EXPECT_UNIQUE(inx2)
+        arr.clear();
+    }
+}
+
+TYPED_TEST_P(avx2argsort, test_array_with_nan)
+{
+    if (!__builtin_cpu_supports("avx2")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx2";
+    }
+    if (!std::is_floating_point<TypeParam>::value) {
+        GTEST_SKIP() << "Skipping this test, it is meant for float/double";
+    }
+    std::vector<TypeParam> arr;
+    for (int64_t size = 2; size <= 1024; ++size) {
+        arr = get_uniform_rand_array<TypeParam>(size);
+        arr[0] = std::numeric_limits<TypeParam>::quiet_NaN();
+        arr[1] = std::numeric_limits<TypeParam>::quiet_NaN();
+        std::vector<int64_t> inx
+                = avx2_argsort<TypeParam>(arr.data(), arr.size());
+        std::vector<TypeParam> sort1;
+        for (auto jj = 0; jj < size; ++jj) {
+            sort1.push_back(arr[inx[jj]]);
+        }
+        if ((!std::isnan(sort1[size - 1])) || (!std::isnan(sort1[size - 2]))) {
+            FAIL() << "NAN's aren't sorted to the end";
+        }
+        if (!std::is_sorted(sort1.begin(), sort1.end() - 2)) {
+            FAIL() << "Array isn't sorted";
+        }
+        EXPECT_UNIQUE(inx)
+        arr.clear();
+    }
+}
+
+TYPED_TEST_P(avx2argsort, test_max_value_at_end_of_array)
+{
+    if (!__builtin_cpu_supports("avx2")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx2";
+    }
+    std::vector<TypeParam> arr;
+    for (int64_t size = 1; size <= 256; ++size) {
+        arr = get_uniform_rand_array<TypeParam>(size);
+        if (std::numeric_limits<TypeParam>::has_infinity) {
+            arr[size - 1] = std::numeric_limits<TypeParam>::infinity();
+        }
+        else {
+            arr[size - 1] = std::numeric_limits<TypeParam>::max();
+        }
+        std::vector<int64_t> inx = avx2_argsort(arr.data(), arr.size());
+        std::vector<TypeParam> sorted;
+        for (auto jj = 0; jj < size; ++jj) {
+            sorted.push_back(arr[inx[jj]]);
+        }
+        EXPECT_TRUE(std::is_sorted(sorted.begin(), sorted.end()))
+                << "Array of size " << size << " is not sorted";
+        EXPECT_UNIQUE(inx)
+        arr.clear();
+    }
+}
+
+TYPED_TEST_P(avx2argsort, test_argselect)
+{
+    if (!__builtin_cpu_supports("avx2")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx2";
+    }
+    const int arrsize = 1024;
+    auto arr = get_uniform_rand_array<TypeParam>(arrsize);
+    if (std::is_floating_point<TypeParam>::value) {
+        arr[0] = std::numeric_limits<TypeParam>::quiet_NaN();
+        arr[1] = std::numeric_limits<TypeParam>::quiet_NaN();
+    }
+    std::vector<int64_t> sorted_inx = std_argsort(arr);
+    for (int64_t k = 0; k < arrsize - 3; ++k) {
+        std::vector<int64_t> inx
+                = avx2_argselect<TypeParam>(arr.data(), k, arr.size());
+        auto true_kth = arr[sorted_inx[k]];
+        EXPECT_EQ(true_kth, arr[inx[k]]) << "Failed at index k = " << k;
+        if (k >= 1) {
+            EXPECT_GE(true_kth, std_max_element(arr, inx, 0, k - 1))
+                    << "failed at k = " << k;
+        }
+        EXPECT_LE(true_kth, std_min_element(arr, inx, k + 1, arrsize - 1))
+                << "failed at k = " << k;
+        EXPECT_UNIQUE(inx)
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(avx2argsort,
+                           test_random,
+                           test_small_range,
+                           test_array_with_nan,
+                           test_max_value_at_end_of_array,
+                           test_argselect);
+
+template <typename T>
+class avx2_keyvalue : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(avx2_keyvalue);
+
+TYPED_TEST_P(avx2_keyvalue, test_random)
+{
+    if (!__builtin_cpu_supports("avx2")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx2";
+    }
+    for (int64_t size = 0; size < 1024; ++size) {
+        std::vector<TypeParam> keys
+                = get_uniform_rand_array_with_uniquevalues<TypeParam>(size);
+        std::vector<uint64_t> values = get_uniform_rand_array<uint64_t>(size);
+        std::vector<std::pair<TypeParam, uint64_t>> sortedarr;
+        for (size_t i = 0; i < keys.size(); i++) {
+            sortedarr.emplace_back(keys[i], values[i]);
+        }
+        /* Sort with std::sort for comparison */
+        std::sort(sortedarr.begin(), sortedarr.end());
+        avx2_qsort_kv(keys.data(), values.data(), keys.size());
+        for (size_t i = 0; i < keys.size(); i++) {
+            ASSERT_EQ(keys[i], sortedarr[i].first);
+            ASSERT_EQ(values[i], sortedarr[i].second);
+        }
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(avx2_keyvalue, test_random);
+
+TEST(avx2_keyvalue, test_inf_at_endofarray)
+{
+    if (!__builtin_cpu_supports("avx2")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx2";
+    }
+    double inf = std::numeric_limits<double>::infinity();
+    std::vector<double> key = {8.0, 7.0, 6.0, 5.0, 4.0, 3.0, 2.0, 1.0, inf};
+    std::vector<double> key_sorted
+            = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, inf};
+    std::vector<uint64_t> val = {7, 6, 5, 4, 3, 2, 1, 0, 8};
+    std::vector<uint64_t> val_sorted = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+    avx2_qsort_kv(key.data(), val.data(), key.size());
+    ASSERT_EQ(key, key_sorted);
+    ASSERT_EQ(val, val_sorted);
+}
+
+using ArgAVX2TestTypes
+        = testing::Types<int32_t, uint32_t, float, uint64_t, int64_t, double>;
+using KvAVX2TestTypes = testing::Types<double, uint64_t, int64_t>;
+
+INSTANTIATE_TYPED_TEST_SUITE_P(T, avx2argsort, ArgAVX2TestTypes);
+INSTANTIATE_TYPED_TEST_SUITE_P(T, avx2_keyvalue, KvAVX2TestTypes);
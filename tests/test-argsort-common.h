@@ -1,8 +1,7 @@
-#include "avx512-64bit-argsort.hpp"
-
 #include "rand_array.h"
 #include <algorithm>
 #include <gtest/gtest.h>
+#include <numeric>
 #include <vector>
 
 template <typename T>
@@ -0,0 +1,137 @@
+/*******************************************
+ * * Copyright (C) 2023 Intel Corporation
+ * * SPDX-License-Identifier: BSD-3-Clause
+ * *******************************************/
+
+#include "avx512-16bit-keyvaluesort.hpp"
+
+#include "rand_array.h"
+#include <gtest/gtest.h>
+
+/* float16 stored as uint16_t, converted with F16C */
+static float fp16_to_float(uint16_t val)
+{
+    return _cvtsh_ss(val);
+}
+
+static bool fp16_less(uint16_t a, uint16_t b)
+{
+    return fp16_to_float(a) < fp16_to_float(b);
+}
+
+static std::vector<uint16_t> get_rand_fp16_array(int64_t arrsize)
+{
+    std::vector<float> farr
+            = get_uniform_rand_array<float>(arrsize, 100.0f, -100.0f);
+    std::vector<uint16_t> arr;
+    for (int64_t ii = 0; ii < arrsize; ++ii) {
+        switch (ii % 37) {
+            case 3: arr.push_back(X86_SIMD_SORT_INFINITYH); break;
+            case 7: arr.push_back(X86_SIMD_SORT_NEGINFINITYH); break;
+            case 11: arr.push_back(0x0001); break; // denormal
+            case 13: arr.push_back(0x8000); break; // -0
+            default: arr.push_back(_cvtss_sh(farr[ii], 0)); break;
+        }
+    }
+    return arr;
+}
+
+TEST(avx512_argsort_fp16, test_random)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    for (int64_t size = 0; size <= 1024; ++size) {
+        std::vector<uint16_t> arr = get_rand_fp16_array(size);
+        if (size > 2) { arr[size / 2] = 0x7e00; }
+        std::vector<int64_t> inx = avx512_argsort_fp16(arr.data(), size);
+        std::vector<uint16_t> sorted;
+        for (auto jj = 0; jj < size; ++jj) {
+            sorted.push_back(arr[inx[jj]]);
+        }
+        int64_t num_nans = (size > 2) ? 1 : 0;
+        ASSERT_TRUE(std::is_sorted(
+                sorted.begin(), sorted.end() - num_nans, fp16_less))
+                << "Array size = " << size;
+        if (num_nans) { ASSERT_TRUE(is_a_nan<uint16_t>(sorted[size - 1])); }
+        std::sort(inx.begin(), inx.end());
+        for (auto jj = 0; jj < size; ++jj) {
+            ASSERT_EQ(inx[jj], jj) << "Indices aren't unique";
+        }
+    }
+}
+
+TEST(avx512_argsort_fp16, test_argselect)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    for (int64_t size = 1; size <= 1024; ++size) {
+        std::vector<uint16_t> arr = get_rand_fp16_array(size);
+        std::vector<uint16_t> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end(), fp16_less);
+        int64_t k = rand() % size;
+        std::vector<int64_t> inx = avx512_argselect_fp16(arr.data(), k, size);
+        ASSERT_EQ(fp16_to_float(sortedarr[k]), fp16_to_float(arr[inx[k]]))
+                << "Array size = " << size;
+        for (int64_t jj = 0; jj < k; ++jj) {
+            ASSERT_FALSE(fp16_less(arr[inx[k]], arr[inx[jj]]));
+        }
+        for (int64_t jj = k + 1; jj < size; ++jj) {
+            ASSERT_FALSE(fp16_less(arr[inx[jj]], arr[inx[k]]));
+        }
+    }
+}
+
+template <typename T>
+class KeyValueSortFp16 : public ::testing::Test {
+};
+
+TYPED_TEST_SUITE_P(KeyValueSortFp16);
+
+TYPED_TEST_P(KeyValueSortFp16, test_random_nan)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    for (bool descending : {false, true}) {
+        for (int64_t size = 0; size <= 1024; ++size) {
+            std::vector<uint16_t> keys = get_rand_fp16_array(size);
+            int64_t num_nans = (size > 2) ? 2 : 0;
+            if (num_nans) {
+                keys[0] = 0x7e00;
+                keys[size / 2] = 0xfe01;
+            }
+            std::vector<TypeParam> values(size);
+            for (int64_t ii = 0; ii < size; ++ii) {
+                values[ii] = (TypeParam)ii;
+            }
+            std::vector<uint16_t> orig = keys;
+            avx512_qsort_kv_fp16(
+                    keys.data(), values.data(), size, descending);
+            for (int64_t ii = 0; ii < size; ++ii) {
+                ASSERT_EQ(keys[ii], orig[(int64_t)values[ii]])
+                        << "Array size = " << size;
+            }
+            for (int64_t ii = size - num_nans; ii < size; ++ii) {
+                ASSERT_TRUE(is_a_nan<uint16_t>(keys[ii]));
+            }
+            if (descending) {
+                ASSERT_TRUE(std::is_sorted(keys.rbegin() + num_nans,
+                                           keys.rend(),
+                                           fp16_less))
+                        << "Array size = " << size;
+            }
+            else {
+                ASSERT_TRUE(std::is_sorted(
+                        keys.begin(), keys.end() - num_nans, fp16_less))
+                        << "Array size = " << size;
+            }
+        }
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(KeyValueSortFp16, test_random_nan);
+
+using TypesKvFp16 = testing::Types<uint16_t, int32_t, uint64_t, double>;
+INSTANTIATE_TYPED_TEST_SUITE_P(T, KeyValueSortFp16, TypesKvFp16);
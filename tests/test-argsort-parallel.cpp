@@ -0,0 +1,123 @@
+/*******************************************
+ * * Copyright (C) 2023 Intel Corporation
+ * * SPDX-License-Identifier: BSD-3-Clause
+ * *******************************************/
+
+#include "avx512-16bit-argsort.hpp"
+#include "avx512-parallel-argsort.hpp"
+
+#include "rand_array.h"
+#include <gtest/gtest.h>
+
+template <typename T>
+static std::vector<T> get_parallel_argsort_array(int64_t arrsize,
+                                                 std::string arrtype)
+{
+    std::vector<T> arr;
+    if (arrtype == "random") { arr = get_uniform_rand_array<T>(arrsize); }
+    else if (arrtype == "distinct") {
+        for (int64_t ii = 0; ii < arrsize; ++ii) {
+            arr.push_back((T)ii);
+        }
+        std::shuffle(arr.begin(), arr.end(), std::default_random_engine(42));
+    }
+    else if (arrtype == "duplicates") {
+        std::vector<T> values = get_uniform_rand_array<T>(10);
+        for (int64_t ii = 0; ii < arrsize; ++ii) {
+            arr.push_back(values[rand() % 10]);
+        }
+    }
+    else if (arrtype == "nan") {
+        arr = get_uniform_rand_array<T>(arrsize);
+        if constexpr (std::is_floating_point_v<T>) {
+            for (int64_t ii = 0; ii < arrsize; ii += 1 + rand() % 2000) {
+                arr[ii] = std::numeric_limits<T>::quiet_NaN();
+            }
+        }
+    }
+    else if (arrtype == "constant") {
+        arr = std::vector<T>(arrsize, get_uniform_rand_array<T>(1)[0]);
+    }
+    return arr;
+}
+
+template <typename T>
+static bool same_key(T a, T b)
+{
+    return a == b || (a != a && b != b);
+}
+
+/*
+ * Same keys in the same order as avx512_argsort, and for distinct keys the
+ * same indices
+ */
+template <typename T>
+static void check_parallel_argsort(xss_executor &executor, int64_t arrsize)
+{
+    std::vector<std::string> arrtypes
+            = {"random", "duplicates", "nan", "constant"};
+    /* 16-bit keys repeat in arrays this big */
+    if (sizeof(T) > 2) { arrtypes.push_back("distinct"); }
+    for (std::string arrtype : arrtypes) {
+        for (bool descending : {false, true}) {
+            std::vector<T> arr
+                    = get_parallel_argsort_array<T>(arrsize, arrtype);
+            std::vector<int64_t> serial_arg
+                    = avx512_argsort<T>(arr.data(), arrsize, descending);
+            std::vector<int64_t> arg = avx512_argsort_parallel<T>(
+                    arr.data(), arrsize, executor, descending);
+            ASSERT_EQ(arg.size(), (size_t)arrsize);
+            for (int64_t ii = 0; ii < arrsize; ++ii) {
+                ASSERT_TRUE(same_key(arr[serial_arg[ii]], arr[arg[ii]]))
+                        << "Array size = " << arrsize << ", " << arrtype
+                        << ", index = " << ii;
+            }
+            if (arrtype == "distinct") { ASSERT_EQ(serial_arg, arg); }
+            std::sort(arg.begin(), arg.end());
+            for (int64_t ii = 0; ii < arrsize; ++ii) {
+                ASSERT_EQ(arg[ii], ii);
+            }
+        }
+    }
+}
+
+template <typename T>
+class avx512_argsort_parallel_test : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(avx512_argsort_parallel_test);
+
+TYPED_TEST_P(avx512_argsort_parallel_test, test_thread_pool)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    xss_thread_pool pool(4);
+    for (int64_t size :
+         {0, 1000, XSS_PARALLEL_CUTOFF, XSS_PARALLEL_CUTOFF + 1, 400009}) {
+        check_parallel_argsort<TypeParam>(pool, size);
+    }
+}
+
+TYPED_TEST_P(avx512_argsort_parallel_test, test_default_executor)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    check_parallel_argsort<TypeParam>(xss_default_executor(), 300000);
+}
+
+REGISTER_TYPED_TEST_SUITE_P(avx512_argsort_parallel_test,
+                            test_thread_pool,
+                            test_default_executor);
+
+using ArgsortParallelTestTypes = testing::Types<int16_t,
+                                                uint16_t,
+                                                int32_t,
+                                                uint32_t,
+                                                float,
+                                                int64_t,
+                                                uint64_t,
+                                                double>;
+INSTANTIATE_TYPED_TEST_SUITE_P(T,
+                               avx512_argsort_parallel_test,
+                               ArgsortParallelTestTypes);
@@ -0,0 +1,110 @@
+/*******************************************
+ * * Copyright (C) 2023 Intel Corporation
+ * * SPDX-License-Identifier: BSD-3-Clause
+ * *******************************************/
+
+#include "avx512-stable-argsort.hpp"
+
+#include "rand_array.h"
+#include <gtest/gtest.h>
+
+/* num_values distinct values, and for floats -0.0 next to +0.0 and NaN's */
+template <typename T>
+static std::vector<T> get_rand_tied_array(int64_t arrsize, int num_values)
+{
+    std::vector<T> values = get_uniform_rand_array<T>(num_values);
+    std::vector<T> arr;
+    for (int64_t ii = 0; ii < arrsize; ++ii) {
+        arr.push_back(values[rand() % num_values]);
+        if constexpr (std::is_floating_point_v<T>) {
+            if (ii % 13 == 5) { arr[ii] = (ii % 2) ? -0.0 : 0.0; }
+            if (ii % 17 == 3) {
+                arr[ii] = (ii % 2) ? -std::numeric_limits<T>::quiet_NaN()
+                                   : std::numeric_limits<T>::quiet_NaN();
+            }
+            if (ii % 19 == 7) {
+                arr[ii] = (ii % 2) ? -std::numeric_limits<T>::infinity()
+                                   : std::numeric_limits<T>::infinity();
+            }
+        }
+        if (ii % 23 == 11) { arr[ii] = std::numeric_limits<T>::lowest(); }
+        if (ii % 29 == 13) { arr[ii] = std::numeric_limits<T>::max(); }
+    }
+    return arr;
+}
+
+template <typename T>
+static std::vector<int64_t>
+std_stable_argsort(const std::vector<T> &arr, bool descending)
+{
+    std::vector<int64_t> arg(arr.size());
+    std::iota(arg.begin(), arg.end(), 0);
+    std::stable_sort(arg.begin(), arg.end(), [&](int64_t a, int64_t b) {
+        T x = arr[a], y = arr[b];
+        if (x != x || y != y) { return x == x && y != y; }
+        return descending ? y < x : x < y;
+    });
+    return arg;
+}
+
+template <typename T>
+class avx512_argsort_stable_test : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(avx512_argsort_stable_test);
+
+TYPED_TEST_P(avx512_argsort_stable_test, test_ties)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    std::vector<int64_t> sizes;
+    for (int64_t size = 0; size < 1024; size += 1 + size / 16) {
+        sizes.push_back(size);
+    }
+    sizes.push_back(10007);
+    sizes.push_back(100000);
+    for (int num_values : {1, 3, 100, 100000}) {
+        for (bool descending : {false, true}) {
+            for (int64_t size : sizes) {
+                std::vector<TypeParam> arr
+                        = get_rand_tied_array<TypeParam>(size, num_values);
+                std::vector<int64_t> arg = avx512_argsort_stable(
+                        arr.data(), size, descending);
+                ASSERT_EQ(std_stable_argsort(arr, descending), arg)
+                        << "Array size = " << size
+                        << ", values = " << num_values;
+            }
+        }
+    }
+}
+
+TYPED_TEST_P(avx512_argsort_stable_test, test_sorted_input)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    for (int64_t size : {0, 1, 2, 100, 1000, 10007}) {
+        std::vector<TypeParam> arr = get_rand_tied_array<TypeParam>(size, 50);
+        std::sort(arr.begin(), arr.end(), [](TypeParam x, TypeParam y) {
+            return x < y || (x == x && y != y);
+        });
+        std::vector<int64_t> arg(size);
+        avx512_argsort_stable(arr.data(), arg.data(), size);
+        ASSERT_EQ(std_stable_argsort(arr, false), arg)
+                << "Array size = " << size;
+        std::reverse(arr.begin(), arr.end());
+        avx512_argsort_stable(arr.data(), arg.data(), size);
+        ASSERT_EQ(std_stable_argsort(arr, false), arg)
+                << "Array size = " << size;
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(avx512_argsort_stable_test,
+                            test_ties,
+                            test_sorted_input);
+
+using ArgsortStableTestTypes = testing::
+        Types<int32_t, uint32_t, float, int64_t, uint64_t, double>;
+INSTANTIATE_TYPED_TEST_SUITE_P(T,
+                               avx512_argsort_stable_test,
+                               ArgsortStableTestTypes);
@@ -0,0 +1,149 @@
+/*******************************************
+ * * Copyright (C) 2023 Intel Corporation
+ * * SPDX-License-Identifier: BSD-3-Clause
+ * *******************************************/
+
+#include "avx512-16bit-keyvaluesort.hpp"
+#include "avx512-32bit-keyvaluesort.hpp"
+#include "avx512-64bit-keyvaluesort.hpp"
+#include "avx512-parallel-keyvaluesort.hpp"
+
+#include "rand_array.h"
+#include <gtest/gtest.h>
+
+template <typename T>
+static std::vector<T> get_parallel_kv_keys(int64_t arrsize,
+                                           std::string arrtype)
+{
+    std::vector<T> arr;
+    if (arrtype == "random") { arr = get_uniform_rand_array<T>(arrsize); }
+    else if (arrtype == "duplicates") {
+        std::vector<T> values = get_uniform_rand_array<T>(10);
+        for (int64_t ii = 0; ii < arrsize; ++ii) {
+            arr.push_back(values[rand() % 10]);
+        }
+    }
+    else if (arrtype == "nan") {
+        arr = get_uniform_rand_array<T>(arrsize);
+        if constexpr (std::is_floating_point_v<T>) {
+            for (int64_t ii = 0; ii < arrsize; ii += 1 + rand() % 2000) {
+                arr[ii] = std::numeric_limits<T>::quiet_NaN();
+            }
+        }
+    }
+    else if (arrtype == "constant") {
+        arr = std::vector<T>(arrsize, get_uniform_rand_array<T>(1)[0]);
+    }
+    return arr;
+}
+
+/* Bytes of x, so that NaN keys compare equal and sort together */
+template <typename T>
+static uint64_t kv_bits(T x)
+{
+    uint64_t bits = 0;
+    std::memcpy(&bits, &x, sizeof(T));
+    return bits;
+}
+
+template <typename K, typename V>
+static std::vector<std::pair<uint64_t, uint64_t>>
+kv_pairs(const std::vector<K> &keys, const std::vector<V> &values)
+{
+    std::vector<std::pair<uint64_t, uint64_t>> pairs;
+    for (size_t ii = 0; ii < keys.size(); ++ii) {
+        pairs.emplace_back(kv_bits(keys[ii]), kv_bits(values[ii]));
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+/*
+ * Same keys as avx512_qsort_kv, NaN's included, and every value still with
+ * its key. The values of equal keys can come out in any order.
+ */
+template <typename K, typename V>
+static void check_parallel_qsort_kv(xss_executor &executor, int64_t arrsize)
+{
+    for (std::string arrtype : {"random", "duplicates", "nan", "constant"}) {
+        for (bool descending : {false, true}) {
+            std::vector<K> keys = get_parallel_kv_keys<K>(arrsize, arrtype);
+            std::vector<V> values = get_uniform_rand_array<V>(arrsize);
+            std::vector<K> sortedkeys = keys;
+            std::vector<V> sortedvalues = values;
+            avx512_qsort_kv<K, V>(sortedkeys.data(),
+                                  sortedvalues.data(),
+                                  arrsize,
+                                  descending);
+            std::vector<std::pair<uint64_t, uint64_t>> pairs
+                    = kv_pairs(keys, values);
+            avx512_qsort_kv_parallel<K, V>(
+                    keys.data(), values.data(), arrsize, executor, descending);
+            ASSERT_EQ(std::memcmp(keys.data(),
+                                  sortedkeys.data(),
+                                  arrsize * sizeof(K)),
+                      0)
+                    << "Array size = " << arrsize << ", " << arrtype;
+            ASSERT_TRUE(kv_pairs(keys, values) == pairs)
+                    << "Array size = " << arrsize << ", " << arrtype;
+        }
+    }
+}
+
+/* TypeParam is std::pair<key type, value type> */
+template <typename KV>
+class avx512_qsort_kv_parallel_test : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(avx512_qsort_kv_parallel_test);
+
+TYPED_TEST_P(avx512_qsort_kv_parallel_test, test_thread_pool)
+{
+    using K = typename TypeParam::first_type;
+    using V = typename TypeParam::second_type;
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+#ifdef __AVX512VBMI2__
+    if ((sizeof(K) == 2 || sizeof(V) == 2)
+        && (!__builtin_cpu_supports("avx512vbmi2"))) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512_vbmi2";
+    }
+#endif
+    xss_thread_pool pool(4);
+    for (int64_t size :
+         {0, 1000, XSS_PARALLEL_CUTOFF, XSS_PARALLEL_CUTOFF + 1, 400009}) {
+        check_parallel_qsort_kv<K, V>(pool, size);
+    }
+}
+
+TYPED_TEST_P(avx512_qsort_kv_parallel_test, test_default_executor)
+{
+    using K = typename TypeParam::first_type;
+    using V = typename TypeParam::second_type;
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+#ifdef __AVX512VBMI2__
+    if ((sizeof(K) == 2 || sizeof(V) == 2)
+        && (!__builtin_cpu_supports("avx512vbmi2"))) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512_vbmi2";
+    }
+#endif
+    check_parallel_qsort_kv<K, V>(xss_default_executor(), 300000);
+}
+
+REGISTER_TYPED_TEST_SUITE_P(avx512_qsort_kv_parallel_test,
+                            test_thread_pool,
+                            test_default_executor);
+
+using KvParallelTestTypes = testing::Types<std::pair<double, uint64_t>,
+                                           std::pair<int64_t, int64_t>,
+                                           std::pair<uint64_t, double>,
+                                           std::pair<float, uint32_t>,
+                                           std::pair<int32_t, int32_t>,
+                                           std::pair<float, uint64_t>,
+                                           std::pair<uint32_t, float>,
+                                           std::pair<int16_t, uint64_t>>;
+INSTANTIATE_TYPED_TEST_SUITE_P(T,
+                               avx512_qsort_kv_parallel_test,
+                               KvParallelTestTypes);
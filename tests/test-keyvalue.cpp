@@ -3,6 +3,8 @@
  * * SPDX-License-Identifier: BSD-3-Clause
  * *******************************************/
 
+#include "avx512-16bit-keyvaluesort.hpp"
+#include "avx512-32bit-keyvaluesort.hpp"
 #include "avx512-64bit-keyvaluesort.hpp"
 
 #include "rand_array.h"
@@ -85,3 +87,85 @@ REGISTER_TYPED_TEST_SUITE_P(KeyValueSort, test_64bit_random_data);
 
 using TypesKv = testing::Types<double, uint64_t, int64_t>;
 INSTANTIATE_TYPED_TEST_SUITE_P(T, KeyValueSort, TypesKv);
+
+/* TypeParam is std::pair<key type, value type> */
+template <typename KV>
+class KeyValueSortWidths : public ::testing::Test {
+};
+
+TYPED_TEST_SUITE_P(KeyValueSortWidths);
+
+TYPED_TEST_P(KeyValueSortWidths, test_random_data)
+{
+    using K = typename TypeParam::first_type;
+    using V = typename TypeParam::second_type;
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+#ifdef __AVX512VBMI2__
+    if ((sizeof(K) == 2 || sizeof(V) == 2)
+        && (!__builtin_cpu_supports("avx512vbmi2"))) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512_vbmi2";
+    }
+#endif
+    std::vector<int64_t> sizes;
+    for (int64_t ii = 0; ii < 1024; ++ii) {
+        sizes.push_back(ii);
+    }
+    sizes.push_back(100003);
+    for (int64_t size : sizes) {
+        /* Few distinct keys, so that many of them are equal */
+        std::vector<K> keys = get_uniform_rand_array<K>(size, 100, 0);
+        std::vector<V> values = get_uniform_rand_array<V>(size);
+        std::vector<std::pair<K, V>> sortedarr;
+        for (int64_t i = 0; i < size; i++) {
+            sortedarr.emplace_back(keys[i], values[i]);
+        }
+        std::sort(sortedarr.begin(), sortedarr.end());
+        avx512_qsort_kv(keys.data(), values.data(), size);
+        /* The values of equal keys can come out in any order */
+        std::vector<std::pair<K, V>> result;
+        for (int64_t i = 0; i < size; i++) {
+            ASSERT_EQ(keys[i], sortedarr[i].first) << "Array size = " << size;
+            result.emplace_back(keys[i], values[i]);
+        }
+        std::sort(result.begin(), result.end());
+        ASSERT_TRUE(result == sortedarr) << "Array size = " << size;
+    }
+}
+
+TYPED_TEST_P(KeyValueSortWidths, test_nan_at_endofarray)
+{
+    using K = typename TypeParam::first_type;
+    using V = typename TypeParam::second_type;
+    if (!std::is_floating_point_v<K>) {
+        GTEST_SKIP() << "Skipping this test, keys are not floating point";
+    }
+    K nan = std::numeric_limits<K>::quiet_NaN();
+    std::vector<K> key = {8, nan, 6, 5, 4, 3, 2, 1};
+    std::vector<V> val = {7, 8, 5, 4, 3, 2, 1, 0};
+    std::vector<V> val_sorted = {0, 1, 2, 3, 4, 5, 7, 8};
+    avx512_qsort_kv(key.data(), val.data(), key.size());
+    ASSERT_TRUE(std::is_sorted(key.begin(), key.end() - 1));
+    ASSERT_TRUE(std::isnan(key.back()));
+    ASSERT_EQ(val, val_sorted);
+}
+
+REGISTER_TYPED_TEST_SUITE_P(KeyValueSortWidths,
+                            test_random_data,
+                            test_nan_at_endofarray);
+
+using TypesKvWidths = testing::Types<std::pair<float, uint32_t>,
+                                     std::pair<uint32_t, float>,
+                                     std::pair<int32_t, int32_t>,
+                                     std::pair<float, uint64_t>,
+                                     std::pair<int32_t, double>,
+                                     std::pair<uint32_t, int64_t>,
+                                     std::pair<double, uint32_t>,
+                                     std::pair<int64_t, float>,
+                                     std::pair<uint64_t, int32_t>,
+                                     std::pair<int16_t, uint64_t>,
+                                     std::pair<uint16_t, uint32_t>,
+                                     std::pair<int16_t, int16_t>,
+                                     std::pair<double, uint16_t>>;
+INSTANTIATE_TYPED_TEST_SUITE_P(T, KeyValueSortWidths, TypesKvWidths);
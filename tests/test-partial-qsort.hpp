@@ -11,10 +11,12 @@ TYPED_TEST_P(avx512_partial_sort, test_ranges)
     int64_t nranges = 500;
 
     if (__builtin_cpu_supports("avx512bw")) {
+#ifdef __AVX512VBMI2__
         if ((sizeof(TypeParam) == 2)
             && (!__builtin_cpu_supports("avx512vbmi2"))) {
             GTEST_SKIP() << "Skipping this test, it requires avx512_vbmi2";
         }
+#endif
         std::vector<TypeParam> arr;
         std::vector<TypeParam> sortedarr;
         std::vector<TypeParam> psortedarr;
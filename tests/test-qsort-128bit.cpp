@@ -0,0 +1,93 @@
+/*******************************************
+ * * Copyright (C) 2023 Intel Corporation
+ * * SPDX-License-Identifier: BSD-3-Clause
+ * *******************************************/
+
+#include "avx512-128bit-qsort.hpp"
+
+#include "rand_array.h"
+#include <gtest/gtest.h>
+
+/*
+ * Keys with few distinct high words, so that the low words decide many of the
+ * compares
+ */
+template <typename T>
+static std::vector<T> get_rand_128bit_array(int64_t arrsize)
+{
+    std::vector<uint64_t> hi = get_uniform_rand_array<uint64_t>(arrsize, 7, 0);
+    std::vector<uint64_t> lo = get_uniform_rand_array<uint64_t>(arrsize);
+    std::vector<T> arr(arrsize);
+    for (int64_t ii = 0; ii < arrsize; ++ii) {
+        if constexpr (std::is_same_v<T, uint64_pair>) {
+            arr[ii] = {hi[ii], lo[ii]};
+        }
+        else {
+            arr[ii] = ((T)hi[ii] << 64) | lo[ii];
+        }
+        /* a few maximum and duplicate keys */
+        if (ii % 97 == 5) {
+            arr[ii] = zmm_vector_128bit<T>::type_max();
+        }
+        if (ii % 89 == 3) { arr[ii] = arr[ii / 2]; }
+    }
+    return arr;
+}
+
+template <typename T>
+class avx512_sort_128bit : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(avx512_sort_128bit);
+
+TYPED_TEST_P(avx512_sort_128bit, test_random)
+{
+    if (!__builtin_cpu_supports("avx512dq")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512dq";
+    }
+    for (int64_t size = 0; size < 1024; ++size) {
+        std::vector<TypeParam> arr = get_rand_128bit_array<TypeParam>(size);
+        std::vector<TypeParam> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        avx512_qsort<TypeParam>(arr.data(), arr.size());
+        ASSERT_TRUE(sortedarr == arr) << "Array size = " << size;
+    }
+    for (int64_t size : {10000, 100003}) {
+        std::vector<TypeParam> arr = get_rand_128bit_array<TypeParam>(size);
+        std::vector<TypeParam> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        avx512_qsort<TypeParam>(arr.data(), arr.size());
+        ASSERT_TRUE(sortedarr == arr) << "Array size = " << size;
+    }
+}
+
+TYPED_TEST_P(avx512_sort_128bit, test_select)
+{
+    if (!__builtin_cpu_supports("avx512dq")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512dq";
+    }
+    for (int64_t size = 1; size <= 1024; ++size) {
+        std::vector<TypeParam> arr = get_rand_128bit_array<TypeParam>(size);
+        std::vector<TypeParam> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        int64_t k = rand() % size;
+        std::vector<TypeParam> psortedarr = arr;
+        avx512_qselect<TypeParam>(psortedarr.data(), k, size);
+        ASSERT_TRUE(sortedarr[k] == psortedarr[k]) << "Array size = " << size;
+        for (int64_t jj = 0; jj < k; ++jj) {
+            ASSERT_FALSE(psortedarr[k] < psortedarr[jj]);
+        }
+        for (int64_t jj = k + 1; jj < size; ++jj) {
+            ASSERT_FALSE(psortedarr[jj] < psortedarr[k]);
+        }
+        psortedarr = arr;
+        avx512_partial_qsort<TypeParam>(psortedarr.data(), k + 1, size);
+        psortedarr.resize(k + 1);
+        sortedarr.resize(k + 1);
+        ASSERT_TRUE(sortedarr == psortedarr) << "Array size = " << size;
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(avx512_sort_128bit, test_random, test_select);
+
+using QSort128bitTestTypes = testing::Types<unsigned __int128, uint64_pair>;
+INSTANTIATE_TYPED_TEST_SUITE_P(T, avx512_sort_128bit, QSort128bitTestTypes);
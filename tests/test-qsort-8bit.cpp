@@ -0,0 +1,89 @@
+/*******************************************
+ * * Copyright (C) 2023 Intel Corporation
+ * * SPDX-License-Identifier: BSD-3-Clause
+ * *******************************************/
+
+#include "avx512-8bit-qsort.hpp"
+
+#include "rand_array.h"
+#include <gtest/gtest.h>
+
+template <typename T>
+class avx512_sort_8bit : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(avx512_sort_8bit);
+
+TYPED_TEST_P(avx512_sort_8bit, test_random)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    for (int64_t size = 0; size < 1024; ++size) {
+        std::vector<TypeParam> arr = get_uniform_rand_array<TypeParam>(size);
+        std::vector<TypeParam> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        avx512_qsort<TypeParam>(arr.data(), arr.size());
+        ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+    }
+}
+
+TYPED_TEST_P(avx512_sort_8bit, test_skewed_and_constant)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    for (int64_t size = 1; size < 20000; size += 997) {
+        /* long runs of a few values, filled with 64 byte stores */
+        std::vector<TypeParam> arr
+                = get_uniform_rand_array<TypeParam>(size, 4, 0);
+        std::vector<TypeParam> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        avx512_qsort<TypeParam>(arr.data(), arr.size());
+        ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+        std::fill(arr.begin(),
+                  arr.end(),
+                  std::numeric_limits<TypeParam>::min());
+        arr[size / 2] = std::numeric_limits<TypeParam>::max();
+        sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        avx512_qsort<TypeParam>(arr.data(), arr.size());
+        ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+    }
+}
+
+TYPED_TEST_P(avx512_sort_8bit, test_select)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    for (int64_t size = 1; size <= 1024; ++size) {
+        std::vector<TypeParam> arr = get_uniform_rand_array<TypeParam>(size);
+        std::vector<TypeParam> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        int64_t k = rand() % size;
+        std::vector<TypeParam> psortedarr = arr;
+        avx512_qselect<TypeParam>(psortedarr.data(), k, size);
+        ASSERT_EQ(sortedarr[k], psortedarr[k]) << "Array size = " << size;
+        ASSERT_TRUE(std::all_of(psortedarr.begin(),
+                                psortedarr.begin() + k,
+                                [&](TypeParam x) { return x <= sortedarr[k]; }))
+                << "Array size = " << size;
+        ASSERT_TRUE(std::all_of(psortedarr.begin() + k,
+                                psortedarr.end(),
+                                [&](TypeParam x) { return x >= sortedarr[k]; }))
+                << "Array size = " << size;
+        psortedarr = arr;
+        avx512_partial_qsort<TypeParam>(psortedarr.data(), k + 1, size);
+        psortedarr.resize(k + 1);
+        sortedarr.resize(k + 1);
+        ASSERT_EQ(sortedarr, psortedarr) << "Array size = " << size;
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(avx512_sort_8bit,
+                            test_random,
+                            test_skewed_and_constant,
+                            test_select);
+
+using QSort8bitTestTypes = testing::Types<uint8_t, int8_t>;
+INSTANTIATE_TYPED_TEST_SUITE_P(T, avx512_sort_8bit, QSort8bitTestTypes);
@@ -0,0 +1,138 @@
+#include "test-qsort-avx2.hpp"
+
+using QSortAVX2TestTypes = testing::Types<float,
+                                          double,
+                                          uint16_t,
+                                          int16_t,
+                                          uint32_t,
+                                          int32_t,
+                                          uint64_t,
+                                          int64_t>;
+
+using QSortAVX2TestFPTypes = testing::Types<float, double>;
+
+INSTANTIATE_TYPED_TEST_SUITE_P(T, avx2_sort, QSortAVX2TestTypes);
+INSTANTIATE_TYPED_TEST_SUITE_P(T, avx2_sort_fp, QSortAVX2TestFPTypes);
+
+TEST(avx2_sort_16bit, test_double_compressstore)
+{
+    if (!__builtin_cpu_supports("avx2")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx2";
+    }
+    std::vector<int16_t> arr = get_uniform_rand_array<int16_t>(16);
+    __m256i x = _mm256_loadu_si256((__m256i const *)arr.data());
+    for (int ii = 0; ii < 1024; ++ii) {
+        int32_t mask = (ii == 0) ? 0xFFFF : (ii == 1) ? 0 : rand() & 0xFFFF;
+        std::vector<int16_t> lt, ge;
+        for (int64_t kk = 0; kk < 16; ++kk) {
+            if ((mask >> kk) & 1) { ge.push_back(arr[kk]); }
+            else {
+                lt.push_back(arr[kk]);
+            }
+        }
+        /* disjoint store points, and the same one (exactly 16 free slots) */
+        for (int64_t offset : {32, 0}) {
+            std::vector<int16_t> out(48, 0);
+            int amount_ge = avx2_double_compressstore16<avx2_vector<int16_t>>(
+                    out.data(), out.data() + offset, mask, x);
+            ASSERT_EQ(amount_ge, (int)ge.size());
+            std::vector<int16_t> out_lt(out.begin(), out.begin() + lt.size());
+            std::vector<int16_t> out_ge(out.begin() + offset + 16 - ge.size(),
+                                        out.begin() + offset + 16);
+            std::sort(lt.begin(), lt.end());
+            std::sort(ge.begin(), ge.end());
+            std::sort(out_lt.begin(), out_lt.end());
+            std::sort(out_ge.begin(), out_ge.end());
+            ASSERT_EQ(lt, out_lt) << "mask = " << mask;
+            ASSERT_EQ(ge, out_ge) << "mask = " << mask;
+        }
+    }
+}
+
+/* float16 values as uint16_t bits, compared through F16C conversions */
+static std::vector<uint16_t> get_rand_fp16_array(int64_t arrsize)
+{
+    std::vector<float> farr = get_uniform_rand_array<float>(
+            arrsize, 70000.0f, -70000.0f);
+    std::vector<uint16_t> arr;
+    for (int64_t ii = 0; ii < arrsize; ++ii) {
+        switch (ii % 17) {
+            case 3: arr.push_back(X86_SIMD_SORT_INFINITYH); break;
+            case 7: arr.push_back(X86_SIMD_SORT_NEGINFINITYH); break;
+            case 11: arr.push_back(0x0001); break; // denormal
+            default: arr.push_back(_cvtss_sh(farr[ii], 0)); break;
+        }
+    }
+    return arr;
+}
+
+static bool fp16_less(uint16_t a, uint16_t b)
+{
+    return _cvtsh_ss(a) < _cvtsh_ss(b);
+}
+
+TEST(avx2_sort_fp16, test_random)
+{
+    if (!__builtin_cpu_supports("avx2")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx2";
+    }
+    for (int64_t size = 0; size < 1024; ++size) {
+        std::vector<uint16_t> arr = get_rand_fp16_array(size);
+        avx2_qsort_fp16(arr.data(), arr.size());
+        ASSERT_TRUE(std::is_sorted(arr.begin(), arr.end(), fp16_less))
+                << "Array size = " << size;
+    }
+}
+
+TEST(avx2_sort_fp16, test_random_nan)
+{
+    if (!__builtin_cpu_supports("avx2")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx2";
+    }
+    const int num_nans = 3;
+    for (int64_t size = num_nans; size < 1024; ++size) {
+        std::vector<uint16_t> arr = get_rand_fp16_array(size);
+        for (auto ii = 1; ii <= num_nans; ++ii) {
+            arr[size - ii] = 0x7e00;
+        }
+        std::random_shuffle(arr.begin(), arr.end());
+        avx2_qsort_fp16(arr.data(), arr.size());
+        for (auto ii = 1; ii <= num_nans; ++ii) {
+            ASSERT_TRUE(std::isnan(_cvtsh_ss(arr[size - ii])))
+                    << "NAN's aren't sorted to the end. Arr size = " << size;
+        }
+        ASSERT_TRUE(std::is_sorted(
+                arr.begin(), arr.end() - num_nans, fp16_less))
+                << "Array isn't sorted. Arr size = " << size;
+    }
+}
+
+TEST(avx2_sort_fp16, test_select)
+{
+    if (!__builtin_cpu_supports("avx2")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx2";
+    }
+    const int64_t size = 1024;
+    std::vector<uint16_t> arr = get_rand_fp16_array(size);
+    std::vector<uint16_t> sortedarr = arr;
+    std::sort(sortedarr.begin(), sortedarr.end(), fp16_less);
+    for (int64_t k = 0; k < size; k += 7) {
+        std::vector<uint16_t> psortedarr = arr;
+        avx2_qselect_fp16(psortedarr.data(), k, size);
+        ASSERT_EQ(_cvtsh_ss(sortedarr[k]), _cvtsh_ss(psortedarr[k]))
+                << "k = " << k;
+        ASSERT_TRUE(std::all_of(psortedarr.begin(),
+                                psortedarr.begin() + k,
+                                [&](uint16_t v) {
+                                    return !fp16_less(psortedarr[k], v);
+                                }))
+                << "k = " << k;
+        psortedarr = arr;
+        avx2_partial_qsort_fp16(psortedarr.data(), k + 1, size);
+        ASSERT_TRUE(std::is_sorted(
+                psortedarr.begin(), psortedarr.begin() + k + 1, fp16_less))
+                << "k = " << k;
+        ASSERT_EQ(_cvtsh_ss(sortedarr[k]), _cvtsh_ss(psortedarr[k]))
+                << "k = " << k;
+    }
+}
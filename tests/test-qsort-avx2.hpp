@@ -0,0 +1,157 @@
+/*******************************************
+ * * Copyright (C) 2022 Intel Corporation
+ * * SPDX-License-Identifier: BSD-3-Clause
+ * *******************************************/
+
+#include "avx2-16bit-qsort.hpp"
+#include "avx2-32bit-qsort.hpp"
+#include "avx2-64bit-qsort.hpp"
+
+#include "rand_array.h"
+#include <gtest/gtest.h>
+
+template <typename T>
+class avx2_sort : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(avx2_sort);
+
+TYPED_TEST_P(avx2_sort, test_random)
+{
+    if (!__builtin_cpu_supports("avx2")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx2";
+    }
+    std::vector<TypeParam> arr;
+    std::vector<TypeParam> sortedarr;
+    for (int64_t size = 0; size < 1024; ++size) {
+        /* Random array */
+        arr = get_uniform_rand_array<TypeParam>(size);
+        sortedarr = arr;
+        /* Sort with std::sort for comparison */
+        std::sort(sortedarr.begin(), sortedarr.end());
+        avx2_qsort<TypeParam>(arr.data(), arr.size());
+        ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+        arr.clear();
+        sortedarr.clear();
+    }
+}
+
+TYPED_TEST_P(avx2_sort, test_reverse_and_constant)
+{
+    if (!__builtin_cpu_supports("avx2")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx2";
+    }
+    std::vector<TypeParam> arr;
+    std::vector<TypeParam> sortedarr;
+    for (int64_t size = 1; size <= 1024; ++size) {
+        /* reverse array */
+        for (int64_t jj = 0; jj < size; ++jj) {
+            arr.push_back((TypeParam)(size - jj));
+        }
+        sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        avx2_qsort<TypeParam>(arr.data(), arr.size());
+        ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+        /* constant array */
+        std::fill(arr.begin(), arr.end(), (TypeParam)size);
+        sortedarr = arr;
+        avx2_qsort<TypeParam>(arr.data(), arr.size());
+        ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+        arr.clear();
+        sortedarr.clear();
+    }
+}
+
+TYPED_TEST_P(avx2_sort, test_select)
+{
+    if (!__builtin_cpu_supports("avx2")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx2";
+    }
+    std::vector<TypeParam> arr;
+    std::vector<TypeParam> sortedarr;
+    std::vector<TypeParam> psortedarr;
+    for (int64_t size = 0; size < 512; ++size) {
+        /* Random array */
+        arr = get_uniform_rand_array<TypeParam>(size);
+        sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        for (size_t k = 0; k < arr.size(); ++k) {
+            psortedarr = arr;
+            avx2_qselect<TypeParam>(psortedarr.data(), k, psortedarr.size());
+            /* index k is correct */
+            ASSERT_EQ(sortedarr[k], psortedarr[k]);
+            /* Check left partition */
+            for (size_t jj = 0; jj < k; jj++) {
+                ASSERT_LE(psortedarr[jj], psortedarr[k]);
+            }
+            /* Check right partition */
+            for (size_t jj = k + 1; jj < arr.size(); jj++) {
+                ASSERT_GE(psortedarr[jj], psortedarr[k]);
+            }
+            psortedarr.clear();
+        }
+        arr.clear();
+        sortedarr.clear();
+    }
+}
+
+TYPED_TEST_P(avx2_sort, test_partial_sort)
+{
+    if (!__builtin_cpu_supports("avx2")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx2";
+    }
+    int64_t arrsize = 1024;
+    int64_t nranges = 500;
+    std::vector<TypeParam> arr;
+    std::vector<TypeParam> sortedarr;
+    std::vector<TypeParam> psortedarr;
+    /* Random array */
+    arr = get_uniform_rand_array<TypeParam>(arrsize);
+    sortedarr = arr;
+    std::sort(sortedarr.begin(), sortedarr.end());
+    for (auto ii = 0; ii < nranges; ++ii) {
+        psortedarr = arr;
+        int k = get_uniform_rand_array<int64_t>(1, arrsize, 1).front();
+        avx2_partial_qsort<TypeParam>(psortedarr.data(), k, psortedarr.size());
+        for (auto jj = 0; jj < k; jj++) {
+            ASSERT_EQ(sortedarr[jj], psortedarr[jj]);
+        }
+        psortedarr.clear();
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(avx2_sort,
+                            test_random,
+                            test_reverse_and_constant,
+                            test_select,
+                            test_partial_sort);
+
+template <typename T>
+class avx2_sort_fp : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(avx2_sort_fp);
+
+TYPED_TEST_P(avx2_sort_fp, test_random_nan)
+{
+    if (!__builtin_cpu_supports("avx2")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx2";
+    }
+    const int num_nans = 3;
+    std::vector<TypeParam> arr;
+    for (int64_t size = num_nans; size < 1024; ++size) {
+        arr = get_uniform_rand_array<TypeParam>(size);
+        for (auto ii = 1; ii <= num_nans; ++ii) {
+            arr[size - ii] = std::numeric_limits<TypeParam>::quiet_NaN();
+        }
+        std::random_shuffle(arr.begin(), arr.end());
+        avx2_qsort<TypeParam>(arr.data(), arr.size());
+        for (auto ii = 1; ii <= num_nans; ++ii) {
+            ASSERT_TRUE(std::isnan(arr[size - ii]))
+                    << "NAN's aren't sorted to the end. Arr size = " << size;
+        }
+        ASSERT_TRUE(std::is_sorted(arr.begin(), arr.end() - num_nans))
+                << "Array isn't sorted. Arr size = " << size;
+        arr.clear();
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(avx2_sort_fp, test_random_nan);
@@ -0,0 +1,216 @@
+/*******************************************
+ * * Copyright (C) 2023 Intel Corporation
+ * * SPDX-License-Identifier: BSD-3-Clause
+ * *******************************************/
+
+/*
+ * Tests the 256-bit AVX-512VL routines (avx512vl_*), which sort 32-bit and
+ * 64-bit types with ymm_vector instead of zmm_vector, and argsort them with
+ * 4 indices per ymm register.
+ */
+#include "avx512-32bit-qsort.hpp"
+#include "avx512-64bit-argsort.hpp"
+#include "avx512-64bit-qsort.hpp"
+
+#include "test-argsort-common.h"
+
+template <typename T>
+class avx512vl_sort : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(avx512vl_sort);
+
+TYPED_TEST_P(avx512vl_sort, test_random)
+{
+    if (!__builtin_cpu_supports("avx512vl")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512vl";
+    }
+    for (int64_t size = 0; size < 1024; ++size) {
+        std::vector<TypeParam> arr = get_uniform_rand_array<TypeParam>(size);
+        std::vector<TypeParam> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        avx512vl_qsort<TypeParam>(arr.data(), size);
+        ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+    }
+}
+
+TYPED_TEST_P(avx512vl_sort, test_small_range)
+{
+    if (!__builtin_cpu_supports("avx512vl")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512vl";
+    }
+    for (int64_t size = 1024; size < 50000; size += 7919) {
+        /* lots of duplicates, exercises every number of lanes >= pivot */
+        std::vector<TypeParam> arr
+                = get_uniform_rand_array<TypeParam>(size, 10, 0);
+        std::vector<TypeParam> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        avx512vl_qsort<TypeParam>(arr.data(), size);
+        ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+    }
+}
+
+TYPED_TEST_P(avx512vl_sort, test_select)
+{
+    if (!__builtin_cpu_supports("avx512vl")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512vl";
+    }
+    for (int64_t size = 1; size < 1024; ++size) {
+        std::vector<TypeParam> arr = get_uniform_rand_array<TypeParam>(size);
+        std::vector<TypeParam> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        int64_t k = rand() % size;
+        avx512vl_qselect<TypeParam>(arr.data(), k, size);
+        ASSERT_EQ(sortedarr[k], arr[k]) << "Array size = " << size;
+    }
+}
+
+TYPED_TEST_P(avx512vl_sort, test_partial_qsort)
+{
+    if (!__builtin_cpu_supports("avx512vl")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512vl";
+    }
+    for (int64_t size = 1; size < 1024; ++size) {
+        std::vector<TypeParam> arr = get_uniform_rand_array<TypeParam>(size);
+        std::vector<TypeParam> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        int64_t k = 1 + rand() % size;
+        avx512vl_partial_qsort<TypeParam>(arr.data(), k, size);
+        arr.resize(k);
+        sortedarr.resize(k);
+        ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(avx512vl_sort,
+                            test_random,
+                            test_small_range,
+                            test_select,
+                            test_partial_qsort);
+
+template <typename T>
+class avx512vl_sort_fp : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(avx512vl_sort_fp);
+
+TYPED_TEST_P(avx512vl_sort_fp, test_random_nan)
+{
+    if (!__builtin_cpu_supports("avx512vl")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512vl";
+    }
+    const int num_nans = 3;
+    std::vector<TypeParam> arr;
+    for (int64_t size = num_nans; size < 1024; ++size) {
+        arr = get_uniform_rand_array<TypeParam>(size);
+        for (auto ii = 1; ii <= num_nans; ++ii) {
+            arr[size - ii] = std::numeric_limits<TypeParam>::quiet_NaN();
+        }
+        std::random_shuffle(arr.begin(), arr.end());
+        avx512vl_qsort<TypeParam>(arr.data(), arr.size());
+        for (auto ii = 1; ii <= num_nans; ++ii) {
+            ASSERT_TRUE(std::isnan(arr[size - ii]))
+                    << "NAN's aren't sorted to the end. Arr size = " << size;
+        }
+        ASSERT_TRUE(std::is_sorted(arr.begin(), arr.end() - num_nans))
+                << "Array isn't sorted. Arr size = " << size;
+        arr.clear();
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(avx512vl_sort_fp, test_random_nan);
+
+template <typename T>
+class avx512vl_argsort_test : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(avx512vl_argsort_test);
+
+TYPED_TEST_P(avx512vl_argsort_test, test_random)
+{
+    if (!__builtin_cpu_supports("avx512vl")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512vl";
+    }
+    for (int64_t size = 0; size <= 1024; ++size) {
+        /* odd sizes have a handful of distinct values */
+        std::vector<TypeParam> arr = size % 2
+                ? get_uniform_rand_array<TypeParam>(size, 20, 1)
+                : get_uniform_rand_array<TypeParam>(size);
+        if constexpr (std::is_floating_point_v<TypeParam>) {
+            if (size % 3 == 0 && size > 0) {
+                arr[rand() % size]
+                        = std::numeric_limits<TypeParam>::quiet_NaN();
+            }
+        }
+        std::vector<int64_t> inx1 = std_argsort(arr);
+        std::vector<int64_t> inx2
+                = avx512vl_argsort<TypeParam>(arr.data(), arr.size());
+        for (int64_t jj = 0; jj < size; ++jj) {
+            if (std::isnan((double)arr[inx1[jj]])) {
+                ASSERT_TRUE(std::isnan((double)arr[inx2[jj]]));
+            }
+            else {
+                ASSERT_EQ(arr[inx1[jj]], arr[inx2[jj]])
+                        << "Array size = " << size;
+            }
+        }
+        EXPECT_UNIQUE(inx2)
+    }
+}
+
+/* The path avx512_argsort takes with -DXSS_AVX512_YMM_THRESHOLD */
+TYPED_TEST_P(avx512vl_argsort_test, test_descending)
+{
+    if (!__builtin_cpu_supports("avx512vl")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512vl";
+    }
+    using vtype = descending_vector<avx512vl_arg_vector<TypeParam>>;
+    for (int64_t size = 0; size <= 1024; size += 3) {
+        std::vector<TypeParam> arr = get_uniform_rand_array<TypeParam>(size);
+        std::vector<int64_t> inx(size);
+        std::iota(inx.begin(), inx.end(), 0);
+        xss_argsort<vtype, ymm_vector<int64_t>>(arr.data(), inx.data(), size);
+        std::vector<TypeParam> sorted;
+        for (int64_t jj = 0; jj < size; ++jj) {
+            sorted.push_back(arr[inx[jj]]);
+        }
+        ASSERT_TRUE(std::is_sorted(sorted.rbegin(), sorted.rend()))
+                << "Array size = " << size;
+        EXPECT_UNIQUE(inx)
+    }
+}
+
+TYPED_TEST_P(avx512vl_argsort_test, test_argselect)
+{
+    if (!__builtin_cpu_supports("avx512vl")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512vl";
+    }
+    for (int64_t size = 1; size <= 1024; ++size) {
+        std::vector<TypeParam> arr = get_uniform_rand_array<TypeParam>(size);
+        std::vector<int64_t> sorted_inx = std_argsort(arr);
+        int64_t k = rand() % size;
+        std::vector<int64_t> inx
+                = avx512vl_argselect<TypeParam>(arr.data(), k, arr.size());
+        ASSERT_EQ(arr[sorted_inx[k]], arr[inx[k]]) << "Array size = " << size;
+        for (int64_t jj = 0; jj < k; ++jj) {
+            ASSERT_LE(arr[inx[jj]], arr[inx[k]]);
+        }
+        for (int64_t jj = k + 1; jj < size; ++jj) {
+            ASSERT_GE(arr[inx[jj]], arr[inx[k]]);
+        }
+        EXPECT_UNIQUE(inx)
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(avx512vl_argsort_test,
+                            test_random,
+                            test_descending,
+                            test_argselect);
+
+using QSortAVX512VLTestTypes = testing::
+        Types<float, double, uint32_t, int32_t, uint64_t, int64_t>;
+
+using QSortAVX512VLTestFPTypes = testing::Types<float, double>;
+
+INSTANTIATE_TYPED_TEST_SUITE_P(T, avx512vl_sort, QSortAVX512VLTestTypes);
+INSTANTIATE_TYPED_TEST_SUITE_P(T, avx512vl_sort_fp, QSortAVX512VLTestFPTypes);
+INSTANTIATE_TYPED_TEST_SUITE_P(T,
+                               avx512vl_argsort_test,
+                               QSortAVX512VLTestTypes);
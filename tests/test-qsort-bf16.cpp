@@ -0,0 +1,172 @@
+/*******************************************
+ * * Copyright (C) 2023 Intel Corporation
+ * * SPDX-License-Identifier: BSD-3-Clause
+ * *******************************************/
+
+#include "avx512-16bit-argsort.hpp"
+#include "avx512-16bit-qsort.hpp"
+
+#include "rand_array.h"
+#include <gtest/gtest.h>
+
+static float bf16_to_float(uint16_t val)
+{
+    uint32_t bits = (uint32_t)val << 16;
+    float ret;
+    std::memcpy(&ret, &bits, sizeof(ret));
+    return ret;
+}
+
+static uint16_t float_to_bf16(float val)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    return bits >> 16;
+}
+
+static bool bf16_less(uint16_t a, uint16_t b)
+{
+    return bf16_to_float(a) < bf16_to_float(b);
+}
+
+static std::vector<uint16_t> get_rand_bf16_array(int64_t arrsize)
+{
+    std::vector<float> farr
+            = get_uniform_rand_array<float>(arrsize, 100.0f, -100.0f);
+    std::vector<uint16_t> arr;
+    for (int64_t ii = 0; ii < arrsize; ++ii) {
+        switch (ii % 37) {
+            case 3: arr.push_back(X86_SIMD_SORT_INFINITYBF16); break;
+            case 7: arr.push_back(X86_SIMD_SORT_NEGINFINITYBF16); break;
+            case 11: arr.push_back(0x0001); break; // denormal
+            case 13: arr.push_back(0x8000); break; // -0
+            default: arr.push_back(float_to_bf16(farr[ii])); break;
+        }
+    }
+    return arr;
+}
+
+TEST(avx512_sort_bf16, test_random)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    for (int64_t size = 0; size < 1024; ++size) {
+        std::vector<uint16_t> arr = get_rand_bf16_array(size);
+        std::vector<uint16_t> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end(), bf16_less);
+        avx512_qsort_bf16(arr.data(), arr.size());
+        ASSERT_TRUE(std::is_sorted(arr.begin(), arr.end(), bf16_less))
+                << "Array size = " << size;
+        for (int64_t ii = 0; ii < size; ++ii) {
+            ASSERT_EQ(bf16_to_float(sortedarr[ii]), bf16_to_float(arr[ii]))
+                    << "Array size = " << size;
+        }
+    }
+}
+
+TEST(avx512_sort_bf16, test_random_nan)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    const int num_nans = 3;
+    for (int64_t size = num_nans; size < 1024; ++size) {
+        std::vector<uint16_t> arr = get_rand_bf16_array(size);
+        arr[size - 1] = 0x7fc0;
+        arr[size - 2] = 0xffc0;
+        arr[size - 3] = 0x7f81;
+        std::random_shuffle(arr.begin(), arr.end());
+        avx512_qsort_bf16(arr.data(), arr.size());
+        for (auto ii = 1; ii <= num_nans; ++ii) {
+            ASSERT_TRUE(is_a_nan_bf16(arr[size - ii]))
+                    << "NAN's aren't sorted to the end. Arr size = " << size;
+        }
+        ASSERT_TRUE(std::is_sorted(
+                arr.begin(), arr.end() - num_nans, bf16_less))
+                << "Array isn't sorted. Arr size = " << size;
+    }
+}
+
+TEST(avx512_sort_bf16, test_select)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    const int64_t size = 1024;
+    std::vector<uint16_t> arr = get_rand_bf16_array(size);
+    arr[size / 3] = 0x7fc0;
+    std::vector<uint16_t> sortedarr;
+    std::copy_if(arr.begin(),
+                 arr.end(),
+                 std::back_inserter(sortedarr),
+                 [](uint16_t v) { return !is_a_nan_bf16(v); });
+    std::sort(sortedarr.begin(), sortedarr.end(), bf16_less);
+    for (int64_t k = 0; k < size - 1; k += 7) {
+        std::vector<uint16_t> psortedarr = arr;
+        avx512_qselect_bf16(psortedarr.data(), k, size, true);
+        ASSERT_EQ(bf16_to_float(sortedarr[k]), bf16_to_float(psortedarr[k]))
+                << "k = " << k;
+        ASSERT_TRUE(is_a_nan_bf16(psortedarr[size - 1])) << "k = " << k;
+        ASSERT_TRUE(std::all_of(psortedarr.begin(),
+                                psortedarr.begin() + k,
+                                [&](uint16_t v) {
+                                    return !bf16_less(psortedarr[k], v);
+                                }))
+                << "k = " << k;
+        psortedarr = arr;
+        avx512_partial_qsort_bf16(psortedarr.data(), k + 1, size, true);
+        ASSERT_TRUE(std::is_sorted(
+                psortedarr.begin(), psortedarr.begin() + k + 1, bf16_less))
+                << "k = " << k;
+        ASSERT_EQ(bf16_to_float(sortedarr[k]), bf16_to_float(psortedarr[k]))
+                << "k = " << k;
+    }
+}
+
+TEST(avx512_argsort_bf16, test_random)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    for (int64_t size = 0; size <= 1024; ++size) {
+        std::vector<uint16_t> arr = get_rand_bf16_array(size);
+        if (size > 2) { arr[size / 2] = 0xffc0; }
+        std::vector<int64_t> inx = avx512_argsort_bf16(arr.data(), size);
+        std::vector<uint16_t> sorted;
+        for (auto jj = 0; jj < size; ++jj) {
+            sorted.push_back(arr[inx[jj]]);
+        }
+        int64_t num_nans = (size > 2) ? 1 : 0;
+        ASSERT_TRUE(std::is_sorted(
+                sorted.begin(), sorted.end() - num_nans, bf16_less))
+                << "Array size = " << size;
+        if (num_nans) { ASSERT_TRUE(is_a_nan_bf16(sorted[size - 1])); }
+        std::sort(inx.begin(), inx.end());
+        for (auto jj = 0; jj < size; ++jj) {
+            ASSERT_EQ(inx[jj], jj) << "Indices aren't unique";
+        }
+    }
+}
+
+TEST(avx512_argsort_bf16, test_argselect)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    for (int64_t size = 1; size <= 1024; ++size) {
+        std::vector<uint16_t> arr = get_rand_bf16_array(size);
+        std::vector<uint16_t> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end(), bf16_less);
+        int64_t k = rand() % size;
+        std::vector<int64_t> inx = avx512_argselect_bf16(arr.data(), k, size);
+        ASSERT_EQ(bf16_to_float(sortedarr[k]), bf16_to_float(arr[inx[k]]))
+                << "Array size = " << size;
+        for (int64_t jj = 0; jj < k; ++jj) {
+            ASSERT_FALSE(bf16_less(arr[inx[k]], arr[inx[jj]]));
+        }
+        for (int64_t jj = k + 1; jj < size; ++jj) {
+            ASSERT_FALSE(bf16_less(arr[inx[jj]], arr[inx[k]]));
+        }
+    }
+}
@@ -0,0 +1,111 @@
+/*******************************************
+ * * Copyright (C) 2023 Intel Corporation
+ * * SPDX-License-Identifier: BSD-3-Clause
+ * *******************************************/
+
+/*
+ * Built with -march=skylake-avx512 to test the 16-bit sorting routines
+ * without AVX512_VBMI2. Calls the static xss_* routines so the linker can't
+ * swap in the avx512_qsort<T> instantiations compiled with VBMI2 elsewhere.
+ */
+#include "avx512-16bit-qsort.hpp"
+
+#include "rand_array.h"
+#include <gtest/gtest.h>
+
+#ifdef __AVX512VBMI2__
+#error "test-qsort-bw.cpp must be compiled without AVX512_VBMI2"
+#endif
+
+template <typename T>
+class avx512bw_sort : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(avx512bw_sort);
+
+TYPED_TEST_P(avx512bw_sort, test_compressstore)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    std::vector<TypeParam> arr = get_uniform_rand_array<TypeParam>(32);
+    __m512i x = _mm512_loadu_si512(arr.data());
+    for (int ii = 0; ii < 1024; ++ii) {
+        __mmask32 mask = (ii == 0) ? 0xFFFFFFFF : (uint32_t)rand();
+        std::vector<TypeParam> expected(32, 0), out(32, 0);
+        int64_t jj = 0;
+        for (int64_t kk = 0; kk < 32; ++kk) {
+            if ((mask >> kk) & 1) { expected[jj++] = arr[kk]; }
+        }
+        avx512_emu_mask_compressstoreu16(out.data(), mask, x);
+        ASSERT_EQ(expected, out) << "mask = " << mask;
+    }
+}
+
+TYPED_TEST_P(avx512bw_sort, test_random)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    for (int64_t size = 0; size < 1024; ++size) {
+        std::vector<TypeParam> arr = get_uniform_rand_array<TypeParam>(size);
+        std::vector<TypeParam> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        xss_qsort<zmm_vector<TypeParam>, TypeParam>(arr.data(), size);
+        ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+    }
+}
+
+TYPED_TEST_P(avx512bw_sort, test_select)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    for (int64_t size = 1; size < 1024; ++size) {
+        std::vector<TypeParam> arr = get_uniform_rand_array<TypeParam>(size);
+        std::vector<TypeParam> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        int64_t k = rand() % size;
+        xss_qselect<zmm_vector<TypeParam>, TypeParam>(
+                arr.data(), k, size, false);
+        ASSERT_EQ(sortedarr[k], arr[k]) << "Array size = " << size;
+    }
+}
+
+TYPED_TEST_P(avx512bw_sort, test_histogram_sort)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    for (int64_t size = 0; size < 1024; ++size) {
+        std::vector<TypeParam> arr = get_uniform_rand_array<TypeParam>(size);
+        std::vector<TypeParam> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        avx512_histogram_sort_16bit(arr.data(), size);
+        ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+    }
+    /* Above the threshold xss_qsort switches to the counting sort */
+    const int64_t threshold = zmm_vector<TypeParam>::histogram_sort_threshold;
+    for (int64_t size : {threshold + 1, threshold + 33, 4 * threshold + 7}) {
+        std::vector<TypeParam> arr = get_uniform_rand_array<TypeParam>(size);
+        std::vector<TypeParam> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        xss_qsort<zmm_vector<TypeParam>, TypeParam>(arr.data(), size);
+        ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+        /* a handful of values, in long runs */
+        arr = get_uniform_rand_array<TypeParam>(size, 10, 0);
+        sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        xss_qsort<zmm_vector<TypeParam>, TypeParam>(arr.data(), size);
+        ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(avx512bw_sort,
+                            test_compressstore,
+                            test_random,
+                            test_select,
+                            test_histogram_sort);
+
+using QSortBWTestTypes = testing::Types<uint16_t, int16_t>;
+
+INSTANTIATE_TYPED_TEST_SUITE_P(T, avx512bw_sort, QSortBWTestTypes);
@@ -0,0 +1,114 @@
+/*******************************************
+ * * Copyright (C) 2023 Intel Corporation
+ * * SPDX-License-Identifier: BSD-3-Clause
+ * *******************************************/
+
+#include "avx512-complex-argsort.hpp"
+
+#include "rand_array.h"
+#include <gtest/gtest.h>
+
+/*
+ * Values with few distinct real parts, so that the imaginary parts decide
+ * many of the compares, and every NaN combination when withnan is set
+ */
+template <typename T>
+static std::vector<std::complex<T>> get_rand_complex_array(int64_t arrsize,
+                                                           bool withnan)
+{
+    std::vector<std::complex<T>> arr(arrsize);
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+    const T inf = std::numeric_limits<T>::infinity();
+    for (int64_t ii = 0; ii < arrsize; ++ii) {
+        T re = (T)(rand() % 15 - 7);
+        T im = (T)(rand() % 1000 - 500) / (T)7;
+        arr[ii] = std::complex<T>(re, im);
+        if (ii % 89 == 3) { arr[ii] = arr[ii / 2]; }
+        if (ii % 97 == 5) { arr[ii] = std::complex<T>(inf, -inf); }
+        if (withnan && ii % 13 == 1) {
+            switch (ii % 3) {
+                case 0: arr[ii] = std::complex<T>(re, nan); break;
+                case 1: arr[ii] = std::complex<T>(nan, im); break;
+                default: arr[ii] = std::complex<T>(nan, nan);
+            }
+        }
+    }
+    return arr;
+}
+
+/* Compares bit patterns, so that NaN's compare equal */
+template <typename T>
+static bool same_values(const std::vector<std::complex<T>> &a,
+                        const std::vector<std::complex<T>> &b)
+{
+    return a.size() == b.size()
+            && (a.empty()
+                || std::memcmp(a.data(), b.data(), a.size() * sizeof(a[0]))
+                        == 0);
+}
+
+template <typename T>
+class avx512_sort_complex : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(avx512_sort_complex);
+
+TYPED_TEST_P(avx512_sort_complex, test_random)
+{
+    if (!__builtin_cpu_supports("avx512dq")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512dq";
+    }
+    for (bool withnan : {false, true}) {
+        for (int64_t size = 0; size < 1024; ++size) {
+            auto arr = get_rand_complex_array<TypeParam>(size, withnan);
+            auto sortedarr = arr;
+            std::sort(sortedarr.begin(),
+                      sortedarr.end(),
+                      complex_lt<TypeParam>);
+            avx512_qsort(arr.data(), arr.size());
+            ASSERT_TRUE(same_values(sortedarr, arr))
+                    << "Array size = " << size;
+        }
+        for (int64_t size : {10000, 100003}) {
+            auto arr = get_rand_complex_array<TypeParam>(size, withnan);
+            auto sortedarr = arr;
+            std::sort(sortedarr.begin(),
+                      sortedarr.end(),
+                      complex_lt<TypeParam>);
+            avx512_qsort(arr.data(), arr.size());
+            ASSERT_TRUE(same_values(sortedarr, arr))
+                    << "Array size = " << size;
+        }
+    }
+}
+
+TYPED_TEST_P(avx512_sort_complex, test_argsort)
+{
+    if (!__builtin_cpu_supports("avx512dq")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512dq";
+    }
+    for (bool withnan : {false, true}) {
+        for (int64_t size : {0, 1, 2, 7, 31, 64, 255, 256, 1000, 10000}) {
+            auto arr = get_rand_complex_array<TypeParam>(size, withnan);
+            auto sortedarr = arr;
+            std::sort(sortedarr.begin(),
+                      sortedarr.end(),
+                      complex_lt<TypeParam>);
+            std::vector<int64_t> arg = avx512_argsort(arr.data(), arr.size());
+            decltype(arr) argsorted;
+            for (auto ii : arg) {
+                argsorted.push_back(arr[ii]);
+            }
+            ASSERT_TRUE(same_values(sortedarr, argsorted))
+                    << "Array size = " << size;
+            std::sort(arg.begin(), arg.end());
+            for (int64_t ii = 0; ii < size; ++ii) {
+                ASSERT_EQ(arg[ii], ii) << "Indices aren't unique";
+            }
+        }
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(avx512_sort_complex, test_random, test_argsort);
+
+using QSortComplexTestTypes = testing::Types<float, double>;
+INSTANTIATE_TYPED_TEST_SUITE_P(T, avx512_sort_complex, QSortComplexTestTypes);
@@ -0,0 +1,136 @@
+/*******************************************
+ * * Copyright (C) 2023 Intel Corporation
+ * * SPDX-License-Identifier: BSD-3-Clause
+ * *******************************************/
+
+#include "avx512-64bit-argsort.hpp"
+#include "avx512-64bit-qsort.hpp"
+
+#include "rand_array.h"
+#include <gtest/gtest.h>
+
+static const int64_t nat = X86_SIMD_SORT_NAT;
+
+/* NaT's at random positions, and INT64_MAX to tell them apart from the end */
+static std::vector<int64_t> get_rand_datetime_array(int64_t arrsize,
+                                                    int num_nat)
+{
+    std::vector<int64_t> arr = get_uniform_rand_array<int64_t>(arrsize);
+    for (int64_t ii = 0; ii < arrsize; ++ii) {
+        if (ii % 61 == 7) { arr[ii] = X86_SIMD_SORT_MAX_INT64; }
+    }
+    for (int ii = 0; ii < num_nat && arrsize > 0; ++ii) {
+        arr[rand() % arrsize] = nat;
+    }
+    return arr;
+}
+
+/* Sorted with NaT's at the end, as in NumPy */
+static std::vector<int64_t> std_sort_datetime(std::vector<int64_t> arr)
+{
+    auto end = std::stable_partition(
+            arr.begin(), arr.end(), [](int64_t x) { return x != nat; });
+    std::sort(arr.begin(), end);
+    return arr;
+}
+
+TEST(avx512_sort_datetime, test_random)
+{
+    if (!__builtin_cpu_supports("avx512dq")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512dq";
+    }
+    for (int num_nat : {0, 1, 5, 300}) {
+        for (int64_t size = 0; size < 1024; ++size) {
+            std::vector<int64_t> arr = get_rand_datetime_array(size, num_nat);
+            std::vector<int64_t> sortedarr = std_sort_datetime(arr);
+            avx512_qsort_datetime(arr.data(), arr.size());
+            ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+        }
+        std::vector<int64_t> arr = get_rand_datetime_array(100003, num_nat);
+        std::vector<int64_t> sortedarr = std_sort_datetime(arr);
+        avx512_qsort_datetime(arr.data(), arr.size());
+        ASSERT_EQ(sortedarr, arr);
+    }
+}
+
+TEST(avx512_sort_datetime, test_select)
+{
+    if (!__builtin_cpu_supports("avx512dq")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512dq";
+    }
+    for (int num_nat : {0, 1, 5, 300}) {
+        for (int64_t size = 1; size <= 1024; ++size) {
+            std::vector<int64_t> arr = get_rand_datetime_array(size, num_nat);
+            std::vector<int64_t> sortedarr = std_sort_datetime(arr);
+            int64_t k = rand() % size;
+            std::vector<int64_t> psortedarr = arr;
+            avx512_qselect_datetime(psortedarr.data(), k, size);
+            ASSERT_EQ(sortedarr[k], psortedarr[k]) << "Array size = " << size;
+            /* everything after k is either NaT or not smaller */
+            for (int64_t jj = k + 1; jj < size; ++jj) {
+                ASSERT_TRUE(psortedarr[jj] == nat
+                            || (sortedarr[k] != nat
+                                && psortedarr[jj] >= sortedarr[k]));
+            }
+            psortedarr = arr;
+            avx512_partial_qsort_datetime(psortedarr.data(), k + 1, size);
+            psortedarr.resize(k + 1);
+            sortedarr.resize(k + 1);
+            ASSERT_EQ(sortedarr, psortedarr) << "Array size = " << size;
+        }
+    }
+}
+
+TEST(avx512_sort_datetime, test_argsort)
+{
+    if (!__builtin_cpu_supports("avx512dq")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512dq";
+    }
+    for (int num_nat : {0, 1, 5, 300}) {
+        for (int64_t size : {0, 1, 2, 9, 64, 255, 1000, 10000}) {
+            std::vector<int64_t> arr = get_rand_datetime_array(size, num_nat);
+            std::vector<int64_t> sortedarr = std_sort_datetime(arr);
+            std::vector<int64_t> arg
+                    = avx512_argsort_datetime(arr.data(), arr.size());
+            for (int64_t jj = 0; jj < size; ++jj) {
+                ASSERT_EQ(sortedarr[jj], arr[arg[jj]])
+                        << "Array size = " << size;
+            }
+            std::sort(arg.begin(), arg.end());
+            for (int64_t jj = 0; jj < size; ++jj) {
+                ASSERT_EQ(arg[jj], jj) << "Indices aren't unique";
+            }
+            if (size == 0) { continue; }
+            int64_t k = rand() % size;
+            arg = avx512_argselect_datetime(arr.data(), k, arr.size());
+            ASSERT_EQ(sortedarr[k], arr[arg[k]]) << "Array size = " << size;
+        }
+    }
+}
+
+/* Indices passed in by the caller, in any order, are moved with the NaT's */
+TEST(avx512_sort_datetime, test_argsort_shuffled_args)
+{
+    if (!__builtin_cpu_supports("avx512dq")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512dq";
+    }
+    for (int num_nat : {1, 5, 300}) {
+        for (int64_t size : {1, 2, 9, 64, 255, 1000, 10000}) {
+            std::vector<int64_t> arr = get_rand_datetime_array(size, num_nat);
+            std::vector<int64_t> sortedarr = std_sort_datetime(arr);
+            std::vector<int64_t> arg(size);
+            std::iota(arg.begin(), arg.end(), 0);
+            std::reverse(arg.begin(), arg.end());
+            std::swap(arg[0], arg[size / 2]);
+            avx512_argsort_datetime(arr.data(), arg.data(), size);
+            for (int64_t jj = 0; jj < size; ++jj) {
+                ASSERT_EQ(sortedarr[jj], arr[arg[jj]])
+                        << "Array size = " << size;
+            }
+            std::sort(arg.begin(), arg.end());
+            for (int64_t jj = 0; jj < size; ++jj) {
+                ASSERT_EQ(arg[jj], jj) << "Indices aren't unique";
+            }
+        }
+    }
+}
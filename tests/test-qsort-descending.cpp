@@ -0,0 +1,246 @@
+/*******************************************
+ * * Copyright (C) 2023 Intel Corporation
+ * * SPDX-License-Identifier: BSD-3-Clause
+ * *******************************************/
+
+#include "avx512-128bit-qsort.hpp"
+#include "avx512-16bit-argsort.hpp"
+#include "avx512-16bit-keyvaluesort.hpp"
+#include "avx512-32bit-keyvaluesort.hpp"
+#include "avx512-64bit-keyvaluesort.hpp"
+#include "avx512-8bit-qsort.hpp"
+#include "avx512-complex-argsort.hpp"
+
+#include "rand_array.h"
+#include <gtest/gtest.h>
+
+/* Random values with repeats, the extremes of T and, for floats, NaN's */
+template <typename T>
+static std::vector<T> get_rand_descending_array(int64_t arrsize)
+{
+    std::vector<T> arr = get_uniform_rand_array<T>(arrsize);
+    for (int64_t ii = 0; ii < arrsize; ++ii) {
+        if constexpr (std::is_floating_point_v<T>) {
+            if (ii % 2 == 1) { arr[ii] = -arr[ii]; }
+            if (ii % 29 == 7) {
+                arr[ii] = std::numeric_limits<T>::quiet_NaN();
+            }
+            if (ii % 37 == 11) {
+                arr[ii] = std::numeric_limits<T>::infinity();
+            }
+        }
+        if (ii % 41 == 13) { arr[ii] = std::numeric_limits<T>::lowest(); }
+        if (ii % 43 == 17) { arr[ii] = std::numeric_limits<T>::max(); }
+        if (ii % 7 == 3) { arr[ii] = arr[ii / 2]; }
+    }
+    return arr;
+}
+
+template <typename T>
+static bool is_nan(T x)
+{
+    return x != x;
+}
+
+/* Same value, NaN's included */
+template <typename T>
+static bool same_value(T a, T b)
+{
+    return a == b || (is_nan(a) && is_nan(b));
+}
+
+/* Descending order with the NaN's at the end */
+template <typename T>
+static bool greater_nan_last(T a, T b)
+{
+    if (is_nan(a) || is_nan(b)) { return !is_nan(a) && is_nan(b); }
+    return a > b;
+}
+
+template <typename T>
+static std::vector<T> sort_descending(std::vector<T> arr)
+{
+    std::sort(arr.begin(), arr.end(), greater_nan_last<T>);
+    return arr;
+}
+
+template <typename T>
+static std::vector<int64_t> get_sizes()
+{
+    std::vector<int64_t> sizes;
+    for (int64_t size = 0; size < 1024; ++size) {
+        sizes.push_back(size);
+    }
+    sizes.push_back(10007);
+    /* 16-bit arrays above 1 << 17 elements are counting sorted */
+    if constexpr (sizeof(T) == 2) { sizes.push_back(300000); }
+    return sizes;
+}
+
+template <typename T>
+class avx512_sort_descending : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(avx512_sort_descending);
+
+TYPED_TEST_P(avx512_sort_descending, test_qsort)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    for (int64_t size : get_sizes<TypeParam>()) {
+        std::vector<TypeParam> arr = get_rand_descending_array<TypeParam>(size);
+        std::vector<TypeParam> sortedarr = sort_descending(arr);
+        avx512_qsort(arr.data(), size, true);
+        for (int64_t ii = 0; ii < size; ++ii) {
+            ASSERT_TRUE(same_value(sortedarr[ii], arr[ii]))
+                    << "Array size = " << size << ", index = " << ii;
+        }
+    }
+}
+
+TYPED_TEST_P(avx512_sort_descending, test_select_partial)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    for (int64_t size = 1; size <= 1024; ++size) {
+        std::vector<TypeParam> arr = get_rand_descending_array<TypeParam>(size);
+        std::vector<TypeParam> sortedarr = sort_descending(arr);
+        int64_t k = rand() % size;
+        std::vector<TypeParam> psortedarr = arr;
+        avx512_qselect(psortedarr.data(), k, size, true, true);
+        ASSERT_TRUE(same_value(sortedarr[k], psortedarr[k]))
+                << "Array size = " << size;
+        for (int64_t jj = 0; jj < size; ++jj) {
+            if (jj < k) {
+                ASSERT_FALSE(greater_nan_last(psortedarr[k], psortedarr[jj]));
+            }
+            if (jj > k) {
+                ASSERT_FALSE(greater_nan_last(psortedarr[jj], psortedarr[k]));
+            }
+        }
+        psortedarr = arr;
+        avx512_partial_qsort(psortedarr.data(), k + 1, size, true, true);
+        for (int64_t jj = 0; jj <= k; ++jj) {
+            ASSERT_TRUE(same_value(sortedarr[jj], psortedarr[jj]))
+                    << "Array size = " << size << ", index = " << jj;
+        }
+    }
+}
+
+TYPED_TEST_P(avx512_sort_descending, test_argsort_argselect)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    for (int64_t size : get_sizes<TypeParam>()) {
+        std::vector<TypeParam> arr = get_rand_descending_array<TypeParam>(size);
+        std::vector<TypeParam> sortedarr = sort_descending(arr);
+        std::vector<int64_t> arg = avx512_argsort(arr.data(), size, true);
+        for (int64_t ii = 0; ii < size; ++ii) {
+            ASSERT_TRUE(same_value(sortedarr[ii], arr[arg[ii]]))
+                    << "Array size = " << size << ", index = " << ii;
+        }
+        if (size == 0) { continue; }
+        int64_t k = rand() % size;
+        arg = avx512_argselect(arr.data(), k, size, true);
+        ASSERT_TRUE(same_value(sortedarr[k], arr[arg[k]]))
+                << "Array size = " << size;
+        for (int64_t jj = 0; jj < size; ++jj) {
+            if (jj < k) {
+                ASSERT_FALSE(greater_nan_last(arr[arg[k]], arr[arg[jj]]));
+            }
+            if (jj > k) {
+                ASSERT_FALSE(greater_nan_last(arr[arg[jj]], arr[arg[k]]));
+            }
+        }
+    }
+}
+
+TYPED_TEST_P(avx512_sort_descending, test_keyvalue)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    for (int64_t size : get_sizes<TypeParam>()) {
+        std::vector<TypeParam> keys
+                = get_rand_descending_array<TypeParam>(size);
+        std::vector<uint64_t> values(size);
+        std::iota(values.begin(), values.end(), 0);
+        std::vector<TypeParam> sortedkeys = sort_descending(keys);
+        std::vector<TypeParam> origkeys = keys;
+        avx512_qsort_kv(keys.data(), values.data(), size, true);
+        std::vector<uint64_t> sortedvalues = values;
+        std::sort(sortedvalues.begin(), sortedvalues.end());
+        for (int64_t ii = 0; ii < size; ++ii) {
+            ASSERT_TRUE(same_value(sortedkeys[ii], keys[ii]))
+                    << "Array size = " << size << ", index = " << ii;
+            ASSERT_EQ(sortedvalues[ii], (uint64_t)ii);
+            if (!is_nan(keys[ii])) {
+                ASSERT_EQ(keys[ii], origkeys[values[ii]]);
+            }
+        }
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(avx512_sort_descending,
+                            test_qsort,
+                            test_select_partial,
+                            test_argsort_argselect,
+                            test_keyvalue);
+
+using QSortDescendingTestTypes = testing::Types<int16_t,
+                                                uint16_t,
+                                                int32_t,
+                                                uint32_t,
+                                                float,
+                                                int64_t,
+                                                uint64_t,
+                                                double>;
+INSTANTIATE_TYPED_TEST_SUITE_P(T,
+                               avx512_sort_descending,
+                               QSortDescendingTestTypes);
+
+/* The dtypes with their own sorting routines */
+TEST(avx512_sort_descending_other, test_8bit_128bit_complex)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    for (int64_t size : {0, 1, 100, 1000, 10007}) {
+        std::vector<int8_t> arr8 = get_uniform_rand_array<int8_t>(size);
+        std::vector<int8_t> sorted8 = arr8;
+        std::sort(sorted8.begin(), sorted8.end(), std::greater<int8_t>());
+        avx512_qsort(arr8.data(), size, true);
+        ASSERT_EQ(sorted8, arr8) << "Array size = " << size;
+
+        std::vector<unsigned __int128> arr128(size);
+        for (int64_t ii = 0; ii < size; ++ii) {
+            arr128[ii] = (unsigned __int128)(rand() % 64) << 64 | rand();
+        }
+        std::vector<unsigned __int128> sorted128 = arr128;
+        std::sort(sorted128.begin(),
+                  sorted128.end(),
+                  std::greater<unsigned __int128>());
+        avx512_qsort(arr128.data(), size, true);
+        ASSERT_TRUE(sorted128 == arr128) << "Array size = " << size;
+
+        std::vector<std::complex<double>> arrc(size);
+        for (int64_t ii = 0; ii < size; ++ii) {
+            arrc[ii] = std::complex<double>(rand() % 15, rand() % 1000);
+        }
+        std::vector<std::complex<double>> sortedc = arrc;
+        std::sort(sortedc.begin(),
+                  sortedc.end(),
+                  [](std::complex<double> a, std::complex<double> b) {
+                      return complex_lt(b, a);
+                  });
+        std::vector<std::complex<double>> argc = arrc;
+        avx512_qsort(arrc.data(), size, true);
+        ASSERT_EQ(sortedc, arrc) << "Array size = " << size;
+        std::vector<int64_t> arg = avx512_argsort(argc.data(), size, true);
+        for (int64_t ii = 0; ii < size; ++ii) {
+            ASSERT_EQ(sortedc[ii], argc[arg[ii]]) << "Array size = " << size;
+        }
+    }
+}
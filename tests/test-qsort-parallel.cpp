@@ -0,0 +1,179 @@
+/*******************************************
+ * * Copyright (C) 2023 Intel Corporation
+ * * SPDX-License-Identifier: BSD-3-Clause
+ * *******************************************/
+
+#include "avx512-16bit-qsort.hpp"
+#include "avx512-32bit-qsort.hpp"
+#include "avx512-64bit-qsort.hpp"
+#include "avx512-parallel-qsort.hpp"
+
+#include "rand_array.h"
+#include <gtest/gtest.h>
+#include <future>
+
+template <typename T>
+static std::vector<T> get_parallel_test_array(int64_t arrsize,
+                                              std::string arrtype)
+{
+    std::vector<T> arr;
+    if (arrtype == "random") { arr = get_uniform_rand_array<T>(arrsize); }
+    else if (arrtype == "duplicates") {
+        std::vector<T> values = get_uniform_rand_array<T>(10);
+        for (int64_t ii = 0; ii < arrsize; ++ii) {
+            arr.push_back(values[rand() % 10]);
+        }
+    }
+    else if (arrtype == "sorted") {
+        arr = get_uniform_rand_array<T>(arrsize);
+        std::sort(arr.begin(), arr.end());
+    }
+    else if (arrtype == "constant") {
+        arr = std::vector<T>(arrsize, get_uniform_rand_array<T>(1)[0]);
+    }
+    if constexpr (std::is_floating_point_v<T>) {
+        if (arrtype == "random") {
+            for (int64_t ii = 0; ii < arrsize; ii += 1001) {
+                arr[ii] = std::numeric_limits<T>::quiet_NaN();
+            }
+        }
+    }
+    return arr;
+}
+
+/* Compares with avx512_qsort, NaN's included */
+template <typename T>
+static void check_parallel_qsort(xss_executor &executor, int64_t arrsize)
+{
+    for (std::string arrtype : {"random", "duplicates", "sorted", "constant"}) {
+        for (bool descending : {false, true}) {
+            std::vector<T> arr = get_parallel_test_array<T>(arrsize, arrtype);
+            std::vector<T> sortedarr = arr;
+            avx512_qsort<T>(sortedarr.data(), arrsize, descending);
+            avx512_qsort_parallel<T>(arr.data(), arrsize, executor, descending);
+            ASSERT_EQ(std::memcmp(arr.data(), sortedarr.data(),
+                                  arrsize * sizeof(T)),
+                      0)
+                    << "Array size = " << arrsize << ", " << arrtype;
+        }
+    }
+}
+
+/* Runs every task on a thread of its own */
+struct thread_per_task_executor : public xss_executor {
+    ~thread_per_task_executor() override
+    {
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+    }
+    int concurrency() const override
+    {
+        return 6;
+    }
+    void submit(std::function<void()> task) override
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        threads.emplace_back(std::move(task));
+    }
+    std::mutex lock;
+    std::vector<std::thread> threads;
+};
+
+/* Runs every task right away on the submitting thread */
+struct inline_executor : public xss_executor {
+    int concurrency() const override
+    {
+        return 16;
+    }
+    void submit(std::function<void()> task) override
+    {
+        task();
+    }
+};
+
+template <typename T>
+class avx512_qsort_parallel_test : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(avx512_qsort_parallel_test);
+
+TYPED_TEST_P(avx512_qsort_parallel_test, test_thread_pool)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    xss_thread_pool pool(4);
+    for (int64_t size : {0,
+                         1000,
+                         XSS_PARALLEL_CUTOFF,
+                         XSS_PARALLEL_CUTOFF + 1,
+                         400009,
+                         1 << 21}) {
+        check_parallel_qsort<TypeParam>(pool, size);
+    }
+}
+
+TYPED_TEST_P(avx512_qsort_parallel_test, test_executors)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    thread_per_task_executor threads;
+    check_parallel_qsort<TypeParam>(threads, 500000);
+    inline_executor inline_tasks;
+    check_parallel_qsort<TypeParam>(inline_tasks, 500000);
+    check_parallel_qsort<TypeParam>(xss_default_executor(), 500000);
+}
+
+REGISTER_TYPED_TEST_SUITE_P(avx512_qsort_parallel_test,
+                            test_thread_pool,
+                            test_executors);
+
+using QSortParallelTestTypes = testing::Types<int16_t,
+                                              uint16_t,
+                                              int32_t,
+                                              uint32_t,
+                                              float,
+                                              int64_t,
+                                              uint64_t,
+                                              double>;
+INSTANTIATE_TYPED_TEST_SUITE_P(T,
+                               avx512_qsort_parallel_test,
+                               QSortParallelTestTypes);
+
+/*
+ * Sorts called from every worker of a pool at once: the workers have to run
+ * the queued tasks while they wait, nobody else will
+ */
+TEST(avx512_qsort_parallel, test_called_from_pool)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    const int num_threads = 2;
+    const int64_t arrsize = 4 * XSS_PARALLEL_CUTOFF + 7;
+    xss_thread_pool pool(num_threads);
+    std::vector<std::vector<int64_t>> arrs;
+    std::vector<std::promise<void>> sorted(num_threads);
+    for (int ii = 0; ii < num_threads; ++ii) {
+        arrs.push_back(get_uniform_rand_array<int64_t>(arrsize));
+    }
+    std::vector<std::vector<int64_t>> sortedarrs = arrs;
+    std::atomic<int> started {0};
+    for (int ii = 0; ii < num_threads; ++ii) {
+        std::sort(sortedarrs[ii].begin(), sortedarrs[ii].end());
+        pool.submit([&, ii]() {
+            /* every worker is in a task before any sort starts */
+            started += 1;
+            while (started < num_threads) {
+                std::this_thread::yield();
+            }
+            avx512_qsort_parallel<int64_t>(arrs[ii].data(), arrsize, pool);
+            sorted[ii].set_value();
+        });
+    }
+    for (int ii = 0; ii < num_threads; ++ii) {
+        sorted[ii].get_future().wait();
+        ASSERT_EQ(sortedarrs[ii], arrs[ii]);
+    }
+}
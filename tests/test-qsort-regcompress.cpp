@@ -0,0 +1,99 @@
+/*******************************************
+ * * Copyright (C) 2023 Intel Corporation
+ * * SPDX-License-Identifier: BSD-3-Clause
+ * *******************************************/
+
+/*
+ * Tests the compress-to-register partitioning used on AMD Zen4. Calls the
+ * static xss_* routines with zmm_vector_regcompress, since the avx512_*
+ * entry points only use it when built with XSS_AVX512_COMPRESS_TO_REGISTER.
+ */
+#include "avx512-16bit-qsort.hpp"
+#include "avx512-32bit-qsort.hpp"
+#include "avx512-64bit-qsort.hpp"
+
+#include "rand_array.h"
+#include <gtest/gtest.h>
+
+template <typename T>
+class avx512_regcompress_sort : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(avx512_regcompress_sort);
+
+TYPED_TEST_P(avx512_regcompress_sort, test_random)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    if ((sizeof(TypeParam) == 2)
+        && (!__builtin_cpu_supports("avx512vbmi2"))) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512_vbmi2";
+    }
+    using vtype = zmm_vector_regcompress<zmm_vector<TypeParam>>;
+    for (int64_t size = 0; size < 1024; ++size) {
+        std::vector<TypeParam> arr = get_uniform_rand_array<TypeParam>(size);
+        std::vector<TypeParam> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        xss_qsort<vtype, TypeParam>(arr.data(), size);
+        ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+    }
+}
+
+TYPED_TEST_P(avx512_regcompress_sort, test_small_range)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    if ((sizeof(TypeParam) == 2)
+        && (!__builtin_cpu_supports("avx512vbmi2"))) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512_vbmi2";
+    }
+    using vtype = zmm_vector_regcompress<zmm_vector<TypeParam>>;
+    for (int64_t size = 1024; size < 50000; size += 7919) {
+        /* lots of duplicates, exercises every number of lanes >= pivot */
+        std::vector<TypeParam> arr
+                = get_uniform_rand_array<TypeParam>(size, 10, 0);
+        std::vector<TypeParam> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        xss_qsort<vtype, TypeParam>(arr.data(), size);
+        ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+    }
+}
+
+TYPED_TEST_P(avx512_regcompress_sort, test_select)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    if ((sizeof(TypeParam) == 2)
+        && (!__builtin_cpu_supports("avx512vbmi2"))) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512_vbmi2";
+    }
+    using vtype = zmm_vector_regcompress<zmm_vector<TypeParam>>;
+    for (int64_t size = 1; size < 1024; ++size) {
+        std::vector<TypeParam> arr = get_uniform_rand_array<TypeParam>(size);
+        std::vector<TypeParam> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        int64_t k = rand() % size;
+        xss_qselect<vtype, TypeParam>(arr.data(), k, size, false);
+        ASSERT_EQ(sortedarr[k], arr[k]) << "Array size = " << size;
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(avx512_regcompress_sort,
+                            test_random,
+                            test_small_range,
+                            test_select);
+
+using QSortRegCompressTestTypes = testing::Types<uint16_t,
+                                                 int16_t,
+                                                 float,
+                                                 double,
+                                                 uint32_t,
+                                                 int32_t,
+                                                 uint64_t,
+                                                 int64_t>;
+
+INSTANTIATE_TYPED_TEST_SUITE_P(T,
+                               avx512_regcompress_sort,
+                               QSortRegCompressTestTypes);
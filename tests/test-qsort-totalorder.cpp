@@ -0,0 +1,219 @@
+/*******************************************
+ * * Copyright (C) 2023 Intel Corporation
+ * * SPDX-License-Identifier: BSD-3-Clause
+ * *******************************************/
+
+#include "avx512-totalorder-qsort.hpp"
+
+#include "rand_array.h"
+#include <gtest/gtest.h>
+
+/* uint16_t stands for half */
+template <typename T>
+struct totalorder_test_traits {
+    using uint_t = uint16_t;
+    static constexpr int mantissa_bits = 10;
+};
+
+template <>
+struct totalorder_test_traits<float> {
+    using uint_t = uint32_t;
+    static constexpr int mantissa_bits = 23;
+};
+
+template <>
+struct totalorder_test_traits<double> {
+    using uint_t = uint64_t;
+    static constexpr int mantissa_bits = 52;
+};
+
+static void sort_totalorder(float *arr, int64_t size, bool nans_first)
+{
+    avx512_qsort_totalorder(arr, size, nans_first);
+}
+static void sort_totalorder(double *arr, int64_t size, bool nans_first)
+{
+    avx512_qsort_totalorder(arr, size, nans_first);
+}
+static void sort_totalorder(uint16_t *arr, int64_t size, bool nans_first)
+{
+    avx512_qsort_fp16_totalorder(arr, size, nans_first);
+}
+static void
+select_totalorder(float *arr, int64_t k, int64_t size, bool nans_first)
+{
+    avx512_qselect_totalorder(arr, k, size, nans_first);
+}
+static void
+select_totalorder(double *arr, int64_t k, int64_t size, bool nans_first)
+{
+    avx512_qselect_totalorder(arr, k, size, nans_first);
+}
+static void
+select_totalorder(uint16_t *arr, int64_t k, int64_t size, bool nans_first)
+{
+    avx512_qselect_fp16_totalorder(arr, k, size, nans_first);
+}
+static void
+partial_sort_totalorder(float *arr, int64_t k, int64_t size, bool nans_first)
+{
+    avx512_partial_qsort_totalorder(arr, k, size, nans_first);
+}
+static void
+partial_sort_totalorder(double *arr, int64_t k, int64_t size, bool nans_first)
+{
+    avx512_partial_qsort_totalorder(arr, k, size, nans_first);
+}
+static void partial_sort_totalorder(uint16_t *arr,
+                                    int64_t k,
+                                    int64_t size,
+                                    bool nans_first)
+{
+    avx512_partial_qsort_fp16_totalorder(arr, k, size, nans_first);
+}
+
+/* Runs f on the values of bits, copied in and out of an array of T */
+template <typename T, typename U, typename F>
+static void on_values(std::vector<U> &bits, F f)
+{
+    std::vector<T> vals(bits.size());
+    if (!bits.empty()) {
+        std::memcpy(vals.data(), bits.data(), bits.size() * sizeof(U));
+    }
+    f(vals.data());
+    if (!bits.empty()) {
+        std::memcpy(bits.data(), vals.data(), bits.size() * sizeof(U));
+    }
+}
+
+/*
+ * Reference order on the bits, spelled out case by case: NaN's at one end,
+ * positive ones by increasing and negative ones by decreasing payload; the
+ * other values negative before positive, by increasing magnitude if positive
+ * and decreasing magnitude if negative
+ */
+template <typename U>
+static bool ref_less(U a, U b, bool nans_first, int mantissa_bits)
+{
+    const int nbits = 8 * sizeof(U);
+    const U sign = (U)1 << (nbits - 1);
+    const U inf = (U)(sign - ((U)1 << mantissa_bits));
+    bool a_nan = (U)(a & ~sign) > inf, b_nan = (U)(b & ~sign) > inf;
+    if (a_nan != b_nan) { return nans_first ? a_nan : b_nan; }
+    bool a_neg = a & sign, b_neg = b & sign;
+    if (a_nan) {
+        if (a_neg != b_neg) { return b_neg; }
+        return a_neg ? a > b : a < b;
+    }
+    if (a_neg != b_neg) { return a_neg; }
+    return a_neg ? a > b : a < b;
+}
+
+/* Random bits, with many NaN's, infinities and zeros of both signs */
+template <typename U>
+static std::vector<U> get_rand_bits(int64_t arrsize, int mantissa_bits)
+{
+    const int nbits = 8 * sizeof(U);
+    const U sign = (U)1 << (nbits - 1);
+    const U inf = (U)(sign - ((U)1 << mantissa_bits));
+    std::vector<U> arr(arrsize);
+    for (int64_t ii = 0; ii < arrsize; ++ii) {
+        U bits = 0;
+        for (size_t jj = 0; jj < sizeof(U); jj += 2) {
+            bits = (U)((uint64_t)bits << 16 | (rand() & 0xFFFF));
+        }
+        switch (rand() % 8) {
+            case 0: bits |= inf | 1; break;
+            case 1: bits = (bits & sign) | inf; break;
+            case 2: bits = bits & sign; break;
+            case 3: bits = ii > 0 ? arr[rand() % ii] : bits; break;
+            default: break;
+        }
+        arr[ii] = bits;
+    }
+    return arr;
+}
+
+template <typename T>
+class avx512_sort_totalorder : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(avx512_sort_totalorder);
+
+TYPED_TEST_P(avx512_sort_totalorder, test_random)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    using U = typename totalorder_test_traits<TypeParam>::uint_t;
+    const int mbits = totalorder_test_traits<TypeParam>::mantissa_bits;
+    for (bool nans_first : {false, true}) {
+        auto less = [&](U a, U b) {
+            return ref_less(a, b, nans_first, mbits);
+        };
+        std::vector<int64_t> sizes;
+        for (int64_t size = 0; size < 1024; ++size) {
+            sizes.push_back(size);
+        }
+        /* 16-bit arrays above 1 << 17 elements are counting sorted */
+        sizes.push_back(100003);
+        sizes.push_back(300000);
+        for (int64_t size : sizes) {
+            std::vector<U> arr = get_rand_bits<U>(size, mbits);
+            std::vector<U> sortedarr = arr;
+            std::sort(sortedarr.begin(), sortedarr.end(), less);
+            on_values<TypeParam>(arr, [&](TypeParam *vals) {
+                sort_totalorder(vals, size, nans_first);
+            });
+            ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+        }
+    }
+}
+
+TYPED_TEST_P(avx512_sort_totalorder, test_select_partial)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    using U = typename totalorder_test_traits<TypeParam>::uint_t;
+    const int mbits = totalorder_test_traits<TypeParam>::mantissa_bits;
+    for (bool nans_first : {false, true}) {
+        auto less = [&](U a, U b) {
+            return ref_less(a, b, nans_first, mbits);
+        };
+        for (int64_t size = 1; size <= 1024; ++size) {
+            std::vector<U> arr = get_rand_bits<U>(size, mbits);
+            std::vector<U> sortedarr = arr;
+            std::sort(sortedarr.begin(), sortedarr.end(), less);
+            int64_t k = rand() % size;
+            std::vector<U> psortedarr = arr;
+            on_values<TypeParam>(psortedarr, [&](TypeParam *vals) {
+                select_totalorder(vals, k, size, nans_first);
+            });
+            ASSERT_EQ(sortedarr[k], psortedarr[k]) << "Array size = " << size;
+            for (int64_t jj = 0; jj < size; ++jj) {
+                if (jj < k) {
+                    ASSERT_FALSE(less(psortedarr[k], psortedarr[jj]));
+                }
+                if (jj > k) {
+                    ASSERT_FALSE(less(psortedarr[jj], psortedarr[k]));
+                }
+            }
+            psortedarr = arr;
+            on_values<TypeParam>(psortedarr, [&](TypeParam *vals) {
+                partial_sort_totalorder(vals, k + 1, size, nans_first);
+            });
+            psortedarr.resize(k + 1);
+            sortedarr.resize(k + 1);
+            ASSERT_EQ(sortedarr, psortedarr) << "Array size = " << size;
+        }
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(avx512_sort_totalorder,
+                            test_random,
+                            test_select_partial);
+
+using QSortTotalOrderTestTypes = testing::Types<uint16_t, float, double>;
+INSTANTIATE_TYPED_TEST_SUITE_P(T,
+                               avx512_sort_totalorder,
+                               QSortTotalOrderTestTypes);
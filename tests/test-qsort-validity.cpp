@@ -0,0 +1,137 @@
+/*******************************************
+ * * Copyright (C) 2023 Intel Corporation
+ * * SPDX-License-Identifier: BSD-3-Clause
+ * *******************************************/
+
+#include "avx512-16bit-argsort.hpp"
+#include "avx512-32bit-qsort.hpp"
+#include "avx512-64bit-argsort.hpp"
+#include "avx512-64bit-qsort.hpp"
+
+#include "rand_array.h"
+#include <gtest/gtest.h>
+
+/* Arrow style validity bitmap with about one null in null_every values */
+static std::vector<uint8_t> get_rand_validity(int64_t arrsize, int null_every)
+{
+    std::vector<uint8_t> validity((arrsize + 7) / 8, 0);
+    for (int64_t ii = 0; ii < arrsize; ++ii) {
+        if (null_every == 0 || rand() % null_every != 0) {
+            validity[ii / 8] |= (uint8_t)(1 << (ii % 8));
+        }
+    }
+    return validity;
+}
+
+static bool is_valid(const std::vector<uint8_t> &validity, int64_t ii)
+{
+    return (validity[ii / 8] >> (ii % 8)) & 1;
+}
+
+/* Puts NaN's in the null slots, which must not be mistaken for values */
+template <typename T>
+static std::vector<T> get_rand_nullable_array(
+        int64_t arrsize, const std::vector<uint8_t> &validity)
+{
+    std::vector<T> arr = get_uniform_rand_array<T>(arrsize);
+    if constexpr (std::is_floating_point_v<T>) {
+        for (int64_t ii = 0; ii < arrsize; ++ii) {
+            if (!is_valid(validity, ii)) {
+                arr[ii] = std::numeric_limits<T>::quiet_NaN();
+            }
+        }
+    }
+    return arr;
+}
+
+template <typename T>
+class avx512_sort_validity : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(avx512_sort_validity);
+
+TYPED_TEST_P(avx512_sort_validity, test_qsort)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    for (int null_every : {0, 1, 2, 10}) {
+        for (bool nulls_first : {false, true}) {
+            for (int64_t size = 0; size < 1024; size += 1 + size / 16) {
+                std::vector<uint8_t> validity
+                        = get_rand_validity(size, null_every);
+                std::vector<TypeParam> arr
+                        = get_rand_nullable_array<TypeParam>(size, validity);
+                std::vector<TypeParam> sortedarr;
+                for (int64_t ii = 0; ii < size; ++ii) {
+                    if (is_valid(validity, ii)) {
+                        sortedarr.push_back(arr[ii]);
+                    }
+                }
+                std::sort(sortedarr.begin(), sortedarr.end());
+                int64_t num_valid = avx512_qsort(
+                        arr.data(), validity.data(), size, nulls_first);
+                ASSERT_EQ(num_valid, (int64_t)sortedarr.size());
+                int64_t begin = nulls_first ? size - num_valid : 0;
+                std::vector<TypeParam> validarr(arr.begin() + begin,
+                                                arr.begin() + begin
+                                                        + num_valid);
+                ASSERT_EQ(sortedarr, validarr) << "Array size = " << size;
+            }
+        }
+    }
+}
+
+TYPED_TEST_P(avx512_sort_validity, test_argsort)
+{
+    if (!__builtin_cpu_supports("avx512bw")) {
+        GTEST_SKIP() << "Skipping this test, it requires avx512bw";
+    }
+    for (int null_every : {0, 1, 2, 10}) {
+        for (bool nulls_first : {false, true}) {
+            for (int64_t size = 0; size < 1024; size += 1 + size / 16) {
+                std::vector<uint8_t> validity
+                        = get_rand_validity(size, null_every);
+                std::vector<TypeParam> arr
+                        = get_rand_nullable_array<TypeParam>(size, validity);
+                std::vector<TypeParam> sortedarr;
+                std::vector<int64_t> nulls;
+                for (int64_t ii = 0; ii < size; ++ii) {
+                    if (is_valid(validity, ii)) {
+                        sortedarr.push_back(arr[ii]);
+                    }
+                    else {
+                        nulls.push_back(ii);
+                    }
+                }
+                std::sort(sortedarr.begin(), sortedarr.end());
+                std::vector<int64_t> arg = avx512_argsort(
+                        arr.data(), validity.data(), size, nulls_first);
+                int64_t num_valid = sortedarr.size();
+                int64_t begin = nulls_first ? size - num_valid : 0;
+                for (int64_t ii = 0; ii < num_valid; ++ii) {
+                    ASSERT_TRUE(is_valid(validity, arg[begin + ii]));
+                    ASSERT_EQ(sortedarr[ii], arr[arg[begin + ii]])
+                            << "Array size = " << size;
+                }
+                std::vector<int64_t> nullarg(
+                        arg.begin() + (nulls_first ? 0 : num_valid),
+                        arg.begin() + (nulls_first ? size - num_valid : size));
+                ASSERT_EQ(nulls, nullarg) << "Array size = " << size;
+            }
+        }
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(avx512_sort_validity, test_qsort, test_argsort);
+
+using QSortValidityTestTypes = testing::Types<int16_t,
+                                              uint16_t,
+                                              int32_t,
+                                              uint32_t,
+                                              float,
+                                              int64_t,
+                                              uint64_t,
+                                              double>;
+INSTANTIATE_TYPED_TEST_SUITE_P(T,
+                               avx512_sort_validity,
+                               QSortValidityTestTypes);
@@ -13,10 +13,12 @@ TYPED_TEST_SUITE_P(avx512_sort);
 TYPED_TEST_P(avx512_sort, test_random)
 {
     if (__builtin_cpu_supports("avx512bw")) {
+#ifdef __AVX512VBMI2__
         if ((sizeof(TypeParam) == 2)
             && (!__builtin_cpu_supports("avx512vbmi2"))) {
             GTEST_SKIP() << "Skipping this test, it requires avx512_vbmi2";
         }
+#endif
         std::vector<int64_t> arrsizes;
         for (int64_t ii = 0; ii < 1024; ++ii) {
             arrsizes.push_back((TypeParam)ii);
@@ -43,10 +45,12 @@ TYPED_TEST_P(avx512_sort, test_random)
 TYPED_TEST_P(avx512_sort, test_reverse)
 {
     if (__builtin_cpu_supports("avx512bw")) {
+#ifdef __AVX512VBMI2__
         if ((sizeof(TypeParam) == 2)
             && (!__builtin_cpu_supports("avx512vbmi2"))) {
             GTEST_SKIP() << "Skipping this test, it requires avx512_vbmi2";
         }
+#endif
         std::vector<int64_t> arrsizes;
         for (int64_t ii = 0; ii < 1024; ++ii) {
             arrsizes.push_back((TypeParam)(ii + 1));
@@ -75,10 +79,12 @@ TYPED_TEST_P(avx512_sort, test_reverse)
 TYPED_TEST_P(avx512_sort, test_constant)
 {
     if (__builtin_cpu_supports("avx512bw")) {
+#ifdef __AVX512VBMI2__
         if ((sizeof(TypeParam) == 2)
             && (!__builtin_cpu_supports("avx512vbmi2"))) {
             GTEST_SKIP() << "Skipping this test, it requires avx512_vbmi2";
         }
+#endif
         std::vector<int64_t> arrsizes;
         for (int64_t ii = 0; ii < 1024; ++ii) {
             arrsizes.push_back((TypeParam)(ii + 1));
@@ -107,10 +113,12 @@ TYPED_TEST_P(avx512_sort, test_constant)
 TYPED_TEST_P(avx512_sort, test_small_range)
 {
     if (__builtin_cpu_supports("avx512bw")) {
+#ifdef __AVX512VBMI2__
         if ((sizeof(TypeParam) == 2)
             && (!__builtin_cpu_supports("avx512vbmi2"))) {
             GTEST_SKIP() << "Skipping this test, it requires avx512_vbmi2";
         }
+#endif
         std::vector<int64_t> arrsizes;
         for (int64_t ii = 0; ii < 1024; ++ii) {
             arrsizes.push_back((TypeParam)(ii + 1));
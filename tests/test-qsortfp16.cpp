@@ -3,12 +3,26 @@
  * * SPDX-License-Identifier: BSD-3-Clause
  * *******************************************/
 
+#include "avx512-16bit-qsort.hpp"
+#include "avx512-64bit-keyvaluesort.hpp"
+#include "avx512fp16-16bit-argsort.hpp"
 #include "avx512fp16-16bit-qsort.hpp"
 
 #include "rand_array.h"
 #include <gtest/gtest.h>
+#include <numeric>
 #include <vector>
 
+static std::vector<_Float16> get_rand_fp16_array(int64_t arrsize)
+{
+    std::vector<_Float16> arr;
+    for (int64_t ii = 0; ii < arrsize; ++ii) {
+        /* a handful of distinct values, to get some duplicates */
+        arr.push_back((_Float16)(rand() % 1000) / (_Float16)7.0f);
+    }
+    return arr;
+}
+
 TEST(avx512_qsort_float16, test_arrsizes)
 {
     if (__builtin_cpu_supports("avx512fp16")) {
@@ -159,3 +173,139 @@ TEST(avx512_partial_qsort_float16, test_ranges)
         GTEST_SKIP() << "Skipping this test, it requires avx512fp16 ISA";
     }
 }
+
+TEST(avx512_qselect_float16, test_nan)
+{
+    if (__builtin_cpu_supports("avx512fp16")) {
+        Fp16Bits nan, inf;
+        nan.i_ = 0x7e00;
+        inf.i_ = X86_SIMD_SORT_INFINITYH;
+        for (int64_t size = 2; size < 1024; ++size) {
+            std::vector<_Float16> arr = get_rand_fp16_array(size);
+            arr[rand() % size] = inf.f_;
+            arr[rand() % size] = nan.f_;
+            std::vector<_Float16> arr_bkp = arr;
+            int64_t nan_count = 0;
+            std::vector<_Float16> sortedarr;
+            for (auto val : arr) {
+                if (is_a_nan(val)) { nan_count++; }
+                else {
+                    sortedarr.push_back(val);
+                }
+            }
+            std::sort(sortedarr.begin(), sortedarr.end());
+            int64_t k = rand() % sortedarr.size();
+            avx512_qselect<_Float16>(arr.data(), k, arr.size(), true);
+            ASSERT_EQ(sortedarr[k], arr[k]) << "Array size = " << size;
+            for (int64_t jj = 0; jj < nan_count; ++jj) {
+                ASSERT_TRUE(is_a_nan(arr[size - 1 - jj]));
+            }
+            /* partial sort */
+            arr = arr_bkp;
+            avx512_partial_qsort<_Float16>(arr.data(), k + 1, arr.size(), true);
+            for (int64_t jj = 0; jj <= k; ++jj) {
+                ASSERT_EQ(sortedarr[jj], arr[jj]) << "Array size = " << size;
+            }
+        }
+    }
+    else {
+        GTEST_SKIP() << "Skipping this test, it requires avx512fp16 ISA";
+    }
+}
+
+TEST(avx512_argsort_float16, test_random)
+{
+    if (__builtin_cpu_supports("avx512fp16")) {
+        for (int64_t size = 0; size <= 1024; ++size) {
+            std::vector<_Float16> arr = get_rand_fp16_array(size);
+            std::vector<_Float16> sortedarr = arr;
+            std::sort(sortedarr.begin(), sortedarr.end());
+            std::vector<int64_t> inx
+                    = avx512_argsort<_Float16>(arr.data(), arr.size());
+            std::vector<_Float16> sort1;
+            for (auto jj = 0; jj < size; ++jj) {
+                sort1.push_back(arr[inx[jj]]);
+            }
+            ASSERT_EQ(sortedarr, sort1) << "Array size = " << size;
+            std::sort(inx.begin(), inx.end());
+            for (auto jj = 0; jj < size; ++jj) {
+                ASSERT_EQ(inx[jj], jj) << "Indices aren't unique";
+            }
+        }
+    }
+    else {
+        GTEST_SKIP() << "Skipping this test, it requires avx512fp16 ISA";
+    }
+}
+
+TEST(avx512_argsort_float16, test_nan)
+{
+    if (__builtin_cpu_supports("avx512fp16")) {
+        Fp16Bits nan;
+        nan.i_ = 0xFFFF;
+        for (int64_t size = 3; size <= 1024; ++size) {
+            std::vector<_Float16> arr = get_rand_fp16_array(size);
+            arr[0] = nan.f_;
+            arr[size / 2] = nan.f_;
+            std::vector<int64_t> inx
+                    = avx512_argsort<_Float16>(arr.data(), arr.size());
+            std::vector<_Float16> sort1;
+            for (auto jj = 0; jj < size; ++jj) {
+                sort1.push_back(arr[inx[jj]]);
+            }
+            ASSERT_TRUE(std::is_sorted(sort1.begin(), sort1.end() - 2))
+                    << "Array size = " << size;
+            ASSERT_TRUE(is_a_nan(sort1[size - 1]));
+            ASSERT_TRUE(is_a_nan(sort1[size - 2]));
+        }
+    }
+    else {
+        GTEST_SKIP() << "Skipping this test, it requires avx512fp16 ISA";
+    }
+}
+
+TEST(avx512_argselect_float16, test_random)
+{
+    if (__builtin_cpu_supports("avx512fp16")) {
+        for (int64_t size = 1; size <= 1024; ++size) {
+            std::vector<_Float16> arr = get_rand_fp16_array(size);
+            std::vector<_Float16> sortedarr = arr;
+            std::sort(sortedarr.begin(), sortedarr.end());
+            int64_t k = rand() % size;
+            std::vector<int64_t> inx
+                    = avx512_argselect<_Float16>(arr.data(), k, arr.size());
+            ASSERT_EQ(sortedarr[k], arr[inx[k]]) << "Array size = " << size;
+            for (int64_t jj = 0; jj < k; ++jj) {
+                ASSERT_LE(arr[inx[jj]], arr[inx[k]]);
+            }
+            for (int64_t jj = k + 1; jj < size; ++jj) {
+                ASSERT_GE(arr[inx[jj]], arr[inx[k]]);
+            }
+        }
+    }
+    else {
+        GTEST_SKIP() << "Skipping this test, it requires avx512fp16 ISA";
+    }
+}
+
+TEST(avx512_keyvalue_float16, test_random)
+{
+    if (__builtin_cpu_supports("avx512fp16")) {
+        for (int64_t size = 0; size <= 1024; ++size) {
+            std::vector<_Float16> keys = get_rand_fp16_array(size);
+            std::vector<uint64_t> vals(size);
+            std::iota(vals.begin(), vals.end(), 0);
+            std::vector<_Float16> orig = keys;
+            avx512_qsort_kv<_Float16, uint64_t>(
+                    keys.data(), vals.data(), keys.size());
+            ASSERT_TRUE(std::is_sorted(keys.begin(), keys.end()))
+                    << "Array size = " << size;
+            for (int64_t jj = 0; jj < size; ++jj) {
+                ASSERT_EQ(keys[jj], orig[vals[jj]]) << "Array size = " << size;
+            }
+        }
+    }
+    else {
+        GTEST_SKIP() << "Skipping this test, it requires avx512fp16 ISA";
+    }
+}
@@ -0,0 +1,268 @@
+/*******************************************
+ * * Copyright (C) 2023 Intel Corporation
+ * * SPDX-License-Identifier: BSD-3-Clause
+ * *******************************************/
+
+#include "scalar-qsort.hpp"
+
+#include "test-argsort-common.h"
+
+/*
+ * Built with baseline flags: these run on every CPU.
+ */
+template <typename T>
+class scalar_sort : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(scalar_sort);
+
+TYPED_TEST_P(scalar_sort, test_random)
+{
+    std::vector<TypeParam> arr;
+    std::vector<TypeParam> sortedarr;
+    for (int64_t size = 0; size < 1024; ++size) {
+        /* Random array */
+        arr = get_uniform_rand_array<TypeParam>(size);
+        sortedarr = arr;
+        /* Sort with std::sort for comparison */
+        std::sort(sortedarr.begin(), sortedarr.end());
+        scalar_qsort<TypeParam>(arr.data(), arr.size());
+        ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+    }
+}
+
+TYPED_TEST_P(scalar_sort, test_reverse_and_constant)
+{
+    std::vector<TypeParam> arr;
+    std::vector<TypeParam> sortedarr;
+    for (int64_t size = 1; size <= 1024; ++size) {
+        /* reverse array */
+        for (int64_t jj = 0; jj < size; ++jj) {
+            arr.push_back((TypeParam)(size - jj));
+        }
+        sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        scalar_qsort<TypeParam>(arr.data(), arr.size());
+        ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+        /* constant array */
+        std::fill(arr.begin(), arr.end(), (TypeParam)size);
+        sortedarr = arr;
+        scalar_qsort<TypeParam>(arr.data(), arr.size());
+        ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+        arr.clear();
+    }
+}
+
+TYPED_TEST_P(scalar_sort, test_small_range)
+{
+    std::vector<TypeParam> arr;
+    std::vector<TypeParam> sortedarr;
+    for (int64_t size = 0; size < 4096; size += 7) {
+        /* array with a handful of distinct values */
+        arr = get_uniform_rand_array<TypeParam>(size, 20, 1);
+        sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        scalar_qsort<TypeParam>(arr.data(), arr.size());
+        ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+    }
+}
+
+TYPED_TEST_P(scalar_sort, test_select)
+{
+    std::vector<TypeParam> arr;
+    std::vector<TypeParam> sortedarr;
+    for (int64_t size = 1; size <= 1024; ++size) {
+        arr = get_uniform_rand_array<TypeParam>(size);
+        sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        int64_t k = rand() % size;
+        scalar_qselect<TypeParam>(arr.data(), k, arr.size());
+        ASSERT_EQ(sortedarr[k], arr[k]) << "Array size = " << size;
+        ASSERT_TRUE(std::all_of(arr.begin(),
+                                arr.begin() + k,
+                                [&](TypeParam x) { return x <= arr[k]; }));
+        ASSERT_TRUE(std::all_of(arr.begin() + k,
+                                arr.end(),
+                                [&](TypeParam x) { return x >= arr[k]; }));
+    }
+}
+
+TYPED_TEST_P(scalar_sort, test_partial_qsort)
+{
+    std::vector<TypeParam> arr;
+    std::vector<TypeParam> sortedarr;
+    for (int64_t size = 1; size <= 1024; ++size) {
+        arr = get_uniform_rand_array<TypeParam>(size);
+        sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        int64_t k = 1 + rand() % size;
+        scalar_partial_qsort<TypeParam>(arr.data(), k, arr.size());
+        arr.resize(k);
+        sortedarr.resize(k);
+        ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(scalar_sort,
+                            test_random,
+                            test_reverse_and_constant,
+                            test_small_range,
+                            test_select,
+                            test_partial_qsort);
+
+template <typename T>
+class scalar_sort_fp : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(scalar_sort_fp);
+
+TYPED_TEST_P(scalar_sort_fp, test_random_nan)
+{
+    const int num_nans = 3;
+    std::vector<TypeParam> arr;
+    for (int64_t size = num_nans; size < 1024; ++size) {
+        arr = get_uniform_rand_array<TypeParam>(size);
+        for (int64_t ii = 1; ii <= num_nans; ++ii) {
+            arr[size - ii] = std::numeric_limits<TypeParam>::quiet_NaN();
+        }
+        std::random_shuffle(arr.begin(), arr.end());
+        scalar_qsort<TypeParam>(arr.data(), arr.size());
+        ASSERT_TRUE(std::is_sorted(arr.begin(), arr.end() - num_nans))
+                << "Array size = " << size;
+        for (int64_t ii = 1; ii <= num_nans; ++ii) {
+            ASSERT_TRUE(std::isnan(arr[size - ii])) << "Array size = " << size;
+        }
+    }
+}
+
+TYPED_TEST_P(scalar_sort_fp, test_select_nan)
+{
+    std::vector<TypeParam> arr;
+    for (int64_t size = 2; size <= 1024; ++size) {
+        arr = get_uniform_rand_array<TypeParam>(size);
+        arr[0] = std::numeric_limits<TypeParam>::quiet_NaN();
+        std::vector<TypeParam> sortedarr(arr.begin() + 1, arr.end());
+        std::sort(sortedarr.begin(), sortedarr.end());
+        int64_t k = rand() % (size - 1);
+        scalar_qselect<TypeParam>(arr.data(), k, arr.size(), true);
+        ASSERT_EQ(sortedarr[k], arr[k]) << "Array size = " << size;
+        ASSERT_TRUE(std::isnan(arr[size - 1])) << "Array size = " << size;
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(scalar_sort_fp, test_random_nan, test_select_nan);
+
+template <typename T>
+class scalarargsort : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(scalarargsort);
+
+TYPED_TEST_P(scalarargsort, test_random)
+{
+    std::vector<TypeParam> arr;
+    for (int64_t size = 0; size <= 1024; ++size) {
+        arr = get_uniform_rand_array<TypeParam>(size);
+        std::vector<int64_t> inx1 = std_argsort(arr);
+        std::vector<int64_t> inx2
+                = scalar_argsort<TypeParam>(arr.data(), arr.size());
+        std::vector<TypeParam> sort1, sort2;
+        for (auto jj = 0; jj < size; ++jj) {
+            sort1.push_back(arr[inx1[jj]]);
+            sort2.push_back(arr[inx2[jj]]);
+        }
+        EXPECT_EQ(sort1, sort2) << "Array size =" << size;
+        EXPECT_UNIQUE(inx2)
+    }
+}
+
+TYPED_TEST_P(scalarargsort, test_array_with_nan)
+{
+    if (!std::is_floating_point<TypeParam>::value) {
+        GTEST_SKIP() << "Skipping this test, it is meant for float/double";
+    }
+    std::vector<TypeParam> arr;
+    for (int64_t size = 2; size <= 1024; ++size) {
+        arr = get_uniform_rand_array<TypeParam>(size);
+        arr[0] = std::numeric_limits<TypeParam>::quiet_NaN();
+        arr[1] = std::numeric_limits<TypeParam>::quiet_NaN();
+        std::vector<int64_t> inx
+                = scalar_argsort<TypeParam>(arr.data(), arr.size());
+        std::vector<TypeParam> sort1;
+        for (auto jj = 0; jj < size; ++jj) {
+            sort1.push_back(arr[inx[jj]]);
+        }
+        ASSERT_TRUE(std::is_sorted(sort1.begin(), sort1.end() - 2))
+                << "Array size = " << size;
+        ASSERT_TRUE(std::isnan(sort1[size - 1]));
+        ASSERT_TRUE(std::isnan(sort1[size - 2]));
+        EXPECT_UNIQUE(inx)
+    }
+}
+
+TYPED_TEST_P(scalarargsort, test_argselect)
+{
+    std::vector<TypeParam> arr;
+    for (int64_t size = 1; size <= 1024; ++size) {
+        arr = get_uniform_rand_array<TypeParam>(size);
+        std::vector<int64_t> sorted_inx = std_argsort(arr);
+        int64_t k = rand() % size;
+        std::vector<int64_t> inx
+                = scalar_argselect<TypeParam>(arr.data(), k, arr.size());
+        ASSERT_EQ(arr[sorted_inx[k]], arr[inx[k]]) << "Array size = " << size;
+        if (k > 0) {
+            EXPECT_GE(arr[inx[k]], std_max_element(arr, inx, 0, k));
+        }
+        EXPECT_LE(arr[inx[k]], std_min_element(arr, inx, k, size));
+        EXPECT_UNIQUE(inx)
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(scalarargsort,
+                            test_random,
+                            test_array_with_nan,
+                            test_argselect);
+
+template <typename T>
+class scalar_keyvalue : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(scalar_keyvalue);
+
+TYPED_TEST_P(scalar_keyvalue, test_random)
+{
+    for (int64_t size = 0; size < 1024; ++size) {
+        std::vector<TypeParam> keys
+                = get_uniform_rand_array_with_uniquevalues<TypeParam>(size);
+        std::vector<uint64_t> values = get_uniform_rand_array<uint64_t>(size);
+        std::vector<std::pair<TypeParam, uint64_t>> sortedarr;
+        for (size_t i = 0; i < keys.size(); i++) {
+            sortedarr.emplace_back(keys[i], values[i]);
+        }
+        /* Sort with std::sort for comparison */
+        std::sort(sortedarr.begin(), sortedarr.end());
+        scalar_qsort_kv(keys.data(), values.data(), keys.size());
+        for (size_t i = 0; i < keys.size(); i++) {
+            ASSERT_EQ(keys[i], sortedarr[i].first);
+            ASSERT_EQ(values[i], sortedarr[i].second);
+        }
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(scalar_keyvalue, test_random);
+
+using QSortScalarTestTypes = testing::Types<float,
+                                            double,
+                                            uint8_t,
+                                            int8_t,
+                                            uint16_t,
+                                            int16_t,
+                                            uint32_t,
+                                            int32_t,
+                                            uint64_t,
+                                            int64_t>;
+using QSortScalarTestFPTypes = testing::Types<float, double>;
+using ArgScalarTestTypes
+        = testing::Types<int32_t, uint32_t, float, uint64_t, int64_t, double>;
+using KvScalarTestTypes = testing::Types<double, uint64_t, int64_t>;
+
+INSTANTIATE_TYPED_TEST_SUITE_P(T, scalar_sort, QSortScalarTestTypes);
+INSTANTIATE_TYPED_TEST_SUITE_P(T, scalar_sort_fp, QSortScalarTestFPTypes);
+INSTANTIATE_TYPED_TEST_SUITE_P(T, scalarargsort, ArgScalarTestTypes);
+INSTANTIATE_TYPED_TEST_SUITE_P(T, scalar_keyvalue, KvScalarTestTypes);
@@ -0,0 +1,141 @@
+/*******************************************
+ * * Copyright (C) 2023 Intel Corporation
+ * * SPDX-License-Identifier: BSD-3-Clause
+ * *******************************************/
+
+#include "x86simdsort.h"
+
+#include "rand_array.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <numeric>
+
+/*
+ * Tests for the compiled library. This file is built with baseline flags, the
+ * library picks whichever ISA the CPU supports.
+ */
+template <typename T>
+class simdsort : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(simdsort);
+
+TYPED_TEST_P(simdsort, test_qsort)
+{
+    for (int64_t size = 0; size < 1024; ++size) {
+        std::vector<TypeParam> arr = get_uniform_rand_array<TypeParam>(size);
+        std::vector<TypeParam> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        x86simdsort::qsort(arr.data(), size);
+        ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+    }
+}
+
+TYPED_TEST_P(simdsort, test_qselect)
+{
+    for (int64_t size = 1; size < 1024; ++size) {
+        std::vector<TypeParam> arr = get_uniform_rand_array<TypeParam>(size);
+        std::vector<TypeParam> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        int64_t k = rand() % size;
+        x86simdsort::qselect(arr.data(), k, size);
+        ASSERT_EQ(sortedarr[k], arr[k]) << "Array size = " << size;
+        for (int64_t jj = 0; jj < k; ++jj) {
+            ASSERT_LE(arr[jj], arr[k]) << "Array size = " << size;
+        }
+        for (int64_t jj = k + 1; jj < size; ++jj) {
+            ASSERT_GE(arr[jj], arr[k]) << "Array size = " << size;
+        }
+    }
+}
+
+TYPED_TEST_P(simdsort, test_partial_qsort)
+{
+    for (int64_t size = 1; size < 1024; ++size) {
+        std::vector<TypeParam> arr = get_uniform_rand_array<TypeParam>(size);
+        std::vector<TypeParam> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        int64_t k = 1 + rand() % size;
+        x86simdsort::partial_qsort(arr.data(), k, size);
+        arr.resize(k);
+        sortedarr.resize(k);
+        ASSERT_EQ(sortedarr, arr) << "Array size = " << size;
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(simdsort,
+                            test_qsort,
+                            test_qselect,
+                            test_partial_qsort);
+
+template <typename T>
+class simdargsort : public ::testing::Test {
+};
+TYPED_TEST_SUITE_P(simdargsort);
+
+TYPED_TEST_P(simdargsort, test_argsort)
+{
+    for (int64_t size = 0; size < 1024; ++size) {
+        std::vector<TypeParam> arr
+                = get_uniform_rand_array_with_uniquevalues<TypeParam>(size);
+        std::vector<int64_t> expected(arr.size());
+        std::iota(expected.begin(), expected.end(), 0);
+        std::sort(expected.begin(),
+                  expected.end(),
+                  [&arr](int64_t a, int64_t b) { return arr[a] < arr[b]; });
+        std::vector<int64_t> arg
+                = x86simdsort::argsort(arr.data(), (int64_t)arr.size());
+        /* 16-bit arrays have duplicates, whose indices can come in any order */
+        std::vector<TypeParam> expected_keys, keys;
+        for (size_t ii = 0; ii < arr.size(); ++ii) {
+            expected_keys.push_back(arr[expected[ii]]);
+            keys.push_back(arr[arg[ii]]);
+        }
+        ASSERT_EQ(expected_keys, keys) << "Array size = " << arr.size();
+        std::sort(arg.begin(), arg.end());
+        std::sort(expected.begin(), expected.end());
+        ASSERT_EQ(expected, arg) << "Indices aren't unique";
+    }
+}
+
+TYPED_TEST_P(simdargsort, test_argselect)
+{
+    for (int64_t size = 1; size < 1024; ++size) {
+        std::vector<TypeParam> arr = get_uniform_rand_array<TypeParam>(size);
+        std::vector<TypeParam> sortedarr = arr;
+        std::sort(sortedarr.begin(), sortedarr.end());
+        int64_t k = rand() % size;
+        std::vector<int64_t> arg
+                = x86simdsort::argselect(arr.data(), k, size);
+        ASSERT_EQ(sortedarr[k], arr[arg[k]]) << "Array size = " << size;
+        for (int64_t jj = 0; jj < k; ++jj) {
+            ASSERT_LE(arr[arg[jj]], arr[arg[k]]) << "Array size = " << size;
+        }
+        for (int64_t jj = k + 1; jj < size; ++jj) {
+            ASSERT_GE(arr[arg[jj]], arr[arg[k]]) << "Array size = " << size;
+        }
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(simdargsort, test_argsort, test_argselect);
+
+using SortTypes = testing::Types<uint8_t,
+                                 int8_t,
+                                 uint16_t,
+                                 int16_t,
+                                 float,
+                                 double,
+                                 uint32_t,
+                                 int32_t,
+                                 uint64_t,
+                                 int64_t>;
+using ArgSortTypes = testing::Types<uint16_t,
+                                    int16_t,
+                                    float,
+                                    double,
+                                    uint32_t,
+                                    int32_t,
+                                    uint64_t,
+                                    int64_t>;
+
+INSTANTIATE_TYPED_TEST_SUITE_P(xss, simdsort, SortTypes);
+INSTANTIATE_TYPED_TEST_SUITE_P(xss, simdargsort, ArgSortTypes);
@@ -3,6 +3,7 @@
  * * SPDX-License-Identifier: BSD-3-Clause
  * *******************************************/
 
+#include <algorithm>
 #include <iostream>
 #include <random>
 #include <type_traits>
@@ -19,7 +20,9 @@ static std::vector<T> get_uniform_rand_array(
     std::random_device r;
     std::default_random_engine e1(r());
     e1.seed(42);
-    std::uniform_int_distribution<T> uniform_dist(min, max);
+    /* uniform_int_distribution is not defined for 8-bit types */
+    using dist_t = typename std::conditional<sizeof(T) == 1, int, T>::type;
+    std::uniform_int_distribution<dist_t> uniform_dist(min, max);
     for (int64_t ii = 0; ii < arrsize; ++ii) {
         arr.emplace_back(uniform_dist(e1));
     }